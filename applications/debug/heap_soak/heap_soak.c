@@ -0,0 +1,346 @@
+#include <furi.h>
+#include <furi_hal.h>
+
+#include <gui/gui.h>
+#include <input/input.h>
+#include <storage/storage.h>
+#include <toolbox/stream/file_stream.h>
+
+#include <lib/subghz/receiver.h>
+#include <lib/subghz/subghz_file_encoder_worker.h>
+#include <lib/subghz/protocols/protocol_items.h>
+#include <lib/nfc/nfc_worker.h>
+#include <lib/nfc/nfc_device.h>
+
+#define TAG "HeapSoak"
+
+/* Soak benchmark for heap fragmentation.
+ *
+ * Sub-GHz receiver decodes a recorded RAW file over and over, keeping decoded keys the way
+ * receiver history does. NFC worker runs read cycles, card is optional. Heap state is sampled
+ * to a CSV file, run the same session on firmware built with and without MEMMGR_SLAB and
+ * compare how largest free block degrades. */
+#define HEAP_SOAK_RAW_PATH EXT_PATH("unit_tests/subghz/test_random_raw.sub")
+#define HEAP_SOAK_LOG_PATH EXT_PATH("heap_soak.csv")
+#define HEAP_SOAK_SAMPLE_PERIOD_S (60)
+#define HEAP_SOAK_NFC_CYCLE_MS (1000)
+#define HEAP_SOAK_HISTORY_SIZE (16)
+
+typedef enum {
+    HeapSoakEventTypeTick,
+    HeapSoakEventTypeInput,
+} HeapSoakEventType;
+
+typedef struct {
+    HeapSoakEventType type;
+    InputEvent input;
+} HeapSoakEvent;
+
+typedef struct {
+    uint32_t elapsed;
+    size_t free;
+    size_t max_free_block;
+    size_t start_max_free_block;
+    size_t worst_max_free_block;
+    uint32_t subghz_decodes;
+    uint32_t nfc_reads;
+} HeapSoakState;
+
+typedef struct {
+    FuriMutex* mutex;
+    HeapSoakState state;
+
+    volatile bool running;
+    volatile uint32_t subghz_decodes;
+    volatile uint32_t nfc_reads;
+
+    FuriThread* subghz_thread;
+    FuriThread* nfc_thread;
+
+    // Decoded keys, replaced in a ring like receiver history does
+    FlipperFormat* history[HEAP_SOAK_HISTORY_SIZE];
+    size_t history_index;
+    SubGhzRadioPreset preset;
+} HeapSoak;
+
+static void heap_soak_subghz_rx_callback(
+    SubGhzReceiver* receiver,
+    SubGhzProtocolDecoderBase* decoder_base,
+    void* context) {
+    HeapSoak* app = context;
+
+    FuriString* text = furi_string_alloc();
+    subghz_protocol_decoder_base_get_string(decoder_base, text);
+
+    FlipperFormat* item = app->history[app->history_index];
+    if(item) flipper_format_free(item);
+    item = flipper_format_string_alloc();
+    subghz_protocol_decoder_base_serialize(decoder_base, item, &app->preset);
+    app->history[app->history_index] = item;
+    app->history_index = (app->history_index + 1) % HEAP_SOAK_HISTORY_SIZE;
+
+    furi_string_free(text);
+    subghz_receiver_reset(receiver);
+    app->subghz_decodes++;
+}
+
+static int32_t heap_soak_subghz_thread(void* context) {
+    HeapSoak* app = context;
+
+    SubGhzEnvironment* environment = subghz_environment_alloc();
+    subghz_environment_set_protocol_registry(environment, (void*)&subghz_protocol_registry);
+    SubGhzReceiver* receiver = subghz_receiver_alloc_init(environment);
+    subghz_receiver_set_filter(receiver, SubGhzProtocolFlag_Decodable);
+    subghz_receiver_set_rx_callback(receiver, heap_soak_subghz_rx_callback, app);
+
+    while(app->running) {
+        SubGhzFileEncoderWorker* file_worker = subghz_file_encoder_worker_alloc();
+        if(!subghz_file_encoder_worker_start(file_worker, HEAP_SOAK_RAW_PATH, NULL)) {
+            FURI_LOG_E(TAG, "Can't open %s, Sub-GHz loop stopped", HEAP_SOAK_RAW_PATH);
+            subghz_file_encoder_worker_free(file_worker);
+            break;
+        }
+
+        // Worker needs some time to read the beginning of the file
+        furi_delay_ms(100);
+        while(app->running) {
+            LevelDuration level_duration =
+                subghz_file_encoder_worker_get_level_duration(file_worker);
+            if(level_duration_is_reset(level_duration)) break;
+            // Yield, to load data inside the worker
+            furi_thread_yield();
+            subghz_receiver_decode(
+                receiver,
+                level_duration_get_level(level_duration),
+                level_duration_get_duration(level_duration));
+        }
+
+        if(subghz_file_encoder_worker_is_running(file_worker)) {
+            subghz_file_encoder_worker_stop(file_worker);
+        }
+        subghz_file_encoder_worker_free(file_worker);
+    }
+
+    for(size_t i = 0; i < HEAP_SOAK_HISTORY_SIZE; i++) {
+        if(app->history[i]) flipper_format_free(app->history[i]);
+        app->history[i] = NULL;
+    }
+
+    subghz_receiver_free(receiver);
+    subghz_environment_free(environment);
+
+    return 0;
+}
+
+static bool heap_soak_nfc_worker_callback(NfcWorkerEvent event, void* context) {
+    HeapSoak* app = context;
+    if(event == NfcWorkerEventReadUidNfcA || event == NfcWorkerEventReadUidNfcB ||
+       event == NfcWorkerEventReadUidNfcF || event == NfcWorkerEventReadUidNfcV ||
+       event == NfcWorkerEventReadMfUltralight || event == NfcWorkerEventReadMfDesfire ||
+       event == NfcWorkerEventReadMfClassicDone || event == NfcWorkerEventReadBankCard ||
+       event == NfcWorkerEventReadNfcV) {
+        app->nfc_reads++;
+    }
+    return true;
+}
+
+static int32_t heap_soak_nfc_thread(void* context) {
+    HeapSoak* app = context;
+
+    NfcWorker* worker = nfc_worker_alloc();
+    NfcDevice* device = nfc_device_alloc();
+    FuriString* format = furi_string_alloc();
+
+    while(app->running) {
+        nfc_worker_start(
+            worker, NfcWorkerStateRead, &device->dev_data, heap_soak_nfc_worker_callback, app);
+        furi_delay_ms(HEAP_SOAK_NFC_CYCLE_MS);
+        nfc_worker_stop(worker);
+
+        // Same as saving read card: render it and drop it
+        nfc_device_prepare_format_string(device, format);
+        nfc_device_data_clear(&device->dev_data);
+    }
+
+    furi_string_free(format);
+    nfc_device_free(device);
+    nfc_worker_free(worker);
+
+    return 0;
+}
+
+static void heap_soak_sample(HeapSoak* app, uint32_t elapsed) {
+    const size_t max_free_block = memmgr_heap_get_max_free_block();
+
+    furi_check(furi_mutex_acquire(app->mutex, FuriWaitForever) == FuriStatusOk);
+    HeapSoakState* state = &app->state;
+    state->elapsed = elapsed;
+    state->free = memmgr_get_free_heap();
+    state->max_free_block = max_free_block;
+    if(!state->start_max_free_block) state->start_max_free_block = max_free_block;
+    if(!state->worst_max_free_block || max_free_block < state->worst_max_free_block) {
+        state->worst_max_free_block = max_free_block;
+    }
+    state->subghz_decodes = app->subghz_decodes;
+    state->nfc_reads = app->nfc_reads;
+    furi_check(furi_mutex_release(app->mutex) == FuriStatusOk);
+}
+
+static void heap_soak_log(HeapSoak* app, Stream* log) {
+    size_t slab_objects = 0;
+    size_t slab_pages = 0;
+    for(size_t i = 0; i < memmgr_heap_slab_get_class_count(); i++) {
+        MemmgrHeapSlabStats stats;
+        memmgr_heap_slab_get_stats(i, &stats);
+        slab_objects += stats.objects;
+        slab_pages += stats.pages;
+    }
+
+    const HeapSoakState* state = &app->state;
+    stream_write_format(
+        log,
+        "%lu,%zu,%zu,%zu,%lu,%zu,%zu,%lu,%lu\n",
+        state->elapsed,
+        state->free,
+        memmgr_get_minimum_free_heap(),
+        state->max_free_block,
+        memmgr_heap_fragmentation_index(state->free, state->max_free_block),
+        slab_objects,
+        slab_pages,
+        state->subghz_decodes,
+        state->nfc_reads);
+}
+
+static void heap_soak_draw_callback(Canvas* canvas, void* context) {
+    HeapSoak* app = context;
+
+    furi_check(furi_mutex_acquire(app->mutex, FuriWaitForever) == FuriStatusOk);
+    const HeapSoakState state = app->state;
+    furi_check(furi_mutex_release(app->mutex) == FuriStatusOk);
+
+    canvas_clear(canvas);
+    canvas_set_font(canvas, FontPrimary);
+    canvas_draw_str(
+        canvas, 2, 10, memmgr_heap_slab_get_class_count() ? "Heap soak: slab" : "Heap soak");
+
+    canvas_set_font(canvas, FontSecondary);
+    char buffer[64];
+    snprintf(
+        buffer,
+        sizeof(buffer),
+        "Time: %lu:%02lu:%02lu",
+        state.elapsed / 3600,
+        state.elapsed / 60 % 60,
+        state.elapsed % 60);
+    canvas_draw_str(canvas, 2, 22, buffer);
+    snprintf(buffer, sizeof(buffer), "Free: %zu", state.free);
+    canvas_draw_str(canvas, 2, 32, buffer);
+    snprintf(
+        buffer,
+        sizeof(buffer),
+        "Block: %zu / %zu",
+        state.max_free_block,
+        state.start_max_free_block);
+    canvas_draw_str(canvas, 2, 42, buffer);
+    snprintf(buffer, sizeof(buffer), "Worst block: %zu", state.worst_max_free_block);
+    canvas_draw_str(canvas, 2, 52, buffer);
+    snprintf(
+        buffer, sizeof(buffer), "SubGhz: %lu NFC: %lu", state.subghz_decodes, state.nfc_reads);
+    canvas_draw_str(canvas, 2, 62, buffer);
+}
+
+static void heap_soak_input_callback(InputEvent* input_event, void* context) {
+    FuriMessageQueue* event_queue = context;
+    HeapSoakEvent event = {.type = HeapSoakEventTypeInput, .input = *input_event};
+    furi_message_queue_put(event_queue, &event, FuriWaitForever);
+}
+
+static void heap_soak_timer_callback(void* context) {
+    FuriMessageQueue* event_queue = context;
+    HeapSoakEvent event = {.type = HeapSoakEventTypeTick};
+    // It's OK to loose this event if system overloaded
+    furi_message_queue_put(event_queue, &event, 0);
+}
+
+int32_t heap_soak_app(void* p) {
+    UNUSED(p);
+
+    HeapSoak* app = malloc(sizeof(HeapSoak));
+    app->mutex = furi_mutex_alloc(FuriMutexTypeNormal);
+    app->preset.name = furi_string_alloc_set("AM650");
+    app->preset.frequency = 433920000;
+    app->running = true;
+
+    FuriMessageQueue* event_queue = furi_message_queue_alloc(8, sizeof(HeapSoakEvent));
+    ViewPort* view_port = view_port_alloc();
+    view_port_draw_callback_set(view_port, heap_soak_draw_callback, app);
+    view_port_input_callback_set(view_port, heap_soak_input_callback, event_queue);
+    Gui* gui = furi_record_open(RECORD_GUI);
+    gui_add_view_port(gui, view_port, GuiLayerFullscreen);
+
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    Stream* log = file_stream_alloc(storage);
+    if(file_stream_open(log, HEAP_SOAK_LOG_PATH, FSAM_WRITE, FSOM_CREATE_ALWAYS)) {
+        stream_write_format(
+            log,
+            "# slab classes: %zu\n"
+            "elapsed_s,free,min_free,max_free_block,fragmentation,slab_objects,slab_pages,"
+            "subghz_decodes,nfc_reads\n",
+            memmgr_heap_slab_get_class_count());
+    } else {
+        FURI_LOG_E(TAG, "Can't open %s", HEAP_SOAK_LOG_PATH);
+    }
+
+    heap_soak_sample(app, 0);
+    heap_soak_log(app, log);
+
+    app->subghz_thread =
+        furi_thread_alloc_ex("HeapSoakSubGhz", 2048, heap_soak_subghz_thread, app);
+    app->nfc_thread = furi_thread_alloc_ex("HeapSoakNfc", 1024, heap_soak_nfc_thread, app);
+    furi_thread_start(app->subghz_thread);
+    furi_thread_start(app->nfc_thread);
+
+    FuriTimer* timer =
+        furi_timer_alloc(heap_soak_timer_callback, FuriTimerTypePeriodic, event_queue);
+    furi_timer_start(timer, furi_kernel_get_tick_frequency());
+
+    const uint32_t start = furi_get_tick();
+    HeapSoakEvent event;
+    while(true) {
+        furi_check(furi_message_queue_get(event_queue, &event, FuriWaitForever) == FuriStatusOk);
+        if(event.type == HeapSoakEventTypeInput) {
+            if(event.input.type == InputTypeShort && event.input.key == InputKeyBack) break;
+        } else {
+            const uint32_t elapsed = (furi_get_tick() - start) / furi_kernel_get_tick_frequency();
+            heap_soak_sample(app, elapsed);
+            if(elapsed % HEAP_SOAK_SAMPLE_PERIOD_S == 0) {
+                heap_soak_log(app, log);
+            }
+            view_port_update(view_port);
+        }
+    }
+
+    furi_timer_free(timer);
+
+    app->running = false;
+    furi_thread_join(app->subghz_thread);
+    furi_thread_join(app->nfc_thread);
+    furi_thread_free(app->subghz_thread);
+    furi_thread_free(app->nfc_thread);
+
+    heap_soak_log(app, log);
+    file_stream_close(log);
+    stream_free(log);
+    furi_record_close(RECORD_STORAGE);
+
+    gui_remove_view_port(gui, view_port);
+    view_port_free(view_port);
+    furi_record_close(RECORD_GUI);
+    furi_message_queue_free(event_queue);
+
+    furi_string_free(app->preset.name);
+    furi_mutex_free(app->mutex);
+    free(app);
+
+    return 0;
+}
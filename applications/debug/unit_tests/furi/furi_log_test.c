@@ -0,0 +1,118 @@
+#include <stdio.h>
+#include <string.h>
+#include <furi.h>
+#include <furi_hal.h>
+#include "../minunit.h"
+
+#define TEST_LOG_TAG "LogTest"
+#define TEST_LOG_FLOOD_COUNT (1000)
+
+static FuriString* test_log_output;
+static FuriMutex* test_log_output_mutex;
+
+// Called by LogWorker in deferred mode, output is collected by test thread
+static void test_log_puts(const char* data) {
+    furi_check(furi_mutex_acquire(test_log_output_mutex, FuriWaitForever) == FuriStatusOk);
+    furi_string_cat_str(test_log_output, data);
+    furi_check(furi_mutex_release(test_log_output_mutex) == FuriStatusOk);
+}
+
+static void test_log_puts_discard(const char* data) {
+    UNUSED(data);
+}
+
+static uint32_t test_log_timestamp(void) {
+    return 1234;
+}
+
+static void test_log_emit(void) {
+    // Not in flash, deferred mode must copy it
+    char stack_string[] = "stack string";
+    // Longer than deferred mode copies, printed in full, in order with queued records
+    char long_string[] = "/ext/apps_data/unit_tests/a/rather/long/path/that/is/over/the/limit.txt";
+
+    FURI_LOG_I(TEST_LOG_TAG, "plain");
+    FURI_LOG_I(
+        TEST_LOG_TAG,
+        "%d %u %x %ld %lu %lld %zu %c %%",
+        -5,
+        7u,
+        255,
+        -9L,
+        9UL,
+        -1LL,
+        (size_t)33,
+        'Q');
+    FURI_LOG_W(
+        TEST_LOG_TAG, "%s|%-8s|%*d|%.*s|%p", stack_string, "left", 6, 42, 5, stack_string, NULL);
+    FURI_LOG_E(TEST_LOG_TAG, "%.3s %hhd %hd %+d %#x %5.2f|", "abcdef", -3, -4, 3, 10, 3.14159);
+    FURI_LOG_I(TEST_LOG_TAG, "%s %.70s", long_string, long_string);
+    FURI_LOG_I(TEST_LOG_TAG, "after long");
+}
+
+// Only our records, other threads may log at the same time
+static void test_log_collect(FuriString* filtered) {
+    furi_check(furi_mutex_acquire(test_log_output_mutex, FuriWaitForever) == FuriStatusOk);
+    const char* line = furi_string_get_cstr(test_log_output);
+    while(*line) {
+        const char* end = strstr(line, "\r\n");
+        if(!end) break;
+        end += 2;
+
+        const char* tag = strstr(line, "[" TEST_LOG_TAG "]");
+        if(tag && tag < end) {
+            furi_string_cat_printf(filtered, "%.*s", (int)(end - line), line);
+        }
+        line = end;
+    }
+    furi_string_reset(test_log_output);
+    furi_check(furi_mutex_release(test_log_output_mutex) == FuriStatusOk);
+}
+
+void test_furi_log() {
+    FuriString* sync_output = furi_string_alloc();
+    FuriString* deferred_output = furi_string_alloc();
+    test_log_output = furi_string_alloc();
+    test_log_output_mutex = furi_mutex_alloc(FuriMutexTypeNormal);
+    FuriLogStats stats_before, stats_after;
+    FuriLogLevel level = furi_log_get_level();
+
+    furi_log_set_level(FuriLogLevelInfo);
+    furi_log_set_timestamp(test_log_timestamp);
+    furi_log_set_puts(test_log_puts);
+
+    // Deferred records look exactly as synchronous ones
+    test_log_emit();
+    test_log_collect(sync_output);
+
+    furi_log_set_mode(FuriLogModeDeferred);
+    test_log_emit();
+    furi_log_set_mode(FuriLogModeSync);
+    test_log_collect(deferred_output);
+
+    // Every record is either printed or counted as dropped
+    furi_log_set_puts(test_log_puts_discard);
+    furi_log_get_stats(&stats_before);
+    furi_log_set_mode(FuriLogModeDeferred);
+    for(size_t i = 0; i < TEST_LOG_FLOOD_COUNT; i++) {
+        FURI_LOG_I(TEST_LOG_TAG, "flood %u", i);
+    }
+    furi_log_set_mode(FuriLogModeSync);
+    furi_log_get_stats(&stats_after);
+
+    furi_log_set_puts(furi_hal_console_puts);
+    furi_log_set_timestamp(furi_get_tick);
+    furi_log_set_level(level);
+
+    mu_assert_string_eq(furi_string_get_cstr(sync_output), furi_string_get_cstr(deferred_output));
+    // Other threads may log meanwhile too
+    mu_check(
+        (stats_after.written - stats_before.written) +
+            (stats_after.dropped - stats_before.dropped) >=
+        TEST_LOG_FLOOD_COUNT);
+
+    furi_string_free(sync_output);
+    furi_string_free(deferred_output);
+    furi_string_free(test_log_output);
+    furi_mutex_free(test_log_output_mutex);
+}
@@ -1,4 +1,5 @@
 #include "../minunit.h"
+#include <furi.h>
 #include <stdlib.h>
 #include <string.h>
 #include <stdbool.h>
@@ -36,3 +37,117 @@ void test_furi_memmgr() {
     }
     free(ptr);
 }
+
+#define TEST_HEAP_PROFILE_ALLOCS (8)
+#define TEST_HEAP_PROFILE_SIZE (100)
+
+// Site is looked up by address, or by allocations made if address is not known yet
+static const MemmgrHeapProfileSite*
+    test_heap_profile_find_site(const uint8_t* dump, uint32_t address) {
+    const MemmgrHeapProfileHeader* header = (const MemmgrHeapProfileHeader*)dump;
+    const MemmgrHeapProfileSite* sites =
+        (const void*)(dump + header->header_size + header->size_class_count * sizeof(uint32_t));
+    for(size_t i = 0; i < header->site_count; i++) {
+        if(address ? sites[i].address == address :
+                     sites[i].count == TEST_HEAP_PROFILE_ALLOCS &&
+                         sites[i].live >= TEST_HEAP_PROFILE_ALLOCS * TEST_HEAP_PROFILE_SIZE) {
+            return &sites[i];
+        }
+    }
+    return NULL;
+}
+
+void test_furi_memmgr_heap_profile() {
+    void* ptrs[TEST_HEAP_PROFILE_ALLOCS];
+    size_t size;
+
+    memmgr_heap_profile_start();
+    mu_check(memmgr_heap_profile_is_running());
+
+    // Same call site for all of them
+    for(size_t i = 0; i < TEST_HEAP_PROFILE_ALLOCS; i++) {
+        ptrs[i] = malloc(TEST_HEAP_PROFILE_SIZE);
+    }
+
+    uint8_t* dump = memmgr_heap_profile_dump(&size);
+    mu_check(dump != NULL);
+    const MemmgrHeapProfileHeader* header = (const MemmgrHeapProfileHeader*)dump;
+    mu_assert_int_eq(MEMMGR_HEAP_PROFILE_MAGIC, header->magic);
+    mu_assert_int_eq(MEMMGR_HEAP_PROFILE_VERSION, header->version);
+    mu_check(header->alloc_count >= TEST_HEAP_PROFILE_ALLOCS);
+    mu_check(header->live >= TEST_HEAP_PROFILE_ALLOCS * TEST_HEAP_PROFILE_SIZE);
+    mu_check(header->peak >= header->live);
+    mu_check(header->worst_max_free_block <= header->max_free_block);
+
+    // 100 bytes belong to (64, 128] class
+    const uint32_t* size_classes = (const uint32_t*)(dump + header->header_size);
+    mu_check(size_classes[4] >= TEST_HEAP_PROFILE_ALLOCS);
+
+    const MemmgrHeapProfileSite* site = test_heap_profile_find_site(dump, 0);
+    mu_check(site != NULL);
+    const uint32_t site_address = site->address;
+    free(dump);
+
+    for(size_t i = 0; i < TEST_HEAP_PROFILE_ALLOCS; i++) {
+        free(ptrs[i]);
+    }
+
+    // Freed blocks are accounted back to the site they came from
+    dump = memmgr_heap_profile_dump(&size);
+    mu_check(dump != NULL);
+    site = test_heap_profile_find_site(dump, site_address);
+    mu_check(site != NULL);
+    mu_assert_int_eq(0, site->live);
+    free(dump);
+
+    memmgr_heap_profile_clear();
+    mu_check(!memmgr_heap_profile_is_running());
+    mu_check(memmgr_heap_profile_dump(&size) == NULL);
+}
+
+#define TEST_SLAB_ALLOCS (32)
+
+void test_furi_memmgr_slab() {
+    MemmgrHeapSlabStats before, after;
+    uint8_t* ptrs[TEST_SLAB_ALLOCS];
+    size_t dump_size;
+
+    mu_assert(memmgr_heap_slab_get_class_count() > 0, "slab allocator is not built in\r\n");
+
+    memmgr_heap_profile_start();
+    memmgr_heap_slab_get_stats(0, &before);
+    const size_t size = before.object_size;
+
+    for(size_t i = 0; i < TEST_SLAB_ALLOCS; i++) {
+        ptrs[i] = malloc(size);
+        // Objects are zeroed like any other allocation
+        for(size_t j = 0; j < size; j++) {
+            mu_assert_int_eq(0, ptrs[i][j]);
+        }
+        memset(ptrs[i], i + 1, size);
+    }
+
+    memmgr_heap_slab_get_stats(0, &after);
+    mu_check(
+        (after.allocs - before.allocs) + (after.fallbacks - before.fallbacks) >=
+        TEST_SLAB_ALLOCS);
+    mu_check(after.capacity >= after.objects);
+    mu_check(after.objects_peak >= after.objects);
+
+    // No object overlaps another one
+    for(size_t i = 0; i < TEST_SLAB_ALLOCS; i++) {
+        for(size_t j = 0; j < size; j++) {
+            mu_assert_int_eq(i + 1, ptrs[i][j]);
+        }
+        free(ptrs[i]);
+    }
+
+    // Heap profile sees slab objects freed as well as allocated
+    uint8_t* dump = memmgr_heap_profile_dump(&dump_size);
+    mu_check(dump != NULL);
+    const MemmgrHeapProfileHeader* header = (const MemmgrHeapProfileHeader*)dump;
+    mu_check(header->alloc_count >= TEST_SLAB_ALLOCS);
+    mu_check(header->free_count >= TEST_SLAB_ALLOCS);
+    free(dump);
+    memmgr_heap_profile_clear();
+}
@@ -1,6 +1,7 @@
 #include <stdio.h>
 #include <string.h>
 #include <furi.h>
+#include <furi_hal.h>
 #include "../minunit.h"
 
 const uint32_t context_value = 0xdeadbeef;
@@ -43,3 +44,93 @@ void test_furi_pubsub() {
     // delete pubsub case
     furi_pubsub_free(test_pubsub);
 }
+
+#define TEST_PUBSUB_SLOW_MS (50)
+#define TEST_PUBSUB_BENCHMARK_ROUNDS (100)
+
+typedef struct {
+    FuriPubSub* pubsub;
+    volatile bool entered;
+    volatile bool finished;
+} TestPubSubSlow;
+
+static void test_pubsub_slow_handler(const void* arg, void* ctx) {
+    UNUSED(arg);
+    TestPubSubSlow* slow = ctx;
+    slow->entered = true;
+    furi_delay_ms(TEST_PUBSUB_SLOW_MS);
+    slow->finished = true;
+}
+
+static void test_pubsub_busy_handler(const void* arg, void* ctx) {
+    UNUSED(arg);
+    UNUSED(ctx);
+    furi_delay_us(1000);
+}
+
+static int32_t test_pubsub_slow_publisher(void* ctx) {
+    TestPubSubSlow* slow = ctx;
+    uint32_t value = notify_value_0;
+    furi_pubsub_publish(slow->pubsub, &value);
+    return 0;
+}
+
+static uint32_t test_pubsub_publish_time_us(FuriPubSub* pubsub) {
+    uint32_t value = notify_value_1;
+    uint32_t cycles = DWT->CYCCNT;
+    for(size_t i = 0; i < TEST_PUBSUB_BENCHMARK_ROUNDS; i++) {
+        furi_pubsub_publish(pubsub, &value);
+    }
+    cycles = DWT->CYCCNT - cycles;
+    return cycles / furi_hal_cortex_instructions_per_microsecond() / TEST_PUBSUB_BENCHMARK_ROUNDS;
+}
+
+void test_furi_pubsub_slow_subscriber() {
+    TestPubSubSlow slow = {.pubsub = furi_pubsub_alloc()};
+    FuriPubSubSubscription* slow_subscription =
+        furi_pubsub_subscribe(slow.pubsub, test_pubsub_slow_handler, &slow);
+
+    FuriThread* thread =
+        furi_thread_alloc_ex("PubSubSlow", 1024, test_pubsub_slow_publisher, &slow);
+
+    // Publishers don't wait for each other
+    furi_thread_start(thread);
+    while(!slow.entered) furi_delay_tick(1);
+    uint32_t time = furi_get_tick();
+    uint32_t value = notify_value_1;
+    furi_pubsub_publish(slow.pubsub, &value);
+    time = furi_get_tick() - time;
+    furi_thread_join(thread);
+    mu_assert(
+        time < furi_ms_to_ticks(TEST_PUBSUB_SLOW_MS * 3 / 2),
+        "publish waited for another publisher");
+
+    // Unsubscribe waits for delivery in progress
+    slow.entered = false;
+    slow.finished = false;
+    furi_thread_start(thread);
+    while(!slow.entered) furi_delay_tick(1);
+    furi_pubsub_unsubscribe(slow.pubsub, slow_subscription);
+    mu_assert(slow.finished, "unsubscribe returned during callback");
+    furi_thread_join(thread);
+    furi_thread_free(thread);
+
+    // Publish latency: subscriber doing work in callback vs subscriber with its own queue
+    FuriPubSubSubscription* subscription =
+        furi_pubsub_subscribe(slow.pubsub, test_pubsub_busy_handler, NULL);
+    uint32_t callback_us = test_pubsub_publish_time_us(slow.pubsub);
+    furi_pubsub_unsubscribe(slow.pubsub, subscription);
+
+    FuriMessageQueue* queue = furi_message_queue_alloc(8, sizeof(uint32_t));
+    subscription = furi_pubsub_subscribe_queue(slow.pubsub, queue);
+    uint32_t queue_us = test_pubsub_publish_time_us(slow.pubsub);
+    furi_pubsub_unsubscribe(slow.pubsub, subscription);
+
+    FURI_LOG_I(
+        "PubSubTest", "publish latency: callback %luus, queue %luus", callback_us, queue_us);
+    mu_assert(queue_us < callback_us, "queue delivery is slower than callback");
+    mu_assert_int_eq(8, furi_message_queue_get_count(queue));
+
+    furi_message_queue_free(queue);
+    furi_pubsub_free(slow.pubsub);
+}
@@ -7,8 +7,12 @@
 void test_furi_create_open();
 void test_furi_concurrent_access();
 void test_furi_pubsub();
+void test_furi_pubsub_slow_subscriber();
 
 void test_furi_memmgr();
+void test_furi_memmgr_heap_profile();
+void test_furi_memmgr_slab();
+void test_furi_log();
 
 static int foo = 0;
 
@@ -33,12 +37,28 @@ MU_TEST(mu_test_furi_pubsub) {
     test_furi_pubsub();
 }
 
+MU_TEST(mu_test_furi_pubsub_slow_subscriber) {
+    test_furi_pubsub_slow_subscriber();
+}
+
 MU_TEST(mu_test_furi_memmgr) {
     // this test is not accurate, but gives a basic understanding
     // that memory management is working fine
     test_furi_memmgr();
 }
 
+MU_TEST(mu_test_furi_memmgr_heap_profile) {
+    test_furi_memmgr_heap_profile();
+}
+
+MU_TEST(mu_test_furi_memmgr_slab) {
+    test_furi_memmgr_slab();
+}
+
+MU_TEST(mu_test_furi_log) {
+    test_furi_log();
+}
+
 MU_TEST_SUITE(test_suite) {
     MU_SUITE_CONFIGURE(&test_setup, &test_teardown);
 
@@ -47,7 +67,14 @@ MU_TEST_SUITE(test_suite) {
     // v2 tests
     MU_RUN_TEST(mu_test_furi_create_open);
     MU_RUN_TEST(mu_test_furi_pubsub);
+    MU_RUN_TEST(mu_test_furi_pubsub_slow_subscriber);
     MU_RUN_TEST(mu_test_furi_memmgr);
+    MU_RUN_TEST(mu_test_furi_memmgr_heap_profile);
+    // Slab is a build option, MEMMGR_SLAB in fbt_options.py
+    if(memmgr_heap_slab_get_class_count() > 0) {
+        MU_RUN_TEST(mu_test_furi_memmgr_slab);
+    }
+    MU_RUN_TEST(mu_test_furi_log);
 }
 
 int run_minunit_test_furi() {
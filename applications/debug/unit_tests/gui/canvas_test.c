@@ -0,0 +1,274 @@
+#include <furi.h>
+#include <furi_hal.h>
+#include <gui/canvas_i.h>
+#include <gui/icon_i.h>
+#include <assets_icons.h>
+#include <u8g2_glue.h>
+#include "../minunit.h"
+
+#define TAG "CanvasTest"
+
+#define CANVAS_TEST_BUFFER_SIZE (128 * 64 / 8)
+#define CANVAS_TEST_RANDOM_ROUNDS (2000)
+
+static u8g2_t canvas_test_fb;
+static u8g2_t canvas_test_fb_ref;
+static uint8_t* canvas_test_buffer;
+static uint8_t* canvas_test_buffer_ref;
+static CompressIcon* canvas_test_compress_icon;
+
+/* Per pixel bitmap drawing as it was before the blitter, used as reference */
+static void canvas_test_ref_draw_int(
+    u8g2_t* u8g2,
+    u8g2_uint_t x,
+    u8g2_uint_t y,
+    u8g2_uint_t w,
+    u8g2_uint_t h,
+    bool mirror,
+    bool rotation,
+    const uint8_t* bitmap) {
+    u8g2_uint_t blen = (w + 7) >> 3;
+
+    if(rotation && !mirror) {
+        x += w + 1;
+    } else if(mirror && !rotation) {
+        y += h - 1;
+    }
+
+    while(h > 0) {
+        const uint8_t* b = bitmap;
+        uint16_t len = w;
+        uint16_t x0 = x;
+        uint16_t y0 = y;
+        uint8_t color = u8g2->draw_color;
+        uint8_t ncolor = (color == 0 ? 1 : 0);
+        uint8_t mask = 1;
+
+        while(len > 0) {
+            if(*b & mask) {
+                u8g2->draw_color = color;
+                u8g2_DrawHVLine(u8g2, x0, y0, 1, 0);
+            } else if(u8g2->bitmap_transparency == 0) {
+                u8g2->draw_color = ncolor;
+                u8g2_DrawHVLine(u8g2, x0, y0, 1, 0);
+            }
+
+            if(rotation) {
+                y0++;
+            } else {
+                x0++;
+            }
+
+            mask <<= 1;
+            if(mask == 0) {
+                mask = 1;
+                b++;
+            }
+            len--;
+        }
+
+        u8g2->draw_color = color;
+        bitmap += blen;
+
+        if(mirror) {
+            if(rotation) {
+                x++;
+            } else {
+                y--;
+            }
+        } else {
+            if(rotation) {
+                x--;
+            } else {
+                y++;
+            }
+        }
+        h--;
+    }
+}
+
+static void canvas_test_ref_draw(
+    u8g2_t* u8g2,
+    u8g2_uint_t x,
+    u8g2_uint_t y,
+    u8g2_uint_t w,
+    u8g2_uint_t h,
+    const uint8_t* bitmap,
+    IconRotation rotation) {
+    if(u8g2_IsIntersection(u8g2, x, y, x + w, y + h) == 0) return;
+    canvas_test_ref_draw_int(
+        u8g2,
+        x,
+        y,
+        w,
+        h,
+        rotation == IconRotation180 || rotation == IconRotation270,
+        rotation == IconRotation90 || rotation == IconRotation270,
+        bitmap);
+}
+
+static void canvas_test_setup_fb(u8g2_t* fb, uint8_t* buffer) {
+    // Display callbacks are never called: nothing is sent, only the buffer is drawn
+    u8g2_Setup_st756x_flipper(fb, U8G2_R0, u8x8_byte_empty, u8x8_dummy_cb);
+    u8g2_SetupBuffer(fb, buffer, 8, u8g2_ll_hvline_vertical_top_lsb, U8G2_R0);
+}
+
+static void canvas_test_alloc() {
+    canvas_test_buffer = malloc(CANVAS_TEST_BUFFER_SIZE);
+    canvas_test_buffer_ref = malloc(CANVAS_TEST_BUFFER_SIZE);
+    canvas_test_setup_fb(&canvas_test_fb, canvas_test_buffer);
+    canvas_test_setup_fb(&canvas_test_fb_ref, canvas_test_buffer_ref);
+    canvas_test_compress_icon = compress_icon_alloc();
+}
+
+static void canvas_test_free() {
+    compress_icon_free(canvas_test_compress_icon);
+    free(canvas_test_buffer);
+    free(canvas_test_buffer_ref);
+}
+
+static void canvas_test_prepare(uint8_t color, uint8_t transparency, uint8_t fill) {
+    memset(canvas_test_buffer, fill, CANVAS_TEST_BUFFER_SIZE);
+    memset(canvas_test_buffer_ref, fill, CANVAS_TEST_BUFFER_SIZE);
+    canvas_test_fb.draw_color = color;
+    canvas_test_fb_ref.draw_color = color;
+    canvas_test_fb.bitmap_transparency = transparency;
+    canvas_test_fb_ref.bitmap_transparency = transparency;
+}
+
+static bool canvas_test_draw_compare(
+    uint8_t x,
+    uint8_t y,
+    uint8_t w,
+    uint8_t h,
+    const uint8_t* bitmap,
+    IconRotation rotation) {
+    canvas_draw_u8g2_bitmap(&canvas_test_fb, x, y, w, h, bitmap, rotation);
+    canvas_test_ref_draw(&canvas_test_fb_ref, x, y, w, h, bitmap, rotation);
+    return memcmp(canvas_test_buffer, canvas_test_buffer_ref, CANVAS_TEST_BUFFER_SIZE) == 0;
+}
+
+MU_TEST(canvas_bitmap_random_test) {
+    const size_t bitmap_size = 32 * 96;
+    uint8_t* bitmap = malloc(bitmap_size);
+    bool match = true;
+
+    for(size_t i = 0; match && i < CANVAS_TEST_RANDOM_ROUNDS; i++) {
+        furi_hal_random_fill_buf(bitmap, bitmap_size);
+        uint8_t params[8];
+        furi_hal_random_fill_buf(params, sizeof(params));
+
+        uint8_t w = params[0] % 96 + 1;
+        uint8_t h = params[1] % 96 + 1;
+        // Mostly near the screen, sometimes wrapped around from the other side
+        uint8_t x = (params[2] & 0x80) ? params[3] : params[3] % 140;
+        uint8_t y = (params[2] & 0x40) ? params[4] : params[4] % 70;
+        IconRotation rotation = params[5] % 4;
+
+        if(params[6] & 1) {
+            uint8_t x0 = params[6] % 128;
+            uint8_t y0 = params[7] % 64;
+            uint8_t x1 = x0 + params[3] % (129 - x0);
+            uint8_t y1 = y0 + params[4] % (65 - y0);
+            u8g2_SetClipWindow(&canvas_test_fb, x0, y0, x1, y1);
+            u8g2_SetClipWindow(&canvas_test_fb_ref, x0, y0, x1, y1);
+        } else {
+            u8g2_SetMaxClipWindow(&canvas_test_fb);
+            u8g2_SetMaxClipWindow(&canvas_test_fb_ref);
+        }
+
+        canvas_test_prepare(params[5] % 3, params[2] & 1, params[7]);
+        match = canvas_test_draw_compare(x, y, w, h, bitmap, rotation);
+        if(!match) {
+            FURI_LOG_E(TAG, "%ux%u at %u,%u rotation %u mismatch", w, h, x, y, rotation);
+        }
+    }
+
+    u8g2_SetMaxClipWindow(&canvas_test_fb);
+    u8g2_SetMaxClipWindow(&canvas_test_fb_ref);
+    free(bitmap);
+    mu_assert(match, "bitmap differs from per pixel drawing\r\n");
+}
+
+MU_TEST(canvas_bitmap_icons_test) {
+    const uint8_t positions[][2] = {{0, 0}, {7, 3}, {100, 50}, {250, 251}};
+    bool match = true;
+
+    for(size_t i = 0; match && i < ICON_PATHS_COUNT; i++) {
+        const Icon* icon = ICON_PATHS[i].icon;
+        uint8_t* bitmap = NULL;
+        compress_icon_decode(canvas_test_compress_icon, icon_get_data(icon), &bitmap);
+
+        for(size_t p = 0; match && p < COUNT_OF(positions); p++) {
+            for(IconRotation rotation = IconRotation0; match && rotation <= IconRotation270;
+                rotation++) {
+                canvas_test_prepare((i + p) % 3, (i + rotation) & 1, 0x5A);
+                match = canvas_test_draw_compare(
+                    positions[p][0],
+                    positions[p][1],
+                    icon->width,
+                    icon->height,
+                    bitmap,
+                    rotation);
+                if(!match) {
+                    FURI_LOG_E(TAG, "%s rotation %u mismatch", ICON_PATHS[i].path, rotation);
+                }
+            }
+        }
+    }
+
+    mu_assert(match, "icon differs from per pixel drawing\r\n");
+}
+
+MU_TEST(canvas_bitmap_benchmark_test) {
+    uint32_t cycles = 0;
+    uint32_t cycles_ref = 0;
+    size_t pixels = 0;
+
+    canvas_test_prepare(1, 0, 0);
+    for(size_t i = 0; i < ICON_PATHS_COUNT; i++) {
+        const Icon* icon = ICON_PATHS[i].icon;
+        uint8_t* bitmap = NULL;
+        compress_icon_decode(canvas_test_compress_icon, icon_get_data(icon), &bitmap);
+        pixels += icon->width * icon->height;
+
+        FURI_CRITICAL_ENTER();
+        uint32_t time_start = DWT->CYCCNT;
+        canvas_draw_u8g2_bitmap(
+            &canvas_test_fb, 0, 0, icon->width, icon->height, bitmap, IconRotation0);
+        cycles += DWT->CYCCNT - time_start;
+        time_start = DWT->CYCCNT;
+        canvas_test_ref_draw(
+            &canvas_test_fb_ref, 0, 0, icon->width, icon->height, bitmap, IconRotation0);
+        cycles_ref += DWT->CYCCNT - time_start;
+        FURI_CRITICAL_EXIT();
+    }
+
+    if(ICON_PATHS_COUNT == 0) return;
+
+    // One frame is every shipped icon drawn once. Only logged, timing depends on the rest of
+    // the system, output is compared above
+    const uint32_t cycles_per_second = furi_hal_cortex_instructions_per_microsecond() * 1000000;
+    FURI_LOG_I(
+        TAG,
+        "%u icons, %u pixels: %lu fps, per pixel reference %lu fps",
+        ICON_PATHS_COUNT,
+        pixels,
+        cycles_per_second / MAX(cycles, 1UL),
+        cycles_per_second / MAX(cycles_ref, 1UL));
+}
+
+MU_TEST_SUITE(canvas) {
+    canvas_test_alloc();
+
+    MU_RUN_TEST(canvas_bitmap_random_test);
+    MU_RUN_TEST(canvas_bitmap_icons_test);
+    MU_RUN_TEST(canvas_bitmap_benchmark_test);
+
+    canvas_test_free();
+}
+
+int run_minunit_test_canvas() {
+    MU_RUN_SUITE(canvas);
+    return MU_EXIT_CODE;
+}
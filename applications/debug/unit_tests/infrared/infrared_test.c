@@ -1,6 +1,7 @@
 #include <furi.h>
 #include <flipper_format.h>
 #include <infrared.h>
+#include <infrared_analyzer.h>
 #include <common/infrared_common_i.h>
 #include "../minunit.h"
 
@@ -522,6 +523,74 @@ MU_TEST(infrared_test_encoder_decoder_all) {
     infrared_test_run_encoder_decoder(InfraredProtocolRCA, 1);
 }
 
+MU_TEST(infrared_test_analyzer) {
+    const InfraredMessage message = {
+        .protocol = InfraredProtocolNEC, .address = 0x42, .command = 0x13, .repeat = false};
+    const uint32_t frames = 3;
+    uint32_t timings_count = 200;
+    uint32_t* timings = malloc(sizeof(uint32_t) * timings_count * frames);
+    uint32_t* expanded = malloc(sizeof(uint32_t) * timings_count * frames);
+    InfraredAnalyzer* analyzer = infrared_analyzer_alloc();
+
+    infrared_reset_encoder(test->encoder_handler, &message);
+    infrared_test_run_encoder_fill_array(test->encoder_handler, timings, &timings_count, NULL);
+    /* Skip leading silence, receiver makes marks a bit longer */
+    --timings_count;
+    memmove(timings, &timings[1], sizeof(uint32_t) * timings_count);
+    for(size_t i = 0; i < timings_count; i += 2) {
+        timings[i] += 60;
+    }
+
+    mu_assert_int_eq(
+        InfraredAnalyzerResultMessage,
+        infrared_analyzer_process(
+            analyzer,
+            timings,
+            timings_count,
+            INFRARED_COMMON_CARRIER_FREQUENCY,
+            INFRARED_COMMON_DUTY_CYCLE));
+    infrared_test_compare_message_results(infrared_analyzer_get_message(analyzer), &message);
+
+    /* NEC can't be sent on that carrier, so the same timings become template */
+    mu_assert_int_eq(
+        InfraredAnalyzerResultTemplate,
+        infrared_analyzer_process(
+            analyzer, timings, timings_count, 56000, INFRARED_COMMON_DUTY_CYCLE));
+    const InfraredTemplate* tmpl = infrared_analyzer_get_template(analyzer);
+    mu_assert_int_eq(1, tmpl->repeat);
+    mu_assert_int_eq(
+        timings_count, infrared_template_expand(tmpl, expanded, timings_count * frames));
+    for(size_t i = 0; i < timings_count; ++i) {
+        mu_check(MATCH_TIMING(expanded[i], timings[i], INFRARED_ANALYZER_TOLERANCE_US));
+    }
+
+    /* Frames separated by gaps fold into one */
+    for(size_t frame = 1; frame < frames; ++frame) {
+        timings[(timings_count + 1) * frame - 1] = 40000;
+        memcpy(&timings[(timings_count + 1) * frame], timings, sizeof(uint32_t) * timings_count);
+    }
+    timings_count = (timings_count + 1) * frames - 1;
+
+    mu_assert_int_eq(
+        InfraredAnalyzerResultTemplate,
+        infrared_analyzer_process(
+            analyzer,
+            timings,
+            timings_count,
+            INFRARED_COMMON_CARRIER_FREQUENCY,
+            INFRARED_COMMON_DUTY_CYCLE));
+    mu_assert_int_eq(frames, tmpl->repeat);
+    mu_assert_int_eq(timings_count, infrared_template_get_timings_size(tmpl));
+    mu_assert_int_eq(timings_count, infrared_template_expand(tmpl, expanded, timings_count));
+    for(size_t i = 0; i < timings_count; ++i) {
+        mu_check(MATCH_TIMING(expanded[i], timings[i], INFRARED_ANALYZER_TOLERANCE_US));
+    }
+
+    infrared_analyzer_free(analyzer);
+    free(expanded);
+    free(timings);
+}
+
 MU_TEST_SUITE(infrared_test) {
     MU_SUITE_CONFIGURE(&infrared_test_alloc, &infrared_test_free);
 
@@ -541,6 +610,7 @@ MU_TEST_SUITE(infrared_test) {
     MU_RUN_TEST(infrared_test_decoder_rca);
     MU_RUN_TEST(infrared_test_decoder_mixed);
     MU_RUN_TEST(infrared_test_encoder_decoder_all);
+    MU_RUN_TEST(infrared_test_analyzer);
 }
 
 int run_minunit_test_infrared() {
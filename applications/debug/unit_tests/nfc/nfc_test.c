@@ -3,6 +3,7 @@
 #include <storage/storage.h>
 #include <lib/flipper_format/flipper_format.h>
 #include <lib/nfc/protocols/nfca.h>
+#include <lib/nfc/protocols/crypto1.h>
 #include <lib/nfc/helpers/mf_classic_dict.h>
 #include <lib/digital_signal/digital_signal.h>
 #include <lib/nfc/nfc_device.h>
@@ -19,6 +20,12 @@
 #define NFC_TEST_SIGNAL_SHORT_FILE "nfc_nfca_signal_short.nfc"
 #define NFC_TEST_SIGNAL_LONG_FILE "nfc_nfca_signal_long.nfc"
 #define NFC_TEST_DICT_PATH EXT_PATH("unit_tests/mf_classic_dict.nfc")
+#define NFC_TEST_DICT_COMPILED_PATH EXT_PATH("unit_tests/.mf_classic_dict.bin")
+#define NFC_TEST_DICT_BENCHMARK_KEYS (512)
+#define NFC_TEST_DICT_BENCHMARK_SECTORS (8)
+#define NFC_TEST_CRYPTO1_ITERATIONS (2000)
+#define NFC_TEST_CRYPTO1_BENCHMARK_BYTES (16)
+#define NFC_TEST_CRYPTO1_BENCHMARK_ROUNDS (64)
 #define NFC_TEST_NFC_DEV_PATH EXT_PATH("unit_tests/nfc/nfc_dev_test.nfc")
 
 static const char* nfc_test_file_type = "Flipper NFC test";
@@ -222,6 +229,140 @@ MU_TEST(nfc_digital_signal_test) {
         "NFC long digital signal test failed\r\n");
 }
 
+// Bitwise Crypto1 reference, the implementation the table driven one replaced
+static uint8_t nfc_test_crypto1_ref_filter(uint32_t in) {
+    uint32_t out = 0;
+    out = 0xf22c0 >> (in & 0xf) & 16;
+    out |= 0x6c9c0 >> (in >> 4 & 0xf) & 8;
+    out |= 0x3c8b0 >> (in >> 8 & 0xf) & 4;
+    out |= 0x1e458 >> (in >> 12 & 0xf) & 2;
+    out |= 0x0d938 >> (in >> 16 & 0xf) & 1;
+    return FURI_BIT(0xEC57E80A, out);
+}
+
+static uint8_t nfc_test_crypto1_ref_bit(Crypto1* crypto1, uint8_t in, int is_encrypted) {
+    uint8_t out = nfc_test_crypto1_ref_filter(crypto1->odd);
+    uint32_t feed = out & (!!is_encrypted);
+    feed ^= !!in;
+    feed ^= 0x29CE5C & crypto1->odd;
+    feed ^= 0x870804 & crypto1->even;
+    crypto1->even = crypto1->even << 1 | __builtin_parity(feed);
+
+    FURI_SWAP(crypto1->odd, crypto1->even);
+    return out;
+}
+
+static uint8_t nfc_test_crypto1_ref_byte(Crypto1* crypto1, uint8_t in, int is_encrypted) {
+    uint8_t out = 0;
+    for(uint8_t i = 0; i < 8; i++) {
+        out |= nfc_test_crypto1_ref_bit(crypto1, FURI_BIT(in, i), is_encrypted) << i;
+    }
+    return out;
+}
+
+static uint32_t nfc_test_crypto1_ref_word(Crypto1* crypto1, uint32_t in, int is_encrypted) {
+    uint32_t out = 0;
+    for(uint8_t i = 0; i < 32; i++) {
+        out |= nfc_test_crypto1_ref_bit(crypto1, FURI_BIT(in, i ^ 24), is_encrypted) << (24 ^ i);
+    }
+    return out;
+}
+
+static void nfc_test_crypto1_ref_encrypt(
+    Crypto1* crypto,
+    uint8_t* keystream,
+    uint8_t* plain_data,
+    uint16_t plain_data_bits,
+    uint8_t* encrypted_data,
+    uint8_t* encrypted_parity) {
+    memset(encrypted_parity, 0, plain_data_bits / 8 + 1);
+    for(uint8_t i = 0; i < plain_data_bits / 8; i++) {
+        encrypted_data[i] =
+            nfc_test_crypto1_ref_byte(crypto, keystream ? keystream[i] : 0, 0) ^ plain_data[i];
+        encrypted_parity[i / 8] |=
+            (((nfc_test_crypto1_ref_filter(crypto->odd) ^ !__builtin_parity(plain_data[i])) &
+              0x01)
+             << (7 - (i & 0x0007)));
+    }
+}
+
+static bool nfc_test_crypto1_state_equal(Crypto1* a, Crypto1* b) {
+    return (a->odd & 0xFFFFFF) == (b->odd & 0xFFFFFF) &&
+           (a->even & 0xFFFFFF) == (b->even & 0xFFFFFF);
+}
+
+MU_TEST(crypto1_differential_test) {
+    uint8_t plain[NFC_TEST_CRYPTO1_BENCHMARK_BYTES];
+    uint8_t keystream[NFC_TEST_CRYPTO1_BENCHMARK_BYTES];
+    uint8_t encrypted[NFC_TEST_CRYPTO1_BENCHMARK_BYTES];
+    uint8_t encrypted_ref[NFC_TEST_CRYPTO1_BENCHMARK_BYTES];
+    uint8_t parity[NFC_TEST_CRYPTO1_BENCHMARK_BYTES + 1];
+    uint8_t parity_ref[NFC_TEST_CRYPTO1_BENCHMARK_BYTES + 1];
+    bool equal = true;
+
+    for(size_t i = 0; i < NFC_TEST_CRYPTO1_ITERATIONS && equal; i++) {
+        uint64_t key = 0;
+        furi_hal_random_fill_buf((uint8_t*)&key, 6);
+        uint32_t in = furi_hal_random_get();
+        int is_encrypted = in & 1;
+        furi_hal_random_fill_buf(plain, sizeof(plain));
+        furi_hal_random_fill_buf(keystream, sizeof(keystream));
+
+        Crypto1 crypto;
+        Crypto1 crypto_ref;
+        crypto1_init(&crypto, key);
+        crypto_ref = crypto;
+
+        equal &= crypto1_filter(crypto.odd) == nfc_test_crypto1_ref_filter(crypto_ref.odd);
+        equal &= crypto1_word(&crypto, in, is_encrypted) ==
+                 nfc_test_crypto1_ref_word(&crypto_ref, in, is_encrypted);
+        equal &= crypto1_byte(&crypto, in >> 8, is_encrypted) ==
+                 nfc_test_crypto1_ref_byte(&crypto_ref, in >> 8, is_encrypted);
+        equal &= crypto1_bit(&crypto, in & 2, is_encrypted) ==
+                 nfc_test_crypto1_ref_bit(&crypto_ref, in & 2, is_encrypted);
+        equal &= nfc_test_crypto1_state_equal(&crypto, &crypto_ref);
+
+        uint8_t* stream = (in & 4) ? keystream : NULL;
+        uint16_t bits = 8 * (1 + (in >> 16) % NFC_TEST_CRYPTO1_BENCHMARK_BYTES);
+        crypto1_encrypt(&crypto, stream, plain, bits, encrypted, parity);
+        nfc_test_crypto1_ref_encrypt(&crypto_ref, stream, plain, bits, encrypted_ref, parity_ref);
+        equal &= memcmp(encrypted, encrypted_ref, bits / 8) == 0;
+        equal &= memcmp(parity, parity_ref, (bits / 8 + 7) / 8) == 0;
+        equal &= nfc_test_crypto1_state_equal(&crypto, &crypto_ref);
+    }
+
+    mu_assert(equal, "Crypto1 differs from the bitwise reference\r\n");
+}
+
+MU_TEST(crypto1_benchmark_test) {
+    uint8_t plain[NFC_TEST_CRYPTO1_BENCHMARK_BYTES] = {};
+    uint8_t encrypted[NFC_TEST_CRYPTO1_BENCHMARK_BYTES];
+    uint8_t parity[NFC_TEST_CRYPTO1_BENCHMARK_BYTES + 1];
+    Crypto1 crypto;
+    crypto1_init(&crypto, 0xA0A1A2A3A4A5);
+
+    FURI_CRITICAL_ENTER();
+    uint32_t time_start = DWT->CYCCNT;
+    for(size_t i = 0; i < NFC_TEST_CRYPTO1_BENCHMARK_ROUNDS; i++) {
+        crypto1_encrypt(&crypto, NULL, plain, sizeof(plain) * 8, encrypted, parity);
+    }
+    uint32_t cycles = DWT->CYCCNT - time_start;
+    time_start = DWT->CYCCNT;
+    for(size_t i = 0; i < NFC_TEST_CRYPTO1_BENCHMARK_ROUNDS; i++) {
+        nfc_test_crypto1_ref_encrypt(&crypto, NULL, plain, sizeof(plain) * 8, encrypted, parity);
+    }
+    uint32_t cycles_ref = DWT->CYCCNT - time_start;
+    FURI_CRITICAL_EXIT();
+
+    // Only logged, timing depends on the rest of the system, correctness is checked above
+    const uint32_t bytes = NFC_TEST_CRYPTO1_BENCHMARK_ROUNDS * NFC_TEST_CRYPTO1_BENCHMARK_BYTES;
+    FURI_LOG_I(
+        TAG,
+        "Crypto1 encrypt: %lu cycles/byte, bitwise reference %lu cycles/byte",
+        cycles / bytes,
+        cycles_ref / bytes);
+}
+
 MU_TEST(mf_classic_dict_test) {
     MfClassicDict* instance = NULL;
     uint64_t key = 0;
@@ -336,6 +477,160 @@ MU_TEST(mf_classic_dict_load_test) {
     furi_record_close(RECORD_STORAGE);
 }
 
+static bool mf_classic_dict_test_write(Storage* storage, const char* content, bool append) {
+    Stream* file_stream = file_stream_alloc(storage);
+    bool written = file_stream_open(
+                       file_stream,
+                       NFC_TEST_DICT_PATH,
+                       FSAM_WRITE,
+                       append ? FSOM_OPEN_APPEND : FSOM_CREATE_ALWAYS) &&
+                   stream_write_cstring(file_stream, content) == strlen(content);
+    file_stream_close(file_stream);
+    stream_free(file_stream);
+    return written;
+}
+
+MU_TEST(mf_classic_dict_compiled_test) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    storage_simply_remove(storage, NFC_TEST_DICT_COMPILED_PATH);
+
+    // Duplicates in different case, comments and CRLF line endings
+    mu_assert(
+        mf_classic_dict_test_write(
+            storage,
+            "# Unit test dict\nA0A1A2A3A4A5\nffffffffffff\r\na0a1a2a3a4a5\n2196FAD8115B\n",
+            false),
+        "write dict failed\r\n");
+
+    MfClassicDict* instance = mf_classic_dict_alloc(MfClassicDictTypeUnitTestCompiled);
+    mu_assert(instance != NULL, "mf_classic_dict_alloc\r\n");
+    mu_assert_int_eq(3, mf_classic_dict_get_total_keys(instance));
+
+    // Source order is kept
+    uint64_t key = 0;
+    mu_check(mf_classic_dict_get_next_key(instance, &key));
+    mu_assert(key == 0xA0A1A2A3A4A5, "invalid key order\r\n");
+    mu_check(mf_classic_dict_get_next_key(instance, &key));
+    mu_assert(key == 0xFFFFFFFFFFFF, "invalid key order\r\n");
+    mu_check(mf_classic_dict_get_next_key(instance, &key));
+    mu_assert(key == 0x2196FAD8115B, "invalid key order\r\n");
+    mu_check(!mf_classic_dict_get_next_key(instance, &key));
+
+    mu_check(mf_classic_dict_rewind(instance));
+    FuriString* temp_str = furi_string_alloc();
+    mu_check(mf_classic_dict_get_key_at_index_str(instance, temp_str, 2));
+    mu_assert(furi_string_cmp_str(temp_str, "2196FAD8115B") == 0, "invalid key loaded\r\n");
+
+    uint8_t key_present[6] = {0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF};
+    uint8_t key_absent[6] = {0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFE};
+    mu_check(mf_classic_dict_is_key_present(instance, key_present));
+    mu_check(!mf_classic_dict_is_key_present(instance, key_absent));
+
+    // Compiled dictionary is read only
+    mu_check(!mf_classic_dict_add_key(instance, key_absent));
+    mf_classic_dict_free(instance);
+
+    // Source change is picked up
+    mu_assert(
+        mf_classic_dict_test_write(storage, "fffffffffffe\n", true), "write dict failed\r\n");
+    instance = mf_classic_dict_alloc(MfClassicDictTypeUnitTestCompiled);
+    mu_assert(instance != NULL, "mf_classic_dict_alloc\r\n");
+    mu_assert_int_eq(4, mf_classic_dict_get_total_keys(instance));
+    mu_check(mf_classic_dict_is_key_present(instance, key_absent));
+    furi_string_set(temp_str, "2196fad8115b");
+    mu_check(mf_classic_dict_is_key_present_str(instance, temp_str));
+    mf_classic_dict_free(instance);
+
+    furi_string_free(temp_str);
+    storage_simply_remove(storage, NFC_TEST_DICT_PATH);
+    storage_simply_remove(storage, NFC_TEST_DICT_COMPILED_PATH);
+    furi_record_close(RECORD_STORAGE);
+}
+
+// Simulated card: answer of the reader to the card nonce depends on the key
+static uint32_t mf_classic_dict_test_auth(uint64_t key, uint32_t cuid, uint32_t nt) {
+    Crypto1 crypto;
+    crypto1_reset(&crypto);
+    crypto1_init(&crypto, key);
+    crypto1_word(&crypto, cuid ^ nt, 0);
+    return crypto1_word(&crypto, 0, 0);
+}
+
+static uint32_t mf_classic_dict_test_attack(
+    MfClassicDictType dict_type,
+    uint64_t card_key,
+    uint32_t* keys_tried,
+    uint32_t* sectors_found) {
+    const uint32_t cuid = 0x2A234F80;
+    const uint32_t nt = 0x01200145;
+    uint32_t card_answer = mf_classic_dict_test_auth(card_key, cuid, nt);
+
+    uint32_t start = furi_get_tick();
+    MfClassicDict* dict = mf_classic_dict_alloc(dict_type);
+    if(dict) {
+        // Same flow as the dictionary attack worker
+        for(size_t i = 0; i < NFC_TEST_DICT_BENCHMARK_SECTORS; i++) {
+            uint64_t key;
+            while(mf_classic_dict_get_next_key(dict, &key)) {
+                (*keys_tried)++;
+                if(mf_classic_dict_test_auth(key, cuid, nt) == card_answer) {
+                    (*sectors_found)++;
+                    break;
+                }
+            }
+            mf_classic_dict_rewind(dict);
+        }
+        mf_classic_dict_free(dict);
+    }
+
+    return furi_get_tick() - start;
+}
+
+MU_TEST(mf_classic_dict_benchmark_test) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    storage_simply_remove(storage, NFC_TEST_DICT_COMPILED_PATH);
+
+    // Card key is the last one
+    FuriString* content = furi_string_alloc();
+    uint64_t key = 0x4D3A99C351DD;
+    for(size_t i = 0; i < NFC_TEST_DICT_BENCHMARK_KEYS; i++) {
+        key = (key * 0x5DEECE66DULL + 0xB) & 0xFFFFFFFFFFFFULL;
+        furi_string_cat_printf(content, "%012llX\n", key);
+    }
+    bool written = mf_classic_dict_test_write(storage, furi_string_get_cstr(content), false);
+    furi_string_free(content);
+    mu_assert(written, "write dict failed\r\n");
+
+    uint32_t text_tried = 0;
+    uint32_t text_found = 0;
+    uint32_t text_time =
+        mf_classic_dict_test_attack(MfClassicDictTypeUnitTest, key, &text_tried, &text_found);
+
+    // First run compiles the dictionary
+    uint32_t compiled_tried = 0;
+    uint32_t compiled_found = 0;
+    mf_classic_dict_test_attack(
+        MfClassicDictTypeUnitTestCompiled, key, &compiled_tried, &compiled_found);
+    compiled_tried = 0;
+    compiled_found = 0;
+    uint32_t compiled_time = mf_classic_dict_test_attack(
+        MfClassicDictTypeUnitTestCompiled, key, &compiled_tried, &compiled_found);
+
+    storage_simply_remove(storage, NFC_TEST_DICT_PATH);
+    storage_simply_remove(storage, NFC_TEST_DICT_COMPILED_PATH);
+    furi_record_close(RECORD_STORAGE);
+
+    mu_assert_int_eq(NFC_TEST_DICT_BENCHMARK_SECTORS, text_found);
+    mu_assert_int_eq(NFC_TEST_DICT_BENCHMARK_SECTORS, compiled_found);
+    mu_assert_int_eq(text_tried, compiled_tried);
+
+    FURI_LOG_I(
+        TAG,
+        "Dict attack: text %lu keys/s, compiled %lu keys/s",
+        text_tried * 1000 / MAX(text_time, 1UL),
+        compiled_tried * 1000 / MAX(compiled_time, 1UL));
+}
+
 MU_TEST(nfca_file_test) {
     NfcDevice* nfc = nfc_device_alloc();
     mu_assert(nfc != NULL, "nfc_device_data != NULL assert failed\r\n");
@@ -563,8 +858,12 @@ MU_TEST_SUITE(nfc) {
     MU_RUN_TEST(mf_classic_1k_7b_file_test);
     MU_RUN_TEST(mf_classic_4k_7b_file_test);
     MU_RUN_TEST(nfc_digital_signal_test);
+    MU_RUN_TEST(crypto1_differential_test);
+    MU_RUN_TEST(crypto1_benchmark_test);
     MU_RUN_TEST(mf_classic_dict_test);
     MU_RUN_TEST(mf_classic_dict_load_test);
+    MU_RUN_TEST(mf_classic_dict_compiled_test);
+    MU_RUN_TEST(mf_classic_dict_benchmark_test);
 
     nfc_test_free();
 }
@@ -212,8 +212,48 @@ MU_TEST(test_protocol_dict) {
     free(data);
 }
 
+MU_TEST(test_protocol_dict_batch) {
+    ProtocolDict* dict = protocol_dict_alloc(test_protocols_base, TestDictProtocolMax);
+    uint8_t data[8];
+
+    LevelDuration pairs[20];
+    for(size_t i = 0; i < COUNT_OF(pairs); i++) {
+        pairs[i] = level_duration_make(i % 2, 100);
+    }
+    pairs[11] = level_duration_make(true, 543);
+    pairs[13] = level_duration_make(true, 666);
+
+    protocol_dict_decoders_start(dict);
+    size_t consumed = 0;
+
+    // protocol 0 takes pairs up to 13 before protocol 1 ends the batch at 11
+    ProtocolId protocol_id =
+        protocol_dict_decoders_feed_batch(dict, pairs, COUNT_OF(pairs), &consumed);
+    mu_assert_int_eq(TestDictProtocol1, protocol_id);
+    mu_assert_int_eq(12, consumed);
+    protocol_dict_get_data(dict, protocol_id, data, sizeof(data));
+    mu_assert_mem_eq(&protocol_1_decoder_result, data, sizeof(uint64_t));
+
+    size_t index = consumed;
+    protocol_id =
+        protocol_dict_decoders_feed_batch(dict, &pairs[index], COUNT_OF(pairs) - index, &consumed);
+    mu_assert_int_eq(TestDictProtocol0, protocol_id);
+    mu_assert_int_eq(2, consumed);
+    protocol_dict_get_data(dict, protocol_id, data, sizeof(data));
+    mu_assert_mem_eq(&protocol_0_decoder_result, data, sizeof(uint32_t));
+
+    index += consumed;
+    protocol_id =
+        protocol_dict_decoders_feed_batch(dict, &pairs[index], COUNT_OF(pairs) - index, &consumed);
+    mu_assert_int_eq(PROTOCOL_NO, protocol_id);
+    mu_assert_int_eq(COUNT_OF(pairs) - index, consumed);
+
+    protocol_dict_free(dict);
+}
+
 MU_TEST_SUITE(test_protocol_dict_suite) {
     MU_RUN_TEST(test_protocol_dict);
+    MU_RUN_TEST(test_protocol_dict_batch);
 }
 
 int run_minunit_test_protocol_dict() {
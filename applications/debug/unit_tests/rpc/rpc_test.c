@@ -4,10 +4,12 @@
 #include "pb_decode.h"
 #include <rpc/rpc.h>
 #include "rpc/rpc_i.h"
+#include "rpc/rpc_gui_frame.h"
 #include "storage.pb.h"
 #include "storage/filesystem_api_defines.h"
 #include "storage/storage.h"
 #include <furi.h>
+#include <furi_hal.h>
 #include "../minunit.h"
 #include <stdint.h>
 #include <pb.h>
@@ -44,7 +46,11 @@ static RpcSessionContext rpc_session[TEST_RPC_SESSIONS];
 #define TAG "UnitTestsRpc"
 #define MAX_RECEIVE_OUTPUT_TIMEOUT 3000
 #define MAX_NAME_LENGTH 254
-#define MAX_DATA_SIZE 512u // have to be exact as in rpc_storage.c
+#define MAX_DATA_SIZE 512u // have to be exact as default chunk size in rpc.c
+#define THROUGHPUT_FILE_SIZE (64u * 1024u)
+#define THROUGHPUT_CHUNK_SIZE 4096u
+// Has to fit a whole THROUGHPUT_CHUNK_SIZE read response with protobuf framing
+#define OUTPUT_STREAM_SIZE (8u * 1024u)
 #define TEST_DIR TEST_DIR_NAME "/"
 #define TEST_DIR_NAME EXT_PATH("unit_tests_tmp")
 #define MD5SUM_SIZE 16
@@ -88,7 +94,7 @@ static void test_rpc_setup(void) {
     }
     furi_check(rpc_session[0].session);
 
-    rpc_session[0].output_stream = furi_stream_buffer_alloc(4096, 1);
+    rpc_session[0].output_stream = furi_stream_buffer_alloc(OUTPUT_STREAM_SIZE, 1);
     rpc_session_set_send_bytes_callback(rpc_session[0].session, output_bytes_callback);
     rpc_session[0].close_session_semaphore = xSemaphoreCreateBinary();
     rpc_session[0].terminate_semaphore = xSemaphoreCreateBinary();
@@ -998,6 +1004,82 @@ MU_TEST(test_storage_read) {
     test_storage_read_run(TEST_DIR "file4.txt", ++command_id);
 }
 
+static void test_storage_read_throughput_run(
+    const char* path,
+    size_t chunk_size,
+    uint32_t command_id) {
+    PB_Main request;
+    rpc_session_set_data_chunk_size(rpc_session[0].session, chunk_size);
+    test_rpc_create_simple_message(&request, PB_Main_storage_read_request_tag, path, command_id);
+
+    uint32_t start = furi_get_tick();
+    test_rpc_encode_and_feed_one(&request, 0);
+
+    rpc_session[0].timeout = xTaskGetTickCount() + MAX_RECEIVE_OUTPUT_TIMEOUT;
+    pb_istream_t istream = {
+        .callback = test_rpc_pb_stream_read,
+        .state = &rpc_session[0],
+        .errmsg = NULL,
+        .bytes_left = 0x7FFFFFFF,
+    };
+    PB_Main result = {.cb_content.funcs.decode = NULL};
+
+    size_t received = 0;
+    size_t messages = 0;
+    bool decoded = true;
+    bool data_valid = true;
+    bool has_next = true;
+    while(has_next) {
+        if(!pb_decode_ex(&istream, &PB_Main_msg, &result, PB_DECODE_DELIMITED)) {
+            decoded = false;
+            break;
+        }
+
+        has_next = result.has_next;
+        if(result.command_id != command_id ||
+           result.which_content != PB_Main_storage_read_response_tag ||
+           !result.content.storage_read_response.file.data ||
+           result.content.storage_read_response.file.data->size > chunk_size) {
+            data_valid = false;
+        } else {
+            // Same pattern as test_create_file writes
+            const pb_bytes_array_t* data = result.content.storage_read_response.file.data;
+            for(size_t i = 0; i < data->size; ++i) {
+                if(data->bytes[i] != '0' + (((received + i) % 128) % 10)) {
+                    data_valid = false;
+                    break;
+                }
+            }
+            received += data->size;
+        }
+        ++messages;
+        pb_release(&PB_Main_msg, &result);
+    }
+
+    uint32_t elapsed = furi_get_tick() - start;
+    rpc_session_set_data_chunk_size(rpc_session[0].session, MAX_DATA_SIZE);
+
+    mu_check(decoded);
+    mu_check(data_valid);
+    mu_assert_int_eq(THROUGHPUT_FILE_SIZE, received);
+    FURI_LOG_I(
+        TAG,
+        "Read %zu bytes in %zu messages of %zu bytes: %lums, %luKB/s",
+        received,
+        messages,
+        chunk_size,
+        elapsed,
+        elapsed ? (uint32_t)(received * 1000 / 1024 / elapsed) : 0);
+}
+
+MU_TEST(test_storage_read_throughput) {
+    test_create_file(TEST_DIR "throughput.bin", THROUGHPUT_FILE_SIZE);
+
+    test_storage_read_throughput_run(TEST_DIR "throughput.bin", MAX_DATA_SIZE, ++command_id);
+    test_storage_read_throughput_run(
+        TEST_DIR "throughput.bin", THROUGHPUT_CHUNK_SIZE, ++command_id);
+}
+
 static void test_storage_write_run(
     const char* path,
     size_t write_size,
@@ -1476,11 +1558,55 @@ MU_TEST(test_system_protobuf_version) {
     test_rpc_free_msg_list(expected_msg_list);
 }
 
+MU_TEST(test_gui_frame_codec) {
+    const size_t size = 1024;
+    uint8_t* previous = malloc(size);
+    uint8_t* frame = malloc(size);
+    uint8_t* decoded = malloc(size);
+    uint8_t* encoded = malloc(size);
+    bool match = true;
+
+    for(size_t round = 0; match && round < 256; round++) {
+        // Noise every third frame, about one byte in eight changed otherwise
+        furi_hal_random_fill_buf(frame, size);
+        if(round % 3) {
+            for(size_t i = 0; i < size; i++) {
+                if(frame[i] % 8) frame[i] = previous[i];
+            }
+        }
+
+        const bool keyframe = (round % 5 == 0);
+        size_t encoded_size =
+            rpc_gui_frame_encode(frame, keyframe ? NULL : previous, size, encoded, size - 1);
+        if(encoded_size == 0) {
+            memcpy(encoded, frame, size);
+            encoded_size = size;
+        }
+
+        memcpy(decoded, previous, size);
+        match = rpc_gui_frame_decode(encoded, encoded_size, decoded, size) &&
+                !memcmp(decoded, frame, size);
+        memcpy(previous, frame, size);
+    }
+
+    // Unchanged frame delta is a handful of repeat runs
+    size_t identical_size = rpc_gui_frame_encode(frame, previous, size, encoded, size - 1);
+
+    free(previous);
+    free(frame);
+    free(decoded);
+    free(encoded);
+
+    mu_assert(match, "decoded frame differs\r\n");
+    mu_assert(identical_size > 0 && identical_size <= 17, "unchanged frame delta is too big\r\n");
+}
+
 MU_TEST_SUITE(test_rpc_system) {
     MU_SUITE_CONFIGURE(&test_rpc_setup, &test_rpc_teardown);
 
     MU_RUN_TEST(test_ping);
     MU_RUN_TEST(test_system_protobuf_version);
+    MU_RUN_TEST(test_gui_frame_codec);
 }
 
 MU_TEST_SUITE(test_rpc_storage) {
@@ -1492,6 +1618,7 @@ MU_TEST_SUITE(test_rpc_storage) {
     MU_RUN_TEST(test_storage_list_md5);
     MU_RUN_TEST(test_storage_list_size);
     MU_RUN_TEST(test_storage_read);
+    MU_RUN_TEST(test_storage_read_throughput);
     MU_RUN_TEST(test_storage_write_read);
     MU_RUN_TEST(test_storage_write);
     MU_RUN_TEST(test_storage_delete);
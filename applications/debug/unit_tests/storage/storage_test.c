@@ -346,6 +346,109 @@ MU_TEST_SUITE(storage_rename) {
     furi_record_close(RECORD_STORAGE);
 }
 
+#define STORAGE_BULK_FILE UNIT_TESTS_PATH("bulk.test")
+#define STORAGE_BULK_FILE_SIZE (256 * 1024)
+#define STORAGE_BULK_BUFFER_SIZE (32 * 1024)
+#define STORAGE_BULK_SEGMENTS 4
+
+static uint32_t storage_bulk_kbps(size_t bytes, uint32_t ticks) {
+    return (uint32_t)(bytes / 1024) * furi_kernel_get_tick_frequency() / MAX(ticks, 1UL);
+}
+
+static uint32_t
+    storage_bulk_read_chunked(File* file, uint8_t* buffer, size_t chunk_size, size_t* total_read) {
+    size_t total = 0;
+    uint32_t start = furi_get_tick();
+    storage_file_seek(file, 0, true);
+    while(total < STORAGE_BULK_FILE_SIZE) {
+        size_t read = storage_file_read(file, buffer, chunk_size);
+        if(read == 0) break;
+        total += read;
+    }
+    *total_read = total;
+    return furi_get_tick() - start;
+}
+
+MU_TEST(storage_file_bulk_transfer) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    File* file = storage_file_alloc(storage);
+    uint8_t* pattern = malloc(STORAGE_BULK_BUFFER_SIZE);
+    uint8_t* buffer = malloc(STORAGE_BULK_BUFFER_SIZE);
+
+    for(size_t i = 0; i < STORAGE_BULK_BUFFER_SIZE; i++) {
+        pattern[i] = (i * 7 + i / 251) & 0xFF;
+    }
+
+    // Bulk write, one message per buffer
+    uint32_t start = furi_get_tick();
+    mu_check(storage_file_open(file, STORAGE_BULK_FILE, FSAM_READ_WRITE, FSOM_CREATE_ALWAYS));
+    for(size_t i = 0; i < STORAGE_BULK_FILE_SIZE / STORAGE_BULK_BUFFER_SIZE; i++) {
+        mu_assert_int_eq(
+            STORAGE_BULK_BUFFER_SIZE,
+            storage_file_write_bulk(file, pattern, STORAGE_BULK_BUFFER_SIZE));
+    }
+    mu_check(storage_file_sync(file));
+    uint32_t write_ticks = furi_get_tick() - start;
+
+    // Small chunks, message round-trip per chunk
+    size_t total = 0;
+    uint32_t read_512_ticks = storage_bulk_read_chunked(file, buffer, 512, &total);
+    mu_assert_int_eq(STORAGE_BULK_FILE_SIZE, total);
+    uint32_t read_4k_ticks = storage_bulk_read_chunked(file, buffer, 4096, &total);
+    mu_assert_int_eq(STORAGE_BULK_FILE_SIZE, total);
+
+    // Bulk read, data check
+    start = furi_get_tick();
+    storage_file_seek(file, 0, true);
+    for(size_t i = 0; i < STORAGE_BULK_FILE_SIZE / STORAGE_BULK_BUFFER_SIZE; i++) {
+        mu_assert_int_eq(
+            STORAGE_BULK_BUFFER_SIZE,
+            storage_file_read_bulk(file, buffer, STORAGE_BULK_BUFFER_SIZE));
+        mu_assert_mem_eq(pattern, buffer, STORAGE_BULK_BUFFER_SIZE);
+    }
+    uint32_t read_bulk_ticks = furi_get_tick() - start;
+
+    // Vectored read, segments are filled in order
+    const size_t segment_size = STORAGE_BULK_BUFFER_SIZE / STORAGE_BULK_SEGMENTS;
+    StorageFileSegment segments[STORAGE_BULK_SEGMENTS];
+    for(size_t i = 0; i < STORAGE_BULK_SEGMENTS; i++) {
+        segments[i].buff = buffer + (STORAGE_BULK_SEGMENTS - 1 - i) * segment_size;
+        segments[i].size = segment_size;
+    }
+    memset(buffer, 0, STORAGE_BULK_BUFFER_SIZE);
+    storage_file_seek(file, 0, true);
+    mu_assert_int_eq(
+        STORAGE_BULK_BUFFER_SIZE, storage_file_readv(file, segments, STORAGE_BULK_SEGMENTS));
+    for(size_t i = 0; i < STORAGE_BULK_SEGMENTS; i++) {
+        mu_assert_mem_eq(pattern + i * segment_size, segments[i].buff, segment_size);
+    }
+
+    // Reading past the end returns the tail only
+    mu_check(storage_file_seek(file, STORAGE_BULK_FILE_SIZE - 100, true));
+    mu_assert_int_eq(100, storage_file_read_bulk(file, buffer, STORAGE_BULK_BUFFER_SIZE));
+    mu_check(storage_file_eof(file));
+
+    mu_check(storage_file_close(file));
+    mu_check(storage_simply_remove(storage, STORAGE_BULK_FILE));
+
+    FURI_LOG_I(
+        "StorageTest",
+        "write bulk %luKB/s, read 512B %luKB/s, read 4KB %luKB/s, read bulk %luKB/s",
+        storage_bulk_kbps(STORAGE_BULK_FILE_SIZE, write_ticks),
+        storage_bulk_kbps(STORAGE_BULK_FILE_SIZE, read_512_ticks),
+        storage_bulk_kbps(STORAGE_BULK_FILE_SIZE, read_4k_ticks),
+        storage_bulk_kbps(STORAGE_BULK_FILE_SIZE, read_bulk_ticks));
+
+    free(buffer);
+    free(pattern);
+    storage_file_free(file);
+    furi_record_close(RECORD_STORAGE);
+}
+
+MU_TEST_SUITE(storage_bulk) {
+    MU_RUN_TEST(storage_file_bulk_transfer);
+}
+
 #define APPSDATA_APP_PATH(path) APPS_DATA_PATH "/" path
 
 static const char* storage_test_apps[] = {
@@ -642,6 +745,7 @@ int run_minunit_test_storage() {
     MU_RUN_SUITE(storage_file);
     MU_RUN_SUITE(storage_dir);
     MU_RUN_SUITE(storage_rename);
+    MU_RUN_SUITE(storage_bulk);
     MU_RUN_SUITE(test_data_path);
     MU_RUN_SUITE(test_storage_common);
     MU_RUN_SUITE(test_md5_calc_suite);
@@ -4,8 +4,13 @@
 #include <toolbox/stream/file_stream.h>
 #include <toolbox/stream/buffered_file_stream.h>
 #include <storage/storage.h>
+#include <flipper_format/flipper_format.h>
 #include "../minunit.h"
 
+// DO NOT USE THIS IN PRODUCTION CODE
+// This is a hack to access the storage message counter
+#include <storage/storage_i.h>
+
 static const char* stream_test_data = "I write differently from what I speak, "
                                       "I speak differently from what I think, "
                                       "I think differently from the way I ought to think, "
@@ -518,12 +523,111 @@ MU_TEST(stream_buffered_large_file_test) {
     furi_string_free(output_data);
 }
 
+#define STREAM_BENCH_KEYS_MAX 16
+
+typedef struct {
+    uint32_t messages;
+    uint32_t time;
+    uint32_t found;
+} StreamBenchResult;
+
+// Rewind and search every key, as loaders do when reading keys out of order
+static void stream_bench_parse(
+    Storage* storage,
+    FlipperFormat* ff,
+    const char* path,
+    FuriString** keys,
+    size_t keys_count,
+    StreamBenchResult* result) {
+    FuriString* value = furi_string_alloc();
+    const uint32_t messages = storage->messages_processed;
+    const uint32_t start = furi_get_tick();
+
+    result->found = 0;
+    if(flipper_format_buffered_file_open_existing(ff, path)) {
+        for(size_t i = keys_count; i > 0; i--) {
+            const char* key = furi_string_get_cstr(keys[i - 1]);
+            if(!flipper_format_key_exist(ff, key)) continue;
+            if(!flipper_format_rewind(ff)) continue;
+            if(flipper_format_read_string(ff, key, value)) result->found++;
+        }
+    }
+    flipper_format_buffered_file_close(ff);
+
+    result->time = furi_get_tick() - start;
+    result->messages = storage->messages_processed - messages;
+    furi_string_free(value);
+}
+
+MU_TEST_1(stream_buffered_cache_bench_subtest, const char* path) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    FuriString* keys[STREAM_BENCH_KEYS_MAX];
+    size_t keys_count = 0;
+
+    // Collect distinct keys
+    Stream* stream = buffered_file_stream_alloc(storage);
+    mu_check(buffered_file_stream_open(stream, path, FSAM_READ, FSOM_OPEN_EXISTING));
+    FuriString* line = furi_string_alloc();
+    while(keys_count < STREAM_BENCH_KEYS_MAX && stream_read_line(stream, line)) {
+        size_t separator = furi_string_search_char(line, ':');
+        if(separator == FURI_STRING_FAILURE || separator == 0) continue;
+        furi_string_left(line, separator);
+        bool known = false;
+        for(size_t i = 0; i < keys_count; i++) {
+            known |= furi_string_equal(keys[i], line);
+        }
+        if(!known) keys[keys_count++] = furi_string_alloc_set(line);
+    }
+    furi_string_free(line);
+    stream_free(stream);
+    mu_check(keys_count > 0);
+
+    StreamBenchResult single;
+    FlipperFormat* ff = flipper_format_buffered_file_alloc(storage);
+    stream_bench_parse(storage, ff, path, keys, keys_count, &single);
+    flipper_format_free(ff);
+
+    StreamBenchResult multi;
+    ff = flipper_format_buffered_file_alloc_ex(storage, 1024, 4);
+    stream_bench_parse(storage, ff, path, keys, keys_count, &multi);
+    flipper_format_free(ff);
+
+    FURI_LOG_I(
+        "StreamTest",
+        "%s: %u keys, 1x1024 %lu calls %lums, 4x1024 %lu calls %lums",
+        path,
+        keys_count,
+        single.messages,
+        single.time,
+        multi.messages,
+        multi.time);
+
+    mu_assert_int_eq(keys_count, single.found);
+    mu_assert_int_eq(keys_count, multi.found);
+
+    for(size_t i = 0; i < keys_count; i++) {
+        furi_string_free(keys[i]);
+    }
+    furi_record_close(RECORD_STORAGE);
+}
+
+MU_TEST(stream_buffered_cache_bench_test) {
+    MU_RUN_TEST_1(
+        stream_buffered_cache_bench_subtest, EXT_PATH("unit_tests/nfc/nfc_nfca_signal_long.nfc"));
+    MU_RUN_TEST_1(
+        stream_buffered_cache_bench_subtest,
+        EXT_PATH("unit_tests/subghz/security_pls_1_0_raw.sub"));
+    MU_RUN_TEST_1(
+        stream_buffered_cache_bench_subtest, EXT_PATH("unit_tests/infrared/test_sirc.irtest"));
+}
+
 MU_TEST_SUITE(stream_suite) {
     MU_RUN_TEST(stream_write_read_save_load_test);
     MU_RUN_TEST(stream_composite_test);
     MU_RUN_TEST(stream_split_test);
     MU_RUN_TEST(stream_buffered_write_after_read_test);
     MU_RUN_TEST(stream_buffered_large_file_test);
+    MU_RUN_TEST(stream_buffered_cache_bench_test);
 }
 
 int run_minunit_test_stream() {
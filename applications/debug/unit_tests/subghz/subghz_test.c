@@ -5,8 +5,13 @@
 #include <lib/subghz/transmitter.h>
 #include <lib/subghz/subghz_keystore.h>
 #include <lib/subghz/subghz_file_encoder_worker.h>
+#include <lib/subghz/subghz_raw_binary.h>
 #include <lib/subghz/protocols/protocol_items.h>
+#include <lib/subghz/protocols/keeloq_common.h>
+#include <lib/subghz/blocks/math.h>
+#include <lib/subghz/blocks/custom_btn.h>
 #include <flipper_format/flipper_format_i.h>
+#include <storage/storage.h>
 #include <lib/subghz/devices/devices.h>
 #include <lib/subghz/devices/cc1101_configs.h>
 
@@ -17,6 +22,13 @@
 #define ALUTECH_AT_4N_DIR_NAME EXT_PATH("subghz/assets/alutech_at_4n")
 #define TEST_RANDOM_DIR_NAME EXT_PATH("unit_tests/subghz/test_random_raw.sub")
 #define TEST_RANDOM_COUNT_PARSE 329
+#define TEST_RANDOM_BINARY_PATH EXT_PATH("unit_tests/subghz/test_random_raw_binary.sub")
+#define TEST_RANDOM_TEXT_PATH EXT_PATH("unit_tests/subghz/test_random_raw_text.sub")
+#define TEST_KEELOQ_KEYSTORE_PATH EXT_PATH("unit_tests/subghz/keeloq_bench_keystore.txt")
+#define TEST_KEELOQ_KEYSTORE_SIZE 2000
+#define TEST_KEELOQ_TARGET_KEY 0x1122334455667788ULL
+#define TEST_KEELOQ_TARGET_NAME "BenchTarget"
+#define TEST_KEELOQ_HOPS 16
 #define TEST_TIMEOUT 10000
 
 static SubGhzEnvironment* environment_handler;
@@ -24,6 +36,7 @@ static SubGhzReceiver* receiver_handler;
 //static SubGhzTransmitter* transmitter_handler;
 static SubGhzFileEncoderWorker* file_worker_encoder_handler;
 static uint16_t subghz_test_decoder_count = 0;
+static uint32_t subghz_test_decoder_hash = 0;
 
 static void subghz_test_rx_callback(
     SubGhzReceiver* receiver,
@@ -36,6 +49,11 @@ static void subghz_test_rx_callback(
     subghz_protocol_decoder_base_get_string(decoder_base, text);
     subghz_receiver_reset(receiver_handler);
     FURI_LOG_T(TAG, "\r\n%s", furi_string_get_cstr(text));
+    // FNV-1a over decoded output, to compare receiver runs
+    for(size_t i = 0; i < furi_string_size(text); i++) {
+        subghz_test_decoder_hash ^= (uint8_t)furi_string_get_char(text, i);
+        subghz_test_decoder_hash *= 16777619UL;
+    }
     furi_string_free(text);
     subghz_test_decoder_count++;
 }
@@ -146,6 +164,58 @@ static bool subghz_decode_random_test(const char* path) {
     }
 }
 
+static bool subghz_decode_raw_timed(
+    const char* path,
+    bool prefilter,
+    uint16_t* count,
+    uint32_t* hash,
+    uint32_t* pulses_per_second) {
+    subghz_test_decoder_count = 0;
+    subghz_test_decoder_hash = 2166136261UL;
+    subghz_environment_reset_keeloq(environment_handler);
+    subghz_custom_btns_reset();
+    subghz_receiver_set_prefilter(receiver_handler, prefilter);
+    subghz_receiver_reset(receiver_handler);
+
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    FlipperFormat* flipper_format = flipper_format_buffered_file_alloc(storage);
+    int32_t* samples = malloc(sizeof(int32_t) * 512);
+    uint32_t pulses = 0;
+    uint32_t cycles = 0;
+    bool result = false;
+
+    if(flipper_format_buffered_file_open_existing(flipper_format, path)) {
+        uint32_t samples_count = 0;
+        while(flipper_format_get_value_count(flipper_format, "RAW_Data", &samples_count)) {
+            samples_count = MIN(samples_count, 512UL);
+            if(!samples_count ||
+               !flipper_format_read_int32(flipper_format, "RAW_Data", samples, samples_count)) {
+                break;
+            }
+            // Only decoding is timed, file reading is the same for both runs
+            uint32_t start = DWT->CYCCNT;
+            for(size_t i = 0; i < samples_count; i++) {
+                subghz_receiver_decode(
+                    receiver_handler, samples[i] > 0, (uint32_t)abs(samples[i]));
+            }
+            cycles += DWT->CYCCNT - start;
+            pulses += samples_count;
+        }
+        result = pulses > 0;
+    }
+
+    free(samples);
+    flipper_format_free(flipper_format);
+    furi_record_close(RECORD_STORAGE);
+    subghz_receiver_set_prefilter(receiver_handler, true);
+
+    uint32_t time_us = cycles / furi_hal_cortex_instructions_per_microsecond();
+    *count = subghz_test_decoder_count;
+    *hash = subghz_test_decoder_hash;
+    *pulses_per_second = (uint64_t)pulses * 1000000 / MAX(time_us, 1UL);
+    return result;
+}
+
 static bool subghz_encoder_test(const char* path) {
     subghz_test_decoder_count = 0;
     uint32_t test_start = furi_get_tick();
@@ -214,6 +284,172 @@ MU_TEST(subghz_keystore_test) {
         "Test keystore error");
 }
 
+static bool subghz_keeloq_keystore_bench_write(const char* path) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    FlipperFormat* flipper_format = flipper_format_file_alloc(storage);
+    bool result = false;
+
+    do {
+        if(!flipper_format_file_open_always(flipper_format, path)) break;
+        if(!flipper_format_write_header_cstr(flipper_format, "Flipper SubGhz Keystore File", 0))
+            break;
+        uint32_t encryption = 0;
+        if(!flipper_format_write_uint32(flipper_format, "Encryption", &encryption, 1)) break;
+
+        // Decoy keys of every learning type, 8 keys per manufacture
+        Stream* stream = flipper_format_get_raw_stream(flipper_format);
+        uint64_t key = 0x0123456789ABCDEFULL;
+        for(size_t i = 0; i < TEST_KEELOQ_KEYSTORE_SIZE - 1; i++) {
+            key = key * 6364136223846793005ULL + 1442695040888963407ULL;
+            stream_write_format(
+                stream,
+                "%08lX%08lX:%u:BenchMf%u\n",
+                (uint32_t)(key >> 32),
+                (uint32_t)key,
+                (i % 4) + KEELOQ_LEARNING_SIMPLE,
+                i / 8);
+        }
+        stream_write_format(
+            stream,
+            "%08lX%08lX:%u:%s\n",
+            (uint32_t)(TEST_KEELOQ_TARGET_KEY >> 32),
+            (uint32_t)TEST_KEELOQ_TARGET_KEY,
+            KEELOQ_LEARNING_NORMAL,
+            TEST_KEELOQ_TARGET_NAME);
+        result = true;
+    } while(false);
+
+    flipper_format_free(flipper_format);
+    furi_record_close(RECORD_STORAGE);
+    return result;
+}
+
+static bool subghz_keeloq_keystore_bench_decode(
+    SubGhzProtocolDecoderBase* decoder,
+    FlipperFormat* flipper_format,
+    FuriString* text,
+    uint64_t manufacture_key,
+    const char* manufacture_name,
+    uint32_t serial,
+    uint16_t counter) {
+    uint8_t btn = 0x2;
+    uint32_t fix = (uint32_t)btn << 28 | serial;
+    uint64_t man = subghz_protocol_keeloq_common_normal_learning(fix, manufacture_key);
+    uint32_t hop;
+    do {
+        // Avoid hops that look like AN-Motors or HCS101 and skip keystore search
+        hop = subghz_protocol_keeloq_common_encrypt(
+            (uint32_t)btn << 28 | (serial & 0x3FF) << 16 | counter++, man);
+    } while((hop & 0xFFF) == 0x000 || (hop & 0xFFF) == 0x404);
+    uint64_t data = subghz_protocol_blocks_reverse_key((uint64_t)fix << 32 | hop, 64);
+
+    uint8_t key_data[sizeof(uint64_t)] = {0};
+    for(size_t i = 0; i < sizeof(uint64_t); i++) {
+        key_data[sizeof(uint64_t) - i - 1] = (data >> (i * 8)) & 0xFF;
+    }
+    uint32_t bits = 64;
+
+    stream_clean(flipper_format_get_raw_stream(flipper_format));
+    flipper_format_write_string_cstr(flipper_format, "Protocol", SUBGHZ_PROTOCOL_KEELOQ_NAME);
+    flipper_format_write_uint32(flipper_format, "Bit", &bits, 1);
+    flipper_format_write_hex(flipper_format, "Key", key_data, sizeof(uint64_t));
+    if(manufacture_name) {
+        flipper_format_write_string_cstr(flipper_format, "Manufacture", manufacture_name);
+    }
+    flipper_format_rewind(flipper_format);
+
+    if(subghz_protocol_decoder_base_deserialize(decoder, flipper_format) !=
+       SubGhzProtocolStatusOk) {
+        return false;
+    }
+    subghz_protocol_decoder_base_get_string(decoder, text);
+    return furi_string_search_str(text, TEST_KEELOQ_TARGET_NAME) != FURI_STRING_FAILURE;
+}
+
+MU_TEST(subghz_keeloq_keystore_bench_test) {
+    mu_assert(
+        subghz_keeloq_keystore_bench_write(TEST_KEELOQ_KEYSTORE_PATH),
+        "Unable to write bench keystore");
+
+    SubGhzEnvironment* environment = subghz_environment_alloc();
+    mu_assert(
+        subghz_environment_load_keystore(environment, TEST_KEELOQ_KEYSTORE_PATH),
+        "Unable to load bench keystore");
+
+    SubGhzProtocolDecoderBase* decoder = subghz_protocol_keeloq.decoder->alloc(environment);
+    FlipperFormat* flipper_format = flipper_format_string_alloc();
+    FuriString* text = furi_string_alloc();
+
+    // Busy band: remotes with unknown manufacture key, every hop walks the whole keystore
+    uint32_t start = furi_get_tick();
+    for(size_t i = 0; i < TEST_KEELOQ_HOPS; i++) {
+        subghz_environment_reset_keeloq(environment);
+        subghz_keeloq_keystore_bench_decode(
+            decoder, flipper_format, text, ~TEST_KEELOQ_TARGET_KEY, NULL, 0x0ABC000 + i, i);
+    }
+    uint32_t scan_time = furi_get_tick() - start;
+
+    // Known remote keeps transmitting, only keys of its manufacture are checked
+    bool decoded = true;
+    start = furi_get_tick();
+    for(size_t i = 0; i < TEST_KEELOQ_HOPS * 16; i++) {
+        decoded &= subghz_keeloq_keystore_bench_decode(
+            decoder,
+            flipper_format,
+            text,
+            TEST_KEELOQ_TARGET_KEY,
+            TEST_KEELOQ_TARGET_NAME,
+            0x0ABCDEF,
+            i * 4);
+    }
+    uint32_t known_time = furi_get_tick() - start;
+
+    FURI_LOG_I(
+        TAG,
+        "KeeLoq %u keys: full scan %lu decodes/s, known manufacture %lu decodes/s",
+        TEST_KEELOQ_KEYSTORE_SIZE,
+        TEST_KEELOQ_HOPS * 1000 / MAX(scan_time, 1UL),
+        TEST_KEELOQ_HOPS * 16 * 1000 / MAX(known_time, 1UL));
+
+    furi_string_free(text);
+    flipper_format_free(flipper_format);
+    subghz_protocol_keeloq.decoder->free(decoder);
+    subghz_environment_free(environment);
+
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    storage_simply_remove(storage, TEST_KEELOQ_KEYSTORE_PATH);
+    furi_record_close(RECORD_STORAGE);
+
+    mu_assert(decoded, "KeeLoq hop was not decoded with bench keystore");
+}
+
+MU_TEST(subghz_receiver_prefilter_test) {
+    uint16_t count_all = 0;
+    uint16_t count_prefilter = 0;
+    uint32_t hash_all = 0;
+    uint32_t hash_prefilter = 0;
+    uint32_t speed_all = 0;
+    uint32_t speed_prefilter = 0;
+
+    mu_assert(
+        subghz_decode_raw_timed(TEST_RANDOM_DIR_NAME, false, &count_all, &hash_all, &speed_all),
+        "Unable to replay RAW capture");
+    mu_assert(
+        subghz_decode_raw_timed(
+            TEST_RANDOM_DIR_NAME, true, &count_prefilter, &hash_prefilter, &speed_prefilter),
+        "Unable to replay RAW capture");
+
+    FURI_LOG_I(
+        TAG,
+        "Receiver: all decoders %lu pulses/s, pre-filter %lu pulses/s",
+        speed_all,
+        speed_prefilter);
+
+    mu_assert(count_all > 0, "Nothing decoded from RAW capture");
+    mu_assert_int_eq(count_all, count_prefilter);
+    mu_assert(hash_all == hash_prefilter, "Pre-filter changed decoded output");
+}
+
 typedef enum {
     SubGhzHalAsyncTxTestTypeNormal,
     SubGhzHalAsyncTxTestTypeInvalidStart,
@@ -814,9 +1050,148 @@ MU_TEST(subghz_random_test) {
     mu_assert(subghz_decode_random_test(TEST_RANDOM_DIR_NAME), "Random test error\r\n");
 }
 
+static bool subghz_raw_binary_test_open(
+    FlipperFormat* flipper_format,
+    SubGhzRawBinaryReader* reader,
+    const char* path) {
+    FuriString* temp_str = furi_string_alloc();
+    uint32_t version = 0;
+    bool result = flipper_format_buffered_file_open_existing(flipper_format, path) &&
+                  flipper_format_read_header(flipper_format, temp_str, &version) &&
+                  flipper_format_read_string(flipper_format, "Protocol", temp_str) &&
+                  subghz_raw_binary_reader_start(reader, flipper_format);
+    furi_string_free(temp_str);
+    return result;
+}
+
+static size_t subghz_raw_binary_test_parse(const char* path, uint32_t* samples_per_second) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    FlipperFormat* flipper_format = flipper_format_buffered_file_alloc(storage);
+    SubGhzRawBinaryReader* reader = subghz_raw_binary_reader_alloc();
+    int32_t* samples = malloc(sizeof(int32_t) * SUBGHZ_RAW_BINARY_BLOCK_SAMPLES);
+    size_t total = 0;
+
+    uint32_t start = furi_get_tick();
+    if(subghz_raw_binary_test_open(flipper_format, reader, path)) {
+        size_t count;
+        while((count = subghz_raw_binary_reader_read(
+                   reader, samples, SUBGHZ_RAW_BINARY_BLOCK_SAMPLES))) {
+            total += count;
+        }
+    }
+    uint32_t time = furi_get_tick() - start;
+    *samples_per_second = (uint64_t)total * 1000 / MAX(time, 1UL);
+
+    free(samples);
+    subghz_raw_binary_reader_free(reader);
+    flipper_format_free(flipper_format);
+    furi_record_close(RECORD_STORAGE);
+    return total;
+}
+
+static bool subghz_raw_binary_test_compare(const char* path_a, const char* path_b) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    FlipperFormat* flipper_format_a = flipper_format_buffered_file_alloc(storage);
+    FlipperFormat* flipper_format_b = flipper_format_buffered_file_alloc(storage);
+    SubGhzRawBinaryReader* reader_a = subghz_raw_binary_reader_alloc();
+    SubGhzRawBinaryReader* reader_b = subghz_raw_binary_reader_alloc();
+    int32_t sample_a = 0;
+    int32_t sample_b = 0;
+    bool result = false;
+
+    if(subghz_raw_binary_test_open(flipper_format_a, reader_a, path_a) &&
+       subghz_raw_binary_test_open(flipper_format_b, reader_b, path_b)) {
+        size_t count_a, count_b;
+        do {
+            count_a = subghz_raw_binary_reader_read(reader_a, &sample_a, 1);
+            count_b = subghz_raw_binary_reader_read(reader_b, &sample_b, 1);
+        } while(count_a && count_a == count_b && sample_a == sample_b);
+        result = !count_a && !count_b;
+    }
+
+    subghz_raw_binary_reader_free(reader_b);
+    subghz_raw_binary_reader_free(reader_a);
+    flipper_format_free(flipper_format_b);
+    flipper_format_free(flipper_format_a);
+    furi_record_close(RECORD_STORAGE);
+    return result;
+}
+
+static bool subghz_raw_binary_test_seek(const char* path, size_t sample) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    FlipperFormat* flipper_format = flipper_format_buffered_file_alloc(storage);
+    SubGhzRawBinaryReader* reader = subghz_raw_binary_reader_alloc();
+    int32_t* samples = malloc(sizeof(int32_t) * (sample + 1));
+    int32_t sample_seek = 0;
+    bool result = false;
+
+    if(subghz_raw_binary_test_open(flipper_format, reader, path) &&
+       subghz_raw_binary_reader_read(reader, samples, sample + 1) == sample + 1 &&
+       subghz_raw_binary_reader_seek(reader, sample) &&
+       subghz_raw_binary_reader_read(reader, &sample_seek, 1) == 1) {
+        result = samples[sample] == sample_seek;
+    }
+
+    free(samples);
+    subghz_raw_binary_reader_free(reader);
+    flipper_format_free(flipper_format);
+    furi_record_close(RECORD_STORAGE);
+    return result;
+}
+
+MU_TEST(subghz_raw_binary_test) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    mu_assert(
+        subghz_raw_binary_convert(storage, TEST_RANDOM_DIR_NAME, TEST_RANDOM_BINARY_PATH, true),
+        "Unable to convert RAW file to binary");
+    mu_assert(
+        subghz_raw_binary_convert(storage, TEST_RANDOM_BINARY_PATH, TEST_RANDOM_TEXT_PATH, false),
+        "Unable to convert RAW file to text");
+
+    FileInfo text_info = {0};
+    FileInfo binary_info = {0};
+    storage_common_stat(storage, TEST_RANDOM_DIR_NAME, &text_info);
+    storage_common_stat(storage, TEST_RANDOM_BINARY_PATH, &binary_info);
+    furi_record_close(RECORD_STORAGE);
+
+    uint32_t text_speed = 0;
+    uint32_t binary_speed = 0;
+    size_t text_count = subghz_raw_binary_test_parse(TEST_RANDOM_DIR_NAME, &text_speed);
+    size_t binary_count = subghz_raw_binary_test_parse(TEST_RANDOM_BINARY_PATH, &binary_speed);
+
+    FURI_LOG_I(
+        TAG,
+        "RAW %zu samples: text %lub %lu samples/s, binary %lub %lu samples/s",
+        text_count,
+        (uint32_t)text_info.size,
+        text_speed,
+        (uint32_t)binary_info.size,
+        binary_speed);
+
+    mu_assert(text_count > SUBGHZ_RAW_BINARY_BLOCK_SAMPLES, "RAW file is too short");
+    mu_assert_int_eq(text_count, binary_count);
+    mu_assert(
+        subghz_raw_binary_test_compare(TEST_RANDOM_DIR_NAME, TEST_RANDOM_BINARY_PATH),
+        "Binary samples differ from text");
+    mu_assert(
+        subghz_raw_binary_test_compare(TEST_RANDOM_DIR_NAME, TEST_RANDOM_TEXT_PATH),
+        "Converted text samples differ from original");
+    mu_assert(
+        subghz_raw_binary_test_seek(TEST_RANDOM_BINARY_PATH, text_count / 2),
+        "Binary seek error");
+    mu_assert(
+        subghz_decode_random_test(TEST_RANDOM_BINARY_PATH), "Random test error on binary file");
+
+    storage = furi_record_open(RECORD_STORAGE);
+    storage_simply_remove(storage, TEST_RANDOM_BINARY_PATH);
+    storage_simply_remove(storage, TEST_RANDOM_TEXT_PATH);
+    furi_record_close(RECORD_STORAGE);
+}
+
 MU_TEST_SUITE(subghz) {
     subghz_test_init();
     MU_RUN_TEST(subghz_keystore_test);
+    MU_RUN_TEST(subghz_keeloq_keystore_bench_test);
 
     MU_RUN_TEST(subghz_hal_async_tx_test);
 
@@ -889,6 +1264,8 @@ MU_TEST_SUITE(subghz) {
     MU_RUN_TEST(subghz_decoder_acurite_592txr_test);
 
     MU_RUN_TEST(subghz_random_test);
+    MU_RUN_TEST(subghz_receiver_prefilter_test);
+    MU_RUN_TEST(subghz_raw_binary_test);
     subghz_test_deinit();
 }
 
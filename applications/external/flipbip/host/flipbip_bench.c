@@ -0,0 +1,221 @@
+// Host benchmark for FlipBIP seed derivation
+//
+// Checks SHA-512 and the BIP39 test vectors (passphrase "TREZOR") through mnemonic_to_seed
+// and through the resumable job sliced at uneven round counts, then times the SHA-512
+// transform and a full 2048 round seed derivation.
+
+#include <bip39.h>
+#include <pbkdf2.h>
+#include <sha2.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define FLIPBIP_BENCH_TRANSFORMS (200000)
+#define FLIPBIP_BENCH_SEEDS (20)
+
+typedef struct {
+    const char* entropy;
+    const char* mnemonic;
+    const char* seed;
+} FlipBipBenchVector;
+
+static const FlipBipBenchVector flipbip_bench_vectors[] = {
+    {"00000000000000000000000000000000",
+     "abandon abandon abandon abandon abandon abandon abandon abandon abandon abandon abandon "
+     "about",
+     "c55257c360c07c72029aebc1b53c05ed0362ada38ead3e3e9efa3708e53495531f09a6987599d18264c1e1c92f2cf"
+     "141630c7a3c4ab7c81b2f001698e7463b04"},
+    {"7f7f7f7f7f7f7f7f7f7f7f7f7f7f7f7f",
+     "legal winner thank year wave sausage worth useful legal winner thank yellow",
+     "2e8905819b8723fe2c1d161860e5ee1830318dbf49a83bd451cfb8440c28bd6fa457fe1296106559a3c80937a1c10"
+     "69be3a3a5bd381ee6260e8d9739fce1f607"},
+    {"80808080808080808080808080808080",
+     "letter advice cage absurd amount doctor acoustic avoid letter advice cage above",
+     "d71de856f81a8acc65e6fc851a38d4d7ec216fd0796d0a6827a3ad6ed5511a30fa280f12eb2e47ed2ac03b5c462a0"
+     "358d18d69fe4f985ec81778c1b370b652a8"},
+    {"ffffffffffffffffffffffffffffffff",
+     "zoo zoo zoo zoo zoo zoo zoo zoo zoo zoo zoo wrong",
+     "ac27495480225222079d7be181583751e86f571027b0497b5b5d11218e0a8a13332572917f0f8e5a589620c6f15b1"
+     "1c61dee327651a14c34e18231052e48c069"},
+    {"000000000000000000000000000000000000000000000000",
+     "abandon abandon abandon abandon abandon abandon abandon abandon abandon abandon abandon "
+     "abandon abandon abandon abandon abandon abandon agent",
+     "035895f2f481b1b0f01fcf8c289c794660b289981a78f8106447707fdd9666ca06da5a9a565181599b79f53b844d8"
+     "a71dd9f439c52a3d7b3e8a79c906ac845fa"},
+    {"7f7f7f7f7f7f7f7f7f7f7f7f7f7f7f7f7f7f7f7f7f7f7f7f",
+     "legal winner thank year wave sausage worth useful legal winner thank year wave sausage "
+     "worth useful legal will",
+     "f2b94508732bcbacbcc020faefecfc89feafa6649a5491b8c952cede496c214a0c7b3c392d168748f2d4a612bada0"
+     "753b52a1c7ac53c1e93abd5c6320b9e95dd"},
+    {"808080808080808080808080808080808080808080808080",
+     "letter advice cage absurd amount doctor acoustic avoid letter advice cage absurd amount "
+     "doctor acoustic avoid letter always",
+     "107d7c02a5aa6f38c58083ff74f04c607c2d2c0ecc55501dadd72d025b751bc27fe913ffb796f841c49b1d33b610c"
+     "f0e91d3aa239027f5e99fe4ce9e5088cd65"},
+    {"ffffffffffffffffffffffffffffffffffffffffffffffff",
+     "zoo zoo zoo zoo zoo zoo zoo zoo zoo zoo zoo zoo zoo zoo zoo zoo zoo when",
+     "0cd6e5d827bb62eb8fc1e262254223817fd068a74b5b449cc2f667c3f1f985a76379b43348d952e2265b4cd129090"
+     "758b3e3c2c49103b5051aac2eaeb890a528"},
+    {"0000000000000000000000000000000000000000000000000000000000000000",
+     "abandon abandon abandon abandon abandon abandon abandon abandon abandon abandon abandon "
+     "abandon abandon abandon abandon abandon abandon abandon abandon abandon abandon abandon "
+     "abandon art",
+     "bda85446c68413707090a52022edd26a1c9462295029f2e60cd7c4f2bbd3097170af7a4d73245cafa9c3cca8d561a"
+     "7c3de6f5d4a10be8ed2a5e608d68f92fcc8"},
+    {"7f7f7f7f7f7f7f7f7f7f7f7f7f7f7f7f7f7f7f7f7f7f7f7f7f7f7f7f7f7f7f7f",
+     "legal winner thank year wave sausage worth useful legal winner thank year wave sausage "
+     "worth useful legal winner thank year wave sausage worth title",
+     "bc09fca1804f7e69da93c2f2028eb238c227f2e9dda30cd63699232578480a4021b146ad717fbb7e451ce9eb835f4"
+     "3620bf5c514db0f8add49f5d121449d3e87"},
+    {"8080808080808080808080808080808080808080808080808080808080808080",
+     "letter advice cage absurd amount doctor acoustic avoid letter advice cage absurd amount "
+     "doctor acoustic avoid letter advice cage absurd amount doctor acoustic bless",
+     "c0c519bd0e91a2ed54357d9d1ebef6f5af218a153624cf4f2da911a0ed8f7a09e2ef61af0aca007096df430022f7a"
+     "2b6fb91661a9589097069720d015e4e982f"},
+    {"ffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff",
+     "zoo zoo zoo zoo zoo zoo zoo zoo zoo zoo zoo zoo zoo zoo zoo zoo zoo zoo zoo zoo zoo zoo zoo "
+     "vote",
+     "dd48c104698c30cfe2b6142103248622fb7bb0ff692eebb00089b32d22484e1613912f0a5b694407be899ffd31ed3"
+     "992c456cdf60f5d4564b8ba3f05a69890ad"},
+};
+
+// Slices the GUI might run between redraws, deliberately not dividing 2048 evenly
+static const uint32_t flipbip_bench_slices[] = {1, 7, 300, 13, 64, 255};
+
+// bip39.c links mnemonic_generate, the bench never calls it
+void random_buffer(uint8_t* buf, size_t len) {
+    memset(buf, 0, len);
+}
+
+static double flipbip_bench_now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static size_t flipbip_bench_unhex(const char* hex, uint8_t* data, size_t size) {
+    size_t len = strlen(hex) / 2;
+    if(len > size) return 0;
+    for(size_t i = 0; i < len; i++) {
+        unsigned byte;
+        sscanf(hex + i * 2, "%2x", &byte);
+        data[i] = byte;
+    }
+    return len;
+}
+
+static bool flipbip_bench_check(const char* name, const uint8_t* data, const char* expected) {
+    uint8_t reference[SHA512_DIGEST_LENGTH];
+    size_t len = flipbip_bench_unhex(expected, reference, sizeof(reference));
+    if(memcmp(data, reference, len) != 0) {
+        printf("FAIL %s\n", name);
+        return false;
+    }
+    return true;
+}
+
+static bool flipbip_bench_sha512(void) {
+    bool ok = true;
+    uint8_t digest[SHA512_DIGEST_LENGTH];
+
+    sha512_Raw((const uint8_t*)"abc", 3, digest);
+    ok &= flipbip_bench_check(
+        "sha512 abc",
+        digest,
+        "ddaf35a193617abacc417349ae20413112e6fa4e89a97ea20a9eeee64b55d39a2192992a274fc1a836ba3c2"
+        "3a3feebbd454d4423643ce80e2a9ac94fa54ca49f");
+
+    uint8_t message[300];
+    for(size_t i = 0; i < sizeof(message); i++) {
+        message[i] = i;
+    }
+    sha512_Raw(message, sizeof(message), digest);
+    ok &= flipbip_bench_check(
+        "sha512 300 bytes",
+        digest,
+        "f1dca2eb677b303265b0b9baff0e061202818f35c1470a69bbaa9bb66025e948d90e565e69642506c6213ae"
+        "f3cf9e929357a59da263deb34d1236dbdcda279b3");
+
+    return ok;
+}
+
+static bool flipbip_bench_vector(const FlipBipBenchVector* vector) {
+    bool ok = true;
+    uint8_t entropy[32];
+    uint8_t seed[64];
+
+    size_t entropy_len = flipbip_bench_unhex(vector->entropy, entropy, sizeof(entropy));
+    const char* mnemonic = mnemonic_from_data(entropy, entropy_len);
+    if(!mnemonic || strcmp(mnemonic, vector->mnemonic) != 0) {
+        printf("FAIL mnemonic_from_data %s\n", vector->entropy);
+        ok = false;
+    }
+    mnemonic_clear();
+    if(!mnemonic_check(vector->mnemonic)) {
+        printf("FAIL mnemonic_check %s\n", vector->entropy);
+        ok = false;
+    }
+
+    mnemonic_to_seed(vector->mnemonic, "TREZOR", seed, NULL);
+    ok &= flipbip_bench_check("mnemonic_to_seed", seed, vector->seed);
+
+    // resumable job, uneven slices until done
+    BIP39_SEED_CTX sctx;
+    mnemonic_to_seed_Init(&sctx, vector->mnemonic, "TREZOR");
+    uint32_t rounds = 1;
+    for(size_t i = 0; rounds < BIP39_PBKDF2_ROUNDS; i++) {
+        uint32_t done = mnemonic_to_seed_Update(
+            &sctx, flipbip_bench_slices[i % (sizeof(flipbip_bench_slices) / sizeof(uint32_t))]);
+        if(done <= rounds || done > BIP39_PBKDF2_ROUNDS) {
+            printf("FAIL progress %u after %u\n", done, rounds);
+            return false;
+        }
+        rounds = done;
+    }
+    memset(seed, 0, sizeof(seed));
+    mnemonic_to_seed_Final(&sctx, seed);
+    ok &= flipbip_bench_check("mnemonic_to_seed job", seed, vector->seed);
+
+    // job abandoned half way is finished by Final
+    mnemonic_to_seed_Init(&sctx, vector->mnemonic, "TREZOR");
+    mnemonic_to_seed_Update(&sctx, BIP39_PBKDF2_ROUNDS / 2);
+    memset(seed, 0, sizeof(seed));
+    mnemonic_to_seed_Final(&sctx, seed);
+    ok &= flipbip_bench_check("mnemonic_to_seed early Final", seed, vector->seed);
+
+    return ok;
+}
+
+int main(void) {
+    bool ok = flipbip_bench_sha512();
+    const size_t vectors_count = sizeof(flipbip_bench_vectors) / sizeof(FlipBipBenchVector);
+    for(size_t i = 0; i < vectors_count; i++) {
+        ok &= flipbip_bench_vector(&flipbip_bench_vectors[i]);
+    }
+    printf("%zu BIP39 vectors: %s\n", vectors_count, ok ? "ok" : "FAILED");
+
+    uint64_t state[8] = {0};
+    uint64_t block[16] = {0};
+    double start = flipbip_bench_now();
+    for(size_t i = 0; i < FLIPBIP_BENCH_TRANSFORMS; i++) {
+        sha512_Transform(state, block, state);
+    }
+    double elapsed = flipbip_bench_now() - start;
+    printf(
+        "sha512_Transform: %.3f us (state %016llx)\n",
+        elapsed * 1e6 / FLIPBIP_BENCH_TRANSFORMS,
+        (unsigned long long)state[0]);
+
+    uint8_t seed[64];
+    start = flipbip_bench_now();
+    for(size_t i = 0; i < FLIPBIP_BENCH_SEEDS; i++) {
+        mnemonic_to_seed(flipbip_bench_vectors[0].mnemonic, "TREZOR", seed, NULL);
+    }
+    elapsed = flipbip_bench_now() - start;
+    printf("mnemonic_to_seed: %.3f ms\n", elapsed * 1e3 / FLIPBIP_BENCH_SEEDS);
+
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -191,10 +191,9 @@ void mnemonic_to_seed(
     const char* passphrase,
     uint8_t seed[512 / 8],
     void (*progress_callback)(uint32_t current, uint32_t total)) {
+#if USE_BIP39_CACHE
     int mnemoniclen = strlen(mnemonic);
     int passphraselen = strlen(passphrase);
-    if(passphraselen > 256) passphraselen = 256;
-#if USE_BIP39_CACHE
     // check cache
     if(mnemoniclen < 256 && passphraselen < 64) {
         for(int i = 0; i < BIP39_CACHE_SIZE; i++) {
@@ -207,23 +206,18 @@ void mnemonic_to_seed(
         }
     }
 #endif
-    uint8_t salt[8 + 256] = {0};
-    memcpy(salt, "mnemonic", 8);
-    memcpy(salt + 8, passphrase, passphraselen);
-    static CONFIDENTIAL PBKDF2_HMAC_SHA512_CTX pctx;
-    pbkdf2_hmac_sha512_Init(
-        &pctx, (const uint8_t*)mnemonic, mnemoniclen, salt, passphraselen + 8, 1);
+    static CONFIDENTIAL BIP39_SEED_CTX sctx;
+    mnemonic_to_seed_Init(&sctx, mnemonic, passphrase);
     if(progress_callback) {
         progress_callback(0, BIP39_PBKDF2_ROUNDS);
     }
     for(int i = 0; i < 16; i++) {
-        pbkdf2_hmac_sha512_Update(&pctx, BIP39_PBKDF2_ROUNDS / 16);
+        uint32_t current = mnemonic_to_seed_Update(&sctx, BIP39_PBKDF2_ROUNDS / 16);
         if(progress_callback) {
-            progress_callback((i + 1) * BIP39_PBKDF2_ROUNDS / 16, BIP39_PBKDF2_ROUNDS);
+            progress_callback(current, BIP39_PBKDF2_ROUNDS);
         }
     }
-    pbkdf2_hmac_sha512_Final(&pctx, seed);
-    memzero(salt, sizeof(salt));
+    mnemonic_to_seed_Final(&sctx, seed);
 #if USE_BIP39_CACHE
     // store to cache
     if(mnemoniclen < 256 && passphraselen < 64) {
@@ -236,6 +230,38 @@ void mnemonic_to_seed(
 #endif
 }
 
+void mnemonic_to_seed_Init(BIP39_SEED_CTX* sctx, const char* mnemonic, const char* passphrase) {
+    int mnemoniclen = strlen(mnemonic);
+    int passphraselen = strlen(passphrase);
+    if(passphraselen > 256) passphraselen = 256;
+    uint8_t salt[8 + 256] = {0};
+    memcpy(salt, "mnemonic", 8);
+    memcpy(salt + 8, passphrase, passphraselen);
+    // pad digests are computed once here, every round reuses them
+    pbkdf2_hmac_sha512_Init(
+        &sctx->pctx, (const uint8_t*)mnemonic, mnemoniclen, salt, passphraselen + 8, 1);
+    sctx->rounds = 1;
+    memzero(salt, sizeof(salt));
+}
+
+uint32_t mnemonic_to_seed_Update(BIP39_SEED_CTX* sctx, uint32_t rounds) {
+    if(rounds > BIP39_PBKDF2_ROUNDS - sctx->rounds) {
+        rounds = BIP39_PBKDF2_ROUNDS - sctx->rounds;
+    }
+    // Init already ran the first round, so have pbkdf2 Update run exactly `rounds`
+    sctx->pctx.first = 0;
+    pbkdf2_hmac_sha512_Update(&sctx->pctx, rounds);
+    sctx->rounds += rounds;
+    return sctx->rounds;
+}
+
+void mnemonic_to_seed_Final(BIP39_SEED_CTX* sctx, uint8_t seed[512 / 8]) {
+    // finish the job if caller stopped early, seed is only valid after all rounds
+    mnemonic_to_seed_Update(sctx, BIP39_PBKDF2_ROUNDS);
+    pbkdf2_hmac_sha512_Final(&sctx->pctx, seed);
+    sctx->rounds = 0;
+}
+
 // binary search for finding the word in the wordlist
 int mnemonic_find_word(const char* word) {
     int lo = 0, hi = BIP39_WORD_COUNT - 1;
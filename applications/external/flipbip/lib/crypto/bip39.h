@@ -28,6 +28,7 @@
 #include <stdint.h>
 
 #include "options.h"
+#include "pbkdf2.h"
 
 #define BIP39_WORD_COUNT 2048
 #define BIP39_PBKDF2_ROUNDS 2048
@@ -53,6 +54,17 @@ void mnemonic_to_seed(
     uint8_t seed[512 / 8],
     void (*progress_callback)(uint32_t current, uint32_t total));
 
+// resumable mnemonic_to_seed, lets the caller run PBKDF2 rounds in slices
+typedef struct _BIP39_SEED_CTX {
+    PBKDF2_HMAC_SHA512_CTX pctx;
+    uint32_t rounds;
+} BIP39_SEED_CTX;
+
+void mnemonic_to_seed_Init(BIP39_SEED_CTX* sctx, const char* mnemonic, const char* passphrase);
+// runs at most `rounds` more rounds, returns rounds done so far out of BIP39_PBKDF2_ROUNDS
+uint32_t mnemonic_to_seed_Update(BIP39_SEED_CTX* sctx, uint32_t rounds);
+void mnemonic_to_seed_Final(BIP39_SEED_CTX* sctx, uint8_t seed[512 / 8]);
+
 int mnemonic_find_word(const char* word);
 const char* mnemonic_complete_word(const char* prefix, int len);
 const char* mnemonic_get_word(int index);
@@ -23,6 +23,8 @@
 #define MAX_TEXT_BUF (MAX_TEXT_LEN + 1) // max length of text + null terminator
 #define MAX_ADDR_BUF (42 + 1) // 42 = max length of address + null terminator
 #define NUM_ADDRS 6
+// PBKDF2 rounds between loading screen updates while deriving the seed
+#define SEED_ROUNDS_PER_STEP 64
 
 #define PAGE_LOADING 0
 #define PAGE_INFO 1
@@ -73,6 +75,7 @@ struct FlipBipScene1 {
 };
 typedef struct {
     int page;
+    int progress;
     int strength;
     uint32_t coin;
     bool overwrite;
@@ -314,7 +317,13 @@ void flipbip_scene_1_draw(Canvas* canvas, FlipBipScene1Model* model) {
 
     if(model->page == PAGE_LOADING) {
         canvas_set_font(canvas, FontPrimary);
-        canvas_draw_str(canvas, 2, 10, TEXT_LOADING);
+        if(model->progress > 0) {
+            char loading[sizeof(TEXT_LOADING) + 5];
+            snprintf(loading, sizeof(loading), "%s %d%%", TEXT_LOADING, model->progress);
+            canvas_draw_str(canvas, 2, 10, loading);
+        } else {
+            canvas_draw_str(canvas, 2, 10, TEXT_LOADING);
+        }
         canvas_draw_str(canvas, 7, 30, s_derivation_text);
         // canvas_draw_icon(canvas, 86, 22, &I_Keychain_39x36);
         if(s_warn_insecure) {
@@ -371,9 +380,9 @@ static int flipbip_scene_1_model_init(
     FlipBipScene1Model* const model,
     const int strength,
     const uint32_t coin,
-    const bool overwrite,
-    const char* passphrase_text) {
+    const bool overwrite) {
     model->page = PAGE_LOADING;
+    model->progress = 0;
     model->mnemonic_only = false;
     model->strength = strength;
     model->coin = coin;
@@ -423,9 +432,35 @@ static int flipbip_scene_1_model_init(
         return FlipBipStatusReturn; // 10 = mnemonic only, return from parent
     }
 
-    // Generate a BIP39 seed from the mnemonic
-    mnemonic_to_seed(model->mnemonic, passphrase_text, model->seed, 0);
+    // seed is derived outside of the model lock, see flipbip_scene_1_derive_seed
+    return FlipBipStatusSuccess;
+}
+
+static void flipbip_scene_1_derive_seed(
+    FlipBipScene1* instance,
+    const char* mnemonic,
+    const char* passphrase_text,
+    uint8_t* seed) {
+    static CONFIDENTIAL BIP39_SEED_CTX sctx;
+
+    // Generate a BIP39 seed from the mnemonic in slices, so the loading screen
+    // shows progress instead of freezing for the whole PBKDF2 run
+    mnemonic_to_seed_Init(&sctx, mnemonic, passphrase_text);
+    uint32_t rounds = 0;
+    do {
+        rounds = mnemonic_to_seed_Update(&sctx, SEED_ROUNDS_PER_STEP);
+        with_view_model(
+            instance->view,
+            FlipBipScene1Model * model,
+            { model->progress = rounds * 100 / BIP39_PBKDF2_ROUNDS; },
+            true);
+        // Let the GUI thread draw before the next slice
+        furi_thread_yield();
+    } while(rounds < BIP39_PBKDF2_ROUNDS);
+    mnemonic_to_seed_Final(&sctx, seed);
+}
 
+static void flipbip_scene_1_model_init_keys(FlipBipScene1Model* const model, const uint32_t coin) {
     // Generate a BIP32 root HD node from the mnemonic
     HDNode* root = malloc(sizeof(HDNode));
     hdnode_from_seed(model->seed, 64, SECP256K1_NAME, root);
@@ -510,9 +545,6 @@ static int flipbip_scene_1_model_init(
     // Clear the BIP39 cache
     bip39_cache_clear();
 #endif
-
-    // 0 = success
-    return FlipBipStatusSuccess;
 }
 
 bool flipbip_scene_1_input(InputEvent* event, void* context) {
@@ -666,14 +698,33 @@ void flipbip_scene_1_enter(void* context) {
     //notification_message(app->notification, &sequence_blink_cyan_100);
     //flipbip_led_set_rgb(app, 255, 0, 0);
 
+    int status = FlipBipStatusSuccess;
+    const char* mnemonic = NULL;
+    with_view_model(
+        instance->view,
+        FlipBipScene1Model * model,
+        {
+            status = flipbip_scene_1_model_init(model, strength, coin, overwrite);
+            mnemonic = model->mnemonic;
+        },
+        true);
+
+    // Only the view dispatcher thread (this one) touches the mnemonic until keys are built
+    CONFIDENTIAL uint8_t seed[64] = {0};
+    if(status == FlipBipStatusSuccess) {
+        flipbip_scene_1_derive_seed(instance, mnemonic, passphrase_text, seed);
+    }
+
     with_view_model(
         instance->view,
         FlipBipScene1Model * model,
         {
             // s_busy = true;
 
-            const int status =
-                flipbip_scene_1_model_init(model, strength, coin, overwrite, passphrase_text);
+            if(status == FlipBipStatusSuccess) {
+                memcpy(model->seed, seed, sizeof(model->seed));
+                flipbip_scene_1_model_init_keys(model, coin);
+            }
 
             // nonzero status, free the mnemonic
             if(status != FlipBipStatusSuccess) {
@@ -705,6 +756,8 @@ void flipbip_scene_1_enter(void* context) {
             }
         },
         true);
+
+    memzero(seed, sizeof(seed));
 }
 
 FlipBipScene1* flipbip_scene_1_alloc() {
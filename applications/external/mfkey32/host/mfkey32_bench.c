@@ -0,0 +1,149 @@
+// Host benchmark for Mfkey32 recovery core
+//
+// Cracks nonces from .mfkey32.log and prints per-nonce results and timing.
+// Batch mode is what the app runs, -s cracks every nonce on its own as the app did before.
+
+#include "../mfkey32_recovery.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#define MFKEY32_BENCH_NONCES_MAX (256)
+
+static double mfkey32_bench_now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+// Same format as written by lib/nfc/helpers/mfkey32.c
+static size_t mfkey32_bench_load(const char* path, MfClassicNonce* nonces, size_t max) {
+    FILE* file = fopen(path, "r");
+    if(!file) {
+        perror(path);
+        return 0;
+    }
+
+    char line[256];
+    size_t count = 0;
+    while(count < max && fgets(line, sizeof(line), file)) {
+        MfClassicNonce* nonce = &nonces[count];
+        unsigned sector;
+        memset(nonce, 0, sizeof(MfClassicNonce));
+        if(sscanf(
+               line,
+               "Sec %u key %c cuid %x nt0 %x nr0 %x ar0 %x nt1 %x nr1 %x ar1 %x",
+               &sector,
+               &nonce->key_type,
+               &nonce->uid,
+               &nonce->nt0,
+               &nonce->nr0_enc,
+               &nonce->ar0_enc,
+               &nonce->nt1,
+               &nonce->nr1_enc,
+               &nonce->ar1_enc) != 9) {
+            continue;
+        }
+        nonce->sector = sector;
+        count++;
+    }
+
+    fclose(file);
+    return count;
+}
+
+static const char* mfkey32_bench_state_name(MfClassicNonceState state) {
+    switch(state) {
+    case MfClassicNonceStateCracked:
+        return "cracked";
+    case MfClassicNonceStateKnownKey:
+        return "known key";
+    case MfClassicNonceStateSkipped:
+        return "skipped";
+    case MfClassicNonceStateFailed:
+        return "failed";
+    default:
+        return "pending";
+    }
+}
+
+int main(int argc, char** argv) {
+    uint32_t msb_limit = 16;
+    bool single = false;
+    int opt;
+
+    while((opt = getopt(argc, argv, "m:s")) != -1) {
+        switch(opt) {
+        case 'm':
+            msb_limit = strtoul(optarg, NULL, 0);
+            break;
+        case 's':
+            single = true;
+            break;
+        default:
+            fprintf(stderr, "Usage: %s [-s] [-m msb_limit] nonces.log\n", argv[0]);
+            return 1;
+        }
+    }
+    if(optind >= argc || msb_limit == 0 || 256 % msb_limit) {
+        fprintf(stderr, "Usage: %s [-s] [-m msb_limit] nonces.log\n", argv[0]);
+        return 1;
+    }
+
+    static MfClassicNonce nonces[MFKEY32_BENCH_NONCES_MAX];
+    const size_t count = mfkey32_bench_load(argv[optind], nonces, MFKEY32_BENCH_NONCES_MAX);
+    if(count == 0) {
+        fprintf(stderr, "No nonces loaded\n");
+        return 1;
+    }
+
+    Mfkey32Recovery* recovery = mfkey32_recovery_alloc(msb_limit);
+    const double start = mfkey32_bench_now();
+
+    size_t cracked = 0;
+    if(single) {
+        for(size_t i = 0; i < count; i++) {
+            const double nonce_start = mfkey32_bench_now();
+            if(mfkey32_recovery_recover(recovery, &nonces[i])) {
+                nonces[i].state = MfClassicNonceStateCracked;
+                cracked++;
+            } else {
+                nonces[i].state = MfClassicNonceStateFailed;
+            }
+            printf(
+                "Sec %2u key %c cuid %08x: %-9s %012llx %7.2fs\n",
+                nonces[i].sector,
+                nonces[i].key_type,
+                nonces[i].uid,
+                mfkey32_bench_state_name(nonces[i].state),
+                (unsigned long long)nonces[i].key,
+                mfkey32_bench_now() - nonce_start);
+        }
+    } else {
+        cracked = mfkey32_recovery_batch(recovery, nonces, count);
+        for(size_t i = 0; i < count; i++) {
+            printf(
+                "Sec %2u key %c cuid %08x: %-9s %012llx\n",
+                nonces[i].sector,
+                nonces[i].key_type,
+                nonces[i].uid,
+                mfkey32_bench_state_name(nonces[i].state),
+                (unsigned long long)nonces[i].key);
+        }
+    }
+
+    const double elapsed = mfkey32_bench_now() - start;
+    printf(
+        "%s: %zu/%zu nonces with key, %.2fs total, %.2fs per nonce\n",
+        single ? "Single" : "Batch",
+        cracked,
+        count,
+        elapsed,
+        elapsed / count);
+
+    mfkey32_recovery_free(recovery);
+    return 0;
+}
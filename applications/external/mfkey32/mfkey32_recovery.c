@@ -0,0 +1,685 @@
+#pragma GCC optimize("O3")
+#pragma GCC optimize("-funroll-all-loops")
+
+#include "mfkey32_recovery.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#define LF_POLY_ODD (0x29CE5C)
+#define LF_POLY_EVEN (0x870804)
+#define CONST_M1_1 (LF_POLY_EVEN << 1 | 1)
+#define CONST_M2_1 (LF_POLY_ODD << 1)
+#define CONST_M1_2 (LF_POLY_ODD)
+#define CONST_M2_2 (LF_POLY_EVEN << 1 | 1)
+#define BIT(x, n) ((x) >> (n)&1)
+#define BEBIT(x, n) BIT(x, (n) ^ 24)
+#define SWAPENDIAN(x) \
+    ((x) = ((x) >> 8 & 0xff00ff) | ((x)&0xff00ff) << 8, (x) = (x) >> 16 | (x) << 16)
+
+#define MSB_STATES (768)
+// Sweep output for one semi-state, later reused as sort scratch for the recovery tables
+#define STATES_BUFFER_SIZE (1280)
+#define TEMP_STATES_SIZE (1280)
+// Progress callback period, in semi-states
+#define SWEEP_NOTIFY_PERIOD (32768)
+// Low bytes per filter index value, lookup1 is balanced
+#define SEMI_STATE_LOW_COUNT (64)
+
+struct Crypto1State {
+    uint32_t odd, even;
+};
+struct Crypto1Params {
+    uint64_t key;
+    uint32_t nr0_enc, uid_xor_nt0, uid_xor_nt1, nr1_enc, p64b, ar1_enc;
+};
+struct Msb {
+    int tail;
+    uint32_t states[MSB_STATES];
+};
+
+struct Mfkey32Recovery {
+    uint32_t msb_limit;
+    Mfkey32RecoveryCallback callback;
+    void* context;
+    Mfkey32RecoveryProgress progress;
+    bool aborted;
+
+    uint32_t* states_buffer;
+    uint32_t* temp_states_odd;
+    uint32_t* temp_states_even;
+    struct Msb* odd_msbs;
+    struct Msb* even_msbs;
+
+    uint16_t histogram[256];
+    // Semi-state low bytes split by their filter index bits, same for every keystream
+    uint8_t semi_state_low[4][SEMI_STATE_LOW_COUNT];
+};
+
+static const uint8_t lookup1[256] = {
+    0, 0,  16, 16, 0,  16, 0,  0,  0, 16, 0,  0,  16, 16, 16, 16, 0, 0,  16, 16, 0,  16, 0,  0,
+    0, 16, 0,  0,  16, 16, 16, 16, 0, 0,  16, 16, 0,  16, 0,  0,  0, 16, 0,  0,  16, 16, 16, 16,
+    8, 8,  24, 24, 8,  24, 8,  8,  8, 24, 8,  8,  24, 24, 24, 24, 8, 8,  24, 24, 8,  24, 8,  8,
+    8, 24, 8,  8,  24, 24, 24, 24, 8, 8,  24, 24, 8,  24, 8,  8,  8, 24, 8,  8,  24, 24, 24, 24,
+    0, 0,  16, 16, 0,  16, 0,  0,  0, 16, 0,  0,  16, 16, 16, 16, 0, 0,  16, 16, 0,  16, 0,  0,
+    0, 16, 0,  0,  16, 16, 16, 16, 8, 8,  24, 24, 8,  24, 8,  8,  8, 24, 8,  8,  24, 24, 24, 24,
+    0, 0,  16, 16, 0,  16, 0,  0,  0, 16, 0,  0,  16, 16, 16, 16, 0, 0,  16, 16, 0,  16, 0,  0,
+    0, 16, 0,  0,  16, 16, 16, 16, 8, 8,  24, 24, 8,  24, 8,  8,  8, 24, 8,  8,  24, 24, 24, 24,
+    8, 8,  24, 24, 8,  24, 8,  8,  8, 24, 8,  8,  24, 24, 24, 24, 0, 0,  16, 16, 0,  16, 0,  0,
+    0, 16, 0,  0,  16, 16, 16, 16, 8, 8,  24, 24, 8,  24, 8,  8,  8, 24, 8,  8,  24, 24, 24, 24,
+    8, 8,  24, 24, 8,  24, 8,  8,  8, 24, 8,  8,  24, 24, 24, 24};
+static const uint8_t lookup2[256] = {
+    0, 0, 4, 4, 0, 4, 0, 0, 0, 4, 0, 0, 4, 4, 4, 4, 0, 0, 4, 4, 0, 4, 0, 0, 0, 4, 0, 0, 4,
+    4, 4, 4, 2, 2, 6, 6, 2, 6, 2, 2, 2, 6, 2, 2, 6, 6, 6, 6, 2, 2, 6, 6, 2, 6, 2, 2, 2, 6,
+    2, 2, 6, 6, 6, 6, 0, 0, 4, 4, 0, 4, 0, 0, 0, 4, 0, 0, 4, 4, 4, 4, 2, 2, 6, 6, 2, 6, 2,
+    2, 2, 6, 2, 2, 6, 6, 6, 6, 0, 0, 4, 4, 0, 4, 0, 0, 0, 4, 0, 0, 4, 4, 4, 4, 0, 0, 4, 4,
+    0, 4, 0, 0, 0, 4, 0, 0, 4, 4, 4, 4, 0, 0, 4, 4, 0, 4, 0, 0, 0, 4, 0, 0, 4, 4, 4, 4, 2,
+    2, 6, 6, 2, 6, 2, 2, 2, 6, 2, 2, 6, 6, 6, 6, 0, 0, 4, 4, 0, 4, 0, 0, 0, 4, 0, 0, 4, 4,
+    4, 4, 0, 0, 4, 4, 0, 4, 0, 0, 0, 4, 0, 0, 4, 4, 4, 4, 2, 2, 6, 6, 2, 6, 2, 2, 2, 6, 2,
+    2, 6, 6, 6, 6, 2, 2, 6, 6, 2, 6, 2, 2, 2, 6, 2, 2, 6, 6, 6, 6, 2, 2, 6, 6, 2, 6, 2, 2,
+    2, 6, 2, 2, 6, 6, 6, 6, 2, 2, 6, 6, 2, 6, 2, 2, 2, 6, 2, 2, 6, 6, 6, 6};
+
+static inline uint32_t prng_successor(uint32_t x, uint32_t n) {
+    SWAPENDIAN(x);
+    while(n--) x = x >> 1 | (x >> 16 ^ x >> 18 ^ x >> 19 ^ x >> 21) << 31;
+    return SWAPENDIAN(x);
+}
+
+static inline int filter(uint32_t const x) {
+    uint32_t f;
+    f = lookup1[x & 0xff] | lookup2[(x >> 8) & 0xff];
+    f |= 0x0d938 >> (x >> 16 & 0xf) & 1;
+    return BIT(0xEC57E80A, f);
+}
+
+static inline uint32_t evenparity32(uint32_t x) {
+    x ^= x >> 16;
+    x ^= x >> 8;
+    x ^= x >> 4;
+    return 0x6996 >> (x & 0xf) & 1;
+}
+
+static inline void update_contribution(uint32_t data[], int item, int mask1, int mask2) {
+    uint32_t p = data[item] >> 25;
+    p = p << 1 | evenparity32(data[item] & mask1);
+    p = p << 1 | evenparity32(data[item] & mask2);
+    data[item] = p << 24 | (data[item] & 0xffffff);
+}
+
+static void crypto1_get_lfsr(struct Crypto1State* state, uint64_t* lfsr) {
+    int i;
+    for(*lfsr = 0, i = 23; i >= 0; --i) {
+        *lfsr = *lfsr << 1 | BIT(state->odd, i ^ 3);
+        *lfsr = *lfsr << 1 | BIT(state->even, i ^ 3);
+    }
+}
+
+static inline uint32_t crypt_word(struct Crypto1State* s) {
+    // "in" and "x" are always 0 (last iteration)
+    uint32_t res_ret = 0;
+    uint32_t feedin, t;
+    for(int i = 0; i <= 31; i++) {
+        res_ret |= ((uint32_t)filter(s->odd) << (24 ^ i)); //-V629
+        feedin = LF_POLY_EVEN & s->even;
+        feedin ^= LF_POLY_ODD & s->odd;
+        s->even = s->even << 1 | (evenparity32(feedin));
+        t = s->odd, s->odd = s->even, s->even = t;
+    }
+    return res_ret;
+}
+
+static inline void crypt_word_noret(struct Crypto1State* s, uint32_t in, int x) {
+    uint8_t ret;
+    uint32_t feedin, t, next_in;
+    for(int i = 0; i <= 31; i++) {
+        next_in = BEBIT(in, i);
+        ret = filter(s->odd);
+        feedin = ret & (!!x);
+        feedin ^= LF_POLY_EVEN & s->even;
+        feedin ^= LF_POLY_ODD & s->odd;
+        feedin ^= !!next_in;
+        s->even = s->even << 1 | (evenparity32(feedin));
+        t = s->odd, s->odd = s->even, s->even = t;
+    }
+    return;
+}
+
+static inline void rollback_word_noret(struct Crypto1State* s, uint32_t in, int x) {
+    uint8_t ret;
+    uint32_t feedin, t, next_in;
+    for(int i = 31; i >= 0; i--) {
+        next_in = BEBIT(in, i);
+        s->odd &= 0xffffff;
+        t = s->odd, s->odd = s->even, s->even = t;
+        ret = filter(s->odd);
+        feedin = ret & (!!x);
+        feedin ^= s->even & 1;
+        feedin ^= LF_POLY_EVEN & (s->even >>= 1);
+        feedin ^= LF_POLY_ODD & s->odd;
+        feedin ^= !!next_in;
+        s->even |= (evenparity32(feedin)) << 23;
+    }
+    return;
+}
+
+static int check_state(struct Crypto1State* t, struct Crypto1Params* p) {
+    if(!(t->odd | t->even)) return 0;
+    rollback_word_noret(t, 0, 0);
+    rollback_word_noret(t, p->nr0_enc, 1);
+    rollback_word_noret(t, p->uid_xor_nt0, 0);
+    struct Crypto1State temp = {t->odd, t->even};
+    crypt_word_noret(t, p->uid_xor_nt1, 0);
+    crypt_word_noret(t, p->nr1_enc, 1);
+    if(p->ar1_enc == (crypt_word(t) ^ p->p64b)) {
+        crypto1_get_lfsr(&temp, &(p->key));
+        return 1;
+    }
+    return 0;
+}
+
+static inline int state_loop(uint32_t* states_buffer, int xks, int m1, int m2) {
+    int states_tail = 0;
+    int round = 0, s = 0;
+    uint32_t xks_bit = 0;
+
+    for(round = 1; round <= 12; round++) {
+        xks_bit = BIT(xks, round);
+
+        for(s = 0; s <= states_tail; s++) {
+            const uint32_t state = states_buffer[s] << 1;
+            // State and state | 1 only differ in the lowest filter input byte
+            const uint32_t f_hi =
+                lookup2[(state >> 8) & 0xff] | (0x0d938 >> (state >> 16 & 0xf) & 1);
+            const uint32_t f0 = BIT(0xEC57E80A, lookup1[state & 0xff] | f_hi);
+            const uint32_t f1 = BIT(0xEC57E80A, lookup1[(state | 1) & 0xff] | f_hi);
+            states_buffer[s] = state;
+
+            if(f0 != f1) {
+                states_buffer[s] |= f0 ^ xks_bit;
+                if(round > 4) {
+                    update_contribution(states_buffer, s, m1, m2);
+                }
+            } else if(f0 == xks_bit) {
+                // TODO: Refactor
+                if(round > 4) {
+                    states_buffer[++states_tail] = states_buffer[s + 1];
+                    states_buffer[s + 1] = states_buffer[s] | 1;
+                    update_contribution(states_buffer, s, m1, m2);
+                    s++;
+                    update_contribution(states_buffer, s, m1, m2);
+                } else {
+                    states_buffer[++states_tail] = states_buffer[++s];
+                    states_buffer[s] = states_buffer[s - 1] | 1;
+                }
+            } else {
+                states_buffer[s--] = states_buffer[states_tail--];
+            }
+        }
+    }
+
+    return states_tail;
+}
+
+// Stable LSD radix sort, without recursion stack use doesn't depend on the data
+static void
+    radix_sort(Mfkey32Recovery* instance, uint32_t* data, size_t count, uint32_t* scratch) {
+    uint16_t* histogram = instance->histogram;
+    uint32_t* src = data;
+    uint32_t* dst = scratch;
+
+    if(count < 2) return;
+
+    for(uint32_t shift = 0; shift < 32; shift += 8) {
+        memset(histogram, 0, sizeof(instance->histogram));
+        for(size_t i = 0; i < count; i++) {
+            histogram[src[i] >> shift & 0xff]++;
+        }
+        // Digit is the same for all values
+        if(histogram[src[0] >> shift & 0xff] == count) continue;
+
+        uint16_t offset = 0;
+        for(size_t i = 0; i < 256; i++) {
+            const uint16_t digit_count = histogram[i];
+            histogram[i] = offset;
+            offset += digit_count;
+        }
+        for(size_t i = 0; i < count; i++) {
+            dst[histogram[src[i] >> shift & 0xff]++] = src[i];
+        }
+
+        uint32_t* tmp = src;
+        src = dst;
+        dst = tmp;
+    }
+
+    if(src != data) {
+        memcpy(data, src, count * sizeof(uint32_t));
+    }
+}
+
+static size_t
+    sort_unique(Mfkey32Recovery* instance, uint32_t* data, size_t count, uint32_t* scratch) {
+    if(count < 2) return count;
+
+    radix_sort(instance, data, count, scratch);
+    size_t unique = 1;
+    for(size_t i = 1; i < count; i++) {
+        if(data[i] != data[unique - 1]) {
+            data[unique++] = data[i];
+        }
+    }
+    return unique;
+}
+
+static int binsearch(uint32_t data[], int start, int stop) {
+    int mid;
+    uint32_t val = data[stop] & 0xff000000;
+    while(start != stop) {
+        mid = (stop - start) >> 1;
+        if(data[start + mid] > val)
+            stop = start + mid;
+        else
+            start += mid + 1;
+    }
+    return start;
+}
+
+static int extend_table(uint32_t data[], int tbl, int end, int bit, int m1, int m2) {
+    for(data[tbl] <<= 1; tbl <= end; data[++tbl] <<= 1) {
+        if((filter(data[tbl]) ^ filter(data[tbl] | 1)) != 0) {
+            data[tbl] |= filter(data[tbl]) ^ bit;
+            update_contribution(data, tbl, m1, m2);
+        } else if(filter(data[tbl]) == bit) {
+            data[++end] = data[tbl + 1];
+            data[tbl + 1] = data[tbl] | 1;
+            update_contribution(data, tbl, m1, m2);
+            tbl++;
+            update_contribution(data, tbl, m1, m2);
+        } else {
+            data[tbl--] = data[end--];
+        }
+    }
+    return end;
+}
+
+static int old_recover(
+    Mfkey32Recovery* instance,
+    uint32_t odd[],
+    int o_head,
+    int o_tail,
+    int oks,
+    uint32_t even[],
+    int e_head,
+    int e_tail,
+    int eks,
+    int rem,
+    int s,
+    struct Crypto1Params* p,
+    int first_run) {
+    int o, e, i;
+    if(rem == -1) {
+        for(e = e_head; e <= e_tail; ++e) {
+            even[e] = (even[e] << 1) ^ evenparity32(even[e] & LF_POLY_EVEN);
+            for(o = o_head; o <= o_tail; ++o, ++s) {
+                struct Crypto1State temp = {0, 0};
+                temp.even = odd[o];
+                temp.odd = even[e] ^ evenparity32(odd[o] & LF_POLY_ODD);
+                if(check_state(&temp, p)) {
+                    return -1;
+                }
+            }
+        }
+        return s;
+    }
+    if(first_run == 0) {
+        for(i = 0; (i < 4) && (rem-- != 0); i++) {
+            oks >>= 1;
+            eks >>= 1;
+            o_tail = extend_table(
+                odd, o_head, o_tail, oks & 1, LF_POLY_EVEN << 1 | 1, LF_POLY_ODD << 1);
+            if(o_head > o_tail) return s;
+            e_tail =
+                extend_table(even, e_head, e_tail, eks & 1, LF_POLY_ODD, LF_POLY_EVEN << 1 | 1);
+            if(e_head > e_tail) return s;
+        }
+    }
+    first_run = 0;
+    radix_sort(instance, &odd[o_head], o_tail - o_head + 1, instance->states_buffer);
+    radix_sort(instance, &even[e_head], e_tail - e_head + 1, instance->states_buffer);
+    while(o_tail >= o_head && e_tail >= e_head) {
+        if(((odd[o_tail] ^ even[e_tail]) >> 24) == 0) {
+            o_tail = binsearch(odd, o_head, o = o_tail);
+            e_tail = binsearch(even, e_head, e = e_tail);
+            s = old_recover(
+                instance, odd, o_tail--, o, oks, even, e_tail--, e, eks, rem, s, p, first_run);
+            if(s == -1) {
+                break;
+            }
+        } else if(odd[o_tail] > even[e_tail]) {
+            o_tail = binsearch(odd, o_head, o_tail) - 1;
+        } else {
+            e_tail = binsearch(even, e_head, e_tail) - 1;
+        }
+    }
+    return s;
+}
+
+static bool mfkey32_recovery_notify(Mfkey32Recovery* instance) {
+    if(!instance->aborted && instance->callback) {
+        instance->aborted = !instance->callback(&instance->progress, instance->context);
+    }
+    return !instance->aborted;
+}
+
+static inline void
+    msb_insert(Mfkey32Recovery* instance, struct Msb* msb, uint32_t state, uint32_t* scratch) {
+    if(msb->tail == MSB_STATES) {
+        // Many semi-states lead to the same state, drop duplicates once the table is full
+        msb->tail = sort_unique(instance, msb->states, msb->tail, scratch);
+        // Unique states per MSB stay well below the limit, this is only a guard
+        if(msb->tail == MSB_STATES) return;
+    }
+    msb->states[msb->tail++] = state;
+}
+
+static inline void sweep_state(
+    Mfkey32Recovery* instance,
+    struct Msb* msbs,
+    uint32_t semi_state,
+    int ks,
+    int m1,
+    int m2,
+    uint32_t msb_head) {
+    uint32_t* states_buffer = instance->states_buffer;
+
+    states_buffer[0] = semi_state;
+    const int states_tail = state_loop(states_buffer, ks, m1, m2);
+    for(int i = 0; i <= states_tail; i++) {
+        const uint32_t msb = (states_buffer[i] >> 24) - msb_head;
+        if(msb < instance->msb_limit) {
+            msb_insert(instance, &msbs[msb], states_buffer[i], instance->temp_states_odd);
+        }
+    }
+}
+
+// Collect states of current round MSBs from every semi-state matching the first keystream bit
+static bool sweep(
+    Mfkey32Recovery* instance,
+    struct Msb* msbs,
+    int ks,
+    int m1,
+    int m2,
+    uint32_t msb_head) {
+    const uint32_t ks_bit = ks & 1;
+
+    if(filter(1 << 20) == (int)ks_bit) {
+        sweep_state(instance, msbs, 1 << 20, ks, m1, m2, msb_head);
+    }
+
+    // Semi-states are enumerated by filter index, the ones with wrong output are never visited
+    for(uint32_t hi = 0; hi < (1 << 12); hi++) {
+        if(hi % (SWEEP_NOTIFY_PERIOD >> 8) == 0 && !mfkey32_recovery_notify(instance)) {
+            return false;
+        }
+
+        const uint32_t f_hi = lookup2[hi & 0xff] | (0x0d938 >> (hi >> 8 & 0xf) & 1);
+        for(uint32_t f_lo = 0; f_lo < 4; f_lo++) {
+            if(BIT(0xEC57E80A, f_lo << 3 | f_hi) != ks_bit) continue;
+
+            const uint8_t* low = instance->semi_state_low[f_lo];
+            for(size_t i = 0; i < SEMI_STATE_LOW_COUNT; i++) {
+                sweep_state(instance, msbs, hi << 8 | low[i], ks, m1, m2, msb_head);
+            }
+        }
+    }
+
+    for(uint32_t i = 0; i < instance->msb_limit; i++) {
+        msbs[i].tail =
+            sort_unique(instance, msbs[i].states, msbs[i].tail, instance->temp_states_odd);
+    }
+
+    return true;
+}
+
+static bool calculate_msb_tables(
+    Mfkey32Recovery* instance,
+    int oks,
+    int eks,
+    uint32_t msb_round,
+    struct Crypto1Params* p) {
+    const uint32_t msb_head = instance->msb_limit * msb_round;
+    struct Msb* odd_msbs = instance->odd_msbs;
+    struct Msb* even_msbs = instance->even_msbs;
+
+    for(uint32_t i = 0; i < instance->msb_limit; i++) {
+        odd_msbs[i].tail = 0;
+        even_msbs[i].tail = 0;
+    }
+
+    if(!sweep(instance, odd_msbs, oks, CONST_M1_1, CONST_M2_1, msb_head)) return false;
+    if(!sweep(instance, even_msbs, eks, CONST_M1_2, CONST_M2_2, msb_head)) return false;
+
+    oks >>= 12;
+    eks >>= 12;
+
+    for(uint32_t i = 0; i < instance->msb_limit; i++) {
+        if(!mfkey32_recovery_notify(instance)) return false;
+        if(!odd_msbs[i].tail || !even_msbs[i].tail) continue;
+
+        memcpy(instance->temp_states_odd, odd_msbs[i].states, odd_msbs[i].tail * sizeof(uint32_t));
+        memcpy(
+            instance->temp_states_even, even_msbs[i].states, even_msbs[i].tail * sizeof(uint32_t));
+        int res = old_recover(
+            instance,
+            instance->temp_states_odd,
+            0,
+            odd_msbs[i].tail - 1,
+            oks,
+            instance->temp_states_even,
+            0,
+            even_msbs[i].tail - 1,
+            eks,
+            3,
+            0,
+            p,
+            1);
+        if(res == -1) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+Mfkey32Recovery* mfkey32_recovery_alloc(uint32_t msb_limit) {
+    Mfkey32Recovery* instance = malloc(sizeof(Mfkey32Recovery));
+    memset(instance, 0, sizeof(Mfkey32Recovery));
+
+    instance->msb_limit = msb_limit;
+    instance->progress.rounds = 256 / msb_limit;
+    instance->states_buffer = malloc(sizeof(uint32_t) * STATES_BUFFER_SIZE);
+    instance->temp_states_odd = malloc(sizeof(uint32_t) * TEMP_STATES_SIZE);
+    instance->temp_states_even = malloc(sizeof(uint32_t) * TEMP_STATES_SIZE);
+    instance->odd_msbs = malloc(sizeof(struct Msb) * msb_limit);
+    instance->even_msbs = malloc(sizeof(struct Msb) * msb_limit);
+
+    uint8_t count[4] = {0};
+    for(size_t i = 0; i < 256; i++) {
+        const uint8_t f_lo = lookup1[i] >> 3;
+        instance->semi_state_low[f_lo][count[f_lo]++] = i;
+    }
+
+    return instance;
+}
+
+void mfkey32_recovery_free(Mfkey32Recovery* instance) {
+    free(instance->states_buffer);
+    free(instance->temp_states_odd);
+    free(instance->temp_states_even);
+    free(instance->odd_msbs);
+    free(instance->even_msbs);
+    free(instance);
+}
+
+void mfkey32_recovery_set_callback(
+    Mfkey32Recovery* instance,
+    Mfkey32RecoveryCallback callback,
+    void* context) {
+    instance->callback = callback;
+    instance->context = context;
+}
+
+bool mfkey32_recovery_check_key(const MfClassicNonce* nonce, uint64_t key) {
+    struct Crypto1State temp = {0, 0};
+
+    for(int i = 0; i < 24; i++) {
+        temp.odd |= (BIT(key, 2 * i + 1) << (i ^ 3));
+        temp.even |= (BIT(key, 2 * i) << (i ^ 3));
+    }
+
+    crypt_word_noret(&temp, nonce->uid ^ nonce->nt1, 0);
+    crypt_word_noret(&temp, nonce->nr1_enc, 1);
+
+    return nonce->ar1_enc == (crypt_word(&temp) ^ prng_successor(nonce->nt1, 64));
+}
+
+bool mfkey32_recovery_recover(Mfkey32Recovery* instance, MfClassicNonce* nonce) {
+    const uint32_t p64 = prng_successor(nonce->nt0, 64);
+    const uint32_t ks2 = nonce->ar0_enc ^ p64;
+    struct Crypto1Params p = {
+        0,
+        nonce->nr0_enc,
+        nonce->uid ^ nonce->nt0,
+        nonce->uid ^ nonce->nt1,
+        nonce->nr1_enc,
+        prng_successor(nonce->nt1, 64),
+        nonce->ar1_enc};
+    int oks = 0, eks = 0;
+    int i = 0;
+    for(i = 31; i >= 0; i -= 2) {
+        oks = oks << 1 | BEBIT(ks2, i);
+    }
+    for(i = 30; i >= 0; i -= 2) {
+        eks = eks << 1 | BEBIT(ks2, i);
+    }
+
+    for(uint32_t round = 0; round < instance->progress.rounds; round++) {
+        instance->progress.round = round;
+        if(!mfkey32_recovery_notify(instance)) break;
+        if(calculate_msb_tables(instance, oks, eks, round, &p)) {
+            nonce->key = p.key;
+            return true;
+        }
+        if(instance->aborted) break;
+    }
+
+    return false;
+}
+
+static inline int mfkey32_nonce_group_compare(const MfClassicNonce* a, const MfClassicNonce* b) {
+    if(a->uid != b->uid) return a->uid < b->uid ? -1 : 1;
+    if(a->sector != b->sector) return a->sector < b->sector ? -1 : 1;
+    return a->key_type - b->key_type;
+}
+
+static bool mfkey32_recovery_has_key(const MfClassicNonce* nonce) {
+    return nonce->state == MfClassicNonceStateCracked ||
+           nonce->state == MfClassicNonceStateKnownKey;
+}
+
+// Try every key known so far on pending nonces of the group
+static bool mfkey32_recovery_check_known_keys(
+    Mfkey32Recovery* instance,
+    MfClassicNonce* nonces,
+    size_t count,
+    size_t group,
+    size_t group_end) {
+    bool found = false;
+
+    for(size_t i = group; i < group_end; i++) {
+        if(nonces[i].state != MfClassicNonceStatePending) continue;
+        for(size_t j = 0; j < count; j++) {
+            if(nonces[j].state != MfClassicNonceStateCracked) continue;
+            if(mfkey32_recovery_check_key(&nonces[i], nonces[j].key)) {
+                nonces[i].state = MfClassicNonceStateKnownKey;
+                nonces[i].key = nonces[j].key;
+                instance->progress.completed++;
+                instance->progress.cracked++;
+                found = true;
+                break;
+            }
+        }
+    }
+
+    return found;
+}
+
+size_t mfkey32_recovery_batch(Mfkey32Recovery* instance, MfClassicNonce* nonces, size_t count) {
+    // Stable insertion sort, there are only tens of nonces
+    for(size_t i = 1; i < count; i++) {
+        MfClassicNonce nonce = nonces[i];
+        size_t j = i;
+        for(; j > 0 && mfkey32_nonce_group_compare(&nonces[j - 1], &nonce) > 0; j--) {
+            nonces[j] = nonces[j - 1];
+        }
+        nonces[j] = nonce;
+    }
+
+    instance->aborted = false;
+    instance->progress.completed = 0;
+    instance->progress.cracked = 0;
+    for(size_t i = 0; i < count; i++) {
+        if(nonces[i].state != MfClassicNonceStatePending) {
+            instance->progress.completed++;
+            if(mfkey32_recovery_has_key(&nonces[i])) instance->progress.cracked++;
+        }
+    }
+
+    size_t group_end = 0;
+    for(size_t group = 0; group < count && !instance->aborted; group = group_end) {
+        group_end = group + 1;
+        while(group_end < count &&
+              mfkey32_nonce_group_compare(&nonces[group], &nonces[group_end]) == 0) {
+            group_end++;
+        }
+
+        bool found = false;
+        for(size_t i = group; i < group_end; i++) {
+            found |= mfkey32_recovery_has_key(&nonces[i]);
+        }
+        // Cards often reuse keys across sectors
+        if(!found) {
+            found = mfkey32_recovery_check_known_keys(instance, nonces, count, group, group_end);
+        }
+
+        for(size_t i = group; i < group_end && !found; i++) {
+            if(nonces[i].state != MfClassicNonceStatePending) continue;
+            instance->progress.round = 0;
+            if(!mfkey32_recovery_notify(instance)) break;
+
+            if(mfkey32_recovery_recover(instance, &nonces[i])) {
+                nonces[i].state = MfClassicNonceStateCracked;
+                instance->progress.cracked++;
+                found = true;
+            } else if(!instance->aborted) {
+                nonces[i].state = MfClassicNonceStateFailed;
+            } else {
+                break;
+            }
+            instance->progress.completed++;
+        }
+
+        // Group key is known, verify the rest instead of cracking them
+        if(found) {
+            mfkey32_recovery_check_known_keys(instance, nonces, count, group, group_end);
+            for(size_t i = group; i < group_end; i++) {
+                if(nonces[i].state != MfClassicNonceStatePending) continue;
+                nonces[i].state = MfClassicNonceStateSkipped;
+                instance->progress.completed++;
+            }
+        }
+    }
+    mfkey32_recovery_notify(instance);
+
+    return instance->progress.cracked;
+}
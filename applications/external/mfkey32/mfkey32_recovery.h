@@ -0,0 +1,84 @@
+#pragma once
+
+// Mfkey32 key recovery core. Has no firmware dependencies, so it also builds on host (see host/)
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum {
+    MfClassicNonceStatePending,
+    MfClassicNonceStateCracked, // Key recovered from this nonce
+    MfClassicNonceStateKnownKey, // Key recovered from another nonce verifies this one
+    MfClassicNonceStateSkipped, // Key for the same sector and key type is already known
+    MfClassicNonceStateFailed, // No key verifies this nonce
+} MfClassicNonceState;
+
+typedef struct {
+    uint32_t uid; // serial number
+    uint32_t nt0; // tag challenge first
+    uint32_t nt1; // tag challenge second
+    uint32_t nr0_enc; // first encrypted reader challenge
+    uint32_t ar0_enc; // first encrypted reader response
+    uint32_t nr1_enc; // second encrypted reader challenge
+    uint32_t ar1_enc; // second encrypted reader response
+    uint8_t sector;
+    char key_type; // 'A' or 'B'
+    MfClassicNonceState state;
+    uint64_t key;
+} MfClassicNonce;
+
+typedef struct {
+    size_t completed; // Nonces processed by batch so far
+    size_t cracked; // Nonces with known key
+    uint32_t round; // MSB round of nonce being cracked
+    uint32_t rounds; // MSB rounds per nonce
+} Mfkey32RecoveryProgress;
+
+/** Called on every MSB round start and periodically within it
+ *
+ * @return     false to abort recovery
+ */
+typedef bool (*Mfkey32RecoveryCallback)(const Mfkey32RecoveryProgress* progress, void* context);
+
+typedef struct Mfkey32Recovery Mfkey32Recovery;
+
+/** Allocate recovery state, reused for every nonce
+ *
+ * @param      msb_limit  MSB values processed per round, divisor of 256. Memory use is
+ *                        about 6 KiB per unit.
+ */
+Mfkey32Recovery* mfkey32_recovery_alloc(uint32_t msb_limit);
+
+void mfkey32_recovery_free(Mfkey32Recovery* instance);
+
+void mfkey32_recovery_set_callback(
+    Mfkey32Recovery* instance,
+    Mfkey32RecoveryCallback callback,
+    void* context);
+
+/** Check key against second authentication of the nonce */
+bool mfkey32_recovery_check_key(const MfClassicNonce* nonce, uint64_t key);
+
+/** Recover key from single nonce
+ *
+ * @return     true and nonce key set if found
+ */
+bool mfkey32_recovery_recover(Mfkey32Recovery* instance, MfClassicNonce* nonce);
+
+/** Recover keys for all pending nonces
+ *
+ * Nonces are grouped in place by UID, sector and key type. Keys found so far are tried on
+ * every group before recovery, and group recovery stops once any of its nonces gives a key.
+ *
+ * @return     number of nonces with key, aborted batch leaves remaining nonces pending
+ */
+size_t mfkey32_recovery_batch(Mfkey32Recovery* instance, MfClassicNonce* nonces, size_t count);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,552 @@
+#include "subbrute_encoder.h"
+
+#include <string.h>
+
+typedef size_t (*SubBruteEncoderGetUpload)(
+    const SubBruteEncoder* encoder,
+    uint64_t key,
+    uint8_t bits,
+    uint32_t te,
+    LevelDuration* upload,
+    size_t size);
+
+/**
+ * Durations are in te units. Protocols with fixed timing have te set, the rest take it from key.
+ */
+struct SubBruteEncoder {
+    const char* name;
+    uint8_t bits_min;
+    uint8_t bits_max;
+    uint16_t te; // Duration unit in us, 0 to use TE of the key
+    bool high_first; // Bit symbol starts with high level
+    uint16_t one[2];
+    uint16_t zero[2];
+    uint16_t header; // Low level before start bit, 0 if there is no header
+    uint16_t start; // High level after header
+    uint16_t stop; // High level after data, 0 if there is no stop bit
+    uint16_t guard; // Low level after stop bit, added to last bit if there is no stop bit
+    uint16_t (*get_header)(uint8_t bits); // Header depending on key length, overrides header
+    SubBruteEncoderGetUpload get_upload;
+};
+
+static size_t subbrute_encoder_pwm_get_upload(
+    const SubBruteEncoder* encoder,
+    uint64_t key,
+    uint8_t bits,
+    uint32_t te,
+    LevelDuration* upload,
+    size_t size);
+
+static size_t subbrute_encoder_chamberlain_get_upload(
+    const SubBruteEncoder* encoder,
+    uint64_t key,
+    uint8_t bits,
+    uint32_t te,
+    LevelDuration* upload,
+    size_t size);
+
+// Same as lib/subghz/protocols/came.c
+static uint16_t subbrute_encoder_came_get_header(uint8_t bits) {
+    switch(bits) {
+    case 24:
+        return 76;
+    case 12:
+    case 18: // Airforce
+        return 47;
+    case 25: // Prastel
+        return 36;
+    default:
+        return 16;
+    }
+}
+
+static const SubBruteEncoder subbrute_encoder_came = {
+    .name = "CAME",
+    .bits_min = 1,
+    .bits_max = 25,
+    .te = 320,
+    .high_first = false,
+    .one = {2, 1},
+    .zero = {1, 2},
+    .start = 1,
+    .get_header = subbrute_encoder_came_get_header,
+    .get_upload = subbrute_encoder_pwm_get_upload,
+};
+
+static const SubBruteEncoder subbrute_encoder_nice_flo = {
+    .name = "Nice FLO",
+    .bits_min = 12,
+    .bits_max = 24,
+    .te = 700,
+    .high_first = false,
+    .one = {2, 1},
+    .zero = {1, 2},
+    .header = 36,
+    .start = 1,
+    .get_upload = subbrute_encoder_pwm_get_upload,
+};
+
+// Long pulse is not a multiple of short one, timing is in us
+static const SubBruteEncoder subbrute_encoder_ansonic = {
+    .name = "Ansonic",
+    .bits_min = 12,
+    .bits_max = 12,
+    .te = 1,
+    .high_first = false,
+    .one = {555, 1111},
+    .zero = {1111, 555},
+    .header = 555 * 35,
+    .start = 555,
+    .get_upload = subbrute_encoder_pwm_get_upload,
+};
+
+static const SubBruteEncoder subbrute_encoder_holtek = {
+    .name = "Holtek_HT12X",
+    .bits_min = 12,
+    .bits_max = 12,
+    .te = 0,
+    .high_first = false,
+    .one = {2, 1},
+    .zero = {1, 2},
+    .header = 36,
+    .start = 1,
+    .get_upload = subbrute_encoder_pwm_get_upload,
+};
+
+static const SubBruteEncoder subbrute_encoder_linear = {
+    .name = "Linear",
+    .bits_min = 10,
+    .bits_max = 10,
+    .te = 500,
+    .high_first = true,
+    .one = {3, 1},
+    .zero = {1, 3},
+    .guard = 41,
+    .get_upload = subbrute_encoder_pwm_get_upload,
+};
+
+static const SubBruteEncoder subbrute_encoder_linear_delta3 = {
+    .name = "LinearDelta3",
+    .bits_min = 8,
+    .bits_max = 8,
+    .te = 500,
+    .high_first = true,
+    .one = {1, 7},
+    .zero = {4, 4},
+    .guard = 66,
+    .get_upload = subbrute_encoder_pwm_get_upload,
+};
+
+static const SubBruteEncoder subbrute_encoder_princeton = {
+    .name = "Princeton",
+    .bits_min = 24,
+    .bits_max = 24,
+    .te = 0,
+    .high_first = true,
+    .one = {3, 1},
+    .zero = {1, 3},
+    .stop = 1,
+    .guard = 30,
+    .get_upload = subbrute_encoder_pwm_get_upload,
+};
+
+static const SubBruteEncoder subbrute_encoder_smc5326 = {
+    .name = "SMC5326",
+    .bits_min = 25,
+    .bits_max = 25,
+    .te = 0,
+    .high_first = true,
+    .one = {3, 1},
+    .zero = {1, 3},
+    .stop = 1,
+    .guard = 25,
+    .get_upload = subbrute_encoder_pwm_get_upload,
+};
+
+static const SubBruteEncoder subbrute_encoder_chamberlain = {
+    .name = "Cham_Code",
+    .bits_min = 7,
+    .bits_max = 9,
+    .te = 1000,
+    .get_upload = subbrute_encoder_chamberlain_get_upload,
+};
+
+static const SubBruteEncoder* const subbrute_encoders[] = {
+    &subbrute_encoder_came,
+    &subbrute_encoder_nice_flo,
+    &subbrute_encoder_ansonic,
+    &subbrute_encoder_holtek,
+    &subbrute_encoder_linear,
+    &subbrute_encoder_linear_delta3,
+    &subbrute_encoder_princeton,
+    &subbrute_encoder_smc5326,
+    &subbrute_encoder_chamberlain,
+};
+
+const SubBruteEncoder* subbrute_encoder_get(const char* protocol_name, uint8_t bits, uint32_t te) {
+    for(size_t i = 0; i < sizeof(subbrute_encoders) / sizeof(subbrute_encoders[0]); i++) {
+        const SubBruteEncoder* encoder = subbrute_encoders[i];
+        if(strcmp(encoder->name, protocol_name) != 0) continue;
+        // Leave keys protocol decoder refuses to SubGhzTransmitter, it reports them
+        if(bits < encoder->bits_min || bits > encoder->bits_max) return NULL;
+        if(encoder->te == 0 && te == 0) return NULL;
+        return encoder;
+    }
+
+    return NULL;
+}
+
+size_t subbrute_encoder_get_upload(
+    const SubBruteEncoder* encoder,
+    uint64_t key,
+    uint8_t bits,
+    uint32_t te,
+    LevelDuration* upload,
+    size_t size) {
+    return encoder->get_upload(encoder, key, bits, te, upload, size);
+}
+
+bool subbrute_encoder_can_stream(const SubBruteEncoder* encoder) {
+    return encoder->get_upload == subbrute_encoder_pwm_get_upload;
+}
+
+size_t subbrute_encoder_get_stream_upload(
+    const SubBruteEncoder* encoder,
+    uint64_t stream_bits,
+    uint8_t count,
+    bool first,
+    bool last,
+    uint8_t bits,
+    uint32_t te,
+    LevelDuration* upload,
+    size_t size) {
+    if(!subbrute_encoder_can_stream(encoder) || count > SUBBRUTE_ENCODER_BITS_MAX) return 0;
+
+    const uint32_t unit = encoder->te ? encoder->te : te;
+    const uint16_t header = encoder->get_header ? encoder->get_header(bits) : encoder->header;
+    const bool with_header = first && header;
+    const bool with_stop = last && encoder->stop;
+    if((size_t)count * 2 + (with_header ? 2 : 0) + (with_stop ? 2 : 0) > size) return 0;
+
+    size_t index = 0;
+    if(with_header) {
+        upload[index++] = level_duration_make(false, unit * header);
+        upload[index++] = level_duration_make(true, unit * encoder->start);
+    }
+
+    for(uint8_t i = count; i > 0; i--) {
+        const uint16_t* symbol = (stream_bits >> (i - 1)) & 1 ? encoder->one : encoder->zero;
+        upload[index++] = level_duration_make(encoder->high_first, unit * symbol[0]);
+        upload[index++] = level_duration_make(!encoder->high_first, unit * symbol[1]);
+    }
+
+    if(with_stop) {
+        upload[index++] = level_duration_make(true, unit * encoder->stop);
+        upload[index++] = level_duration_make(false, unit * encoder->guard);
+    } else if(last && encoder->guard && index) {
+        // Only high first protocols have guard without stop bit, last level is low
+        upload[index - 1] = level_duration_make(
+            false, level_duration_get_duration(upload[index - 1]) + unit * encoder->guard);
+    }
+
+    return index;
+}
+
+static size_t subbrute_encoder_pwm_get_upload(
+    const SubBruteEncoder* encoder,
+    uint64_t key,
+    uint8_t bits,
+    uint32_t te,
+    LevelDuration* upload,
+    size_t size) {
+    return subbrute_encoder_get_stream_upload(
+        encoder, key, bits, true, true, bits, te, upload, size);
+}
+
+// Same as lib/subghz/protocols/chamberlain_code.c
+#define CHAMBERLAIN_CODE_BIT_1 0b0011
+#define CHAMBERLAIN_CODE_BIT_0 0b0111
+#define CHAMBERLAIN_7_CODE_MASK_CHECK 0x10000001101
+#define CHAMBERLAIN_8_CODE_MASK_CHECK 0x1000001001
+#define CHAMBERLAIN_9_CODE_MASK_CHECK 0x10000000001
+#define CHAMBERLAIN_GUARD_BITS 36
+
+static size_t subbrute_encoder_chamberlain_get_upload(
+    const SubBruteEncoder* encoder,
+    uint64_t key,
+    uint8_t bits,
+    uint32_t te,
+    LevelDuration* upload,
+    size_t size) {
+    (void)te;
+
+    uint64_t data = 0;
+    for(uint8_t i = bits; i > 0; i--) {
+        const bool bit = (key >> (i - 1)) & 1;
+        data = data << 4 | (bit ? CHAMBERLAIN_CODE_BIT_1 : CHAMBERLAIN_CODE_BIT_0);
+    }
+
+    uint8_t count;
+    switch(bits) {
+    case 7:
+        data = ((data >> 4) << 16) | (data & 0xF) << 4 | CHAMBERLAIN_7_CODE_MASK_CHECK;
+        count = 44;
+        break;
+    case 8:
+        data = ((data >> 12) << 16) | (data & 0xFF) << 4 | CHAMBERLAIN_8_CODE_MASK_CHECK;
+        count = 40;
+        break;
+    case 9:
+        data = (data << 4) | CHAMBERLAIN_9_CODE_MASK_CHECK;
+        count = 44;
+        break;
+    default:
+        return 0;
+    }
+
+    // Guard time and data as NRZ bits, each bit lasts te
+    size_t index = 0;
+    bool level = false;
+    uint32_t duration = encoder->te * CHAMBERLAIN_GUARD_BITS;
+    for(uint8_t i = count; i > 0; i--) {
+        const bool bit = (data >> (i - 1)) & 1;
+        if(bit == level) {
+            duration += encoder->te;
+        } else {
+            if(index >= size) return 0;
+            upload[index++] = level_duration_make(level, duration);
+            level = bit;
+            duration = encoder->te;
+        }
+    }
+    if(index >= size) return 0;
+    upload[index++] = level_duration_make(level, duration);
+
+    return index;
+}
+
+uint64_t subbrute_de_bruijn_length(uint8_t bits) {
+    return (1ULL << bits) + bits - 1;
+}
+
+/**
+ * Lyndon words with length dividing n, in lexicographic order, concatenated give the least
+ * De Bruijn sequence (Fredricksen, Kessler, Maiorana). Words are built one by one with
+ * Duval's algorithm, state is a single word of up to n bits.
+ */
+static void subbrute_de_bruijn_next_word(SubBruteDeBruijn* instance) {
+    do {
+        const uint8_t length = instance->length;
+        while(instance->length < instance->bits) {
+            instance->word[instance->length] = instance->word[instance->length - length];
+            instance->length++;
+        }
+        while(instance->length && instance->word[instance->length - 1]) {
+            instance->length--;
+        }
+        if(!instance->length) {
+            // Sequence starts with n zeros, repeat them to get all keys wrapping around
+            instance->emit = 0;
+            instance->tail = instance->bits - 1;
+            return;
+        }
+        instance->word[instance->length - 1] = 1;
+    } while(instance->bits % instance->length);
+
+    instance->emit = instance->length;
+    instance->position = 0;
+}
+
+static bool subbrute_de_bruijn_next_bit(SubBruteDeBruijn* instance, bool* bit) {
+    if(instance->position == instance->emit && instance->emit) {
+        subbrute_de_bruijn_next_word(instance);
+    }
+    if(instance->emit) {
+        *bit = instance->word[instance->position++];
+        return true;
+    }
+    if(instance->tail) {
+        instance->tail--;
+        *bit = false;
+        return true;
+    }
+    instance->done = true;
+    return false;
+}
+
+void subbrute_de_bruijn_init(SubBruteDeBruijn* instance, uint8_t bits, uint64_t skip) {
+    memset(instance, 0, sizeof(SubBruteDeBruijn));
+    if(bits == 0 || bits > SUBBRUTE_DE_BRUIJN_BITS_MAX) {
+        instance->done = true;
+        return;
+    }
+
+    instance->bits = bits;
+    // First Lyndon word is "0"
+    instance->length = 1;
+    instance->emit = 1;
+
+    bool bit;
+    while(skip-- && subbrute_de_bruijn_next_bit(instance, &bit)) {
+    }
+}
+
+uint8_t subbrute_de_bruijn_next(SubBruteDeBruijn* instance, uint64_t* stream_bits, uint8_t count) {
+    uint8_t index = 0;
+    bool bit;
+    *stream_bits = 0;
+    while(index < count && !instance->done && subbrute_de_bruijn_next_bit(instance, &bit)) {
+        *stream_bits = *stream_bits << 1 | bit;
+        index++;
+    }
+    return index;
+}
+
+static bool subbrute_tx_buffer_put(SubBruteTxBuffer* buffer, LevelDuration level_duration) {
+    // Async TX injects guard pulse between two equal levels
+    if(buffer->size && !level_duration_get_level(level_duration) &&
+       !level_duration_get_level(buffer->upload[buffer->size - 1])) {
+        buffer->upload[buffer->size - 1] = level_duration_make(
+            false,
+            level_duration_get_duration(buffer->upload[buffer->size - 1]) +
+                level_duration_get_duration(level_duration));
+        return true;
+    }
+    if(buffer->size == SUBBRUTE_TX_BUFFER_SIZE) return false;
+    buffer->upload[buffer->size++] = level_duration;
+    return true;
+}
+
+bool subbrute_tx_buffer_append(
+    SubBruteTxBuffer* buffer,
+    const LevelDuration* upload,
+    size_t size,
+    uint8_t repeat,
+    uint32_t gap) {
+    if(!size || !repeat || buffer->repeat > 1) return false;
+
+    if(buffer->size + size * repeat + 1 > SUBBRUTE_TX_BUFFER_SIZE) {
+        // Keep repeats out of buffer if they don't fit, yield replays it
+        if(buffer->size || size + 1 > SUBBRUTE_TX_BUFFER_SIZE) return false;
+        for(size_t i = 0; i < size; i++) {
+            subbrute_tx_buffer_put(buffer, upload[i]);
+        }
+        buffer->repeat = repeat;
+        buffer->gap = gap;
+        return true;
+    }
+
+    for(uint8_t r = 0; r < repeat; r++) {
+        for(size_t i = 0; i < size; i++) {
+            subbrute_tx_buffer_put(buffer, upload[i]);
+        }
+    }
+    if(gap) subbrute_tx_buffer_put(buffer, level_duration_make(false, gap));
+    buffer->repeat = 1;
+    return true;
+}
+
+void subbrute_tx_queue_reset(SubBruteTxQueue* queue) {
+    for(size_t i = 0; i < 2; i++) {
+        queue->buffer[i].ready = false;
+        queue->buffer[i].size = 0;
+        queue->buffer[i].repeat = 0;
+        queue->buffer[i].gap = 0;
+        queue->buffer[i].tag = 0;
+    }
+    queue->back = 0;
+    queue->front = 0;
+    queue->position = 0;
+    queue->repeat = 0;
+    queue->gap = 0;
+    queue->gap_pending = false;
+    queue->has_peek = false;
+    queue->finished = false;
+    queue->underrun = false;
+}
+
+SubBruteTxBuffer* subbrute_tx_queue_get_free(SubBruteTxQueue* queue) {
+    SubBruteTxBuffer* buffer = &queue->buffer[queue->back];
+    if(buffer->ready) return NULL;
+    return buffer;
+}
+
+void subbrute_tx_queue_push(SubBruteTxQueue* queue) {
+    SubBruteTxBuffer* buffer = &queue->buffer[queue->back];
+    if(!buffer->size) return;
+    if(!buffer->repeat) buffer->repeat = 1;
+    buffer->ready = true;
+    queue->back ^= 1;
+}
+
+void subbrute_tx_queue_finish(SubBruteTxQueue* queue) {
+    queue->finished = true;
+}
+
+uint64_t subbrute_tx_queue_get_tag(SubBruteTxQueue* queue) {
+    const SubBruteTxBuffer* buffer = &queue->buffer[queue->front];
+    if(buffer->ready) return buffer->tag;
+    // Queue is empty, buffer on air would be the one worker fills
+    return queue->buffer[queue->back].tag;
+}
+
+bool subbrute_tx_queue_is_underrun(SubBruteTxQueue* queue) {
+    return queue->underrun;
+}
+
+void subbrute_tx_queue_clear_underrun(SubBruteTxQueue* queue) {
+    queue->underrun = false;
+}
+
+static LevelDuration subbrute_tx_queue_next(SubBruteTxQueue* queue) {
+    if(queue->gap_pending) {
+        queue->gap_pending = false;
+        return level_duration_make(false, queue->gap);
+    }
+
+    SubBruteTxBuffer* buffer = &queue->buffer[queue->front];
+    if(!buffer->ready) {
+        if(!queue->finished) queue->underrun = true;
+        return level_duration_reset();
+    }
+
+    LevelDuration ret = buffer->upload[queue->position];
+    if(++queue->position == buffer->size) {
+        queue->position = 0;
+        if(++queue->repeat >= buffer->repeat) {
+            queue->repeat = 0;
+            queue->gap = buffer->gap;
+            queue->gap_pending = buffer->gap > 0;
+            // Hand buffer back to worker empty
+            buffer->size = 0;
+            buffer->repeat = 0;
+            buffer->gap = 0;
+            buffer->ready = false;
+            queue->front ^= 1;
+        }
+    }
+
+    return ret;
+}
+
+LevelDuration subbrute_tx_queue_yield(void* context) {
+    SubBruteTxQueue* queue = context;
+
+    LevelDuration ret = queue->has_peek ? queue->peek : subbrute_tx_queue_next(queue);
+    queue->has_peek = false;
+    if(level_duration_is_reset(ret) || level_duration_get_level(ret)) return ret;
+
+    // Low level may continue in the next buffer or gap, look ahead and merge
+    while(true) {
+        LevelDuration next = subbrute_tx_queue_next(queue);
+        if(level_duration_is_reset(next) || level_duration_get_level(next)) {
+            queue->peek = next;
+            queue->has_peek = true;
+            break;
+        }
+        ret = level_duration_make(
+            false, level_duration_get_duration(ret) + level_duration_get_duration(next));
+    }
+
+    return ret;
+}
@@ -0,0 +1,166 @@
+#pragma once
+
+// Direct upload generation for fixed code protocols, skips FlipperFormat and SubGhzTransmitter.
+// Has no firmware dependencies, so it also builds on host (see host/)
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <lib/toolbox/level_duration.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define SUBBRUTE_ENCODER_BITS_MAX (64)
+#define SUBBRUTE_ENCODER_UPLOAD_MAX (SUBBRUTE_ENCODER_BITS_MAX * 2 + 4)
+#define SUBBRUTE_DE_BRUIJN_BITS_MAX (16)
+
+typedef struct SubBruteEncoder SubBruteEncoder;
+
+/** Find encoder for protocol
+ *
+ * @param      protocol_name  Protocol name as in key file
+ * @param      bits           Key length
+ * @param      te             TE from key file, 0 if there is none
+ *
+ * @return     NULL if protocol has to go through SubGhzTransmitter
+ */
+const SubBruteEncoder* subbrute_encoder_get(const char* protocol_name, uint8_t bits, uint32_t te);
+
+/** Build upload for one key transmission, same as protocol encoder in lib/subghz does
+ *
+ * @return     upload size, 0 if it doesn't fit
+ */
+size_t subbrute_encoder_get_upload(
+    const SubBruteEncoder* encoder,
+    uint64_t key,
+    uint8_t bits,
+    uint32_t te,
+    LevelDuration* upload,
+    size_t size);
+
+/** Protocol bit symbols don't depend on neighbours, so a bit stream can be sent without framing */
+bool subbrute_encoder_can_stream(const SubBruteEncoder* encoder);
+
+/** Build upload for a part of bit stream, see subbrute_encoder_can_stream
+ *
+ * First part starts with protocol header, last one ends with protocol stop bit and guard time.
+ *
+ * @param      stream_bits  Bits to send, MSB first
+ * @param      count        Number of bits, up to SUBBRUTE_ENCODER_BITS_MAX
+ *
+ * @return     upload size, 0 if it doesn't fit
+ */
+size_t subbrute_encoder_get_stream_upload(
+    const SubBruteEncoder* encoder,
+    uint64_t stream_bits,
+    uint8_t count,
+    bool first,
+    bool last,
+    uint8_t bits,
+    uint32_t te,
+    LevelDuration* upload,
+    size_t size);
+
+/** Binary De Bruijn sequence B(2, n), every n bit key appears in it exactly once.
+ *
+ * Receivers that shift bits into a register and compare it on every bit accept a key from the
+ * middle of the stream, so whole key space takes 2^n + n - 1 bits instead of n * 2^n.
+ */
+typedef struct {
+    uint8_t bits;
+    uint8_t length; // Length of current Lyndon word
+    uint8_t position; // Next bit of current word to emit
+    uint8_t emit; // Length of current word if it is emitted, 0 otherwise
+    uint8_t tail; // Trailing zeros left to emit, linearize cyclic sequence
+    bool done;
+    uint8_t word[SUBBRUTE_DE_BRUIJN_BITS_MAX];
+} SubBruteDeBruijn;
+
+/** Number of bits in linear De Bruijn sequence for n bit keys */
+uint64_t subbrute_de_bruijn_length(uint8_t bits);
+
+/** Start sequence, skipping first skip bits */
+void subbrute_de_bruijn_init(SubBruteDeBruijn* instance, uint8_t bits, uint64_t skip);
+
+/** Get next bits of sequence, MSB first
+ *
+ * @return     number of bits stored, up to count, 0 at the end of sequence
+ */
+uint8_t subbrute_de_bruijn_next(SubBruteDeBruijn* instance, uint64_t* stream_bits, uint8_t count);
+
+/** Two buffer queue feeding async TX.
+ *
+ * Worker fills one buffer while the other is on air. Yield runs in DMA interrupt, it plays
+ * buffers in turn and merges adjacent low levels, so radio never gets a guard pulse between keys.
+ * Async TX takes half of its DMA buffer at once, buffer holds twice that so one refill can't
+ * drain both of them.
+ */
+#define SUBBRUTE_TX_BUFFER_SIZE (256)
+
+typedef struct {
+    LevelDuration upload[SUBBRUTE_TX_BUFFER_SIZE];
+    size_t size;
+    uint8_t repeat; // Times to play whole buffer, more than 1 if key repeats didn't fit
+    uint32_t gap; // Low level after last repeat, us
+    uint64_t tag; // Worker data, e.g. step of the first key
+    volatile bool ready;
+} SubBruteTxBuffer;
+
+typedef struct {
+    SubBruteTxBuffer buffer[2];
+    uint8_t back; // Buffer worker fills
+    volatile uint8_t front; // Buffer on air
+    size_t position;
+    uint8_t repeat;
+    uint32_t gap;
+    bool gap_pending;
+    bool has_peek;
+    LevelDuration peek;
+    volatile bool finished;
+    volatile bool underrun;
+} SubBruteTxQueue;
+
+/** Add upload to buffer, repeated and followed by low level gap
+ *
+ * @return     false if buffer has no room for it, push buffer and append to the next one
+ */
+bool subbrute_tx_buffer_append(
+    SubBruteTxBuffer* buffer,
+    const LevelDuration* upload,
+    size_t size,
+    uint8_t repeat,
+    uint32_t gap);
+
+void subbrute_tx_queue_reset(SubBruteTxQueue* queue);
+
+/** Get buffer to fill
+ *
+ * @return     NULL if both buffers are waiting for TX
+ */
+SubBruteTxBuffer* subbrute_tx_queue_get_free(SubBruteTxQueue* queue);
+
+/** Pass buffer from subbrute_tx_queue_get_free to TX */
+void subbrute_tx_queue_push(SubBruteTxQueue* queue);
+
+/** No more buffers, yield ends transmission once queue is empty */
+void subbrute_tx_queue_finish(SubBruteTxQueue* queue);
+
+/** Tag of buffer on air or the next one to go */
+uint64_t subbrute_tx_queue_get_tag(SubBruteTxQueue* queue);
+
+/** Yield ended transmission because worker didn't fill next buffer in time
+ *
+ * Queue keeps its content, clear flag and start async TX again to continue.
+ */
+bool subbrute_tx_queue_is_underrun(SubBruteTxQueue* queue);
+
+void subbrute_tx_queue_clear_underrun(SubBruteTxQueue* queue);
+
+/** Async TX callback, context is SubBruteTxQueue */
+LevelDuration subbrute_tx_queue_yield(void* context);
+
+#ifdef __cplusplus
+}
+#endif
@@ -8,6 +8,8 @@
 #define TAG "SubBruteWorker"
 #define SUBBRUTE_TX_TIMEOUT 6
 #define SUBBRUTE_MANUAL_TRANSMIT_INTERVAL 250
+#define SUBBRUTE_TX_QUEUE_POLL 2
+#define SUBBRUTE_DE_BRUIJN_CHUNK 32
 
 SubBruteWorker* subbrute_worker_alloc(const SubGhzDevice* radio_device) {
     SubBruteWorker* instance = malloc(sizeof(SubBruteWorker));
@@ -39,6 +41,10 @@ SubBruteWorker* subbrute_worker_alloc(const SubGhzDevice* radio_device) {
 
     instance->radio_device = radio_device;
 
+    instance->tx_queue = malloc(sizeof(SubBruteTxQueue));
+    instance->upload = malloc(SUBBRUTE_ENCODER_UPLOAD_MAX * sizeof(LevelDuration));
+    instance->de_bruijn = false;
+
     return instance;
 }
 
@@ -56,6 +62,9 @@ void subbrute_worker_free(SubBruteWorker* instance) {
     subghz_environment_free(instance->environment);
     instance->environment = NULL;
 
+    free(instance->upload);
+    free(instance->tx_queue);
+
     furi_thread_free(instance->thread);
 
     subghz_devices_sleep(instance->radio_device);
@@ -244,6 +253,30 @@ bool subbrute_worker_transmit_current_key(SubBruteWorker* instance, uint64_t ste
 
     bool result;
     instance->protocol_name = subbrute_protocol_file(instance->file);
+
+    const SubBruteEncoder* encoder = subbrute_worker_get_encoder(instance);
+    if(encoder) {
+        size_t size = subbrute_encoder_get_upload(
+            encoder,
+            subbrute_worker_get_key(instance, step),
+            instance->bits,
+            instance->te,
+            instance->upload,
+            SUBBRUTE_ENCODER_UPLOAD_MAX);
+
+        SubBruteTxQueue* queue = instance->tx_queue;
+        subbrute_tx_queue_reset(queue);
+        SubBruteTxBuffer* buffer = subbrute_tx_queue_get_free(queue);
+        buffer->tag = step;
+        result = subbrute_tx_buffer_append(buffer, instance->upload, size, instance->repeat, 0);
+        if(result) {
+            subbrute_tx_queue_push(queue);
+            subbrute_tx_queue_finish(queue);
+            subbrute_worker_subghz_transmit_queue(instance);
+        }
+        return result;
+    }
+
     FlipperFormat* flipper_format = flipper_format_string_alloc();
     Stream* stream = flipper_format_get_raw_stream(flipper_format);
 
@@ -348,6 +381,198 @@ void subbrute_worker_subghz_transmit(SubBruteWorker* instance, FlipperFormat* fl
     instance->transmit_mode = false;
 }
 
+static bool subbrute_worker_radio_start_tx(SubBruteWorker* instance) {
+    subghz_devices_reset(instance->radio_device);
+    subghz_devices_idle(instance->radio_device);
+    subghz_devices_load_preset(instance->radio_device, instance->preset, NULL);
+    subghz_devices_set_frequency(
+        instance->radio_device, instance->frequency); // TODO is freq valid check
+
+    return subghz_devices_set_tx(instance->radio_device) &&
+           subghz_devices_start_async_tx(
+               instance->radio_device, subbrute_tx_queue_yield, instance->tx_queue);
+}
+
+void subbrute_worker_subghz_transmit_queue(SubBruteWorker* instance) {
+    const uint8_t timeout = instance->tx_timeout_ms;
+    while(instance->transmit_mode) {
+        furi_delay_ms(timeout);
+    }
+    instance->transmit_mode = true;
+
+    if(subbrute_worker_radio_start_tx(instance)) {
+        while(!subghz_devices_is_async_complete_tx(instance->radio_device)) {
+            furi_delay_ms(SUBBRUTE_TX_QUEUE_POLL);
+        }
+        subghz_devices_stop_async_tx(instance->radio_device);
+    }
+
+    subghz_devices_idle(instance->radio_device);
+
+    instance->transmit_mode = false;
+}
+
+const SubBruteEncoder* subbrute_worker_get_encoder(SubBruteWorker* instance) {
+    return subbrute_encoder_get(
+        subbrute_protocol_file(instance->file), instance->bits, instance->te);
+}
+
+uint64_t subbrute_worker_get_key(SubBruteWorker* instance, uint64_t step) {
+    if(instance->attack == SubBruteAttackLoadFile) {
+        return subbrute_protocol_file_key(
+            step, instance->load_index, instance->file_key, instance->two_bytes);
+    }
+    return subbrute_protocol_default_key(instance->file, step);
+}
+
+/**
+ * Append upload to the buffer being filled, pushing it to TX once it is full
+ *
+ * @return false if both buffers are waiting for TX
+ */
+static bool subbrute_worker_queue_upload(
+    SubBruteWorker* instance,
+    size_t size,
+    uint8_t repeat,
+    uint32_t gap,
+    uint64_t tag) {
+    SubBruteTxQueue* queue = instance->tx_queue;
+    SubBruteTxBuffer* buffer;
+    while((buffer = subbrute_tx_queue_get_free(queue))) {
+        if(!buffer->size) buffer->tag = tag;
+        if(subbrute_tx_buffer_append(buffer, instance->upload, size, repeat, gap)) return true;
+        // Any single upload fits into empty buffer
+        furi_check(buffer->size);
+        subbrute_tx_queue_push(queue);
+    }
+    return false;
+}
+
+/**
+ * Send keys from current step through direct upload, keeping radio in TX for the whole attack
+ *
+ * @return Finished or Tx if stopped
+ */
+static SubBruteWorkerState
+    subbrute_worker_transmit_queue(SubBruteWorker* instance, const SubBruteEncoder* encoder) {
+    SubBruteTxQueue* queue = instance->tx_queue;
+    subbrute_tx_queue_reset(queue);
+
+    const uint32_t gap = instance->tx_timeout_ms * 1000;
+    const bool de_bruijn = instance->de_bruijn && subbrute_worker_can_de_bruijn(instance);
+    const uint64_t de_bruijn_length = subbrute_de_bruijn_length(instance->bits);
+    SubBruteDeBruijn sequence;
+    if(de_bruijn) {
+        subbrute_de_bruijn_init(&sequence, instance->bits, instance->step);
+    }
+
+    // Next key, or next bit of De Bruijn sequence
+    uint64_t position = instance->step;
+    size_t size = 0;
+    uint8_t repeat = 0;
+    uint32_t upload_gap = 0;
+    bool queued = false;
+    bool tx_started = false;
+    SubBruteWorkerState state = SubBruteWorkerStateTx;
+
+    while(instance->worker_running) {
+        while(!queued) {
+            if(!size) {
+                if(de_bruijn) {
+                    uint64_t stream_bits;
+                    uint8_t count = subbrute_de_bruijn_next(
+                        &sequence, &stream_bits, SUBBRUTE_DE_BRUIJN_CHUNK);
+                    const bool last = position + count >= de_bruijn_length;
+                    size = subbrute_encoder_get_stream_upload(
+                        encoder,
+                        stream_bits,
+                        count,
+                        position == instance->step,
+                        last,
+                        instance->bits,
+                        instance->te,
+                        instance->upload,
+                        SUBBRUTE_ENCODER_UPLOAD_MAX);
+                    repeat = 1;
+                    upload_gap = last ? gap : 0;
+                } else {
+                    size = subbrute_encoder_get_upload(
+                        encoder,
+                        subbrute_worker_get_key(instance, position),
+                        instance->bits,
+                        instance->te,
+                        instance->upload,
+                        SUBBRUTE_ENCODER_UPLOAD_MAX);
+                    repeat = instance->repeat;
+                    upload_gap = gap;
+                }
+                furi_check(size);
+            }
+
+            // Step shown while buffer is on air, De Bruijn key is done with its last bit
+            uint64_t tag = position;
+            if(de_bruijn) {
+                tag = position < instance->bits ? 0 : position - (instance->bits - 1);
+            }
+            if(!subbrute_worker_queue_upload(instance, size, repeat, upload_gap, tag)) break;
+
+            if(de_bruijn) {
+                position += SUBBRUTE_DE_BRUIJN_CHUNK;
+                queued = position >= de_bruijn_length;
+            } else {
+                queued = position + 1 > instance->max_value;
+                position++;
+            }
+            size = 0;
+
+            if(queued) {
+                subbrute_tx_queue_push(queue);
+                subbrute_tx_queue_finish(queue);
+            }
+        }
+
+        if(!tx_started) {
+            if(!subbrute_worker_radio_start_tx(instance)) {
+                FURI_LOG_W(TAG, "Cannot start TX");
+                break;
+            }
+            tx_started = true;
+        } else if(subghz_devices_is_async_complete_tx(instance->radio_device)) {
+            subghz_devices_stop_async_tx(instance->radio_device);
+            if(!subbrute_tx_queue_is_underrun(queue)) {
+                tx_started = false;
+                state = SubBruteWorkerStateFinished;
+                break;
+            }
+            // Worker was late, continue where yield stopped
+            FURI_LOG_W(TAG, "TX queue underrun");
+            subbrute_tx_queue_clear_underrun(queue);
+            if(!subghz_devices_set_tx(instance->radio_device) ||
+               !subghz_devices_start_async_tx(
+                   instance->radio_device, subbrute_tx_queue_yield, queue)) {
+                tx_started = false;
+                break;
+            }
+        }
+
+        instance->step = subbrute_tx_queue_get_tag(queue);
+        furi_delay_ms(SUBBRUTE_TX_QUEUE_POLL);
+    }
+
+    if(tx_started) {
+        subghz_devices_stop_async_tx(instance->radio_device);
+    }
+    subghz_devices_idle(instance->radio_device);
+
+    if(state == SubBruteWorkerStateFinished) {
+        instance->step = instance->max_value;
+    } else {
+        instance->step = subbrute_tx_queue_get_tag(queue);
+    }
+
+    return state;
+}
+
 void subbrute_worker_send_callback(SubBruteWorker* instance) {
     if(instance->callback != NULL) {
         instance->callback(instance->context, instance->state);
@@ -382,10 +607,15 @@ int32_t subbrute_worker_thread(void* context) {
 
     instance->protocol_name = subbrute_protocol_file(instance->file);
 
+    const SubBruteEncoder* encoder = subbrute_worker_get_encoder(instance);
+    if(encoder) {
+        local_state = subbrute_worker_transmit_queue(instance, encoder);
+    }
+
     FlipperFormat* flipper_format = flipper_format_string_alloc();
     Stream* stream = flipper_format_get_raw_stream(flipper_format);
 
-    while(instance->worker_running) {
+    while(!encoder && instance->worker_running) {
         stream_clean(stream);
         if(instance->attack == SubBruteAttackLoadFile) {
             subbrute_protocol_file_payload(
@@ -465,6 +695,25 @@ void subbrute_worker_set_repeats(SubBruteWorker* instance, uint8_t repeats) {
     instance->repeat = repeats;
 }
 
+bool subbrute_worker_can_de_bruijn(SubBruteWorker* instance) {
+    furi_assert(instance);
+    const SubBruteEncoder* encoder = subbrute_worker_get_encoder(instance);
+
+    // Every key of bit length must be in range, ternary and file attacks only cover a part
+    return encoder && subbrute_encoder_can_stream(encoder) &&
+           instance->attack != SubBruteAttackLoadFile &&
+           instance->bits <= SUBBRUTE_DE_BRUIJN_BITS_MAX &&
+           instance->max_value == (1ULL << instance->bits) - 1;
+}
+
+bool subbrute_worker_get_de_bruijn(SubBruteWorker* instance) {
+    return instance->de_bruijn;
+}
+
+void subbrute_worker_set_de_bruijn(SubBruteWorker* instance, bool de_bruijn) {
+    instance->de_bruijn = de_bruijn;
+}
+
 uint32_t subbrute_worker_get_te(SubBruteWorker* instance) {
     return instance->te;
 }
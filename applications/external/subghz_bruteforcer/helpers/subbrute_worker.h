@@ -46,6 +46,9 @@ uint8_t subbrute_worker_get_timeout(SubBruteWorker* instance);
 void subbrute_worker_set_timeout(SubBruteWorker* instance, uint8_t timeout);
 uint8_t subbrute_worker_get_repeats(SubBruteWorker* instance);
 void subbrute_worker_set_repeats(SubBruteWorker* instance, uint8_t repeats);
+bool subbrute_worker_can_de_bruijn(SubBruteWorker* instance);
+bool subbrute_worker_get_de_bruijn(SubBruteWorker* instance);
+void subbrute_worker_set_de_bruijn(SubBruteWorker* instance, bool de_bruijn);
 uint32_t subbrute_worker_get_te(SubBruteWorker* instance);
 void subbrute_worker_set_te(SubBruteWorker* instance, uint32_t te);
 
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "subbrute_worker.h"
+#include "subbrute_encoder.h"
 #include <lib/subghz/protocols/base.h>
 #include <lib/subghz/transmitter.h>
 #include <lib/subghz/receiver.h>
@@ -24,6 +25,11 @@ struct SubBruteWorker {
     uint8_t tx_timeout_ms;
     const SubGhzDevice* radio_device;
 
+    // Direct upload, for protocols subbrute_encoder knows
+    SubBruteTxQueue* tx_queue;
+    LevelDuration* upload;
+    bool de_bruijn;
+
     // Initiated values
     SubBruteAttacks attack; // Attack state
     uint32_t frequency;
@@ -47,4 +53,7 @@ struct SubBruteWorker {
 
 int32_t subbrute_worker_thread(void* context);
 void subbrute_worker_subghz_transmit(SubBruteWorker* instance, FlipperFormat* flipper_format);
-void subbrute_worker_send_callback(SubBruteWorker* instance);
\ No newline at end of file
+void subbrute_worker_subghz_transmit_queue(SubBruteWorker* instance);
+void subbrute_worker_send_callback(SubBruteWorker* instance);
+const SubBruteEncoder* subbrute_worker_get_encoder(SubBruteWorker* instance);
+uint64_t subbrute_worker_get_key(SubBruteWorker* instance, uint64_t step);
\ No newline at end of file
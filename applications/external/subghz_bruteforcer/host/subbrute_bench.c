@@ -0,0 +1,307 @@
+// Host benchmark for Sub-GHz Bruteforcer direct upload
+//
+// Runs every attack through encoder and TX queue the way worker does, with yield drained in
+// async TX refill sized chunks, and prints keys per second and total airtime. Fails if yield
+// produces two equal levels in a row, runs dry before the end, or De Bruijn sequence misses a key.
+
+#include "../helpers/subbrute_encoder.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+// Same as API_HAL_SUBGHZ_ASYNC_TX_BUFFER_HALF, samples pulled from yield per DMA interrupt
+#define SUBBRUTE_BENCH_REFILL (128)
+#define SUBBRUTE_BENCH_DE_BRUIJN_CHUNK (32)
+#define SUBBRUTE_BENCH_TERNARY_MAX_VALUE (6561)
+
+typedef struct {
+    const char* name;
+    const char* protocol;
+    uint8_t bits;
+    uint32_t te;
+    uint8_t repeat;
+    bool ternary; // 3^8 keys instead of 2^bits
+} SubBruteBenchAttack;
+
+// Keep in sync with subbrute_protocols.c, frequency doesn't change airtime so bands share a row
+static const SubBruteBenchAttack subbrute_bench_attacks[] = {
+    {"CAME 12bit", "CAME", 12, 0, 3, false},
+    {"Nice 12bit", "Nice FLO", 12, 0, 3, false},
+    {"Ansonic 12bit", "Ansonic", 12, 0, 3, false},
+    {"Holtek FM 12bit", "Holtek_HT12X", 12, 204, 4, false},
+    {"Holtek AM 12bit", "Holtek_HT12X", 12, 433, 3, false},
+    {"Chamberlain 9bit", "Cham_Code", 9, 0, 3, false},
+    {"Chamberlain 8bit", "Cham_Code", 8, 0, 3, false},
+    {"Chamberlain 7bit", "Cham_Code", 7, 0, 3, false},
+    {"Linear 10bit", "Linear", 10, 0, 5, false},
+    {"LinearDelta3 8bit", "LinearDelta3", 8, 0, 5, false},
+    {"UNILARM 25bit", "SMC5326", 25, 209, 4, true},
+    {"SMC5326 25bit", "SMC5326", 25, 320, 4, true},
+    {"PT2260 24bit", "Princeton", 24, 286, 4, true},
+};
+
+typedef struct {
+    SubBruteTxQueue queue;
+    LevelDuration upload[SUBBRUTE_ENCODER_UPLOAD_MAX];
+    uint64_t airtime; // us
+    size_t samples;
+    size_t errors;
+    bool has_level;
+    bool level;
+} SubBruteBench;
+
+static double subbrute_bench_now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static bool subbrute_bench_queue(
+    SubBruteBench* bench,
+    size_t size,
+    uint8_t repeat,
+    uint32_t gap,
+    uint64_t tag) {
+    SubBruteTxBuffer* buffer;
+    while((buffer = subbrute_tx_queue_get_free(&bench->queue))) {
+        if(!buffer->size) buffer->tag = tag;
+        if(subbrute_tx_buffer_append(buffer, bench->upload, size, repeat, gap)) return true;
+        subbrute_tx_queue_push(&bench->queue);
+    }
+    return false;
+}
+
+// One DMA half buffer refill, false once yield ends transmission
+static bool subbrute_bench_refill(SubBruteBench* bench) {
+    for(size_t i = 0; i < SUBBRUTE_BENCH_REFILL; i++) {
+        LevelDuration level_duration = subbrute_tx_queue_yield(&bench->queue);
+        if(level_duration_is_reset(level_duration)) return false;
+
+        const bool level = level_duration_get_level(level_duration);
+        if(bench->has_level && bench->level == level) {
+            // Async TX would inject guard pulse here
+            bench->errors++;
+        }
+        bench->has_level = true;
+        bench->level = level;
+        bench->airtime += level_duration_get_duration(level_duration);
+        bench->samples++;
+    }
+    return true;
+}
+
+static void subbrute_bench_reset(SubBruteBench* bench) {
+    subbrute_tx_queue_reset(&bench->queue);
+    bench->airtime = 0;
+    bench->samples = 0;
+    bench->errors = 0;
+    bench->has_level = false;
+}
+
+/**
+ * Send keys 0..max_value like worker does, producer runs once per refill
+ *
+ * @return     producer time, s
+ */
+static double subbrute_bench_keys(
+    SubBruteBench* bench,
+    const SubBruteEncoder* encoder,
+    const SubBruteBenchAttack* attack,
+    uint64_t max_value,
+    uint32_t gap) {
+    subbrute_bench_reset(bench);
+
+    uint64_t step = 0;
+    size_t size = 0;
+    bool queued = false;
+    double produce = 0;
+    do {
+        const double start = subbrute_bench_now();
+        while(!queued) {
+            // Airtime doesn't depend on key value, every symbol pair has the same length
+            if(!size) {
+                size = subbrute_encoder_get_upload(
+                    encoder,
+                    step,
+                    attack->bits,
+                    attack->te,
+                    bench->upload,
+                    SUBBRUTE_ENCODER_UPLOAD_MAX);
+            }
+            if(!subbrute_bench_queue(bench, size, attack->repeat, gap, step)) break;
+            size = 0;
+            queued = step + 1 > max_value;
+            step++;
+            if(queued) {
+                subbrute_tx_queue_push(&bench->queue);
+                subbrute_tx_queue_finish(&bench->queue);
+            }
+        }
+        produce += subbrute_bench_now() - start;
+    } while(subbrute_bench_refill(bench));
+
+    if(subbrute_tx_queue_is_underrun(&bench->queue)) bench->errors++;
+    return produce;
+}
+
+static double subbrute_bench_de_bruijn(
+    SubBruteBench* bench,
+    const SubBruteEncoder* encoder,
+    const SubBruteBenchAttack* attack,
+    uint32_t gap) {
+    subbrute_bench_reset(bench);
+
+    SubBruteDeBruijn sequence;
+    subbrute_de_bruijn_init(&sequence, attack->bits, 0);
+    const uint64_t length = subbrute_de_bruijn_length(attack->bits);
+
+    uint64_t position = 0;
+    size_t size = 0;
+    bool queued = false;
+    double produce = 0;
+    do {
+        const double start = subbrute_bench_now();
+        while(!queued) {
+            if(!size) {
+                uint64_t stream_bits;
+                const uint8_t count = subbrute_de_bruijn_next(
+                    &sequence, &stream_bits, SUBBRUTE_BENCH_DE_BRUIJN_CHUNK);
+                size = subbrute_encoder_get_stream_upload(
+                    encoder,
+                    stream_bits,
+                    count,
+                    position == 0,
+                    position + count >= length,
+                    attack->bits,
+                    attack->te,
+                    bench->upload,
+                    SUBBRUTE_ENCODER_UPLOAD_MAX);
+            }
+            const bool last = position + SUBBRUTE_BENCH_DE_BRUIJN_CHUNK >= length;
+            if(!subbrute_bench_queue(bench, size, 1, last ? gap : 0, position)) break;
+            size = 0;
+            position += SUBBRUTE_BENCH_DE_BRUIJN_CHUNK;
+            queued = last;
+            if(queued) {
+                subbrute_tx_queue_push(&bench->queue);
+                subbrute_tx_queue_finish(&bench->queue);
+            }
+        }
+        produce += subbrute_bench_now() - start;
+    } while(subbrute_bench_refill(bench));
+
+    if(subbrute_tx_queue_is_underrun(&bench->queue)) bench->errors++;
+    return produce;
+}
+
+// Every key appears exactly once as a window of the sequence
+static bool subbrute_bench_de_bruijn_check(uint8_t bits) {
+    const uint64_t keys = 1ULL << bits;
+    uint8_t* seen = calloc(keys, 1);
+    SubBruteDeBruijn sequence;
+    subbrute_de_bruijn_init(&sequence, bits, 0);
+
+    uint64_t window = 0;
+    uint64_t length = 0;
+    uint64_t stream_bits;
+    uint8_t count;
+    bool ok = true;
+    while((count = subbrute_de_bruijn_next(&sequence, &stream_bits, 7))) {
+        for(uint8_t i = count; i > 0; i--) {
+            window = ((window << 1) | ((stream_bits >> (i - 1)) & 1)) & (keys - 1);
+            if(++length >= bits && seen[window]++) ok = false;
+        }
+    }
+    for(uint64_t key = 0; key < keys; key++) {
+        if(!seen[key]) ok = false;
+    }
+    free(seen);
+    return ok && length == subbrute_de_bruijn_length(bits);
+}
+
+int main(int argc, char** argv) {
+    uint32_t gap_ms = 6; // SUBBRUTE_TX_TIMEOUT
+    int opt;
+
+    while((opt = getopt(argc, argv, "g:")) != -1) {
+        switch(opt) {
+        case 'g':
+            gap_ms = strtoul(optarg, NULL, 0);
+            break;
+        default:
+            fprintf(stderr, "Usage: %s [-g gap_ms]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    size_t errors = 0;
+    for(uint8_t bits = 1; bits <= SUBBRUTE_DE_BRUIJN_BITS_MAX; bits++) {
+        if(!subbrute_bench_de_bruijn_check(bits)) {
+            printf("De Bruijn sequence for %u bits misses keys\n", bits);
+            errors++;
+        }
+    }
+
+    static SubBruteBench bench;
+    printf(
+        "%-18s %6s %8s %9s %10s %12s %12s\n",
+        "Attack",
+        "Keys",
+        "ms/key",
+        "Airtime,s",
+        "Keys/s air",
+        "Keys/s CPU",
+        "De Bruijn,s");
+    for(size_t i = 0; i < sizeof(subbrute_bench_attacks) / sizeof(subbrute_bench_attacks[0]);
+        i++) {
+        const SubBruteBenchAttack* attack = &subbrute_bench_attacks[i];
+        const SubBruteEncoder* encoder =
+            subbrute_encoder_get(attack->protocol, attack->bits, attack->te);
+        if(!encoder) {
+            printf("%-18s no direct encoder\n", attack->name);
+            errors++;
+            continue;
+        }
+
+        const uint64_t max_value =
+            attack->ternary ? SUBBRUTE_BENCH_TERNARY_MAX_VALUE : (1ULL << attack->bits) - 1;
+        const uint64_t keys = max_value + 1;
+        const double produce =
+            subbrute_bench_keys(&bench, encoder, attack, max_value, gap_ms * 1000);
+        const double airtime = bench.airtime / 1e6;
+        if(bench.errors) {
+            printf("%-18s %zu TX errors\n", attack->name, bench.errors);
+            errors++;
+        }
+
+        char de_bruijn[16] = "-";
+        if(!attack->ternary && attack->bits <= SUBBRUTE_DE_BRUIJN_BITS_MAX &&
+           subbrute_encoder_can_stream(encoder)) {
+            subbrute_bench_de_bruijn(&bench, encoder, attack, gap_ms * 1000);
+            if(bench.errors) {
+                printf("%-18s %zu De Bruijn TX errors\n", attack->name, bench.errors);
+                errors++;
+            }
+            snprintf(de_bruijn, sizeof(de_bruijn), "%.2f", bench.airtime / 1e6);
+        }
+
+        printf(
+            "%-18s %6llu %8.2f %9.1f %10.1f %12.0f %12s\n",
+            attack->name,
+            (unsigned long long)keys,
+            airtime * 1e3 / keys,
+            airtime,
+            keys / airtime,
+            keys / produce,
+            de_bruijn);
+    }
+
+    if(errors) {
+        printf("%zu errors\n", errors);
+        return 1;
+    }
+    return 0;
+}
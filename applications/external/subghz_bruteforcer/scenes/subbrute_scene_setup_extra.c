@@ -180,6 +180,16 @@ static void setup_extra_te_callback(VariableItem* item) {
     }
 }
 
+static void setup_extra_de_bruijn_callback(VariableItem* item) {
+    furi_assert(item);
+    SubBruteState* instance = variable_item_get_context(item);
+    furi_assert(instance);
+
+    const bool de_bruijn = variable_item_get_current_value_index(item);
+    subbrute_worker_set_de_bruijn(instance->worker, de_bruijn);
+    variable_item_set_current_value_text(item, de_bruijn ? "ON" : "OFF");
+}
+
 static void subbrute_scene_setup_extra_init_var_list(SubBruteState* instance, bool on_extra) {
     furi_assert(instance);
     char str[6];
@@ -243,6 +253,14 @@ static void subbrute_scene_setup_extra_init_var_list(SubBruteState* instance, bo
                 break;
             }
         }
+        if(subbrute_worker_can_de_bruijn(instance->worker)) {
+            // Whole key space as one bit stream, for receivers with shift register
+            item = variable_item_list_add(
+                var_list, "De Bruijn", 2, setup_extra_de_bruijn_callback, instance);
+            const bool de_bruijn = subbrute_worker_get_de_bruijn(instance->worker);
+            variable_item_set_current_value_index(item, de_bruijn);
+            variable_item_set_current_value_text(item, de_bruijn ? "ON" : "OFF");
+        }
     } else {
         item = variable_item_list_add(var_list, "Show Extra", 0, NULL, NULL);
     }
@@ -2,15 +2,37 @@
 
 #include <stdlib.h>
 #include <m-dict.h>
+#include <m-array.h>
 #include <flipper_format/flipper_format.h>
+#include <toolbox/stream/stream.h>
+#include <toolbox/stream/buffered_file_stream.h>
+#include <toolbox/crc32_calc.h>
 
 #include "infrared_signal.h"
 
+#define TAG "InfraredBruteForce"
+
+#define INFRARED_BRUTE_FORCE_INDEX_EXTENSION ".idx"
+#define INFRARED_BRUTE_FORCE_INDEX_MAGIC 0x58495249 // "IRIX"
+#define INFRARED_BRUTE_FORCE_INDEX_VERSION 2
+#define INFRARED_BRUTE_FORCE_INDEX_CRC_BLOCK_SIZE 512
+
 typedef struct {
     uint32_t index;
     uint32_t count;
 } InfraredBruteForceRecord;
 
+/* Sidecar index: header followed by one entry per signal in file order,
+ * entry is offset (uint32_t), name length (uint8_t) and name. Offset points
+ * to the end of the line before the "name" key of the signal. */
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t db_size;
+    uint32_t db_crc; /**< CRC32 of the first and the last block of the database */
+    uint32_t count; /**< Zero until the index is complete */
+} InfraredBruteForceIndexHeader;
+
 DICT_DEF2(
     InfraredBruteForceRecordDict,
     FuriString*,
@@ -18,12 +40,16 @@ DICT_DEF2(
     InfraredBruteForceRecord,
     M_POD_OPLIST);
 
+ARRAY_DEF(InfraredBruteForceOffsetArray, uint32_t, M_POD_OPLIST);
+
 struct InfraredBruteForce {
     FlipperFormat* ff;
     const char* db_filename;
     FuriString* current_record_name;
     InfraredSignal* current_signal;
     InfraredBruteForceRecordDict_t records;
+    InfraredBruteForceOffsetArray_t offsets;
+    size_t current_offset;
     bool is_started;
 };
 
@@ -35,12 +61,14 @@ InfraredBruteForce* infrared_brute_force_alloc() {
     brute_force->is_started = false;
     brute_force->current_record_name = furi_string_alloc();
     InfraredBruteForceRecordDict_init(brute_force->records);
+    InfraredBruteForceOffsetArray_init(brute_force->offsets);
     return brute_force;
 }
 
 void infrared_brute_force_free(InfraredBruteForce* brute_force) {
     furi_assert(!brute_force->is_started);
     InfraredBruteForceRecordDict_clear(brute_force->records);
+    InfraredBruteForceOffsetArray_clear(brute_force->offsets);
     furi_string_free(brute_force->current_record_name);
     free(brute_force);
 }
@@ -50,15 +78,147 @@ void infrared_brute_force_set_db_filename(InfraredBruteForce* brute_force, const
     brute_force->db_filename = db_filename;
 }
 
-bool infrared_brute_force_calculate_messages(InfraredBruteForce* brute_force) {
-    furi_assert(!brute_force->is_started);
-    furi_assert(brute_force->db_filename);
+static bool infrared_brute_force_get_index_header(
+    InfraredBruteForce* brute_force,
+    Storage* storage,
+    InfraredBruteForceIndexHeader* header) {
+    File* file = storage_file_alloc(storage);
+    uint8_t* block = malloc(INFRARED_BRUTE_FORCE_INDEX_CRC_BLOCK_SIZE);
+    uint32_t size = 0;
+    uint32_t crc = 0;
+
+    // Storage timestamp is global and changes on every write, index included,
+    // so the database is identified by its size and content at both ends
     bool success = false;
+    do {
+        if(!storage_file_open(file, brute_force->db_filename, FSAM_READ, FSOM_OPEN_EXISTING))
+            break;
+        size = storage_file_size(file);
 
-    Storage* storage = furi_record_open(RECORD_STORAGE);
+        size_t read = storage_file_read(file, block, INFRARED_BRUTE_FORCE_INDEX_CRC_BLOCK_SIZE);
+        if(read != MIN(size, (uint32_t)INFRARED_BRUTE_FORCE_INDEX_CRC_BLOCK_SIZE)) break;
+        crc = crc32_calc_buffer(crc, block, read);
+
+        if(size > INFRARED_BRUTE_FORCE_INDEX_CRC_BLOCK_SIZE) {
+            if(!storage_file_seek(file, size - INFRARED_BRUTE_FORCE_INDEX_CRC_BLOCK_SIZE, true))
+                break;
+            read = storage_file_read(file, block, INFRARED_BRUTE_FORCE_INDEX_CRC_BLOCK_SIZE);
+            if(read != INFRARED_BRUTE_FORCE_INDEX_CRC_BLOCK_SIZE) break;
+            crc = crc32_calc_buffer(crc, block, read);
+        }
+        success = true;
+    } while(false);
+
+    storage_file_close(file);
+    storage_file_free(file);
+    free(block);
+
+    if(success) {
+        header->magic = INFRARED_BRUTE_FORCE_INDEX_MAGIC;
+        header->version = INFRARED_BRUTE_FORCE_INDEX_VERSION;
+        header->db_size = size;
+        header->db_crc = crc;
+        header->count = 0;
+    }
+    return success;
+}
+
+/* Opens the index and checks it against the database, on success the stream
+ * is positioned on the first entry */
+static bool infrared_brute_force_open_index(
+    InfraredBruteForce* brute_force,
+    Storage* storage,
+    Stream* stream,
+    FuriString* index_path) {
+    InfraredBruteForceIndexHeader expected;
+    InfraredBruteForceIndexHeader header;
+
+    bool success = false;
+    do {
+        if(!infrared_brute_force_get_index_header(brute_force, storage, &expected)) break;
+        if(!buffered_file_stream_open(
+               stream, furi_string_get_cstr(index_path), FSAM_READ, FSOM_OPEN_EXISTING))
+            break;
+        if(stream_read(stream, (uint8_t*)&header, sizeof(header)) != sizeof(header)) break;
+        if(header.magic != expected.magic || header.version != expected.version ||
+           header.db_size != expected.db_size || header.db_crc != expected.db_crc ||
+           !header.count)
+            break;
+        success = true;
+    } while(false);
+
+    return success;
+}
+
+/* Calls the callback for every signal name in the index */
+typedef void (*InfraredBruteForceIndexCallback)(
+    InfraredBruteForce* brute_force,
+    const char* name,
+    uint32_t offset);
+
+static bool infrared_brute_force_read_index(
+    InfraredBruteForce* brute_force,
+    Storage* storage,
+    InfraredBruteForceIndexCallback callback) {
+    FuriString* index_path = furi_string_alloc_printf(
+        "%s" INFRARED_BRUTE_FORCE_INDEX_EXTENSION, brute_force->db_filename);
+    Stream* stream = buffered_file_stream_alloc(storage);
+
+    bool success = infrared_brute_force_open_index(brute_force, storage, stream, index_path);
+    if(success) {
+        char name[UINT8_MAX + 1];
+        uint32_t offset;
+        uint8_t name_size;
+        while(stream_read(stream, (uint8_t*)&offset, sizeof(offset)) == sizeof(offset)) {
+            if(stream_read(stream, &name_size, sizeof(name_size)) != sizeof(name_size) ||
+               stream_read(stream, (uint8_t*)name, name_size) != name_size) {
+                success = false;
+                break;
+            }
+            name[name_size] = '\0';
+            callback(brute_force, name, offset);
+        }
+    }
+
+    buffered_file_stream_close(stream);
+    stream_free(stream);
+    furi_string_free(index_path);
+    return success;
+}
+
+static bool
+    infrared_brute_force_write_index_entry(Stream* stream, uint32_t offset, FuriString* name) {
+    uint8_t name_size = MIN(furi_string_size(name), (size_t)UINT8_MAX);
+    return stream_write(stream, (uint8_t*)&offset, sizeof(offset)) == sizeof(offset) &&
+           stream_write(stream, &name_size, sizeof(name_size)) == sizeof(name_size) &&
+           stream_write(stream, (const uint8_t*)furi_string_get_cstr(name), name_size) ==
+               name_size;
+}
+
+/* Scans the whole database once, counting records and writing the index */
+static bool infrared_brute_force_build_index(InfraredBruteForce* brute_force, Storage* storage) {
+    FuriString* index_path = furi_string_alloc_printf(
+        "%s" INFRARED_BRUTE_FORCE_INDEX_EXTENSION, brute_force->db_filename);
     FlipperFormat* ff = flipper_format_buffered_file_alloc(storage);
+    Stream* db_stream = flipper_format_get_raw_stream(ff);
+    Stream* index_stream = buffered_file_stream_alloc(storage);
+    InfraredBruteForceIndexHeader header;
+
+    bool success = flipper_format_buffered_file_open_existing(ff, brute_force->db_filename);
+    bool index_ok = false;
+    do {
+        if(!success) break;
+        if(!infrared_brute_force_get_index_header(brute_force, storage, &header)) break;
+        if(!buffered_file_stream_open(
+               index_stream,
+               furi_string_get_cstr(index_path),
+               FSAM_READ_WRITE,
+               FSOM_CREATE_ALWAYS))
+            break;
+        if(stream_write(index_stream, (uint8_t*)&header, sizeof(header)) != sizeof(header)) break;
+        index_ok = true;
+    } while(false);
 
-    success = flipper_format_buffered_file_open_existing(ff, brute_force->db_filename);
     if(success) {
         FuriString* signal_name;
         signal_name = furi_string_alloc();
@@ -68,11 +228,80 @@ bool infrared_brute_force_calculate_messages(InfraredBruteForce* brute_force) {
             if(record) { //-V547
                 ++(record->count);
             }
+
+            if(!index_ok) continue;
+            size_t position = stream_tell(db_stream);
+            uint32_t offset = 0;
+            // The "name" line starts after the previous end of line
+            if(stream_seek_to_char(db_stream, '\n', StreamDirectionBackward)) {
+                offset = stream_tell(db_stream);
+            }
+            stream_seek(db_stream, position, StreamOffsetFromStart);
+
+            index_ok = infrared_brute_force_write_index_entry(index_stream, offset, signal_name);
+            header.count++;
         }
         furi_string_free(signal_name);
     }
 
+    // Index is only valid once the count is written
+    if(index_ok && header.count) {
+        index_ok = stream_seek(index_stream, 0, StreamOffsetFromStart) &&
+                   stream_write(index_stream, (uint8_t*)&header, sizeof(header)) == sizeof(header);
+    }
+    if(!index_ok) {
+        FURI_LOG_W(TAG, "Unable to write index");
+    }
+
+    buffered_file_stream_close(index_stream);
+    stream_free(index_stream);
     flipper_format_free(ff);
+    furi_string_free(index_path);
+    return success;
+}
+
+static void infrared_brute_force_count_callback(
+    InfraredBruteForce* brute_force,
+    const char* name,
+    uint32_t offset) {
+    UNUSED(offset);
+    FuriString* key = furi_string_alloc_set(name);
+    InfraredBruteForceRecord* record = InfraredBruteForceRecordDict_get(brute_force->records, key);
+    if(record) {
+        ++(record->count);
+    }
+    furi_string_free(key);
+}
+
+static void infrared_brute_force_offset_callback(
+    InfraredBruteForce* brute_force,
+    const char* name,
+    uint32_t offset) {
+    if(furi_string_equal(brute_force->current_record_name, name)) {
+        InfraredBruteForceOffsetArray_push_back(brute_force->offsets, offset);
+    }
+}
+
+bool infrared_brute_force_calculate_messages(InfraredBruteForce* brute_force) {
+    furi_assert(!brute_force->is_started);
+    furi_assert(brute_force->db_filename);
+    bool success = false;
+
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+
+    success = infrared_brute_force_read_index(
+        brute_force, storage, infrared_brute_force_count_callback);
+    if(!success) {
+        // Drop partial counts from a broken index
+        InfraredBruteForceRecordDict_it_t it;
+        for(InfraredBruteForceRecordDict_it(it, brute_force->records);
+            !InfraredBruteForceRecordDict_end_p(it);
+            InfraredBruteForceRecordDict_next(it)) {
+            InfraredBruteForceRecordDict_ref(it)->value.count = 0;
+        }
+        success = infrared_brute_force_build_index(brute_force, storage);
+    }
+
     furi_record_close(RECORD_STORAGE);
     return success;
 }
@@ -101,6 +330,14 @@ bool infrared_brute_force_start(
 
     if(*record_count) {
         Storage* storage = furi_record_open(RECORD_STORAGE);
+        // Without index, signals are searched in the database
+        InfraredBruteForceOffsetArray_reset(brute_force->offsets);
+        brute_force->current_offset = 0;
+        if(!infrared_brute_force_read_index(
+               brute_force, storage, infrared_brute_force_offset_callback)) {
+            InfraredBruteForceOffsetArray_reset(brute_force->offsets);
+        }
+
         brute_force->ff = flipper_format_buffered_file_alloc(storage);
         brute_force->current_signal = infrared_signal_alloc();
         brute_force->is_started = true;
@@ -128,6 +365,15 @@ void infrared_brute_force_stop(InfraredBruteForce* brute_force) {
 
 bool infrared_brute_force_send_next(InfraredBruteForce* brute_force) {
     furi_assert(brute_force->is_started);
+    if(!InfraredBruteForceOffsetArray_empty_p(brute_force->offsets)) {
+        if(brute_force->current_offset >=
+           InfraredBruteForceOffsetArray_size(brute_force->offsets)) {
+            return false;
+        }
+        uint32_t offset = *InfraredBruteForceOffsetArray_get(
+            brute_force->offsets, brute_force->current_offset++);
+        stream_seek(flipper_format_get_raw_stream(brute_force->ff), offset, StreamOffsetFromStart);
+    }
     const bool success = infrared_signal_search_and_read(
         brute_force->current_signal, brute_force->ff, brute_force->current_record_name);
     if(success) {
@@ -319,7 +319,9 @@ static void infrared_cli_process_decode(Cli* cli, FuriString* args) {
             break;
         }
         if(!flipper_format_read_header(input_file, header, &version) ||
-           (!furi_string_start_with_str(header, "IR")) || version != 1) {
+           (!furi_string_start_with_str(header, "IR")) ||
+           (version != INFRARED_SIGNAL_FILE_VERSION &&
+            version != INFRARED_SIGNAL_FILE_VERSION_TEMPLATE)) {
             printf(
                 "Invalid or corrupted input file: \"%s\"\r\n", furi_string_get_cstr(input_path));
             break;
@@ -334,7 +336,9 @@ static void infrared_cli_process_decode(Cli* cli, FuriString* args) {
                 "Failed to open file for writing: \"%s\"\r\n", furi_string_get_cstr(output_path));
             break;
         }
-        if(output_file && !flipper_format_write_header(output_file, header, version)) {
+        // Decoded output is stored without templates
+        if(output_file &&
+           !flipper_format_write_header(output_file, header, INFRARED_SIGNAL_FILE_VERSION)) {
             printf(
                 "Failed to write to the output file: \"%s\"\r\n",
                 furi_string_get_cstr(output_path));
@@ -424,6 +428,8 @@ static void
             printf("Missing signal name.\r\n");
             break;
         }
+        uint32_t start = furi_get_tick();
+        uint32_t first_signal_time = 0;
         if(!infrared_brute_force_calculate_messages(brute_force)) {
             printf("Invalid remote name.\r\n");
             break;
@@ -444,6 +450,7 @@ static void
         int records_sent = 0;
         while(running) {
             running = infrared_brute_force_send_next(brute_force);
+            if(!records_sent) first_signal_time = furi_get_tick() - start;
 
             if(cli_cmd_interrupt_received(cli)) break;
 
@@ -452,6 +459,10 @@ static void
         }
 
         infrared_brute_force_stop(brute_force);
+        printf(
+            "\r\nFirst signal in %lums, total %lums.\r\n",
+            first_signal_time,
+            furi_get_tick() - start);
     } while(false);
 
     furi_string_free(remote_path);
@@ -117,24 +117,37 @@ void infrared_remote_move_button(InfraredRemote* remote, size_t index_orig, size
     InfraredButtonArray_push_at(remote->buttons, index_dest, button);
 }
 
-bool infrared_remote_store(InfraredRemote* remote) {
+static bool infrared_remote_store_signals(InfraredRemote* remote, bool compact) {
     Storage* storage = furi_record_open(RECORD_STORAGE);
     FlipperFormat* ff = flipper_format_file_alloc(storage);
     const char* path = furi_string_get_cstr(remote->path);
 
-    FURI_LOG_I(TAG, "store file: \'%s\'", path);
+    FURI_LOG_I(TAG, "store file: \'%s\'%s", path, compact ? " (compact)" : "");
+
+    InfraredButtonArray_it_t it;
+    uint32_t version = INFRARED_SIGNAL_FILE_VERSION;
+    if(compact) {
+        for(InfraredButtonArray_it(it, remote->buttons); !InfraredButtonArray_end_p(it);
+            InfraredButtonArray_next(it)) {
+            InfraredRemoteButton* button = *InfraredButtonArray_cref(it);
+            if(infrared_signal_is_compacted_to_template(
+                   infrared_remote_button_get_signal(button))) {
+                version = INFRARED_SIGNAL_FILE_VERSION_TEMPLATE;
+                break;
+            }
+        }
+    }
 
     bool success = flipper_format_file_open_always(ff, path) &&
-                   flipper_format_write_header_cstr(ff, "IR signals file", 1);
+                   flipper_format_write_header_cstr(ff, INFRARED_SIGNAL_FILE_HEADER, version);
     if(success) {
-        InfraredButtonArray_it_t it;
         for(InfraredButtonArray_it(it, remote->buttons); !InfraredButtonArray_end_p(it);
             InfraredButtonArray_next(it)) {
             InfraredRemoteButton* button = *InfraredButtonArray_cref(it);
-            success = infrared_signal_save(
-                infrared_remote_button_get_signal(button),
-                ff,
-                infrared_remote_button_get_name(button));
+            InfraredSignal* signal = infrared_remote_button_get_signal(button);
+            const char* name = infrared_remote_button_get_name(button);
+            success = compact ? infrared_signal_save_compact(signal, ff, name) :
+                                infrared_signal_save(signal, ff, name);
             if(!success) {
                 break;
             }
@@ -146,6 +159,14 @@ bool infrared_remote_store(InfraredRemote* remote) {
     return success;
 }
 
+bool infrared_remote_store(InfraredRemote* remote) {
+    return infrared_remote_store_signals(remote, false);
+}
+
+bool infrared_remote_store_compact(InfraredRemote* remote) {
+    return infrared_remote_store_signals(remote, true);
+}
+
 bool infrared_remote_load(InfraredRemote* remote, FuriString* path) {
     Storage* storage = furi_record_open(RECORD_STORAGE);
     FlipperFormat* ff = flipper_format_buffered_file_alloc(storage);
@@ -160,7 +181,10 @@ bool infrared_remote_load(InfraredRemote* remote, FuriString* path) {
         if(!flipper_format_buffered_file_open_existing(ff, furi_string_get_cstr(path))) break;
         uint32_t version;
         if(!flipper_format_read_header(ff, buf, &version)) break;
-        if(!furi_string_equal(buf, "IR signals file") || (version != 1)) break;
+        if(!furi_string_equal(buf, INFRARED_SIGNAL_FILE_HEADER) ||
+           (version != INFRARED_SIGNAL_FILE_VERSION &&
+            version != INFRARED_SIGNAL_FILE_VERSION_TEMPLATE))
+            break;
 
         path_extract_filename(path, buf, true);
         infrared_remote_clear_buttons(remote);
@@ -26,5 +26,7 @@ bool infrared_remote_delete_button(InfraredRemote* remote, size_t index);
 void infrared_remote_move_button(InfraredRemote* remote, size_t index_orig, size_t index_dest);
 
 bool infrared_remote_store(InfraredRemote* remote);
+/* Stores raw buttons as messages or templates; later edits store them raw again */
+bool infrared_remote_store_compact(InfraredRemote* remote);
 bool infrared_remote_load(InfraredRemote* remote, FuriString* path);
 bool infrared_remote_remove(InfraredRemote* remote);
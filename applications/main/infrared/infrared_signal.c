@@ -5,6 +5,7 @@
 #include <core/check.h>
 #include <infrared_worker.h>
 #include <infrared_transmit.h>
+#include <infrared_analyzer.h>
 
 #define TAG "InfraredSignal"
 
@@ -83,7 +84,8 @@ static bool infrared_signal_is_raw_valid(InfraredRawSignal* raw) {
     return true;
 }
 
-static inline bool infrared_signal_save_message(InfraredMessage* message, FlipperFormat* ff) {
+static inline bool
+    infrared_signal_save_message(const InfraredMessage* message, FlipperFormat* ff) {
     const char* protocol_name = infrared_get_protocol_name(message->protocol);
     return flipper_format_write_string_cstr(ff, "type", "parsed") &&
            flipper_format_write_string_cstr(ff, "protocol", protocol_name) &&
@@ -99,6 +101,39 @@ static inline bool infrared_signal_save_raw(InfraredRawSignal* raw, FlipperForma
            flipper_format_write_uint32(ff, "data", raw->timings, raw->timings_size);
 }
 
+static inline bool infrared_signal_save_template(const InfraredTemplate* tmpl, FlipperFormat* ff) {
+    return flipper_format_write_string_cstr(ff, "type", "template") &&
+           flipper_format_write_uint32(ff, "frequency", &tmpl->frequency, 1) &&
+           flipper_format_write_float(ff, "duty_cycle", &tmpl->duty_cycle, 1) &&
+           flipper_format_write_uint32(ff, "symbols", tmpl->symbols, tmpl->symbols_count * 2) &&
+           flipper_format_write_uint32(ff, "length", &tmpl->length, 1) &&
+           flipper_format_write_uint32(ff, "repeat", &tmpl->repeat, 1) &&
+           flipper_format_write_hex(
+               ff, "stream", tmpl->stream, infrared_template_get_stream_size(tmpl));
+}
+
+/* Raw signal is stored as message or template when it transmits the same timings */
+static bool infrared_signal_save_raw_compact(InfraredRawSignal* raw, FlipperFormat* ff) {
+    InfraredAnalyzer* analyzer = infrared_analyzer_alloc();
+    bool success;
+
+    switch(infrared_analyzer_process(
+        analyzer, raw->timings, raw->timings_size, raw->frequency, raw->duty_cycle)) {
+    case InfraredAnalyzerResultMessage:
+        success = infrared_signal_save_message(infrared_analyzer_get_message(analyzer), ff);
+        break;
+    case InfraredAnalyzerResultTemplate:
+        success = infrared_signal_save_template(infrared_analyzer_get_template(analyzer), ff);
+        break;
+    default:
+        success = infrared_signal_save_raw(raw, ff);
+        break;
+    }
+
+    infrared_analyzer_free(analyzer);
+    return success;
+}
+
 static inline bool infrared_signal_read_message(InfraredSignal* signal, FlipperFormat* ff) {
     FuriString* buf;
     buf = furi_string_alloc();
@@ -146,6 +181,49 @@ static inline bool infrared_signal_read_raw(InfraredSignal* signal, FlipperForma
     return success;
 }
 
+static inline bool infrared_signal_read_template(InfraredSignal* signal, FlipperFormat* ff) {
+    InfraredTemplate* tmpl = malloc(sizeof(InfraredTemplate));
+    uint32_t symbols_size;
+    bool success = false;
+
+    do {
+        if(!flipper_format_read_uint32(ff, "frequency", &tmpl->frequency, 1)) break;
+        if(!flipper_format_read_float(ff, "duty_cycle", &tmpl->duty_cycle, 1)) break;
+        if(!flipper_format_get_value_count(ff, "symbols", &symbols_size)) break;
+        if(!symbols_size || (symbols_size % 2) || (symbols_size > COUNT_OF(tmpl->symbols))) {
+            FURI_LOG_E(TAG, "Wrong template symbols");
+            break;
+        }
+        if(!flipper_format_read_uint32(ff, "symbols", tmpl->symbols, symbols_size)) break;
+        tmpl->symbols_count = symbols_size / 2;
+        if(!flipper_format_read_uint32(ff, "length", &tmpl->length, 1)) break;
+        if(!flipper_format_read_uint32(ff, "repeat", &tmpl->repeat, 1)) break;
+        if(!infrared_template_is_valid(tmpl)) {
+            FURI_LOG_E(TAG, "Template is out of range");
+            break;
+        }
+        if(!flipper_format_read_hex(
+               ff, "stream", tmpl->stream, infrared_template_get_stream_size(tmpl)))
+            break;
+
+        const size_t timings_size = infrared_template_get_timings_size(tmpl);
+        uint32_t* timings = malloc(sizeof(uint32_t) * timings_size);
+        success = infrared_template_expand(tmpl, timings, timings_size) == timings_size;
+
+        if(success) {
+            infrared_signal_set_raw_signal(
+                signal, timings, timings_size, tmpl->frequency, tmpl->duty_cycle);
+        } else {
+            FURI_LOG_E(TAG, "Corrupted template stream");
+        }
+
+        free(timings);
+    } while(false);
+
+    free(tmpl);
+    return success;
+}
+
 static bool infrared_signal_read_body(InfraredSignal* signal, FlipperFormat* ff) {
     FuriString* tmp = furi_string_alloc();
 
@@ -157,6 +235,8 @@ static bool infrared_signal_read_body(InfraredSignal* signal, FlipperFormat* ff)
             success = infrared_signal_read_raw(signal, ff);
         } else if(furi_string_equal(tmp, "parsed")) {
             success = infrared_signal_read_message(signal, ff);
+        } else if(furi_string_equal(tmp, "template")) {
+            success = infrared_signal_read_template(signal, ff);
         } else {
             FURI_LOG_E(TAG, "Unknown signal type");
         }
@@ -261,6 +341,33 @@ bool infrared_signal_save(InfraredSignal* signal, FlipperFormat* ff, const char*
     }
 }
 
+bool infrared_signal_save_compact(InfraredSignal* signal, FlipperFormat* ff, const char* name) {
+    if(!flipper_format_write_comment_cstr(ff, "") ||
+       !flipper_format_write_string_cstr(ff, "name", name)) {
+        return false;
+    } else if(signal->is_raw) {
+        return infrared_signal_save_raw_compact(&signal->payload.raw, ff);
+    } else {
+        return infrared_signal_save_message(&signal->payload.message, ff);
+    }
+}
+
+bool infrared_signal_is_compacted_to_template(InfraredSignal* signal) {
+    if(!signal->is_raw) return false;
+
+    InfraredRawSignal* raw = &signal->payload.raw;
+    InfraredAnalyzer* analyzer = infrared_analyzer_alloc();
+    const bool is_template = infrared_analyzer_process(
+                                 analyzer,
+                                 raw->timings,
+                                 raw->timings_size,
+                                 raw->frequency,
+                                 raw->duty_cycle) == InfraredAnalyzerResultTemplate;
+    infrared_analyzer_free(analyzer);
+
+    return is_template;
+}
+
 bool infrared_signal_read(InfraredSignal* signal, FlipperFormat* ff, FuriString* name) {
     FuriString* tmp = furi_string_alloc();
 
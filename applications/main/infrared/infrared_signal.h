@@ -7,6 +7,10 @@
 #include <infrared.h>
 #include <flipper_format/flipper_format.h>
 
+#define INFRARED_SIGNAL_FILE_HEADER "IR signals file"
+#define INFRARED_SIGNAL_FILE_VERSION (1U)
+#define INFRARED_SIGNAL_FILE_VERSION_TEMPLATE (2U)
+
 typedef struct InfraredSignal InfraredSignal;
 
 typedef struct {
@@ -36,6 +40,10 @@ void infrared_signal_set_message(InfraredSignal* signal, const InfraredMessage*
 InfraredMessage* infrared_signal_get_message(InfraredSignal* signal);
 
 bool infrared_signal_save(InfraredSignal* signal, FlipperFormat* ff, const char* name);
+/* Raw timings are stored as a parsed message or a template when they transmit the same.
+ * Files holding templates must carry INFRARED_SIGNAL_FILE_VERSION_TEMPLATE. */
+bool infrared_signal_save_compact(InfraredSignal* signal, FlipperFormat* ff, const char* name);
+bool infrared_signal_is_compacted_to_template(InfraredSignal* signal);
 bool infrared_signal_read(InfraredSignal* signal, FlipperFormat* ff, FuriString* name);
 bool infrared_signal_search_and_read(
     InfraredSignal* signal,
@@ -6,6 +6,7 @@ typedef enum {
     SubmenuIndexMoveButton,
     SubmenuIndexDeleteButton,
     SubmenuIndexRenameRemote,
+    SubmenuIndexCompactRemote,
     SubmenuIndexDeleteRemote,
 } SubmenuIndex;
 
@@ -49,6 +50,12 @@ void infrared_scene_edit_on_enter(void* context) {
         SubmenuIndexRenameRemote,
         infrared_scene_edit_submenu_callback,
         context);
+    submenu_add_item(
+        submenu,
+        "Compact Remote",
+        SubmenuIndexCompactRemote,
+        infrared_scene_edit_submenu_callback,
+        context);
     submenu_add_item(
         submenu,
         "Delete Remote",
@@ -94,6 +101,11 @@ bool infrared_scene_edit_on_event(void* context, SceneManagerEvent event) {
             infrared->app_state.edit_mode = InfraredEditModeRename;
             scene_manager_next_scene(scene_manager, InfraredSceneEditRename);
             consumed = true;
+        } else if(submenu_index == SubmenuIndexCompactRemote) {
+            if(infrared_remote_store_compact(infrared->remote)) {
+                scene_manager_next_scene(scene_manager, InfraredSceneEditRenameDone);
+            }
+            consumed = true;
         } else if(submenu_index == SubmenuIndexDeleteRemote) {
             infrared->app_state.edit_target = InfraredEditTargetRemote;
             infrared->app_state.edit_mode = InfraredEditModeDelete;
@@ -41,7 +41,13 @@ static void nfc_scene_mf_classic_dict_attack_prepare_view(Nfc* nfc, DictAttackSt
 
     // Identify scene state
     if(state == DictAttackStateIdle) {
-        if(mf_classic_dict_check_presence(MfClassicDictTypeUser)) {
+        // Compiled dictionary has both user and system keys, so it is the only stage
+        dict = mf_classic_dict_alloc(MfClassicDictTypeCompiled);
+        if(dict) {
+            worker_state = NfcWorkerStateMfClassicDictAttack;
+            dict_attack_set_header(nfc->dict_attack, "MF Classic Dictionary");
+            state = DictAttackStateFlipperDictInProgress;
+        } else if(mf_classic_dict_check_presence(MfClassicDictTypeUser)) {
             state = DictAttackStateUserDictInProgress;
         } else {
             state = DictAttackStateFlipperDictInProgress;
@@ -62,7 +68,7 @@ static void nfc_scene_mf_classic_dict_attack_prepare_view(Nfc* nfc, DictAttackSt
             state = DictAttackStateFlipperDictInProgress;
         }
     }
-    if(state == DictAttackStateFlipperDictInProgress) {
+    if(state == DictAttackStateFlipperDictInProgress && !dict) {
         worker_state = NfcWorkerStateMfClassicDictAttack;
         dict_attack_set_header(nfc->dict_attack, "MF Classic System Dictionary");
         dict = mf_classic_dict_alloc(MfClassicDictTypeSystem);
@@ -9,6 +9,7 @@
 #include <lib/subghz/receiver.h>
 #include <lib/subghz/transmitter.h>
 #include <lib/subghz/subghz_file_encoder_worker.h>
+#include <lib/subghz/subghz_raw_binary.h>
 #include <lib/subghz/protocols/protocol_items.h>
 #include <applications/drivers/subghz/cc1101_ext/cc1101_ext_interconnect.h>
 #include <lib/subghz/devices/cc1101_int/cc1101_int_interconnect.h>
@@ -585,6 +586,8 @@ static void subghz_cli_command_print_usage() {
     printf("\trx <frequency:in Hz> <device: 0 - CC1101_INT, 1 - CC1101_EXT>\t - Receive\r\n");
     printf("\trx_raw <frequency:in Hz>\t - Receive RAW\r\n");
     printf("\tdecode_raw <file_name: path_RAW_file>\t - Testing\r\n");
+    printf(
+        "\tconvert_raw <path_RAW_file> <path_converted_file> <format: text, binary>\t - Convert RAW file format\r\n");
 
     if(furi_hal_rtc_is_flag_set(FuriHalRtcFlagDebug)) {
         printf("\r\n");
@@ -674,6 +677,53 @@ static void subghz_cli_command_encrypt_raw(Cli* cli, FuriString* args) {
     furi_string_free(source);
 }
 
+static void subghz_cli_command_convert_raw(Cli* cli, FuriString* args) {
+    UNUSED(cli);
+
+    FuriString* source = furi_string_alloc();
+    FuriString* destination = furi_string_alloc();
+    FuriString* format = furi_string_alloc();
+
+    do {
+        if(!args_read_string_and_trim(args, source) ||
+           !args_read_string_and_trim(args, destination) ||
+           !args_read_string_and_trim(args, format)) {
+            subghz_cli_command_print_usage();
+            break;
+        }
+
+        bool binary = furi_string_cmp_str(format, "binary") == 0;
+        if(!binary && furi_string_cmp_str(format, "text") != 0) {
+            subghz_cli_command_print_usage();
+            break;
+        }
+
+        Storage* storage = furi_record_open(RECORD_STORAGE);
+        uint32_t start = furi_get_tick();
+        bool result = subghz_raw_binary_convert(
+            storage, furi_string_get_cstr(source), furi_string_get_cstr(destination), binary);
+        uint32_t time = furi_get_tick() - start;
+        if(result) {
+            FileInfo source_info = {0};
+            FileInfo destination_info = {0};
+            storage_common_stat(storage, furi_string_get_cstr(source), &source_info);
+            storage_common_stat(storage, furi_string_get_cstr(destination), &destination_info);
+            printf(
+                "Converted %lub -> %lub in %lums\r\n",
+                (uint32_t)source_info.size,
+                (uint32_t)destination_info.size,
+                time);
+        } else {
+            printf("Failed to convert RAW file\r\n");
+        }
+        furi_record_close(RECORD_STORAGE);
+    } while(false);
+
+    furi_string_free(format);
+    furi_string_free(destination);
+    furi_string_free(source);
+}
+
 static void subghz_cli_command_chat(Cli* cli, FuriString* args, void* context) {
     UNUSED(context);
     uint32_t frequency = 433920000;
@@ -902,6 +952,11 @@ static void subghz_cli_command(Cli* cli, FuriString* args, void* context) {
             break;
         }
 
+        if(furi_string_cmp_str(cmd, "convert_raw") == 0) {
+            subghz_cli_command_convert_raw(cli, args);
+            break;
+        }
+
         if(furi_hal_rtc_is_flag_set(FuriHalRtcFlagDebug)) {
             if(furi_string_cmp_str(cmd, "encrypt_keeloq") == 0) {
                 subghz_cli_command_encrypt_keeloq(cli, args);
@@ -276,6 +276,28 @@ void cli_command_sysctl_heap_track(Cli* cli, FuriString* args, void* context) {
     }
 }
 
+void cli_command_sysctl_log_mode(Cli* cli, FuriString* args, void* context) {
+    UNUSED(cli);
+    UNUSED(context);
+    if(!furi_string_cmp(args, "sync")) {
+        furi_log_set_mode(FuriLogModeSync);
+        printf("Log records are printed by caller");
+    } else if(!furi_string_cmp(args, "deferred")) {
+        furi_log_set_mode(FuriLogModeDeferred);
+        printf("Log records are queued and printed by log worker");
+    } else if(furi_string_empty(args)) {
+        FuriLogStats stats;
+        furi_log_get_stats(&stats);
+        printf(
+            "Mode: %s, queued: %lu, dropped: %lu",
+            furi_log_get_mode() == FuriLogModeDeferred ? "deferred" : "sync",
+            stats.written,
+            stats.dropped);
+    } else {
+        cli_print_usage("sysctl log_mode", "<sync|deferred>", furi_string_get_cstr(args));
+    }
+}
+
 void cli_command_sysctl_print_usage() {
     printf("Usage:\r\n");
     printf("sysctl <cmd> <args>\r\n");
@@ -287,6 +309,7 @@ void cli_command_sysctl_print_usage() {
 #else
     printf("\theap_track <none|main>\t - Set heap allocation tracking mode\r\n");
 #endif
+    printf("\tlog_mode [sync|deferred]\t - Set or show log output mode\r\n");
 }
 
 void cli_command_sysctl(Cli* cli, FuriString* args, void* context) {
@@ -309,6 +332,11 @@ void cli_command_sysctl(Cli* cli, FuriString* args, void* context) {
             break;
         }
 
+        if(furi_string_cmp_str(cmd, "log_mode") == 0) {
+            cli_command_sysctl_log_mode(cli, args, context);
+            break;
+        }
+
         cli_command_sysctl_print_usage();
     } while(false);
 
@@ -428,6 +456,32 @@ void cli_command_free(Cli* cli, FuriString* args, void* context) {
 
     printf("Pool free: %zu\r\n", memmgr_pool_get_free());
     printf("Maximum pool block: %zu\r\n", memmgr_pool_get_max_block());
+
+    const size_t slab_classes = memmgr_heap_slab_get_class_count();
+    if(slab_classes) {
+        printf(
+            "%-6s %-8s %-8s %-8s %-6s %-10s %s\r\n",
+            "Slab",
+            "Objects",
+            "Peak",
+            "Capacity",
+            "Pages",
+            "Allocs",
+            "Fallbacks");
+    }
+    for(size_t i = 0; i < slab_classes; i++) {
+        MemmgrHeapSlabStats stats;
+        memmgr_heap_slab_get_stats(i, &stats);
+        printf(
+            "%-6zu %-8zu %-8zu %-8zu %-6zu %-10lu %lu\r\n",
+            stats.object_size,
+            stats.objects,
+            stats.objects_peak,
+            stats.capacity,
+            stats.pages,
+            stats.allocs,
+            stats.fallbacks);
+    }
 }
 
 void cli_command_free_blocks(Cli* cli, FuriString* args, void* context) {
@@ -438,6 +492,87 @@ void cli_command_free_blocks(Cli* cli, FuriString* args, void* context) {
     memmgr_heap_printf_free_blocks();
 }
 
+static void cli_command_heap_profile_info(const uint8_t* dump) {
+    MemmgrHeapProfileHeader header;
+    memcpy(&header, dump, sizeof(header));
+
+    printf(
+        "Profiling: %s, %lu s\r\n",
+        memmgr_heap_profile_is_running() ? "running" : "stopped",
+        (header.tick - header.start_tick) / furi_kernel_get_tick_frequency());
+    printf(
+        "Allocs: %lu, frees: %lu, untracked: %lu\r\n",
+        header.alloc_count,
+        header.free_count,
+        header.untracked_count);
+    printf("Live: %lu, peak: %lu\r\n", header.live, header.peak);
+    printf(
+        "Largest free block: %lu, worst: %lu\r\n",
+        header.max_free_block,
+        header.worst_max_free_block);
+    printf(
+        "Fragmentation: %lu/1000\r\n",
+        memmgr_heap_fragmentation_index(header.heap_free, header.max_free_block));
+
+    printf("%-12s %-8s %-8s %s\r\n", "Thread", "Allocs", "Live", "Peak");
+    const uint8_t* threads = dump + header.header_size +
+                             header.size_class_count * sizeof(uint32_t) +
+                             header.site_count * sizeof(MemmgrHeapProfileSite);
+    for(size_t i = 0; i < header.thread_count; i++) {
+        MemmgrHeapProfileThread thread;
+        memcpy(&thread, threads + i * sizeof(thread), sizeof(thread));
+        printf(
+            "%-12.*s %-8lu %-8lu %lu\r\n",
+            (int)sizeof(thread.name),
+            thread.name,
+            thread.count,
+            thread.live,
+            thread.peak);
+    }
+}
+
+/** Heap profile Command
+ *
+ * Arguments:
+ * - start - discard previous profile and start recording
+ * - stop - stop recording, keep profile
+ * - clear - stop recording and release profile
+ * - info - print profile summary
+ * - dump - print binary profile as hex, decode with scripts/heap_profile.py
+ */
+void cli_command_heap_profile(Cli* cli, FuriString* args, void* context) {
+    UNUSED(cli);
+    UNUSED(context);
+
+    if(!furi_string_cmp(args, "start")) {
+        memmgr_heap_profile_start();
+        printf("Heap profiling started");
+    } else if(!furi_string_cmp(args, "stop")) {
+        memmgr_heap_profile_stop();
+        printf("Heap profiling stopped");
+    } else if(!furi_string_cmp(args, "clear")) {
+        memmgr_heap_profile_clear();
+        printf("Heap profile cleared");
+    } else if(!furi_string_cmp(args, "info") || !furi_string_cmp(args, "dump")) {
+        size_t size;
+        uint8_t* dump = memmgr_heap_profile_dump(&size);
+        if(!dump) {
+            printf("No heap profile, start it first");
+        } else if(!furi_string_cmp(args, "info")) {
+            cli_command_heap_profile_info(dump);
+        } else {
+            for(size_t i = 0; i < size; i++) {
+                printf("%02X", dump[i]);
+                if(i % 32 == 31 || i == size - 1) printf("\r\n");
+            }
+        }
+        free(dump);
+    } else {
+        cli_print_usage(
+            "heap_profile", "<start|stop|clear|info|dump>", furi_string_get_cstr(args));
+    }
+}
+
 void cli_command_i2c(Cli* cli, FuriString* args, void* context) {
     UNUSED(cli);
     UNUSED(args);
@@ -479,6 +614,8 @@ void cli_commands_init(Cli* cli) {
     cli_add_command(cli, "ps", CliCommandFlagParallelSafe, cli_command_ps, NULL);
     cli_add_command(cli, "free", CliCommandFlagParallelSafe, cli_command_free, NULL);
     cli_add_command(cli, "free_blocks", CliCommandFlagParallelSafe, cli_command_free_blocks, NULL);
+    cli_add_command(
+        cli, "heap_profile", CliCommandFlagParallelSafe, cli_command_heap_profile, NULL);
 
     cli_add_command(cli, "vibro", CliCommandFlagDefault, cli_command_vibro, NULL);
     cli_add_command(cli, "led", CliCommandFlagDefault, cli_command_led, NULL);
@@ -8,6 +8,9 @@
 #include <u8g2_glue.h>
 #include <xtreme.h>
 
+/** Decoded icons cache budget, status bar, menu and animation icons are redrawn every frame */
+#define CANVAS_ICON_CACHE_BUDGET (4096u)
+
 const CanvasFontParameters canvas_font_params[FontTotalNumber] = {
     [FontPrimary] = {.leading_default = 12, .leading_min = 11, .height = 8, .descender = 2},
     [FontSecondary] = {.leading_default = 11, .leading_min = 9, .height = 7, .descender = 2},
@@ -23,6 +26,7 @@ const CanvasFontParameters canvas_font_params[FontTotalNumber] = {
 Canvas* canvas_init() {
     Canvas* canvas = malloc(sizeof(Canvas));
     canvas->compress_icon = compress_icon_alloc();
+    compress_icon_set_cache_budget(canvas->compress_icon, CANVAS_ICON_CACHE_BUDGET);
 
     // Setup u8g2
     u8g2_Setup_st756x_flipper(&canvas->fb, U8G2_R0, u8x8_hw_spi_stm32, u8g2_gpio_and_delay_stm32);
@@ -33,6 +37,7 @@ Canvas* canvas_init() {
     u8g2_SetPowerSave(&canvas->fb, 0);
 
     // Clear buffer and send to device
+    canvas->committed = malloc(canvas_get_buffer_size(canvas));
     canvas_clear(canvas);
     canvas_commit(canvas);
 
@@ -42,6 +47,7 @@ Canvas* canvas_init() {
 void canvas_free(Canvas* canvas) {
     furi_assert(canvas);
     compress_icon_free(canvas->compress_icon);
+    free(canvas->committed);
     free(canvas);
 }
 
@@ -57,7 +63,37 @@ void canvas_reset(Canvas* canvas) {
 
 void canvas_commit(Canvas* canvas) {
     furi_assert(canvas);
-    u8g2_SendBuffer(&canvas->fb);
+    uint8_t* buffer = u8g2_GetBufferPtr(&canvas->fb);
+    const uint8_t tile_width = u8g2_GetBufferTileWidth(&canvas->fb);
+    const uint8_t pages = u8g2_GetBufferTileHeight(&canvas->fb);
+    const size_t page_size = tile_width * 8;
+
+    // Display keeps its RAM, pages equal to the last commit are not sent
+    canvas->committed_pages = 0;
+    for(uint8_t page = 0; page < pages; page++) {
+        uint8_t* data = buffer + page * page_size;
+        uint8_t* committed = canvas->committed + page * page_size;
+        if(!canvas->committed_valid || memcmp(data, committed, page_size) != 0) {
+            memcpy(committed, data, page_size);
+            canvas->committed_pages |= 1 << page;
+        }
+    }
+    canvas->committed_valid = true;
+
+    uint8_t page = 0;
+    while(page < pages) {
+        if(!(canvas->committed_pages & (1 << page))) {
+            page++;
+            continue;
+        }
+        uint8_t count = 1;
+        while(page + count < pages && (canvas->committed_pages & (1 << (page + count)))) {
+            count++;
+        }
+        u8g2_UpdateDisplayArea(&canvas->fb, 0, page, tile_width, count);
+        page += count;
+    }
+    if(canvas->committed_pages) u8x8_RefreshDisplay(u8g2_GetU8x8(&canvas->fb));
 }
 
 uint8_t* canvas_get_buffer(Canvas* canvas) {
@@ -83,6 +119,49 @@ void canvas_frame_set(
     canvas->height = height;
 }
 
+void canvas_set_region(Canvas* canvas, uint8_t x, uint8_t y, uint8_t width, uint8_t height) {
+    furi_assert(canvas);
+    furi_assert(canvas->orientation == CanvasOrientationHorizontal);
+    u8g2_SetClipWindow(&canvas->fb, x, y, x + width, y + height);
+    canvas->region = true;
+    canvas->region_x0 = x;
+    canvas->region_y0 = y;
+    canvas->region_x1 = x + width;
+    canvas->region_y1 = y + height;
+}
+
+bool canvas_region_is_kept(Canvas* canvas) {
+    furi_assert(canvas);
+    if(!canvas->region || !canvas->committed_valid) return false;
+
+    uint8_t* buffer = u8g2_GetBufferPtr(&canvas->fb);
+    const uint8_t tile_width = u8g2_GetBufferTileWidth(&canvas->fb);
+    const uint8_t pages = u8g2_GetBufferTileHeight(&canvas->fb);
+    const size_t page_size = tile_width * 8;
+
+    for(uint8_t page = 0; page < pages; page++) {
+        // Rows of the page inside of the region, bit per row
+        uint8_t rows = 0;
+        for(uint8_t bit = 0; bit < 8; bit++) {
+            uint8_t y = page * 8 + bit;
+            if(y >= canvas->region_y0 && y < canvas->region_y1) rows |= 1 << bit;
+        }
+        for(size_t x = 0; x < page_size; x++) {
+            uint8_t allowed = (x >= canvas->region_x0 && x < canvas->region_x1) ? rows : 0;
+            size_t i = page * page_size + x;
+            if((buffer[i] ^ canvas->committed[i]) & ~allowed) return false;
+        }
+    }
+
+    return true;
+}
+
+void canvas_reset_region(Canvas* canvas) {
+    furi_assert(canvas);
+    u8g2_SetMaxClipWindow(&canvas->fb);
+    canvas->region = false;
+}
+
 uint8_t canvas_width(const Canvas* canvas) {
     furi_assert(canvas);
     return canvas->width;
@@ -117,7 +196,18 @@ const CanvasFontParameters* canvas_get_font_params(const Canvas* canvas, Font fo
 
 void canvas_clear(Canvas* canvas) {
     furi_assert(canvas);
-    if(xtreme_settings.dark_mode) {
+    if(canvas->region) {
+        // Clip window keeps the box inside of the region
+        uint8_t color = canvas->fb.draw_color;
+        canvas->fb.draw_color = xtreme_settings.dark_mode ? 1 : 0;
+        u8g2_DrawBox(
+            &canvas->fb,
+            0,
+            0,
+            u8g2_GetDisplayWidth(&canvas->fb),
+            u8g2_GetDisplayHeight(&canvas->fb));
+        canvas->fb.draw_color = color;
+    } else if(xtreme_settings.dark_mode) {
         u8g2_FillBuffer(&canvas->fb);
     } else {
         u8g2_ClearBuffer(&canvas->fb);
@@ -359,6 +449,165 @@ static void canvas_draw_u8g2_bitmap_int(
     }
 }
 
+/** Apply up to 8 vertical pixels to the tile buffer
+ *
+ * Bit 0 of bits is the pixel at row, pixels outside of mask are not touched.
+ * Works like u8g2_DrawHVLine for every pixel: clip window, draw color and
+ * bitmap transparency are respected.
+ */
+static inline void canvas_blit_column_int(
+    u8g2_t* u8g2,
+    u8g2_uint_t x,
+    int16_t row,
+    uint8_t bits,
+    uint8_t mask) {
+    int16_t lo = u8g2->user_y0 - row;
+    int16_t hi = u8g2->user_y1 - row;
+    if(hi <= 0 || lo >= 8 || hi <= lo) return;
+    if(lo > 0) mask &= 0xFF << lo;
+    if(hi < 8) mask &= 0xFF >> (8 - hi);
+    if(mask == 0) return;
+
+    uint8_t fg = bits & mask;
+    uint8_t bg = u8g2->bitmap_transparency ? 0 : mask & ~bits;
+    uint8_t set, clear, toggle;
+    if(u8g2->draw_color == 1) {
+        set = fg;
+        clear = bg;
+        toggle = 0;
+    } else if(u8g2->draw_color == 0) {
+        set = bg;
+        clear = fg;
+        toggle = 0;
+    } else {
+        set = 0;
+        clear = bg;
+        toggle = fg;
+    }
+
+    row -= u8g2->pixel_curr_row;
+    uint8_t shift = row & 7;
+    int16_t page = (row - shift) / 8;
+    uint8_t* ptr = u8g2->tile_buf_ptr + x;
+
+    uint16_t set_w = (uint16_t)set << shift;
+    uint16_t clear_w = (uint16_t)clear << shift;
+    uint16_t toggle_w = (uint16_t)toggle << shift;
+    if(page >= 0 && ((set_w | clear_w | toggle_w) & 0xFF)) {
+        uint8_t* p = ptr + page * u8g2->pixel_buf_width;
+        *p = ((*p | (uint8_t)set_w) & ~(uint8_t)clear_w) ^ (uint8_t)toggle_w;
+    }
+    if((set_w | clear_w | toggle_w) >> 8) {
+        uint8_t* p = ptr + (page + 1) * u8g2->pixel_buf_width;
+        *p = ((*p | (set_w >> 8)) & ~(clear_w >> 8)) ^ (toggle_w >> 8);
+    }
+}
+
+/** Apply up to 8 vertical pixels, rows wrap around like u8g2_uint_t coordinates */
+static inline void canvas_blit_column(
+    u8g2_t* u8g2,
+    u8g2_uint_t x,
+    u8g2_uint_t row,
+    uint8_t bits,
+    uint8_t mask) {
+    if(x < u8g2->user_x0 || x >= u8g2->user_x1) return;
+    canvas_blit_column_int(u8g2, x, row, bits, mask);
+    if(row > 248) canvas_blit_column_int(u8g2, x, (int16_t)row - 256, bits, mask);
+}
+
+/** Transpose 8x8 bit matrix, byte n bit m becomes byte m bit n */
+static inline uint64_t canvas_blit_transpose(uint64_t v) {
+    uint64_t t;
+    t = (v ^ (v >> 7)) & 0x00AA00AA00AA00AAULL;
+    v = v ^ t ^ (t << 7);
+    t = (v ^ (v >> 14)) & 0x0000CCCC0000CCCCULL;
+    v = v ^ t ^ (t << 14);
+    t = (v ^ (v >> 28)) & 0x00000000F0F0F0F0ULL;
+    v = v ^ t ^ (t << 28);
+    return v;
+}
+
+static inline uint8_t canvas_blit_reverse(uint8_t v) {
+    v = (v & 0xF0) >> 4 | (v & 0x0F) << 4;
+    v = (v & 0xCC) >> 2 | (v & 0x33) << 2;
+    v = (v & 0xAA) >> 1 | (v & 0x55) << 1;
+    return v;
+}
+
+/** Draw bitmap rows as tile buffer columns: bitmap bytes are already vertical */
+static void canvas_blit_rows_as_columns(
+    u8g2_t* u8g2,
+    u8g2_uint_t x,
+    u8g2_uint_t y,
+    u8g2_uint_t w,
+    u8g2_uint_t h,
+    bool backward,
+    const uint8_t* bitmap) {
+    const uint8_t blen = (w + 7) / 8;
+    const uint8_t last_mask = (w & 7) ? (0xFF >> (8 - (w & 7))) : 0xFF;
+
+    for(uint8_t j = 0; j < h; j++) {
+        u8g2_uint_t column = backward ? x - j : x + j;
+        if(column >= u8g2->user_x0 && column < u8g2->user_x1) {
+            u8g2_uint_t row = y;
+            for(uint8_t b = 0; b < blen; b++) {
+                uint8_t mask = (b == blen - 1) ? last_mask : 0xFF;
+                canvas_blit_column(u8g2, column, row, bitmap[b], mask);
+                row += 8;
+            }
+        }
+        bitmap += blen;
+    }
+}
+
+/** Draw bitmap columns as tile buffer columns, transposing 8x8 blocks */
+static void canvas_blit_columns(
+    u8g2_t* u8g2,
+    u8g2_uint_t x,
+    u8g2_uint_t y,
+    u8g2_uint_t w,
+    u8g2_uint_t h,
+    bool flip,
+    const uint8_t* bitmap) {
+    const uint8_t blen = (w + 7) / 8;
+
+    for(uint16_t j = 0; j < h; j += 8) {
+        uint8_t rows = MIN(h - j, 8);
+        uint8_t mask = 0xFF >> (8 - rows);
+        u8g2_uint_t row = y + j;
+        if(flip) {
+            mask = canvas_blit_reverse(mask);
+            row = y + h - 8 - j;
+        }
+
+        for(uint8_t b = 0; b < blen; b++) {
+            uint8_t columns = MIN(w - b * 8, 8);
+            u8g2_uint_t column = x + b * 8;
+            bool visible = false;
+            for(uint8_t i = 0; i < columns; i++) {
+                u8g2_uint_t c = column + i;
+                if(c >= u8g2->user_x0 && c < u8g2->user_x1) {
+                    visible = true;
+                    break;
+                }
+            }
+            if(!visible) continue;
+
+            uint64_t block = 0;
+            for(uint8_t k = 0; k < rows; k++) {
+                block |= (uint64_t)bitmap[(j + k) * blen + b] << (k * 8);
+            }
+            block = canvas_blit_transpose(block);
+
+            for(uint8_t i = 0; i < columns; i++) {
+                uint8_t bits = block >> (i * 8);
+                if(flip) bits = canvas_blit_reverse(bits);
+                canvas_blit_column(u8g2, column + i, row, bits, mask);
+            }
+        }
+    }
+}
+
 void canvas_draw_u8g2_bitmap(
     u8g2_t* u8g2,
     u8g2_uint_t x,
@@ -375,6 +624,28 @@ void canvas_draw_u8g2_bitmap(
     if(u8g2_IsIntersection(u8g2, x, y, x + w, y + h) == 0) return;
 #endif /* U8G2_WITH_INTERSECTION */
 
+    // Tile buffer is written directly unless display is rotated
+    if(u8g2->cb == U8G2_R0 && u8g2->ll_hvline == u8g2_ll_hvline_vertical_top_lsb) {
+        if(u8g2->is_page_clip_window_intersection == 0) return;
+        switch(rotation) {
+        case IconRotation0:
+            canvas_blit_columns(u8g2, x, y, w, h, false, bitmap);
+            break;
+        case IconRotation90:
+            canvas_blit_rows_as_columns(u8g2, x + w + 1, y, w, h, true, bitmap);
+            break;
+        case IconRotation180:
+            canvas_blit_columns(u8g2, x, y, w, h, true, bitmap);
+            break;
+        case IconRotation270:
+            canvas_blit_rows_as_columns(u8g2, x, y, w, h, false, bitmap);
+            break;
+        default:
+            break;
+        }
+        return;
+    }
+
     switch(rotation) {
     case IconRotation0:
         canvas_draw_u8g2_bitmap_int(u8g2, x, y, w, h, 0, 0, bitmap);
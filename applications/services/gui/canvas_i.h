@@ -23,6 +23,14 @@ struct Canvas {
     uint8_t width;
     uint8_t height;
     CompressIcon* compress_icon;
+    bool region;
+    uint8_t region_x0;
+    uint8_t region_y0;
+    uint8_t region_x1; /**< Exclusive */
+    uint8_t region_y1; /**< Exclusive */
+    uint8_t* committed; /**< Display content, only changed pages are sent on commit */
+    bool committed_valid;
+    uint8_t committed_pages; /**< Pages sent by last commit, bit per page */
 };
 
 /** Allocate memory and initialize canvas
@@ -68,6 +76,36 @@ void canvas_frame_set(
     uint8_t width,
     uint8_t height);
 
+/** Limit drawing to region, everything outside of it is kept as is
+ *
+ * Used for partial redraws: canvas_clear clears only the region. Region is in
+ * screen coordinates, so canvas orientation must stay horizontal.
+ *
+ * @param      canvas  Canvas instance
+ * @param      x       x coordinate
+ * @param      y       y coordinate
+ * @param      width   width
+ * @param      height  height
+ */
+void canvas_set_region(Canvas* canvas, uint8_t x, uint8_t y, uint8_t width, uint8_t height);
+
+/** Check that nothing outside of the region changed since last commit
+ *
+ * Drawing that writes to the frame buffer directly is not clipped, partial
+ * redraw must be redone in full when this returns false.
+ *
+ * @param      canvas  Canvas instance
+ *
+ * @return     true if only the region changed
+ */
+bool canvas_region_is_kept(Canvas* canvas);
+
+/** Remove region limit set with canvas_set_region
+ *
+ * @param      canvas  Canvas instance
+ */
+void canvas_reset_region(Canvas* canvas);
+
 /** Set canvas orientation
  *
  * @param      canvas       Canvas instance
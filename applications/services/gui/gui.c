@@ -3,6 +3,8 @@
 #include <assets_icons.h>
 #include <storage/storage.h>
 #include <storage/storage_i.h>
+#include <cli/cli.h>
+#include <lib/toolbox/args.h>
 
 #define TAG "GuiSrv"
 
@@ -42,6 +44,33 @@ size_t gui_active_view_port_count(Gui* gui, GuiLayer layer) {
 
 void gui_update(Gui* gui) {
     furi_assert(gui);
+    // Called from draw callbacks too, gui lock is already taken there
+    FURI_CRITICAL_ENTER();
+    gui->damage.full = true;
+    FURI_CRITICAL_EXIT();
+    if(!gui->direct_draw) furi_thread_flags_set(gui->thread_id, GUI_THREAD_FLAG_DRAW);
+}
+
+void gui_update_region(Gui* gui, uint8_t x, uint8_t y, uint8_t width, uint8_t height) {
+    furi_assert(gui);
+    if(!width || !height || x >= GUI_DISPLAY_WIDTH || y >= GUI_DISPLAY_HEIGHT) return;
+    uint8_t x1 = MIN(x + width, GUI_DISPLAY_WIDTH);
+    uint8_t y1 = MIN(y + height, GUI_DISPLAY_HEIGHT);
+
+    FURI_CRITICAL_ENTER();
+    GuiDamage* damage = &gui->damage;
+    if(damage->x1 == 0) {
+        damage->x0 = x;
+        damage->y0 = y;
+        damage->x1 = x1;
+        damage->y1 = y1;
+    } else {
+        damage->x0 = MIN(damage->x0, x);
+        damage->y0 = MIN(damage->y0, y);
+        damage->x1 = MAX(damage->x1, x1);
+        damage->y1 = MAX(damage->y1, y1);
+    }
+    FURI_CRITICAL_EXIT();
     if(!gui->direct_draw) furi_thread_flags_set(gui->thread_id, GUI_THREAD_FLAG_DRAW);
 }
 
@@ -267,6 +296,47 @@ static bool gui_redraw_desktop(Gui* gui) {
     return false;
 }
 
+// Region is in screen coordinates, it can't be used if anything is drawn rotated
+static bool gui_redraw_region_allowed(Gui* gui) {
+    if(furi_hal_rtc_is_flag_set(FuriHalRtcFlagHandOrient)) return false;
+
+    for(size_t i = 0; i < GuiLayerMAX; i++) {
+        ViewPortArray_it_t it;
+        ViewPortArray_it(it, gui->layers[i]);
+        while(!ViewPortArray_end_p(it)) {
+            ViewPort* view_port = *ViewPortArray_ref(it);
+            if(view_port_is_enabled(view_port) &&
+               view_port_get_orientation(view_port) != ViewPortOrientationHorizontal) {
+                return false;
+            }
+            ViewPortArray_next(it);
+        }
+    }
+
+    return true;
+}
+
+static void gui_redraw_layers(Gui* gui) {
+    canvas_reset(gui->canvas);
+
+    if(gui->lockdown) {
+        gui_redraw_desktop(gui);
+        bool need_attention =
+            (gui_view_port_find_enabled(gui->layers[GuiLayerWindow]) != 0 ||
+             gui_view_port_find_enabled(gui->layers[GuiLayerFullscreen]) != 0);
+        if(xtreme_settings.lockscreen_statusbar) {
+            gui_redraw_status_bar(gui, need_attention);
+        }
+    } else {
+        if(!gui_redraw_fs(gui)) {
+            if(!gui_redraw_window(gui)) {
+                gui_redraw_desktop(gui);
+            }
+            gui_redraw_status_bar(gui, false);
+        }
+    }
+}
+
 static void gui_redraw(Gui* gui) {
     furi_assert(gui);
     gui_lock(gui);
@@ -274,34 +344,66 @@ static void gui_redraw(Gui* gui) {
     do {
         if(gui->direct_draw) break;
 
-        canvas_reset(gui->canvas);
+        GuiDamage damage;
+        FURI_CRITICAL_ENTER();
+        damage = gui->damage;
+        memset(&gui->damage, 0, sizeof(GuiDamage));
+        FURI_CRITICAL_EXIT();
+        if(!damage.full && damage.x1 == 0) break;
+
+        uint32_t frame_start = DWT->CYCCNT;
+        bool partial = !damage.full &&
+                       (damage.x1 - damage.x0) * (damage.y1 - damage.y0) <
+                           GUI_DISPLAY_WIDTH * GUI_DISPLAY_HEIGHT &&
+                       gui_redraw_region_allowed(gui);
+        if(partial) {
+            canvas_set_orientation(gui->canvas, CanvasOrientationHorizontal);
+            canvas_set_region(
+                gui->canvas,
+                damage.x0,
+                damage.y0,
+                damage.x1 - damage.x0,
+                damage.y1 - damage.y0);
+        }
 
-        if(gui->lockdown) {
-            gui_redraw_desktop(gui);
-            bool need_attention =
-                (gui_view_port_find_enabled(gui->layers[GuiLayerWindow]) != 0 ||
-                 gui_view_port_find_enabled(gui->layers[GuiLayerFullscreen]) != 0);
-            if(xtreme_settings.lockscreen_statusbar) {
-                gui_redraw_status_bar(gui, need_attention);
-            }
-        } else {
-            if(!gui_redraw_fs(gui)) {
-                if(!gui_redraw_window(gui)) {
-                    gui_redraw_desktop(gui);
-                }
-                gui_redraw_status_bar(gui, false);
-            }
+        gui_redraw_layers(gui);
+
+        if(partial && !canvas_region_is_kept(gui->canvas)) {
+            // Some view port wrote to the frame buffer directly, past the clip
+            canvas_reset_region(gui->canvas);
+            partial = false;
+            gui_redraw_layers(gui);
         }
 
         canvas_commit(gui->canvas);
-        for
-            M_EACH(p, gui->canvas_callback_pair, CanvasCallbackPairArray_t) {
-                p->callback(
-                    canvas_get_buffer(gui->canvas),
-                    canvas_get_buffer_size(gui->canvas),
-                    canvas_get_orientation(gui->canvas),
-                    p->context);
-            }
+        if(partial) canvas_reset_region(gui->canvas);
+
+        // Framebuffer callbacks only get frames that differ from the previous one
+        CanvasOrientation orientation = canvas_get_orientation(gui->canvas);
+        if(gui->canvas->committed_pages || gui->canvas_callback_pending ||
+           gui->canvas_callback_orientation != orientation) {
+            gui->canvas_callback_pending = false;
+            gui->canvas_callback_orientation = orientation;
+            for
+                M_EACH(p, gui->canvas_callback_pair, CanvasCallbackPairArray_t) {
+                    p->callback(
+                        canvas_get_buffer(gui->canvas),
+                        canvas_get_buffer_size(gui->canvas),
+                        orientation,
+                        p->context);
+                }
+        }
+
+        uint32_t frame_time =
+            (DWT->CYCCNT - frame_start) / furi_hal_cortex_instructions_per_microsecond();
+        GuiStats* stats = &gui->stats;
+        stats->frames++;
+        if(partial) stats->partial_frames++;
+        if(!gui->canvas->committed_pages) stats->idle_frames++;
+        stats->frame_time_us += frame_time;
+        stats->frame_time_max_us = MAX(stats->frame_time_max_us, frame_time);
+        stats->bytes_sent += __builtin_popcount(gui->canvas->committed_pages) * GUI_DISPLAY_WIDTH;
+        stats->bytes_total += canvas_get_buffer_size(gui->canvas);
     } while(false);
 
     gui_unlock(gui);
@@ -408,7 +510,7 @@ void gui_add_view_port(Gui* gui, ViewPort* view_port, GuiLayer layer) {
     }
     // Add view port and link with gui
     ViewPortArray_push_back(gui->layers[layer], view_port);
-    view_port_gui_set(view_port, gui);
+    view_port_gui_set(view_port, gui, layer);
     gui_unlock(gui);
 
     // Request redraw
@@ -420,7 +522,7 @@ void gui_remove_view_port(Gui* gui, ViewPort* view_port) {
     furi_assert(view_port);
 
     gui_lock(gui);
-    view_port_gui_set(view_port, NULL);
+    view_port_gui_set(view_port, NULL, GuiLayerMAX);
     ViewPortArray_it_t it;
     for(size_t i = 0; i < GuiLayerMAX; i++) {
         ViewPortArray_it(it, gui->layers[i]);
@@ -507,6 +609,7 @@ void gui_add_framebuffer_callback(Gui* gui, GuiCanvasCommitCallback callback, vo
     gui_lock(gui);
     furi_assert(!CanvasCallbackPairArray_count(gui->canvas_callback_pair, p));
     CanvasCallbackPairArray_push_back(gui->canvas_callback_pair, p);
+    gui->canvas_callback_pending = true;
     gui_unlock(gui);
 
     // Request redraw
@@ -609,12 +712,109 @@ Gui* gui_alloc() {
     return gui;
 }
 
+static void gui_cli_icon_cache(Cli* cli, FuriString* args, void* context) {
+    UNUSED(cli);
+    Gui* gui = context;
+    FuriString* cmd = furi_string_alloc();
+    int budget = 0;
+
+    do {
+        if(!args_read_string_and_trim(args, cmd) || furi_string_cmp_str(cmd, "stats") == 0) {
+            CompressIconCacheStats stats;
+            compress_icon_get_cache_stats(gui->canvas->compress_icon, &stats);
+            uint32_t lookups = stats.hits + stats.misses;
+            printf(
+                "Hits: %lu, misses: %lu, hit rate: %lu%%\r\n",
+                stats.hits,
+                stats.misses,
+                lookups ? stats.hits * 100 / lookups : 0);
+            printf(
+                "Decodes: %lu, decode time: %luus, avg %luus\r\n",
+                stats.decodes,
+                stats.decode_time_us,
+                stats.decodes ? stats.decode_time_us / stats.decodes : 0);
+            printf("Bypassed: %lu, evictions: %lu\r\n", stats.bypassed, stats.evictions);
+            printf(
+                "Entries: %lu, used: %zu of %zu bytes\r\n",
+                stats.entries,
+                stats.used,
+                stats.budget);
+            break;
+        }
+
+        if(furi_string_cmp_str(cmd, "reset") == 0) {
+            compress_icon_reset_cache_stats(gui->canvas->compress_icon);
+            break;
+        }
+
+        bool is_clear = furi_string_cmp_str(cmd, "clear") == 0;
+        bool is_budget = furi_string_cmp_str(cmd, "budget") == 0 &&
+                         args_read_int_and_trim(args, &budget) && budget >= 0;
+        if(!is_clear && !is_budget) {
+            printf("Usage: icon_cache [stats|reset|clear|budget <bytes>]\r\n");
+            break;
+        }
+
+        // Entries are touched by the drawing thread only under the lock
+        gui_lock(gui);
+        if(gui->direct_draw) {
+            printf("Canvas is used by direct draw, try again later\r\n");
+        } else if(is_clear) {
+            compress_icon_cache_clear(gui->canvas->compress_icon);
+        } else {
+            compress_icon_set_cache_budget(gui->canvas->compress_icon, budget);
+        }
+        gui_unlock(gui);
+    } while(false);
+
+    furi_string_free(cmd);
+}
+
+static void gui_cli_stats(Cli* cli, FuriString* args, void* context) {
+    UNUSED(cli);
+    Gui* gui = context;
+    FuriString* cmd = furi_string_alloc();
+
+    gui_lock(gui);
+    if(args_read_string_and_trim(args, cmd) && furi_string_cmp_str(cmd, "reset") == 0) {
+        memset(&gui->stats, 0, sizeof(GuiStats));
+    } else {
+        GuiStats* stats = &gui->stats;
+        uint64_t sent_percent = stats->bytes_sent * 100ULL;
+        if(stats->bytes_total) sent_percent /= stats->bytes_total;
+        printf(
+            "Frames: %lu, partial: %lu, idle: %lu\r\n",
+            stats->frames,
+            stats->partial_frames,
+            stats->idle_frames);
+        printf(
+            "Frame time: avg %luus, max %luus\r\n",
+            stats->frames ? stats->frame_time_us / stats->frames : 0,
+            stats->frame_time_max_us);
+        printf(
+            "Display: %lu of %lu bytes sent (%lu%%)\r\n",
+            stats->bytes_sent,
+            stats->bytes_total,
+            (uint32_t)sent_percent);
+    }
+    gui_unlock(gui);
+
+    furi_string_free(cmd);
+}
+
 int32_t gui_srv(void* p) {
     UNUSED(p);
     Gui* gui = gui_alloc();
 
     furi_record_create(RECORD_GUI, gui);
 
+#ifdef SRV_CLI
+    Cli* cli = furi_record_open(RECORD_CLI);
+    cli_add_command(cli, "icon_cache", CliCommandFlagParallelSafe, gui_cli_icon_cache, gui);
+    cli_add_command(cli, "gui_stats", CliCommandFlagParallelSafe, gui_cli_stats, gui);
+    furi_record_close(RECORD_CLI);
+#endif
+
     while(1) {
         uint32_t flags =
             furi_thread_flags_wait(GUI_THREAD_FLAG_ALL, FuriFlagWaitAny, FuriWaitForever);
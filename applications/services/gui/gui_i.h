@@ -55,6 +55,26 @@ ARRAY_DEF(CanvasCallbackPairArray, CanvasCallbackPair, M_POD_OPLIST);
 
 ALGO_DEF(CanvasCallbackPairArray, CanvasCallbackPairArray_t);
 
+/** Screen area to redraw, accumulated between redraws */
+typedef struct {
+    bool full; /**< Whole screen */
+    uint8_t x0;
+    uint8_t y0;
+    uint8_t x1; /**< Exclusive, 0 if no region is damaged */
+    uint8_t y1; /**< Exclusive */
+} GuiDamage;
+
+/** Redraw statistics */
+typedef struct {
+    uint32_t frames;
+    uint32_t partial_frames; /**< Redrawn only in damaged region */
+    uint32_t idle_frames; /**< Nothing changed on display */
+    uint32_t frame_time_us; /**< Total time of redraws */
+    uint32_t frame_time_max_us;
+    uint32_t bytes_sent; /**< Sent to display */
+    uint32_t bytes_total; /**< Would be sent without page tracking */
+} GuiStats;
+
 /** Gui structure */
 struct Gui {
     // Thread and lock
@@ -67,6 +87,10 @@ struct Gui {
     ViewPortArray_t layers[GuiLayerMAX];
     Canvas* canvas;
     CanvasCallbackPairArray_t canvas_callback_pair;
+    bool canvas_callback_pending; /**< Call framebuffer callbacks even if nothing changed */
+    CanvasOrientation canvas_callback_orientation;
+    GuiDamage damage;
+    GuiStats stats;
 
     // Input
     FuriMessageQueue* input_queue;
@@ -91,6 +115,19 @@ ViewPort* gui_view_port_find_enabled(ViewPortArray_t array);
  */
 void gui_update(Gui* gui);
 
+/** Update GUI, request redraw of screen region
+ *
+ * Everything in the region is redrawn, the rest of the screen is kept if
+ * nothing else requested redraw.
+ *
+ * @param      gui     Gui instance
+ * @param      x       x coordinate on screen
+ * @param      y       y coordinate on screen
+ * @param      width   width
+ * @param      height  height
+ */
+void gui_update_region(Gui* gui, uint8_t x, uint8_t y, uint8_t width, uint8_t height);
+
 /** Input event callback
  * 
  * Used to receive input from input service or to inject new input events
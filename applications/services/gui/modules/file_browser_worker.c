@@ -4,9 +4,11 @@
 #include <storage/storage.h>
 
 #include <toolbox/path.h>
+#include <toolbox/crc32_calc.h>
 #include <core/check.h>
 #include <core/common_defines.h>
 #include <furi.h>
+#include <xtreme.h>
 
 #include <m-array.h>
 #include <stdbool.h>
@@ -18,6 +20,8 @@
 #define BROWSER_ROOT STORAGE_ANY_PATH_PREFIX
 #define FILE_NAME_LEN_MAX 254
 #define LONG_LOAD_THRESHOLD 100
+#define LISTING_CHUNK_SIZE 1024
+#define LISTING_HEAP_RESERVE (16 * 1024)
 
 typedef enum {
     WorkerEvtStop = (1 << 0),
@@ -34,6 +38,33 @@ typedef enum {
 
 ARRAY_DEF(_idx_last_array, int32_t) // Unused, kept for compatibility
 
+typedef struct {
+    const char* name;
+    bool is_folder;
+} BrowserListingItem;
+
+ARRAY_DEF(BrowserListingItemArray, BrowserListingItem, M_POD_OPLIST)
+ARRAY_DEF(BrowserListingChunkArray, char*, M_PTR_OPLIST)
+
+/*
+ * Filtered and sorted names of the current folder, read once per visit.
+ * Names are kept in fixed chunks, so item pointers stay valid while the listing grows.
+ * It grows as long as the heap allows, leaving LISTING_HEAP_RESERVE to the rest of the system.
+ * After a write to the storage the folder is scanned again, the listing is stale only if
+ * the names in the folder changed.
+ */
+typedef struct {
+    FuriString* path;
+    BrowserListingItemArray_t items;
+    BrowserListingChunkArray_t chunks;
+    size_t chunk_used;
+    uint32_t storage_timestamp;
+    uint32_t folder_hash; /**< CRC32 of the filtered names in directory order */
+    bool valid;
+    FuriString* sort_key_a;
+    FuriString* sort_key_b;
+} BrowserListing;
+
 struct BrowserWorker {
     FuriThread* thread;
 
@@ -46,6 +77,7 @@ struct BrowserWorker {
     uint32_t load_count;
     bool skip_assets;
     bool hide_dot_files;
+    bool hide_ext;
     _idx_last_array_t _idx_last; // Unused, kept for compatibility
 
     void* cb_ctx;
@@ -55,6 +87,8 @@ struct BrowserWorker {
     BrowserWorkerLongLoadCallback long_load_cb;
 
     bool keep_selection;
+
+    BrowserListing listing;
 };
 
 static bool browser_path_is_file(FuriString* path) {
@@ -109,6 +143,159 @@ static bool browser_filter_by_name(BrowserWorker* browser, FuriString* name, boo
     return false;
 }
 
+static void browser_listing_reset(BrowserListing* listing) {
+    BrowserListingItemArray_reset(listing->items);
+    for
+        M_EACH(chunk, listing->chunks, BrowserListingChunkArray_t) {
+            free(*chunk);
+        }
+    BrowserListingChunkArray_reset(listing->chunks);
+    listing->chunk_used = LISTING_CHUNK_SIZE;
+    listing->valid = false;
+}
+
+static bool browser_listing_add(BrowserListing* listing, const char* name, bool is_folder) {
+    size_t name_size = strlen(name) + 1;
+    bool new_chunk = listing->chunk_used + name_size > LISTING_CHUNK_SIZE;
+
+    // Growing the item array holds the old and the new copy at once
+    size_t heap_needed = LISTING_HEAP_RESERVE + (new_chunk ? LISTING_CHUNK_SIZE : 0) +
+                         2 * BrowserListingItemArray_size(listing->items) *
+                             sizeof(BrowserListingItem);
+    if(memmgr_get_free_heap() < heap_needed) {
+        return false;
+    }
+
+    if(new_chunk) {
+        BrowserListingChunkArray_push_back(listing->chunks, malloc(LISTING_CHUNK_SIZE));
+        listing->chunk_used = 0;
+    }
+
+    char* chunk = *BrowserListingChunkArray_back(listing->chunks);
+    char* name_copy = chunk + listing->chunk_used;
+    memcpy(name_copy, name, name_size);
+    listing->chunk_used += name_size;
+
+    BrowserListingItemArray_push_back(
+        listing->items, (BrowserListingItem){.name = name_copy, .is_folder = is_folder});
+    return true;
+}
+
+// Item name as the browser views display it
+static void browser_listing_item_key(
+    FuriString* key,
+    const BrowserListingItem* item,
+    bool hide_ext) {
+    furi_string_set_str(key, item->name);
+    if(hide_ext && !item->is_folder) {
+        size_t dot = furi_string_search_rchar(key, '.');
+        if(dot > 0) {
+            furi_string_left(key, dot);
+        }
+    }
+}
+
+// Same order and same key as the browser views sort with
+static int browser_listing_item_cmp(
+    BrowserListing* listing,
+    const BrowserListingItem* a,
+    const BrowserListingItem* b,
+    bool hide_ext) {
+    if(xtreme_settings.sort_dirs_first && a->is_folder != b->is_folder) {
+        return a->is_folder ? -1 : 1;
+    }
+    browser_listing_item_key(listing->sort_key_a, a, hide_ext);
+    browser_listing_item_key(listing->sort_key_b, b, hide_ext);
+    return furi_string_cmpi(listing->sort_key_a, listing->sort_key_b);
+}
+
+// Shell sort, qsort has no context for the comparison keys
+static void browser_listing_sort(BrowserListing* listing, bool hide_ext) {
+    size_t items_cnt = BrowserListingItemArray_size(listing->items);
+    if(items_cnt < 2) return;
+    BrowserListingItem* items = BrowserListingItemArray_get(listing->items, 0);
+
+    size_t gap = 1;
+    while(gap < items_cnt / 3) {
+        gap = gap * 3 + 1;
+    }
+    for(; gap > 0; gap /= 3) {
+        for(size_t i = gap; i < items_cnt; i++) {
+            BrowserListingItem item = items[i];
+            size_t j = i;
+            while(j >= gap &&
+                  browser_listing_item_cmp(listing, &items[j - gap], &item, hide_ext) > 0) {
+                items[j] = items[j - gap];
+                j -= gap;
+            }
+            items[j] = item;
+        }
+    }
+}
+
+static bool browser_listing_is_valid(BrowserListing* listing, FuriString* path) {
+    return listing->valid && furi_string_cmp(listing->path, path) == 0;
+}
+
+static uint32_t browser_folder_hash_add(uint32_t hash, const char* name, bool is_folder) {
+    hash = crc32_calc_buffer(hash, name, strlen(name) + 1);
+    return crc32_calc_buffer(hash, &is_folder, sizeof(is_folder));
+}
+
+// Hash of the filtered names in directory order, no sorting or allocation per name
+static bool browser_folder_hash(BrowserWorker* browser, Storage* storage, uint32_t* hash) {
+    FileInfo file_info;
+    File* directory = storage_file_alloc(storage);
+
+    char name_temp[FILE_NAME_LEN_MAX];
+    FuriString* name_str = furi_string_alloc();
+
+    bool state = false;
+    *hash = 0;
+    if(storage_dir_open(directory, furi_string_get_cstr(browser->listing.path))) {
+        state = true;
+        while(storage_dir_read(directory, &file_info, name_temp, FILE_NAME_LEN_MAX)) {
+            if(storage_file_get_error(directory) != FSE_OK) {
+                state = false;
+                break;
+            }
+            if(name_temp[0] == '\0') continue;
+            furi_string_set(name_str, name_temp);
+            if(browser_filter_by_name(browser, name_str, file_info_is_dir(&file_info))) {
+                *hash = browser_folder_hash_add(*hash, name_temp, file_info_is_dir(&file_info));
+            }
+        }
+    }
+
+    furi_string_free(name_str);
+    storage_dir_close(directory);
+    storage_file_free(directory);
+
+    return state;
+}
+
+// Storage timestamp is global, a write elsewhere only costs a scan of the listed folder
+static bool browser_listing_is_stale(BrowserWorker* browser) {
+    BrowserListing* listing = &browser->listing;
+    bool stale = true;
+    uint32_t timestamp = 0;
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+
+    if(storage_common_timestamp(storage, furi_string_get_cstr(listing->path), &timestamp) ==
+       FSE_OK) {
+        uint32_t hash = 0;
+        if(timestamp == listing->storage_timestamp) {
+            stale = false;
+        } else if(browser_folder_hash(browser, storage, &hash) && hash == listing->folder_hash) {
+            listing->storage_timestamp = timestamp;
+            stale = false;
+        }
+    }
+
+    furi_record_close(RECORD_STORAGE);
+    return stale;
+}
+
 static bool browser_folder_check_and_switch(FuriString* path) {
     FileInfo file_info;
     Storage* storage = furi_record_open(RECORD_STORAGE);
@@ -143,6 +330,7 @@ static bool browser_folder_init(
     bool state = false;
     FileInfo file_info;
     uint32_t total_files_cnt = 0;
+    BrowserListing* listing = &browser->listing;
 
     Storage* storage = furi_record_open(RECORD_STORAGE);
     File* directory = storage_file_alloc(storage);
@@ -154,6 +342,13 @@ static bool browser_folder_init(
     *item_cnt = 0;
     *file_idx = -1;
 
+    browser_listing_reset(listing);
+    furi_string_set(listing->path, path);
+    const char* path_cstr = furi_string_get_cstr(path);
+    bool listing_ok =
+        storage_common_timestamp(storage, path_cstr, &listing->storage_timestamp) == FSE_OK;
+    listing->folder_hash = 0;
+
     if(storage_dir_open(directory, furi_string_get_cstr(path))) {
         state = true;
         while(1) {
@@ -164,6 +359,12 @@ static bool browser_folder_init(
                 total_files_cnt++;
                 furi_string_set(name_str, name_temp);
                 if(browser_filter_by_name(browser, name_str, file_info_is_dir(&file_info))) {
+                    if(listing_ok) {
+                        listing_ok =
+                            browser_listing_add(listing, name_temp, file_info_is_dir(&file_info));
+                        listing->folder_hash = browser_folder_hash_add(
+                            listing->folder_hash, name_temp, file_info_is_dir(&file_info));
+                    }
                     if(!furi_string_empty(filename)) {
                         if(furi_string_cmp(name_str, filename) == 0) {
                             *file_idx = *item_cnt;
@@ -186,11 +387,57 @@ static bool browser_folder_init(
     storage_dir_close(directory);
     storage_file_free(directory);
 
+    if(listing_ok && state) {
+        browser_listing_sort(listing, browser->hide_ext);
+        listing->valid = true;
+
+        if(*file_idx >= 0) {
+            const char* name = furi_string_get_cstr(filename);
+            for(size_t i = 0; i < BrowserListingItemArray_size(listing->items); i++) {
+                if(strcmp(BrowserListingItemArray_get(listing->items, i)->name, name) == 0) {
+                    *file_idx = i;
+                    break;
+                }
+            }
+        }
+    } else {
+        browser_listing_reset(listing);
+    }
+
     furi_record_close(RECORD_STORAGE);
 
     return state;
 }
 
+// Load files list from the listing read at folder init, sorted, paging only touches the page
+static void browser_folder_load_listing(
+    BrowserWorker* browser,
+    FuriString* path,
+    uint32_t offset,
+    uint32_t count) {
+    BrowserListing* listing = &browser->listing;
+    size_t items_cnt = BrowserListingItemArray_size(listing->items);
+    size_t end = MIN((size_t)offset + count, items_cnt);
+
+    if(browser->list_load_cb) {
+        browser->list_load_cb(browser->cb_ctx, offset);
+    }
+
+    FuriString* name_str = furi_string_alloc();
+    for(size_t i = offset; i < end; i++) {
+        const BrowserListingItem* item = BrowserListingItemArray_get(listing->items, i);
+        furi_string_printf(name_str, "%s/%s", furi_string_get_cstr(path), item->name);
+        if(browser->list_item_cb) {
+            browser->list_item_cb(browser->cb_ctx, name_str, item->is_folder, false);
+        }
+    }
+    furi_string_free(name_str);
+
+    if(browser->list_item_cb) {
+        browser->list_item_cb(browser->cb_ctx, NULL, false, true);
+    }
+}
+
 // Load files list by chunks, like it was originally, not compatible with sorting, sorting needs to be disabled to use this
 static bool browser_folder_load_chunked(
     BrowserWorker* browser,
@@ -270,6 +517,7 @@ static bool browser_folder_load_chunked(
 }
 
 // Load all files at once, may cause memory overflow so need to limit that to about 400 files
+// Used when the folder listing is not available, big folders are sorted with it instead
 static bool browser_folder_load_full(BrowserWorker* browser, FuriString* path) {
     FileInfo file_info;
 
@@ -437,7 +685,33 @@ static int32_t browser_worker(void* context) {
         if(flags & WorkerEvtLoad) {
             FURI_LOG_D(
                 TAG, "Load offset: %lu cnt: %lu", browser->load_offset, browser->load_count);
-            if(items_cnt > BROWSER_SORT_THRESHOLD) {
+            bool listing_valid = browser_listing_is_valid(&browser->listing, path);
+            bool reload = listing_valid && browser_listing_is_stale(browser);
+            if(reload) {
+                // Folder contents changed, pages already loaded no longer match.
+                // Start the folder view over instead of mixing old and new contents.
+                bool is_root = browser_folder_check_and_switch(path);
+                int32_t file_idx = 0;
+                browser_folder_init(browser, path, filename, &items_cnt, &file_idx);
+                furi_string_set(browser->path_current, path);
+                FURI_LOG_D(
+                    TAG,
+                    "Reload folder: %s items: %lu idx: %ld",
+                    furi_string_get_cstr(path),
+                    items_cnt,
+                    file_idx);
+                if(browser->folder_cb) {
+                    browser->folder_cb(browser->cb_ctx, items_cnt, file_idx, is_root);
+                }
+            }
+            if(reload) {
+                // Folder callback already requested a new load
+            } else if(listing_valid && items_cnt > BROWSER_SORT_THRESHOLD) {
+                browser_folder_load_listing(
+                    browser, path, browser->load_offset, browser->load_count);
+            } else if(listing_valid) {
+                browser_folder_load_listing(browser, path, 0, items_cnt);
+            } else if(items_cnt > BROWSER_SORT_THRESHOLD) {
                 browser_folder_load_chunked(
                     browser, path, browser->load_offset, browser->load_count);
             } else {
@@ -477,6 +751,15 @@ BrowserWorker* file_browser_worker_alloc(
         furi_string_set_str(browser->path_start, base_path);
     }
 
+    browser->hide_ext = false;
+
+    browser->listing.path = furi_string_alloc();
+    browser->listing.sort_key_a = furi_string_alloc();
+    browser->listing.sort_key_b = furi_string_alloc();
+    BrowserListingItemArray_init(browser->listing.items);
+    BrowserListingChunkArray_init(browser->listing.chunks);
+    browser_listing_reset(&browser->listing);
+
     browser->thread = furi_thread_alloc_ex("BrowserWorker", 2048, browser_worker, browser);
     furi_thread_start(browser->thread);
 
@@ -495,6 +778,13 @@ void file_browser_worker_free(BrowserWorker* browser) {
     furi_string_free(browser->path_current);
     furi_string_free(browser->path_start);
 
+    browser_listing_reset(&browser->listing);
+    BrowserListingItemArray_clear(browser->listing.items);
+    BrowserListingChunkArray_clear(browser->listing.chunks);
+    furi_string_free(browser->listing.path);
+    furi_string_free(browser->listing.sort_key_a);
+    furi_string_free(browser->listing.sort_key_b);
+
     free(browser);
 }
 
@@ -531,6 +821,11 @@ void file_browser_worker_set_long_load_callback(
     browser->long_load_cb = cb;
 }
 
+void file_browser_worker_set_hide_ext(BrowserWorker* browser, bool hide_ext) {
+    furi_assert(browser);
+    browser->hide_ext = hide_ext;
+}
+
 void file_browser_worker_set_config(
     BrowserWorker* browser,
     FuriString* path,
@@ -50,6 +50,9 @@ void file_browser_worker_set_long_load_callback(
     BrowserWorker* browser,
     BrowserWorkerLongLoadCallback cb);
 
+// Sort big folders without file extensions, like the view displays them
+void file_browser_worker_set_hide_ext(BrowserWorker* browser, bool hide_ext);
+
 void file_browser_worker_set_config(
     BrowserWorker* browser,
     FuriString* path,
@@ -90,9 +90,16 @@ static void view_port_setup_canvas_orientation(const ViewPort* view_port, Canvas
     canvas_set_orientation(canvas, orientation);
 }
 
+// Status bar icons are laid out by GUI, their updates never reach beyond the status bar
+static bool view_port_is_status_bar(const ViewPort* view_port) {
+    return view_port->layer == GuiLayerStatusBarLeft ||
+           view_port->layer == GuiLayerStatusBarRight;
+}
+
 ViewPort* view_port_alloc() {
     ViewPort* view_port = malloc(sizeof(ViewPort));
     view_port->orientation = ViewPortOrientationHorizontal;
+    view_port->layer = GuiLayerMAX;
     view_port->is_enabled = true;
     view_port->mutex = furi_mutex_alloc(FuriMutexTypeRecursive);
     return view_port;
@@ -183,14 +190,21 @@ void view_port_update(ViewPort* view_port) {
         FURI_LOG_W(TAG, "ViewPort lockup: see %s:%d", __FILE__, __LINE__ - 3);
     }
 
-    if(view_port->gui && view_port->is_enabled) gui_update(view_port->gui);
+    if(view_port->gui && view_port->is_enabled) {
+        if(view_port_is_status_bar(view_port)) {
+            gui_update_region(view_port->gui, 0, 0, GUI_DISPLAY_WIDTH, GUI_STATUS_BAR_HEIGHT);
+        } else {
+            gui_update(view_port->gui);
+        }
+    }
     furi_mutex_release(view_port->mutex);
 }
 
-void view_port_gui_set(ViewPort* view_port, Gui* gui) {
+void view_port_gui_set(ViewPort* view_port, Gui* gui, GuiLayer layer) {
     furi_assert(view_port);
     furi_check(furi_mutex_acquire(view_port->mutex, FuriWaitForever) == FuriStatusOk);
     view_port->gui = gui;
+    view_port->layer = layer;
     furi_check(furi_mutex_release(view_port->mutex) == FuriStatusOk);
 }
 
@@ -115,6 +115,22 @@ bool loader_is_locked(Loader* loader) {
     return result.value;
 }
 
+bool loader_get_fap_profile(
+    Loader* loader,
+    FuriString* name,
+    FlipperApplicationLoadProfile* profile) {
+    LoaderMessage message;
+    LoaderMessageBoolResult result;
+    message.type = LoaderMessageTypeGetFapProfile;
+    message.fap_profile.name = name;
+    message.fap_profile.profile = profile;
+    message.api_lock = api_lock_alloc_locked();
+    message.bool_value = &result;
+    furi_message_queue_put(loader->queue, &message, FuriWaitForever);
+    api_lock_wait_unlock_and_free(message.api_lock);
+    return result.value;
+}
+
 void loader_show_menu(Loader* loader) {
     LoaderMessage message;
     message.type = LoaderMessageTypeShowMenu;
@@ -231,6 +247,7 @@ static Loader* loader_alloc() {
     loader->app.thread = NULL;
     loader->app.insomniac = false;
     loader->app.fap = NULL;
+    loader->fap_profile_name = furi_string_alloc();
     MenuAppList_init(loader->menu_apps);
 
     if(!furi_hal_is_normal_boot()) return loader;
@@ -489,10 +506,8 @@ static LoaderStatus loader_start_external_app(
         FURI_LOG_I(TAG, "Starting app");
 
         loader->app.thread = flipper_application_alloc_thread(loader->app.fap, args);
-        FuriString* app_name = furi_string_alloc();
-        path_extract_filename_no_ext(path, app_name);
-        furi_thread_set_appid(loader->app.thread, furi_string_get_cstr(app_name));
-        furi_string_free(app_name);
+        path_extract_filename_no_ext(path, loader->fap_profile_name);
+        furi_thread_set_appid(loader->app.thread, furi_string_get_cstr(loader->fap_profile_name));
 
         /* This flag is set by the debugger - to break on app start */
         if(furi_hal_debug_is_gdb_session_active()) {
@@ -632,6 +647,20 @@ static void loader_do_unlock(Loader* loader) {
     loader->app.thread = NULL;
 }
 
+static bool loader_do_get_fap_profile(Loader* loader, LoaderMessageFapProfile* fap_profile) {
+    if(loader->app.fap && loader->app.thread) {
+        flipper_application_get_load_profile(loader->app.fap, &loader->fap_profile);
+    }
+
+    if(furi_string_empty(loader->fap_profile_name)) {
+        return false;
+    }
+
+    furi_string_set(fap_profile->name, loader->fap_profile_name);
+    *fap_profile->profile = loader->fap_profile;
+    return true;
+}
+
 static void loader_do_app_closed(Loader* loader) {
     furi_assert(loader->app.thread);
 
@@ -648,6 +677,7 @@ static void loader_do_app_closed(Loader* loader) {
     }
 
     if(loader->app.fap) {
+        flipper_application_get_load_profile(loader->app.fap, &loader->fap_profile);
         flipper_application_free(loader->app.fap);
         loader->app.fap = NULL;
         loader->app.thread = NULL;
@@ -726,6 +756,11 @@ int32_t loader_srv(void* p) {
             case LoaderMessageTypeApplicationsClosed:
                 loader_do_applications_closed(loader);
                 break;
+            case LoaderMessageTypeGetFapProfile:
+                message.bool_value->value =
+                    loader_do_get_fap_profile(loader, &message.fap_profile);
+                api_lock_unlock(message.api_lock);
+                break;
             }
         }
     }
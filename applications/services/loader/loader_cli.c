@@ -4,6 +4,7 @@
 #include <lib/toolbox/args.h>
 #include <notification/notification_messages.h>
 #include "loader.h"
+#include "loader_i.h"
 
 static void loader_cli_print_usage() {
     printf("Usage:\r\n");
@@ -12,6 +13,7 @@ static void loader_cli_print_usage() {
     printf("\tlist\t - List available applications\r\n");
     printf("\topen <Application Name:string>\t - Open application by name\r\n");
     printf("\tinfo\t - Show loader state\r\n");
+    printf("\tprofile\t - Show load time of the last external application\r\n");
 }
 
 static void loader_cli_list() {
@@ -37,6 +39,25 @@ static void loader_cli_info(Loader* loader) {
     }
 }
 
+static void loader_cli_profile(Loader* loader) {
+    FuriString* name = furi_string_alloc();
+    FlipperApplicationLoadProfile profile;
+
+    if(!loader_get_fap_profile(loader, name, &profile)) {
+        printf("No external application was loaded\r\n");
+    } else {
+        printf("Application: %s\r\n", furi_string_get_cstr(name));
+        printf("Read: %lu us\r\n", profile.read_us);
+        printf("Relocate: %lu us\r\n", profile.relocate_us);
+        printf("  Symbol resolution: %lu us\r\n", profile.resolve_us);
+        printf("  Symbols resolved: %lu\r\n", profile.symbols_resolved);
+        printf("  Relocation cache: %s\r\n", profile.relocation_cache_used ? "hit" : "miss");
+        printf("Init: %lu us\r\n", profile.init_us);
+    }
+
+    furi_string_free(name);
+}
+
 static void loader_cli_open(FuriString* args, Loader* loader) {
     FuriString* app_name = furi_string_alloc();
 
@@ -97,6 +118,11 @@ static void loader_cli(Cli* cli, FuriString* args, void* context) {
             break;
         }
 
+        if(furi_string_cmp_str(cmd, "profile") == 0) {
+            loader_cli_profile(loader);
+            break;
+        }
+
         loader_cli_print_usage();
     } while(false);
 
@@ -22,6 +22,9 @@ struct Loader {
     LoaderAppData app;
 
     MenuAppList_t menu_apps;
+
+    FuriString* fap_profile_name;
+    FlipperApplicationLoadProfile fap_profile;
 };
 
 typedef enum {
@@ -36,6 +39,7 @@ typedef enum {
 
     LoaderMessageTypeStartByNameDetachedWithGuiError,
     LoaderMessageTypeShowSettings,
+    LoaderMessageTypeGetFapProfile,
 } LoaderMessageType;
 
 typedef struct {
@@ -44,6 +48,11 @@ typedef struct {
     FuriString* error_message;
 } LoaderMessageStartByName;
 
+typedef struct {
+    FuriString* name;
+    FlipperApplicationLoadProfile* profile;
+} LoaderMessageFapProfile;
+
 typedef struct {
     LoaderStatus value;
 } LoaderMessageLoaderStatusResult;
@@ -58,6 +67,7 @@ typedef struct {
 
     union {
         LoaderMessageStartByName start;
+        LoaderMessageFapProfile fap_profile;
     };
 
     union {
@@ -65,3 +75,15 @@ typedef struct {
         LoaderMessageBoolResult* bool_value;
     };
 } LoaderMessage;
+
+/**
+ * @brief Get load profile of the running or the last closed FAP
+ * @param loader Loader instance
+ * @param name App name output
+ * @param profile Profile output
+ * @return true if any FAP was loaded since boot
+ */
+bool loader_get_fap_profile(
+    Loader* loader,
+    FuriString* name,
+    FlipperApplicationLoadProfile* profile);
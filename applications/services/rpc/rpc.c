@@ -28,6 +28,13 @@ typedef enum {
 
 #define RPC_ALL_EVENTS (RpcEvtNewData | RpcEvtDisconnect)
 
+/* Room for the varint length prefix in front of the encoded message */
+#define RPC_TX_PREFIX_SIZE 5
+#define RPC_TX_BUFFER_ALIGN 256
+
+#define RPC_DATA_CHUNK_SIZE_DEFAULT 512
+#define RPC_DATA_CHUNK_SIZE_USB 4096
+
 DICT_DEF2(RpcHandlerDict, pb_size_t, M_DEFAULT_OPLIST, RpcHandler, M_POD_OPLIST)
 
 typedef struct {
@@ -86,6 +93,10 @@ struct RpcSession {
     RpcSessionTerminatedCallback terminated_callback;
     RpcOwner owner;
     void* context;
+
+    uint8_t* tx_buffer;
+    size_t tx_buffer_size;
+    size_t data_chunk_size;
 };
 
 struct Rpc {
@@ -354,6 +365,9 @@ static void rpc_session_thread_pending_callback(void* context, uint32_t arg) {
     }
     free(session->system_contexts);
     free(session->decoded_message);
+    if(session->tx_buffer) {
+        free(session->tx_buffer);
+    }
     RpcHandlerDict_clear(session->handlers);
     furi_stream_buffer_free(session->stream);
 
@@ -388,6 +402,8 @@ RpcSession* rpc_session_open(Rpc* rpc, RpcOwner owner) {
     session->terminate = false;
     session->decode_error = false;
     session->owner = owner;
+    session->data_chunk_size =
+        (owner == RpcOwnerUsb) ? RPC_DATA_CHUNK_SIZE_USB : RPC_DATA_CHUNK_SIZE_DEFAULT;
     RpcHandlerDict_init(session->handlers);
 
     session->decoded_message = malloc(sizeof(PB_Main));
@@ -445,36 +461,85 @@ void rpc_add_handler(RpcSession* session, pb_size_t message_tag, RpcHandler* han
     RpcHandlerDict_set_at(session->handlers, message_tag, *handler);
 }
 
+size_t rpc_session_get_data_chunk_size(RpcSession* session) {
+    furi_assert(session);
+    return session->data_chunk_size;
+}
+
+void rpc_session_set_data_chunk_size(RpcSession* session, size_t size) {
+    furi_assert(session);
+    furi_assert(size && size <= UINT16_MAX);
+    session->data_chunk_size = size;
+}
+
+static bool rpc_encode_to_tx_buffer(RpcSession* session, PB_Main* message, size_t* size) {
+    if(session->tx_buffer_size <= RPC_TX_PREFIX_SIZE) {
+        return false;
+    }
+
+    pb_ostream_t ostream = pb_ostream_from_buffer(
+        session->tx_buffer + RPC_TX_PREFIX_SIZE, session->tx_buffer_size - RPC_TX_PREFIX_SIZE);
+    if(!pb_encode(&ostream, &PB_Main_msg, message)) {
+        return false;
+    }
+
+    *size = ostream.bytes_written;
+    return true;
+}
+
+/* Must be called with callbacks_mutex taken, returns pointer into the session tx buffer */
+static uint8_t* rpc_encode(RpcSession* session, PB_Main* message, size_t* size) {
+    // Encode right away into the buffer kept from previous messages, size it only on overflow
+    if(!rpc_encode_to_tx_buffer(session, message, size)) {
+        pb_ostream_t ostream = PB_OSTREAM_SIZING;
+        bool result = pb_encode(&ostream, &PB_Main_msg, message);
+        furi_check(result);
+
+        size_t buffer_size = ostream.bytes_written + RPC_TX_PREFIX_SIZE;
+        buffer_size = (buffer_size + RPC_TX_BUFFER_ALIGN - 1) & ~(RPC_TX_BUFFER_ALIGN - 1);
+        if(session->tx_buffer) {
+            free(session->tx_buffer);
+        }
+        session->tx_buffer = malloc(buffer_size);
+        session->tx_buffer_size = buffer_size;
+
+        result = rpc_encode_to_tx_buffer(session, message, size);
+        furi_check(result);
+    }
+
+    // Put the delimiter right in front of the message
+    uint8_t prefix[RPC_TX_PREFIX_SIZE];
+    pb_ostream_t prefix_stream = pb_ostream_from_buffer(prefix, sizeof(prefix));
+    pb_encode_varint(&prefix_stream, *size);
+
+    uint8_t* buffer = session->tx_buffer + RPC_TX_PREFIX_SIZE - prefix_stream.bytes_written;
+    memcpy(buffer, prefix, prefix_stream.bytes_written);
+    *size += prefix_stream.bytes_written;
+
+    return buffer;
+}
+
 void rpc_send(RpcSession* session, PB_Main* message) {
     furi_assert(session);
     furi_assert(message);
 
-    pb_ostream_t ostream = PB_OSTREAM_SIZING;
-
 #if SRV_RPC_DEBUG
     FURI_LOG_I(TAG, "OUTPUT:");
     rpc_debug_print_message(message);
 #endif
 
-    bool result = pb_encode_ex(&ostream, &PB_Main_msg, message, PB_ENCODE_DELIMITED);
-    furi_check(result && ostream.bytes_written);
-
-    uint8_t* buffer = malloc(ostream.bytes_written);
-    ostream = pb_ostream_from_buffer(buffer, ostream.bytes_written);
-
-    pb_encode_ex(&ostream, &PB_Main_msg, message, PB_ENCODE_DELIMITED);
+    furi_mutex_acquire(session->callbacks_mutex, FuriWaitForever);
+    if(session->send_bytes_callback) {
+        size_t size = 0;
+        uint8_t* buffer = rpc_encode(session, message, &size);
 
 #if SRV_RPC_DEBUG
-    rpc_debug_print_data("OUTPUT", buffer, ostream.bytes_written);
+        rpc_debug_print_data("OUTPUT", buffer, size);
 #endif
 
-    furi_mutex_acquire(session->callbacks_mutex, FuriWaitForever);
-    if(session->send_bytes_callback) {
-        session->send_bytes_callback(session->context, buffer, ostream.bytes_written);
+        session->send_bytes_callback(session->context, buffer, size);
     }
     furi_mutex_release(session->callbacks_mutex);
-
-    free(buffer);
 }
 
 void rpc_send_and_release(RpcSession* session, PB_Main* message) {
@@ -1,6 +1,7 @@
 #include "flipper.pb.h"
 #include "rpc_i.h"
 #include "gui.pb.h"
+#include "rpc_gui_frame.h"
 #include <gui/gui_i.h>
 #include <assets_icons.h>
 
@@ -26,6 +27,16 @@ typedef struct {
     // Transmit
     PB_Main* transmit_frame;
     FuriThread* transmit_thread;
+    FuriMutex* transmit_mutex;
+    size_t transmit_frame_size;
+    uint8_t* transmit_pending;
+    PB_Gui_ScreenOrientation transmit_orientation;
+
+    // Delta stream, previous frame is what client has
+    uint8_t* transmit_previous;
+    PB_Gui_ScreenOrientation transmit_previous_orientation;
+    bool transmit_delta;
+    bool transmit_keyframe;
 
     bool virtual_display_not_empty;
     bool is_streaming;
@@ -52,17 +63,61 @@ static void rpc_system_gui_screen_stream_frame_callback(
     furi_assert(context);
 
     RpcGuiSystem* rpc_gui = (RpcGuiSystem*)context;
-    uint8_t* buffer = rpc_gui->transmit_frame->content.gui_screen_frame.data->bytes;
 
-    furi_assert(size == rpc_gui->transmit_frame->content.gui_screen_frame.data->size);
+    furi_assert(size == rpc_gui->transmit_frame_size);
 
-    memcpy(buffer, data, size);
-    rpc_gui->transmit_frame->content.gui_screen_frame.orientation =
-        rpc_system_gui_screen_orientation_map[orientation];
+    furi_check(furi_mutex_acquire(rpc_gui->transmit_mutex, FuriWaitForever) == FuriStatusOk);
+    memcpy(rpc_gui->transmit_pending, data, size);
+    rpc_gui->transmit_orientation = rpc_system_gui_screen_orientation_map[orientation];
+    furi_check(furi_mutex_release(rpc_gui->transmit_mutex) == FuriStatusOk);
 
     furi_thread_flags_set(furi_thread_get_id(rpc_gui->transmit_thread), RpcGuiWorkerFlagTransmit);
 }
 
+/** Move pending frame into transmit message
+ *
+ * @return     false if client already has this frame
+ */
+static bool rpc_system_gui_screen_stream_frame_prepare(RpcGuiSystem* rpc_gui) {
+    PB_Gui_ScreenFrame* frame = &rpc_gui->transmit_frame->content.gui_screen_frame;
+    const size_t size = rpc_gui->transmit_frame_size;
+    bool send = true;
+
+    furi_check(furi_mutex_acquire(rpc_gui->transmit_mutex, FuriWaitForever) == FuriStatusOk);
+
+    frame->orientation = rpc_gui->transmit_orientation;
+    if(!rpc_gui->transmit_delta) {
+        memcpy(frame->data->bytes, rpc_gui->transmit_pending, size);
+        frame->data->size = size;
+    } else if(
+        !rpc_gui->transmit_keyframe &&
+        rpc_gui->transmit_orientation == rpc_gui->transmit_previous_orientation &&
+        memcmp(rpc_gui->transmit_pending, rpc_gui->transmit_previous, size) == 0) {
+        send = false;
+    } else {
+        // Encoded frame is always shorter than raw one, that's how client tells them apart
+        size_t encoded_size = rpc_gui_frame_encode(
+            rpc_gui->transmit_pending,
+            rpc_gui->transmit_keyframe ? NULL : rpc_gui->transmit_previous,
+            size,
+            frame->data->bytes,
+            size - 1);
+        if(encoded_size == 0) {
+            memcpy(frame->data->bytes, rpc_gui->transmit_pending, size);
+            encoded_size = size;
+        }
+        frame->data->size = encoded_size;
+
+        memcpy(rpc_gui->transmit_previous, rpc_gui->transmit_pending, size);
+        rpc_gui->transmit_previous_orientation = rpc_gui->transmit_orientation;
+        rpc_gui->transmit_keyframe = false;
+    }
+
+    furi_check(furi_mutex_release(rpc_gui->transmit_mutex) == FuriStatusOk);
+
+    return send;
+}
+
 static int32_t rpc_system_gui_screen_stream_frame_transmit_thread(void* context) {
     furi_assert(context);
 
@@ -73,7 +128,8 @@ static int32_t rpc_system_gui_screen_stream_frame_transmit_thread(void* context)
         uint32_t flags =
             furi_thread_flags_wait(RpcGuiWorkerFlagAny, FuriFlagWaitAny, FuriWaitForever);
 
-        if(flags & RpcGuiWorkerFlagTransmit) {
+        if((flags & RpcGuiWorkerFlagTransmit) &&
+           rpc_system_gui_screen_stream_frame_prepare(rpc_gui)) {
             transmit_time = furi_get_tick();
             rpc_send(rpc_gui->session, rpc_gui->transmit_frame);
             transmit_time = furi_get_tick() - transmit_time;
@@ -117,6 +173,11 @@ static void rpc_system_gui_start_screen_stream_process(const PB_Main* request, v
         rpc_gui->transmit_frame->content.gui_screen_frame.data =
             malloc(PB_BYTES_ARRAY_T_ALLOCSIZE(framebuffer_size));
         rpc_gui->transmit_frame->content.gui_screen_frame.data->size = framebuffer_size;
+        rpc_gui->transmit_frame_size = framebuffer_size;
+        rpc_gui->transmit_pending = malloc(framebuffer_size);
+        rpc_gui->transmit_mutex = furi_mutex_alloc(FuriMutexTypeNormal);
+        // Raw frames until client asks for delta stream
+        rpc_gui->transmit_delta = false;
         // Transmission thread for async TX
         rpc_gui->transmit_thread = furi_thread_alloc_ex(
             "GuiRpcWorker", 1024, rpc_system_gui_screen_stream_frame_transmit_thread, rpc_gui);
@@ -150,6 +211,11 @@ static void rpc_system_gui_stop_screen_stream_process(const PB_Main* request, vo
         pb_release(&PB_Main_msg, rpc_gui->transmit_frame);
         free(rpc_gui->transmit_frame);
         rpc_gui->transmit_frame = NULL;
+        furi_mutex_free(rpc_gui->transmit_mutex);
+        free(rpc_gui->transmit_pending);
+        free(rpc_gui->transmit_previous);
+        rpc_gui->transmit_pending = NULL;
+        rpc_gui->transmit_previous = NULL;
     }
 
     rpc_send_and_release_empty(session, request->command_id, PB_CommandStatus_OK);
@@ -329,6 +395,33 @@ static void rpc_system_gui_stop_virtual_display_process(const PB_Main* request,
     rpc_send_and_release_empty(session, request->command_id, PB_CommandStatus_OK);
 }
 
+/* Protobuf has no room for stream options, so ScreenFrame coming from client while the screen
+ * stream is running and virtual display is not is a stream control message. Its first data byte
+ * selects stream format, see RPC_GUI_FRAME_DELTA_VERSION, and next frame is always a keyframe.
+ * Older firmware ignores such frames and keeps streaming raw frames. */
+static void rpc_system_gui_screen_stream_control_process(
+    RpcGuiSystem* rpc_gui,
+    const PB_Gui_ScreenFrame* control) {
+    const uint8_t version = (control->data && control->data->size) ? control->data->bytes[0] : 0;
+
+    FURI_LOG_D(TAG, "ScreenStreamControl: version %u", version);
+
+    furi_check(furi_mutex_acquire(rpc_gui->transmit_mutex, FuriWaitForever) == FuriStatusOk);
+    if(version == RPC_GUI_FRAME_DELTA_VERSION) {
+        if(!rpc_gui->transmit_previous) {
+            rpc_gui->transmit_previous = malloc(rpc_gui->transmit_frame_size);
+        }
+        rpc_gui->transmit_delta = true;
+    } else {
+        rpc_gui->transmit_delta = false;
+    }
+    rpc_gui->transmit_keyframe = true;
+    furi_check(furi_mutex_release(rpc_gui->transmit_mutex) == FuriStatusOk);
+
+    // Resend current frame in the requested format
+    furi_thread_flags_set(furi_thread_get_id(rpc_gui->transmit_thread), RpcGuiWorkerFlagTransmit);
+}
+
 static void rpc_system_gui_virtual_display_frame_process(const PB_Main* request, void* context) {
     furi_assert(request);
     furi_assert(context);
@@ -340,11 +433,21 @@ static void rpc_system_gui_virtual_display_frame_process(const PB_Main* request,
     furi_assert(session);
 
     if(!rpc_gui->virtual_display_view_port) {
-        FURI_LOG_W(TAG, "Virtual display is not started, ignoring incoming frame packet");
+        if(rpc_gui->is_streaming) {
+            rpc_system_gui_screen_stream_control_process(
+                rpc_gui, &request->content.gui_screen_frame);
+        } else {
+            FURI_LOG_W(TAG, "Virtual display is not started, ignoring incoming frame packet");
+        }
         return;
     }
 
     size_t buffer_size = canvas_get_buffer_size(rpc_gui->gui->canvas);
+    const pb_bytes_array_t* data = request->content.gui_screen_frame.data;
+    if(!data || data->size < buffer_size) {
+        FURI_LOG_W(TAG, "Virtual display frame is too short, ignoring");
+        return;
+    }
     memcpy(
         rpc_gui->virtual_display_buffer,
         request->content.gui_screen_frame.data->bytes,
@@ -436,6 +539,11 @@ void rpc_system_gui_free(void* context) {
         pb_release(&PB_Main_msg, rpc_gui->transmit_frame);
         free(rpc_gui->transmit_frame);
         rpc_gui->transmit_frame = NULL;
+        furi_mutex_free(rpc_gui->transmit_mutex);
+        free(rpc_gui->transmit_pending);
+        free(rpc_gui->transmit_previous);
+        rpc_gui->transmit_pending = NULL;
+        rpc_gui->transmit_previous = NULL;
     }
     furi_record_close(RECORD_GUI);
     free(rpc_gui);
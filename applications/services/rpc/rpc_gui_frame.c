@@ -0,0 +1,107 @@
+#include "rpc_gui_frame.h"
+
+#include <furi.h>
+
+#define RPC_GUI_FRAME_REPEAT_FLAG (0x80)
+#define RPC_GUI_FRAME_REPEAT_MIN (2)
+#define RPC_GUI_FRAME_REPEAT_MAX (0x7F + RPC_GUI_FRAME_REPEAT_MIN)
+#define RPC_GUI_FRAME_LITERAL_MAX (0x80)
+
+static inline uint8_t
+    rpc_gui_frame_byte(const uint8_t* frame, const uint8_t* previous, size_t index) {
+    return previous ? frame[index] ^ previous[index] : frame[index];
+}
+
+size_t rpc_gui_frame_encode(
+    const uint8_t* frame,
+    const uint8_t* previous,
+    size_t size,
+    uint8_t* out,
+    size_t out_size) {
+    furi_assert(frame);
+    furi_assert(out);
+
+    if(out_size == 0) return 0;
+
+    size_t pos = 0;
+    out[pos++] = previous ? RpcGuiFrameFormatDelta : RpcGuiFrameFormatKeyframe;
+
+    size_t i = 0;
+    while(i < size) {
+        const uint8_t value = rpc_gui_frame_byte(frame, previous, i);
+        size_t run = 1;
+        while(i + run < size && run < RPC_GUI_FRAME_REPEAT_MAX &&
+              rpc_gui_frame_byte(frame, previous, i + run) == value) {
+            run++;
+        }
+
+        if(run >= RPC_GUI_FRAME_REPEAT_MIN) {
+            if(pos + 2 > out_size) return 0;
+            out[pos++] = RPC_GUI_FRAME_REPEAT_FLAG | (run - RPC_GUI_FRAME_REPEAT_MIN);
+            out[pos++] = value;
+            i += run;
+        } else {
+            // Extend literal until a repeat worth its control byte begins
+            const size_t start = i++;
+            while(i < size && i - start < RPC_GUI_FRAME_LITERAL_MAX) {
+                const uint8_t next = rpc_gui_frame_byte(frame, previous, i);
+                if(i + 2 < size && next == rpc_gui_frame_byte(frame, previous, i + 1) &&
+                   next == rpc_gui_frame_byte(frame, previous, i + 2)) {
+                    break;
+                }
+                i++;
+            }
+
+            const size_t length = i - start;
+            if(pos + 1 + length > out_size) return 0;
+            out[pos++] = length - 1;
+            for(size_t j = start; j < i; j++) {
+                out[pos++] = rpc_gui_frame_byte(frame, previous, j);
+            }
+        }
+    }
+
+    return pos;
+}
+
+bool rpc_gui_frame_decode(const uint8_t* data, size_t data_size, uint8_t* frame, size_t size) {
+    furi_assert(frame);
+
+    if(data_size == size) {
+        memcpy(frame, data, size);
+        return true;
+    }
+
+    if(data_size == 0) return false;
+
+    bool delta;
+    if(data[0] == RpcGuiFrameFormatDelta) {
+        delta = true;
+    } else if(data[0] == RpcGuiFrameFormatKeyframe) {
+        delta = false;
+    } else {
+        return false;
+    }
+
+    size_t pos = 1;
+    size_t i = 0;
+    while(pos < data_size) {
+        const uint8_t control = data[pos++];
+        if(control & RPC_GUI_FRAME_REPEAT_FLAG) {
+            const size_t run = (control & ~RPC_GUI_FRAME_REPEAT_FLAG) + RPC_GUI_FRAME_REPEAT_MIN;
+            if(pos >= data_size || i + run > size) return false;
+            const uint8_t value = data[pos++];
+            for(size_t j = 0; j < run; j++, i++) {
+                frame[i] = delta ? frame[i] ^ value : value;
+            }
+        } else {
+            const size_t length = control + 1;
+            if(pos + length > data_size || i + length > size) return false;
+            for(size_t j = 0; j < length; j++, i++) {
+                frame[i] = delta ? frame[i] ^ data[pos++] : data[pos++];
+            }
+        }
+    }
+
+    return i == size;
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Delta screen stream format version
+ *
+ * Advertised as `gui.screen_stream.delta` property. Client enables the format by sending
+ * ScreenFrame with this version in the first data byte while the screen stream is running
+ * and virtual display is not. Version 0 returns the stream to raw frames.
+ */
+#define RPC_GUI_FRAME_DELTA_VERSION (1)
+
+/** First byte of an encoded frame
+ *
+ * Frames of exactly framebuffer size are always raw and carry no format byte.
+ * Payload is a sequence of runs: control byte below 0x80 is followed by control + 1 literal
+ * bytes, control byte 0x80 and above is followed by one byte repeated (control & 0x7F) + 2
+ * times.
+ */
+typedef enum {
+    RpcGuiFrameFormatKeyframe = 0x01, /**< run length encoded frame */
+    RpcGuiFrameFormatDelta = 0x02, /**< run length encoded XOR against the previous frame */
+} RpcGuiFrameFormat;
+
+/** Encode frame
+ *
+ * @param      frame     framebuffer to encode
+ * @param      previous  previously sent framebuffer, NULL to encode a keyframe
+ * @param      size      framebuffer size
+ * @param      out       output buffer
+ * @param      out_size  output buffer size
+ *
+ * @return     encoded size, 0 if encoded frame doesn't fit into output buffer
+ */
+size_t rpc_gui_frame_encode(
+    const uint8_t* frame,
+    const uint8_t* previous,
+    size_t size,
+    uint8_t* out,
+    size_t out_size);
+
+/** Decode raw or encoded frame
+ *
+ * @param      data       received frame data
+ * @param      data_size  received frame data size
+ * @param      frame      framebuffer holding the previous frame, updated in place
+ * @param      size       framebuffer size
+ *
+ * @return     true if frame is valid, framebuffer content is undefined otherwise
+ */
+bool rpc_gui_frame_decode(const uint8_t* data, size_t data_size, uint8_t* frame, size_t size);
+
+#ifdef __cplusplus
+}
+#endif
@@ -25,6 +25,20 @@ void rpc_send_and_release_empty(RpcSession* session, uint32_t command_id, PB_Com
 
 void rpc_add_handler(RpcSession* session, pb_size_t message_tag, RpcHandler* handler);
 
+/** Get size of data chunks to stream to the peer, depends on the transport
+ *
+ * @param   session     pointer to RpcSession descriptor
+ * @return              chunk size in bytes
+ */
+size_t rpc_session_get_data_chunk_size(RpcSession* session);
+
+/** Override size of data chunks to stream to the peer
+ *
+ * @param   session     pointer to RpcSession descriptor
+ * @param   size        chunk size in bytes, up to UINT16_MAX
+ */
+void rpc_session_set_data_chunk_size(RpcSession* session, size_t size);
+
 void* rpc_system_system_alloc(RpcSession* session);
 void* rpc_system_storage_alloc(RpcSession* session);
 void rpc_system_storage_free(void* ctx);
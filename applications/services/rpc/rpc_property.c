@@ -3,14 +3,20 @@
 #include <furi_hal_info.h>
 #include <furi_hal_power.h>
 #include <core/core_defines.h>
+#include <toolbox/property.h>
 
 #include "rpc_i.h"
+#include "rpc_gui_frame.h"
 
 #define TAG "RpcProperty"
 
 #define PROPERTY_CATEGORY_DEVICE_INFO "devinfo"
 #define PROPERTY_CATEGORY_POWER_INFO "pwrinfo"
 #define PROPERTY_CATEGORY_POWER_DEBUG "pwrdebug"
+#define PROPERTY_CATEGORY_GUI "gui"
+#define PROPERTY_CATEGORY_HEAP "heap"
+
+#define PROPERTY_HEAP_PROFILE_CHUNK_SIZE (128)
 
 typedef struct {
     RpcSession* session;
@@ -41,6 +47,76 @@ static void
     }
 }
 
+static void rpc_system_property_gui_get(PropertyValueCallback out, char sep, void* context) {
+    FuriString* key = furi_string_alloc();
+    FuriString* value = furi_string_alloc();
+
+    // Single key, so it is the last one
+    PropertyValueContext property_context = {
+        .key = key, .value = value, .out = out, .sep = sep, .last = true, .context = context};
+
+    property_value_out(
+        &property_context, "%u", 2, "screen_stream", "delta", RPC_GUI_FRAME_DELTA_VERSION);
+
+    furi_string_free(key);
+    furi_string_free(value);
+}
+
+/* Heap profile dump goes as hex encoded chunks: heap.profile.dump.000, heap.profile.dump.001, ...
+ * scripts/heap_profile.py decodes concatenated chunks. */
+static void rpc_system_property_heap_get(PropertyValueCallback out, char sep, void* context) {
+    FuriString* key = furi_string_alloc();
+    FuriString* value = furi_string_alloc();
+
+    PropertyValueContext property_context = {
+        .key = key, .value = value, .out = out, .sep = sep, .last = false, .context = context};
+
+    const size_t heap_free = memmgr_get_free_heap();
+    const size_t max_free_block = memmgr_heap_get_max_free_block();
+    size_t dump_size = 0;
+    uint8_t* dump = memmgr_heap_profile_dump(&dump_size);
+
+    property_value_out(&property_context, "%zu", 1, "total", memmgr_get_total_heap());
+    property_value_out(&property_context, "%zu", 1, "free", heap_free);
+    property_value_out(&property_context, "%zu", 1, "min_free", memmgr_get_minimum_free_heap());
+    property_value_out(&property_context, "%zu", 1, "max_free_block", max_free_block);
+    property_value_out(
+        &property_context,
+        "%lu",
+        1,
+        "fragmentation",
+        memmgr_heap_fragmentation_index(heap_free, max_free_block));
+
+    property_context.last = !dump;
+    property_value_out(
+        &property_context, "%u", 2, "profile", "running", memmgr_heap_profile_is_running());
+
+    if(dump) {
+        property_value_out(&property_context, "%zu", 2, "profile", "size", dump_size);
+
+        FuriString* chunk = furi_string_alloc();
+        char index[8];
+        for(size_t offset = 0; offset < dump_size; offset += PROPERTY_HEAP_PROFILE_CHUNK_SIZE) {
+            const size_t chunk_size = MIN(dump_size - offset, PROPERTY_HEAP_PROFILE_CHUNK_SIZE);
+            furi_string_reset(chunk);
+            for(size_t i = 0; i < chunk_size; i++) {
+                furi_string_cat_printf(chunk, "%02X", dump[offset + i]);
+            }
+
+            snprintf(index, sizeof(index), "%03zu", offset / PROPERTY_HEAP_PROFILE_CHUNK_SIZE);
+            property_context.last = offset + chunk_size >= dump_size;
+            property_value_out(
+                &property_context, NULL, 3, "profile", "dump", index, furi_string_get_cstr(chunk));
+        }
+
+        furi_string_free(chunk);
+        free(dump);
+    }
+
+    furi_string_free(key);
+    furi_string_free(value);
+}
+
 static void rpc_system_property_get_process(const PB_Main* request, void* context) {
     furi_assert(request);
     furi_assert(request->which_content == PB_Main_property_get_request_tag);
@@ -81,6 +157,10 @@ static void rpc_system_property_get_process(const PB_Main* request, void* contex
         furi_hal_power_info_get(rpc_system_property_get_callback, '.', &property_context);
     } else if(!furi_string_cmp(topkey, PROPERTY_CATEGORY_POWER_DEBUG)) {
         furi_hal_power_debug_get(rpc_system_property_get_callback, &property_context);
+    } else if(!furi_string_cmp(topkey, PROPERTY_CATEGORY_GUI)) {
+        rpc_system_property_gui_get(rpc_system_property_get_callback, '.', &property_context);
+    } else if(!furi_string_cmp(topkey, PROPERTY_CATEGORY_HEAP)) {
+        rpc_system_property_heap_get(rpc_system_property_get_callback, '.', &property_context);
     } else {
         rpc_send_and_release_empty(
             session, request->command_id, PB_CommandStatus_ERROR_INVALID_PARAMETERS);
@@ -17,8 +17,6 @@
 
 #define MAX_NAME_LENGTH 254
 
-static const size_t MAX_DATA_SIZE = 512;
-
 typedef enum {
     RpcStorageStateIdle = 0,
     RpcStorageStateWriting,
@@ -376,37 +374,32 @@ static void rpc_system_storage_read_process(const PB_Main* request, void* contex
 
     if(fs_operation_success) {
         size_t size_left = storage_file_size(file);
+        size_t chunk_size = MIN(size_left, rpc_session_get_data_chunk_size(session));
+
+        /* one data buffer for the whole file, file is read right into the message */
+        response->command_id = request->command_id;
+        response->which_content = PB_Main_storage_read_response_tag;
+        response->command_status = PB_CommandStatus_OK;
+        response->content.storage_read_response.has_file = true;
+        response->content.storage_read_response.file.data =
+            malloc(PB_BYTES_ARRAY_T_ALLOCSIZE(chunk_size));
+        uint8_t* buffer = &response->content.storage_read_response.file.data->bytes[0];
+        uint16_t* read_size_msg = &response->content.storage_read_response.file.data->size;
+
         do {
-            response->command_id = request->command_id;
-            response->which_content = PB_Main_storage_read_response_tag;
-            response->command_status = PB_CommandStatus_OK;
-
-            size_t read_size = MIN(size_left, MAX_DATA_SIZE);
-            if(read_size) {
-                response->content.storage_read_response.has_file = true;
-                response->content.storage_read_response.file.data =
-                    malloc(PB_BYTES_ARRAY_T_ALLOCSIZE(read_size));
-                uint8_t* buffer = &response->content.storage_read_response.file.data->bytes[0];
-                uint16_t* read_size_msg = &response->content.storage_read_response.file.data->size;
-
-                *read_size_msg = storage_file_read(file, buffer, read_size);
-                size_left -= *read_size_msg;
-                fs_operation_success = (*read_size_msg == read_size);
-
-                response->has_next = fs_operation_success && (size_left > 0);
-            } else {
-                response->content.storage_read_response.file.data =
-                    malloc(PB_BYTES_ARRAY_T_ALLOCSIZE(0));
-                response->content.storage_read_response.file.data->size = 0;
-                response->content.storage_read_response.has_file = true;
-                response->has_next = false;
-                fs_operation_success = true;
-            }
+            size_t read_size = MIN(size_left, chunk_size);
+            *read_size_msg = storage_file_read_bulk(file, buffer, read_size);
+            size_left -= *read_size_msg;
+            fs_operation_success = (*read_size_msg == read_size);
+
+            response->has_next = fs_operation_success && (size_left > 0);
 
             if(fs_operation_success) {
-                rpc_send_and_release(session, response);
+                rpc_send(session, response);
             }
         } while((size_left != 0) && fs_operation_success);
+
+        pb_release(&PB_Main_msg, response);
     }
 
     if(!fs_operation_success) {
@@ -47,7 +47,7 @@ struct File {
  *      @brief Write bytes from buffer to file
  *      @param file pointer to file object
  *      @param buff pointer to buffer for writing
- *      @param bytes_to_read how many bytes to write, must be smaller or equal to buffer size 
+ *      @param bytes_to_write how many bytes to write, must be smaller or equal to buffer size 
  *      @return how many bytes actually has been written
  * 
  *  @var FS_File_Api::seek
@@ -96,8 +96,8 @@ typedef struct {
         FS_AccessMode access_mode,
         FS_OpenMode open_mode);
     bool (*const close)(void* context, File* file);
-    uint16_t (*read)(void* context, File* file, void* buff, uint16_t bytes_to_read);
-    uint16_t (*write)(void* context, File* file, const void* buff, uint16_t bytes_to_write);
+    size_t (*read)(void* context, File* file, void* buff, size_t bytes_to_read);
+    size_t (*write)(void* context, File* file, const void* buff, size_t bytes_to_write);
     bool (*const seek)(void* context, File* file, uint32_t offset, bool from_start);
     uint64_t (*tell)(void* context, File* file);
     bool (*const truncate)(void* context, File* file);
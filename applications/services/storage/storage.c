@@ -106,6 +106,7 @@ int32_t storage_srv(void* p) {
     while(1) {
         if(furi_message_queue_get(app->message_queue, &message, STORAGE_TICK) == FuriStatusOk) {
             storage_process_message(app, &message);
+            app->messages_processed++;
         } else {
             storage_tick(app);
         }
@@ -103,6 +103,49 @@ uint16_t storage_file_read(File* file, void* buff, uint16_t bytes_to_read);
  */
 uint16_t storage_file_write(File* file, const void* buff, uint16_t bytes_to_write);
 
+/** Scatter/gather segment for vectored file transfers */
+typedef struct {
+    void* buff; /**< Buffer, only read from on write */
+    size_t size; /**< Buffer size */
+} StorageFileSegment;
+
+/** Reads bytes from a file into a buffer in a single storage request, without the
+ * uint16_t size limit. Use it for large transfers, every storage_file_read call is a
+ * separate round trip to the storage thread.
+ * @param file pointer to file object.
+ * @param buff pointer to a buffer, for reading
+ * @param bytes_to_read how many bytes to read. Must be less than or equal to the size of the buffer.
+ * @return size_t how many bytes were actually read
+ */
+size_t storage_file_read_bulk(File* file, void* buff, size_t bytes_to_read);
+
+/** Writes bytes from a buffer to a file in a single storage request, without the
+ * uint16_t size limit.
+ * @param file pointer to file object.
+ * @param buff pointer to buffer, for writing
+ * @param bytes_to_write how many bytes to write. Must be less than or equal to the size of the buffer.
+ * @return size_t how many bytes were actually written
+ */
+size_t storage_file_write_bulk(File* file, const void* buff, size_t bytes_to_write);
+
+/** Reads bytes from a file into several buffers in a single storage request.
+ * Stops on the first segment that was not filled completely.
+ * @param file pointer to file object.
+ * @param segments array of buffers to fill, in file order
+ * @param segments_count number of segments
+ * @return size_t how many bytes were actually read in total
+ */
+size_t storage_file_readv(File* file, const StorageFileSegment* segments, size_t segments_count);
+
+/** Writes bytes from several buffers to a file in a single storage request.
+ * Stops on the first segment that was not written completely.
+ * @param file pointer to file object.
+ * @param segments array of buffers to write, in file order
+ * @param segments_count number of segments
+ * @return size_t how many bytes were actually written in total
+ */
+size_t storage_file_writev(File* file, const StorageFileSegment* segments, size_t segments_count);
+
 /** Moves the r/w pointer 
  * @param file pointer to file object.
  * @param offset offset to move the r/w pointer
@@ -42,6 +42,7 @@
 #define S_RETURN_BOOL (return_data.bool_value);
 #define S_RETURN_UINT16 (return_data.uint16_value);
 #define S_RETURN_UINT64 (return_data.uint64_value);
+#define S_RETURN_SIZE (return_data.size_value);
 #define S_RETURN_ERROR (return_data.error_value);
 #define S_RETURN_CSTRING (return_data.cstring_value);
 
@@ -178,6 +179,56 @@ uint16_t storage_file_write(File* file, const void* buff, uint16_t bytes_to_writ
     return S_RETURN_UINT16;
 }
 
+size_t storage_file_readv(File* file, const StorageFileSegment* segments, size_t segments_count) {
+    if(segments_count == 0) {
+        return 0;
+    }
+
+    S_FILE_API_PROLOGUE;
+    S_API_PROLOGUE;
+
+    SAData data = {
+        .ftransfer = {
+            .file = file,
+            .segments = segments,
+            .segments_count = segments_count,
+        }};
+
+    S_API_MESSAGE(StorageCommandFileReadV);
+    S_API_EPILOGUE;
+    return S_RETURN_SIZE;
+}
+
+size_t storage_file_writev(File* file, const StorageFileSegment* segments, size_t segments_count) {
+    if(segments_count == 0) {
+        return 0;
+    }
+
+    S_FILE_API_PROLOGUE;
+    S_API_PROLOGUE;
+
+    SAData data = {
+        .ftransfer = {
+            .file = file,
+            .segments = segments,
+            .segments_count = segments_count,
+        }};
+
+    S_API_MESSAGE(StorageCommandFileWriteV);
+    S_API_EPILOGUE;
+    return S_RETURN_SIZE;
+}
+
+size_t storage_file_read_bulk(File* file, void* buff, size_t bytes_to_read) {
+    StorageFileSegment segment = {.buff = buff, .size = bytes_to_read};
+    return bytes_to_read ? storage_file_readv(file, &segment, 1) : 0;
+}
+
+size_t storage_file_write_bulk(File* file, const void* buff, size_t bytes_to_write) {
+    StorageFileSegment segment = {.buff = (void*)buff, .size = bytes_to_write};
+    return bytes_to_write ? storage_file_writev(file, &segment, 1) : 0;
+}
+
 bool storage_file_seek(File* file, uint32_t offset, bool from_start) {
     S_FILE_API_PROLOGUE;
     S_API_PROLOGUE;
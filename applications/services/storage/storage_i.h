@@ -25,6 +25,7 @@ struct Storage {
     StorageData storage[STORAGE_COUNT];
     StorageSDGui sd_gui;
     FuriPubSub* pubsub;
+    uint32_t messages_processed;
 };
 
 #ifdef __cplusplus
@@ -26,6 +26,12 @@ typedef struct {
     uint16_t bytes_to_write;
 } SADataFWrite;
 
+typedef struct {
+    File* file;
+    const StorageFileSegment* segments;
+    size_t segments_count;
+} SADataFTransfer;
+
 typedef struct {
     File* file;
     uint32_t offset;
@@ -101,6 +107,7 @@ typedef union {
     SADataFOpen fopen;
     SADataFRead fread;
     SADataFWrite fwrite;
+    SADataFTransfer ftransfer;
     SADataFSeek fseek;
     SADataFExpand fexpand;
 
@@ -125,6 +132,7 @@ typedef union {
     bool bool_value;
     uint16_t uint16_value;
     uint64_t uint64_value;
+    size_t size_value;
     FS_Error error_value;
     const char* cstring_value;
 } SAReturn;
@@ -158,6 +166,8 @@ typedef enum {
 
     StorageCommandFileExpand,
     StorageCommandCommonRename,
+    StorageCommandFileReadV,
+    StorageCommandFileWriteV,
 } StorageCommand;
 
 typedef struct {
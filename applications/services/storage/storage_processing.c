@@ -144,9 +144,9 @@ bool storage_process_file_close(Storage* app, File* file) {
     return ret;
 }
 
-static uint16_t
-    storage_process_file_read(Storage* app, File* file, void* buff, uint16_t const bytes_to_read) {
-    uint16_t ret = 0;
+static size_t
+    storage_process_file_read(Storage* app, File* file, void* buff, size_t const bytes_to_read) {
+    size_t ret = 0;
     StorageData* storage = get_storage_by_file(file, app->storage);
 
     if(storage == NULL) {
@@ -158,12 +158,12 @@ static uint16_t
     return ret;
 }
 
-static uint16_t storage_process_file_write(
+static size_t storage_process_file_write(
     Storage* app,
     File* file,
     const void* buff,
-    uint16_t const bytes_to_write) {
-    uint16_t ret = 0;
+    size_t const bytes_to_write) {
+    size_t ret = 0;
     StorageData* storage = get_storage_by_file(file, app->storage);
 
     if(storage == NULL) {
@@ -176,6 +176,30 @@ static uint16_t storage_process_file_write(
     return ret;
 }
 
+static size_t storage_process_file_transfer(
+    Storage* app,
+    File* file,
+    const StorageFileSegment* segments,
+    size_t segments_count,
+    bool write) {
+    size_t ret = 0;
+
+    // All segments are done in one request, stop on the first short transfer
+    for(size_t i = 0; i < segments_count; i++) {
+        size_t segment_ret = 0;
+        if(write) {
+            segment_ret =
+                storage_process_file_write(app, file, segments[i].buff, segments[i].size);
+        } else {
+            segment_ret = storage_process_file_read(app, file, segments[i].buff, segments[i].size);
+        }
+        ret += segment_ret;
+        if(segment_ret != segments[i].size) break;
+    }
+
+    return ret;
+}
+
 static bool storage_process_file_seek(
     Storage* app,
     File* file,
@@ -603,6 +627,22 @@ void storage_process_message_internal(Storage* app, StorageMessage* message) {
             message->data->fwrite.buff,
             message->data->fwrite.bytes_to_write);
         break;
+    case StorageCommandFileReadV:
+        message->return_data->size_value = storage_process_file_transfer(
+            app,
+            message->data->ftransfer.file,
+            message->data->ftransfer.segments,
+            message->data->ftransfer.segments_count,
+            false);
+        break;
+    case StorageCommandFileWriteV:
+        message->return_data->size_value = storage_process_file_transfer(
+            app,
+            message->data->ftransfer.file,
+            message->data->ftransfer.segments,
+            message->data->ftransfer.segments_count,
+            true);
+        break;
     case StorageCommandFileSeek:
         message->return_data->bool_value = storage_process_file_seek(
             app,
@@ -12,6 +12,9 @@ typedef FRESULT SDError;
 
 #define TAG "StorageExt"
 
+/* Largest whole number of sectors that fits FatFs 16-bit transfer size */
+#define STORAGE_EXT_CHUNK_SIZE (127 * 512)
+
 /********************* Definitions ********************/
 
 typedef struct {
@@ -350,19 +353,29 @@ static bool storage_ext_file_close(void* ctx, File* file) {
     return (file->error_id == FSE_OK);
 }
 
-static uint16_t
-    storage_ext_file_read(void* ctx, File* file, void* buff, uint16_t const bytes_to_read) {
+static size_t
+    storage_ext_file_read(void* ctx, File* file, void* buff, size_t const bytes_to_read) {
     StorageData* storage = ctx;
     SDFile* file_data = storage_get_storage_file_data(file, storage);
-    uint16_t bytes_read = 0;
-    file->internal_error_id = f_read(file_data, buff, bytes_to_read, &bytes_read);
+    size_t bytes_read = 0;
+
+    // FatFs takes 16-bit sizes, whole sectors in a chunk are read directly to the buffer
+    do {
+        UINT chunk_to_read = MIN(bytes_to_read - bytes_read, (size_t)STORAGE_EXT_CHUNK_SIZE);
+        UINT chunk_read = 0;
+        file->internal_error_id =
+            f_read(file_data, (uint8_t*)buff + bytes_read, chunk_to_read, &chunk_read);
+        bytes_read += chunk_read;
+        if(chunk_read != chunk_to_read) break;
+    } while(file->internal_error_id == FR_OK && bytes_read < bytes_to_read);
+
     file->error_id = storage_ext_parse_error(file->internal_error_id);
     return bytes_read;
 }
 
-static uint16_t
-    storage_ext_file_write(void* ctx, File* file, const void* buff, uint16_t const bytes_to_write) {
-    uint16_t bytes_written = 0;
+static size_t
+    storage_ext_file_write(void* ctx, File* file, const void* buff, size_t const bytes_to_write) {
+    size_t bytes_written = 0;
 #ifdef FURI_RAM_EXEC
     UNUSED(ctx);
     UNUSED(file);
@@ -372,7 +385,16 @@ static uint16_t
 #else
     StorageData* storage = ctx;
     SDFile* file_data = storage_get_storage_file_data(file, storage);
-    file->internal_error_id = f_write(file_data, buff, bytes_to_write, &bytes_written);
+
+    do {
+        UINT chunk_to_write = MIN(bytes_to_write - bytes_written, (size_t)STORAGE_EXT_CHUNK_SIZE);
+        UINT chunk_written = 0;
+        file->internal_error_id = f_write(
+            file_data, (const uint8_t*)buff + bytes_written, chunk_to_write, &chunk_written);
+        bytes_written += chunk_written;
+        if(chunk_written != chunk_to_write) break;
+    } while(file->internal_error_id == FR_OK && bytes_written < bytes_to_write);
+
     file->error_id = storage_ext_parse_error(file->internal_error_id);
 #endif
     return bytes_written;
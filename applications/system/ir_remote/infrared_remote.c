@@ -150,7 +150,7 @@ bool infrared_remote_load(InfraredRemote* remote, FuriString* path) {
     if(success) {
         uint32_t version;
         success = flipper_format_read_header(ff, buf, &version) &&
-                  !furi_string_cmp(buf, "IR signals file") && (version == 1);
+                  !furi_string_cmp(buf, "IR signals file") && (version == 1 || version == 2);
     }
 
     if(success) {
@@ -5,6 +5,7 @@
 #include <core/check.h>
 #include <lib/infrared/worker/infrared_transmit.h>
 #include <lib/infrared/worker/infrared_worker.h>
+#include <lib/infrared/analyzer/infrared_analyzer.h>
 
 #define TAG "InfraredSignal"
 
@@ -146,6 +147,49 @@ static inline bool infrared_signal_read_raw(InfraredSignal* signal, FlipperForma
     return success;
 }
 
+static inline bool infrared_signal_read_template(InfraredSignal* signal, FlipperFormat* ff) {
+    InfraredTemplate* tmpl = malloc(sizeof(InfraredTemplate));
+    uint32_t symbols_size;
+    bool success = false;
+
+    do {
+        if(!flipper_format_read_uint32(ff, "frequency", &tmpl->frequency, 1)) break;
+        if(!flipper_format_read_float(ff, "duty_cycle", &tmpl->duty_cycle, 1)) break;
+        if(!flipper_format_get_value_count(ff, "symbols", &symbols_size)) break;
+        if(!symbols_size || (symbols_size % 2) || (symbols_size > COUNT_OF(tmpl->symbols))) {
+            FURI_LOG_E(TAG, "Wrong template symbols");
+            break;
+        }
+        if(!flipper_format_read_uint32(ff, "symbols", tmpl->symbols, symbols_size)) break;
+        tmpl->symbols_count = symbols_size / 2;
+        if(!flipper_format_read_uint32(ff, "length", &tmpl->length, 1)) break;
+        if(!flipper_format_read_uint32(ff, "repeat", &tmpl->repeat, 1)) break;
+        if(!infrared_template_is_valid(tmpl)) {
+            FURI_LOG_E(TAG, "Template is out of range");
+            break;
+        }
+        if(!flipper_format_read_hex(
+               ff, "stream", tmpl->stream, infrared_template_get_stream_size(tmpl)))
+            break;
+
+        const size_t timings_size = infrared_template_get_timings_size(tmpl);
+        uint32_t* timings = malloc(sizeof(uint32_t) * timings_size);
+        success = infrared_template_expand(tmpl, timings, timings_size) == timings_size;
+
+        if(success) {
+            infrared_signal_set_raw_signal(
+                signal, timings, timings_size, tmpl->frequency, tmpl->duty_cycle);
+        } else {
+            FURI_LOG_E(TAG, "Corrupted template stream");
+        }
+
+        free(timings);
+    } while(false);
+
+    free(tmpl);
+    return success;
+}
+
 static bool infrared_signal_read_body(InfraredSignal* signal, FlipperFormat* ff) {
     FuriString* tmp = furi_string_alloc();
 
@@ -157,6 +201,8 @@ static bool infrared_signal_read_body(InfraredSignal* signal, FlipperFormat* ff)
             success = infrared_signal_read_raw(signal, ff);
         } else if(furi_string_equal(tmp, "parsed")) {
             success = infrared_signal_read_message(signal, ff);
+        } else if(furi_string_equal(tmp, "template")) {
+            success = infrared_signal_read_template(signal, ff);
         } else {
             FURI_LOG_E(TAG, "Unknown signal type");
         }
@@ -14,6 +14,8 @@ TARGET_HW = 7
 COMPACT = 1
 ## Optimize for debugging experience
 DEBUG = 0
+## Serve small allocations from slab pages
+MEMMGR_SLAB = 0
 
 # Suffix to add to files when building distribution
 # If OS environment has DIST_SUFFIX set, it will be used instead
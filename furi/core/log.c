@@ -1,15 +1,77 @@
 #include "log.h"
 #include "check.h"
+#include "kernel.h"
 #include "mutex.h"
+#include "thread.h"
 #include <furi_hal.h>
+#include <stddef.h>
 
 #define FURI_LOG_LEVEL_DEFAULT FuriLogLevelInfo
 
+#define FURI_LOG_DEFERRED_BUFFER_SIZE (4096UL)
+#define FURI_LOG_DEFERRED_BUFFER_MASK (FURI_LOG_DEFERRED_BUFFER_SIZE - 1)
+#define FURI_LOG_DEFERRED_RECORD_MAX (256UL)
+#define FURI_LOG_DEFERRED_STRING_MAX (64UL)
+#define FURI_LOG_DEFERRED_SPEC_MAX (16UL)
+#define FURI_LOG_DEFERRED_STACK_SIZE (2048UL)
+#define FURI_LOG_DEFERRED_FLUSH_WAIT_TICKS (10UL)
+
+#define FURI_LOG_RECORD_PADDING (1UL << 31)
+
+#define FURI_LOG_DEFERRED_FLAG_RECORD (1UL << 0)
+
+/* Record in the deferred ring, followed by arguments and strings that can't be referenced.
+ * Size is written last, zero until producer is done with the record. Zero sized records don't
+ * exist: consumer clears every record it has printed. */
+typedef struct {
+    uint32_t size;
+    uint32_t timestamp;
+    const char* tag;
+    const char* format;
+    uint8_t level;
+    bool raw;
+} FuriLogRecord;
+
+typedef enum {
+    FuriLogArgNone,
+    FuriLogArgSkip,
+    FuriLogArgInt,
+    FuriLogArgLong,
+    FuriLogArgLongLong,
+    FuriLogArgIntMax,
+    FuriLogArgSize,
+    FuriLogArgPtrDiff,
+    FuriLogArgDouble,
+    FuriLogArgLongDouble,
+    FuriLogArgPointer,
+    FuriLogArgString,
+    FuriLogArgInvalid,
+} FuriLogArgType;
+
+typedef struct {
+    FuriLogArgType type;
+    uint8_t stars; /**< count of `*` width and precision arguments before the value */
+    bool star_precision; /**< precision is the last `*` argument */
+    int precision; /**< literal precision, -1 if not set */
+} FuriLogSpec;
+
+typedef struct {
+    uint8_t* buffer;
+    uint32_t head; /**< reserved by producers, free running */
+    uint32_t tail; /**< released by consumer, free running */
+    uint32_t written;
+    uint32_t dropped;
+    FuriThread* thread;
+    FuriThreadId thread_id;
+} FuriLogDeferred;
+
 typedef struct {
     FuriLogLevel log_level;
     FuriLogPuts puts;
     FuriLogTimestamp timestamp;
     FuriMutex* mutex;
+    FuriLogMode mode;
+    FuriLogDeferred deferred;
 } FuriLogParams;
 
 static FuriLogParams furi_log;
@@ -35,53 +97,542 @@ void furi_log_init() {
     furi_log.puts = furi_hal_console_puts;
     furi_log.timestamp = furi_get_tick;
     furi_log.mutex = furi_mutex_alloc(FuriMutexTypeNormal);
+    furi_log.mode = FuriLogModeSync;
 }
 
-void furi_log_print_format(FuriLogLevel level, const char* tag, const char* format, ...) {
-    if(level <= furi_log.log_level &&
-       furi_mutex_acquire(furi_log.mutex, FuriWaitForever) == FuriStatusOk) {
-        FuriString* string;
-        string = furi_string_alloc();
+static void furi_log_cat_header(
+    FuriString* string,
+    FuriLogLevel level,
+    const char* tag,
+    uint32_t timestamp) {
+    const char* color = _FURI_LOG_CLR_RESET;
+    const char* log_letter = " ";
+    switch(level) {
+    case FuriLogLevelError:
+        color = _FURI_LOG_CLR_E;
+        log_letter = "E";
+        break;
+    case FuriLogLevelWarn:
+        color = _FURI_LOG_CLR_W;
+        log_letter = "W";
+        break;
+    case FuriLogLevelInfo:
+        color = _FURI_LOG_CLR_I;
+        log_letter = "I";
+        break;
+    case FuriLogLevelDebug:
+        color = _FURI_LOG_CLR_D;
+        log_letter = "D";
+        break;
+    case FuriLogLevelTrace:
+        color = _FURI_LOG_CLR_T;
+        log_letter = "T";
+        break;
+    default:
+        break;
+    }
+
+    // Timestamp
+    furi_string_cat_printf(
+        string, "%lu %s[%s][%s] " _FURI_LOG_CLR_RESET, timestamp, color, log_letter, tag);
+}
+
+/** Parse printf conversion specification
+ *
+ * @param      format  pointer to `%`
+ * @param      spec    parsed specification
+ *
+ * @return     pointer to the first character after the specification
+ */
+static const char* furi_log_spec_parse(const char* format, FuriLogSpec* spec) {
+    spec->type = FuriLogArgInvalid;
+    spec->stars = 0;
+    spec->star_precision = false;
+    spec->precision = -1;
+
+    format++;
+    while(*format && strchr("-+ #0", *format)) format++;
+
+    if(*format == '*') {
+        spec->stars++;
+        format++;
+    }
+    while(*format >= '0' && *format <= '9') format++;
+
+    if(*format == '.') {
+        format++;
+        spec->precision = 0;
+        if(*format == '*') {
+            spec->stars++;
+            spec->star_precision = true;
+            spec->precision = -1;
+            format++;
+        }
+        while(*format >= '0' && *format <= '9') {
+            spec->precision = spec->precision * 10 + (*format - '0');
+            format++;
+        }
+    }
 
-        const char* color = _FURI_LOG_CLR_RESET;
-        const char* log_letter = " ";
-        switch(level) {
-        case FuriLogLevelError:
-            color = _FURI_LOG_CLR_E;
-            log_letter = "E";
+    FuriLogArgType integer = FuriLogArgInt;
+    if(format[0] == 'h') {
+        format += (format[1] == 'h') ? 2 : 1;
+    } else if(format[0] == 'l' && format[1] == 'l') {
+        integer = FuriLogArgLongLong;
+        format += 2;
+    } else if(format[0] == 'l') {
+        integer = FuriLogArgLong;
+        format++;
+    } else if(format[0] == 'j') {
+        integer = FuriLogArgIntMax;
+        format++;
+    } else if(format[0] == 'z') {
+        integer = FuriLogArgSize;
+        format++;
+    } else if(format[0] == 't') {
+        integer = FuriLogArgPtrDiff;
+        format++;
+    } else if(format[0] == 'L') {
+        integer = FuriLogArgLongDouble;
+        format++;
+    }
+
+    switch(*format) {
+    case '%':
+        spec->type = FuriLogArgNone;
+        break;
+    case 'd':
+    case 'i':
+    case 'u':
+    case 'o':
+    case 'x':
+    case 'X':
+        if(integer != FuriLogArgLongDouble) spec->type = integer;
+        break;
+    case 'c':
+        // wint_t is promoted to int as well
+        spec->type = FuriLogArgInt;
+        break;
+    case 'f':
+    case 'F':
+    case 'e':
+    case 'E':
+    case 'g':
+    case 'G':
+    case 'a':
+    case 'A':
+        spec->type = (integer == FuriLogArgLongDouble) ? FuriLogArgLongDouble :
+                                                         FuriLogArgDouble;
+        break;
+    case 'p':
+        spec->type = FuriLogArgPointer;
+        break;
+    case 's':
+        spec->type = FuriLogArgString;
+        break;
+    case 'n':
+        // Consumed, never written
+        spec->type = FuriLogArgSkip;
+        break;
+    default:
+        return format;
+    }
+
+    return format + 1;
+}
+
+static inline bool furi_log_is_const(const char* str) {
+    // Firmware flash outlives any record, apps and stack don't
+    return (uintptr_t)str >= FLASH_BASE && (uintptr_t)str < (FLASH_BASE + FLASH_SIZE);
+}
+
+/** Size of string copy with terminator, 0 if string is too long to be deferred */
+static inline size_t furi_log_string_size(const char* str, size_t max) {
+    const size_t len = strnlen(str ? str : "(null)", MIN(max, FURI_LOG_DEFERRED_STRING_MAX + 1));
+    return (len > FURI_LOG_DEFERRED_STRING_MAX) ? 0 : len + 1;
+}
+
+/** Walk arguments and either measure or store them
+ *
+ * @param      format  printf format
+ * @param      args    format arguments
+ * @param      out     payload buffer, NULL to measure only
+ * @param      out_size  payload size, payload buffer size on input when storing
+ *
+ * @return     false if format is not supported or arguments don't fit
+ */
+static bool
+    furi_log_deferred_args(const char* format, va_list args, uint8_t* out, size_t* out_size) {
+    // Strings may change between measuring and storing, capacity is checked again
+    const size_t capacity = out ? *out_size : SIZE_MAX;
+    size_t size = 0;
+
+    while(*format) {
+        if(*format != '%') {
+            format++;
+            continue;
+        }
+
+        FuriLogSpec spec;
+        const char* end = furi_log_spec_parse(format, &spec);
+        if(spec.type == FuriLogArgInvalid ||
+           (size_t)(end - format) >= FURI_LOG_DEFERRED_SPEC_MAX) {
+            return false;
+        }
+        format = end;
+
+        int precision = spec.precision;
+        for(uint8_t i = 0; i < spec.stars; i++) {
+            int star = va_arg(args, int);
+            if(spec.star_precision && i == spec.stars - 1) precision = star;
+            if(size + sizeof(star) > capacity) return false;
+            if(out) memcpy(out + size, &star, sizeof(star));
+            size += sizeof(star);
+        }
+
+#define FURI_LOG_ARG_STORE(arg_type)                              \
+    {                                                             \
+        arg_type value = va_arg(args, arg_type);                  \
+        if(size + sizeof(value) > capacity) return false;         \
+        if(out) memcpy(out + size, &value, sizeof(value));        \
+        size += sizeof(value);                                    \
+    }
+
+        switch(spec.type) {
+        case FuriLogArgSkip:
+            (void)va_arg(args, void*);
+            break;
+        case FuriLogArgInt:
+            FURI_LOG_ARG_STORE(int);
+            break;
+        case FuriLogArgLong:
+            FURI_LOG_ARG_STORE(long);
+            break;
+        case FuriLogArgLongLong:
+            FURI_LOG_ARG_STORE(long long);
+            break;
+        case FuriLogArgIntMax:
+            FURI_LOG_ARG_STORE(intmax_t);
+            break;
+        case FuriLogArgSize:
+            FURI_LOG_ARG_STORE(size_t);
             break;
-        case FuriLogLevelWarn:
-            color = _FURI_LOG_CLR_W;
-            log_letter = "W";
+        case FuriLogArgPtrDiff:
+            FURI_LOG_ARG_STORE(ptrdiff_t);
             break;
-        case FuriLogLevelInfo:
-            color = _FURI_LOG_CLR_I;
-            log_letter = "I";
+        case FuriLogArgDouble:
+            FURI_LOG_ARG_STORE(double);
             break;
-        case FuriLogLevelDebug:
-            color = _FURI_LOG_CLR_D;
-            log_letter = "D";
+        case FuriLogArgLongDouble:
+            FURI_LOG_ARG_STORE(long double);
             break;
-        case FuriLogLevelTrace:
-            color = _FURI_LOG_CLR_T;
-            log_letter = "T";
+        case FuriLogArgPointer:
+            FURI_LOG_ARG_STORE(void*);
             break;
+        case FuriLogArgString: {
+            // Strings are copied, pointed memory may be gone by the time record is printed
+            const char* str = va_arg(args, const char*);
+            const size_t max = precision < 0 ? SIZE_MAX : (size_t)precision;
+            const size_t str_size = furi_log_string_size(str, max);
+            if(!str_size || size + str_size > capacity) return false;
+            if(out) {
+                memcpy(out + size, str ? str : "(null)", str_size - 1);
+                out[size + str_size - 1] = '\0';
+            }
+            size += str_size;
+            break;
+        }
         default:
             break;
         }
 
-        // Timestamp
-        furi_string_printf(
-            string,
-            "%lu %s[%s][%s] " _FURI_LOG_CLR_RESET,
-            furi_log.timestamp(),
-            color,
-            log_letter,
-            tag);
+#undef FURI_LOG_ARG_STORE
+    }
+
+    *out_size = size;
+    return true;
+}
+
+/** Reserve contiguous ring space
+ *
+ * @return     record pointer, NULL if ring is full
+ */
+static FuriLogRecord* furi_log_deferred_reserve(FuriLogDeferred* deferred, uint32_t size) {
+    uint32_t head = __atomic_load_n(&deferred->head, __ATOMIC_RELAXED);
+    uint32_t padding;
+
+    do {
+        const uint32_t offset = head & FURI_LOG_DEFERRED_BUFFER_MASK;
+        padding = (offset + size > FURI_LOG_DEFERRED_BUFFER_SIZE) ?
+                      FURI_LOG_DEFERRED_BUFFER_SIZE - offset :
+                      0;
+        const uint32_t tail = __atomic_load_n(&deferred->tail, __ATOMIC_ACQUIRE);
+        if(head + padding + size - tail > FURI_LOG_DEFERRED_BUFFER_SIZE) {
+            return NULL;
+        }
+    } while(!__atomic_compare_exchange_n(
+        &deferred->head,
+        &head,
+        head + padding + size,
+        true,
+        __ATOMIC_SEQ_CST,
+        __ATOMIC_RELAXED));
+
+    if(padding) {
+        uint32_t* marker = (uint32_t*)&deferred->buffer[head & FURI_LOG_DEFERRED_BUFFER_MASK];
+        __atomic_store_n(marker, padding | FURI_LOG_RECORD_PADDING, __ATOMIC_RELEASE);
+    }
+
+    // Consumer sleeps while ring is empty, so only the first record needs to wake it
+    if(head == __atomic_load_n(&deferred->tail, __ATOMIC_SEQ_CST)) {
+        furi_thread_flags_set(deferred->thread_id, FURI_LOG_DEFERRED_FLAG_RECORD);
+    }
+
+    return (FuriLogRecord*)&deferred->buffer[(head + padding) & FURI_LOG_DEFERRED_BUFFER_MASK];
+}
+
+/** Enqueue record into deferred ring
+ *
+ * @return     false if record can't be deferred and must be printed synchronously
+ */
+static bool furi_log_deferred_push(
+    FuriLogLevel level,
+    bool raw,
+    const char* tag,
+    const char* format,
+    va_list args) {
+    FuriLogDeferred* deferred = &furi_log.deferred;
+
+    size_t args_size = 0;
+    va_list args_copy;
+    va_copy(args_copy, args);
+    const bool supported = furi_log_deferred_args(format, args_copy, NULL, &args_size);
+    va_end(args_copy);
+
+    const bool tag_copy = tag && !furi_log_is_const(tag);
+    const bool format_copy = !furi_log_is_const(format);
+    const size_t tag_size = tag_copy ? furi_log_string_size(tag, SIZE_MAX) : 0;
+    const size_t format_size = format_copy ? strlen(format) + 1 : 0;
+
+    size_t size = sizeof(FuriLogRecord) + args_size + tag_size + format_size;
+    const size_t align = __alignof__(FuriLogRecord);
+    size = (size + align - 1) & ~(align - 1);
+    if(!supported || (tag_copy && !tag_size) || size > FURI_LOG_DEFERRED_RECORD_MAX) {
+        return false;
+    }
+
+    FuriLogRecord* record = furi_log_deferred_reserve(deferred, size);
+    if(!record) {
+        __atomic_fetch_add(&deferred->dropped, 1, __ATOMIC_RELAXED);
+        return true;
+    }
+
+    uint8_t* payload = (uint8_t*)(record + 1);
+    if(!furi_log_deferred_args(format, args, payload, &args_size)) {
+        // Skipped by consumer
+        __atomic_fetch_add(&deferred->dropped, 1, __ATOMIC_RELAXED);
+        __atomic_store_n(&record->size, size | FURI_LOG_RECORD_PADDING, __ATOMIC_RELEASE);
+        return true;
+    }
+    payload += args_size;
+
+    record->timestamp = furi_log.timestamp();
+    record->level = level;
+    record->raw = raw;
+    record->tag = tag;
+    if(tag_copy) {
+        memcpy(payload, tag, tag_size - 1);
+        payload[tag_size - 1] = '\0';
+        record->tag = (const char*)payload;
+        payload += tag_size;
+    }
+    record->format = format;
+    if(format_copy) {
+        memcpy(payload, format, format_size);
+        record->format = (const char*)payload;
+    }
+
+    __atomic_fetch_add(&deferred->written, 1, __ATOMIC_RELAXED);
+    __atomic_store_n(&record->size, size, __ATOMIC_RELEASE);
+    return true;
+}
+
+static void furi_log_deferred_format(FuriString* string, const FuriLogRecord* record) {
+    const uint8_t* payload = (const uint8_t*)(record + 1);
+    const char* format = record->format;
+    char spec_str[FURI_LOG_DEFERRED_SPEC_MAX];
+
+    while(*format) {
+        const char* percent = strchr(format, '%');
+        if(!percent) {
+            furi_string_cat_str(string, format);
+            break;
+        }
+        furi_string_cat_printf(string, "%.*s", (int)(percent - format), format);
+
+        FuriLogSpec spec;
+        format = furi_log_spec_parse(percent, &spec);
+        memcpy(spec_str, percent, format - percent);
+        spec_str[format - percent] = '\0';
+
+        int star[2] = {0};
+        for(uint8_t i = 0; i < spec.stars; i++) {
+            memcpy(&star[i], payload, sizeof(int));
+            payload += sizeof(int);
+        }
+
+#define FURI_LOG_ARG_PRINT(value)                                                 \
+    {                                                                             \
+        if(spec.stars == 0) {                                                     \
+            furi_string_cat_printf(string, spec_str, value);                      \
+        } else if(spec.stars == 1) {                                              \
+            furi_string_cat_printf(string, spec_str, star[0], value);             \
+        } else {                                                                  \
+            furi_string_cat_printf(string, spec_str, star[0], star[1], value);    \
+        }                                                                         \
+    }
+
+#define FURI_LOG_ARG_LOAD_PRINT(arg_type)               \
+    {                                                   \
+        arg_type value;                                 \
+        memcpy(&value, payload, sizeof(value));         \
+        payload += sizeof(value);                       \
+        FURI_LOG_ARG_PRINT(value);                      \
+    }
+
+        switch(spec.type) {
+        case FuriLogArgNone:
+            furi_string_push_back(string, '%');
+            break;
+        case FuriLogArgInt:
+            FURI_LOG_ARG_LOAD_PRINT(int);
+            break;
+        case FuriLogArgLong:
+            FURI_LOG_ARG_LOAD_PRINT(long);
+            break;
+        case FuriLogArgLongLong:
+            FURI_LOG_ARG_LOAD_PRINT(long long);
+            break;
+        case FuriLogArgIntMax:
+            FURI_LOG_ARG_LOAD_PRINT(intmax_t);
+            break;
+        case FuriLogArgSize:
+            FURI_LOG_ARG_LOAD_PRINT(size_t);
+            break;
+        case FuriLogArgPtrDiff:
+            FURI_LOG_ARG_LOAD_PRINT(ptrdiff_t);
+            break;
+        case FuriLogArgDouble:
+            FURI_LOG_ARG_LOAD_PRINT(double);
+            break;
+        case FuriLogArgLongDouble:
+            FURI_LOG_ARG_LOAD_PRINT(long double);
+            break;
+        case FuriLogArgPointer:
+            FURI_LOG_ARG_LOAD_PRINT(void*);
+            break;
+        case FuriLogArgString: {
+            const char* value = (const char*)payload;
+            payload += strlen(value) + 1;
+            FURI_LOG_ARG_PRINT(value);
+            break;
+        }
+        default:
+            break;
+        }
+
+#undef FURI_LOG_ARG_LOAD_PRINT
+#undef FURI_LOG_ARG_PRINT
+    }
+}
+
+/** Print and release committed records, must be called with log mutex held
+ *
+ * @return     true if ring is empty, false if a record is still being written
+ */
+static bool furi_log_deferred_drain(FuriString* string) {
+    FuriLogDeferred* deferred = &furi_log.deferred;
+
+    while(true) {
+        const uint32_t tail = deferred->tail;
+        if(tail == __atomic_load_n(&deferred->head, __ATOMIC_SEQ_CST)) return true;
+
+        FuriLogRecord* record =
+            (FuriLogRecord*)&deferred->buffer[tail & FURI_LOG_DEFERRED_BUFFER_MASK];
+        uint32_t size = __atomic_load_n(&record->size, __ATOMIC_ACQUIRE);
+        if(size == 0) return false;
+
+        if(!(size & FURI_LOG_RECORD_PADDING)) {
+            furi_string_reset(string);
+            if(!record->raw) {
+                furi_log_cat_header(string, record->level, record->tag, record->timestamp);
+            }
+            furi_log_deferred_format(string, record);
+            if(!record->raw) {
+                furi_string_cat_str(string, "\r\n");
+            }
+
+            furi_log.puts(furi_string_get_cstr(string));
+        }
+
+        size &= ~FURI_LOG_RECORD_PADDING;
+        memset(record, 0, size);
+        __atomic_store_n(&deferred->tail, tail + size, __ATOMIC_SEQ_CST);
+    }
+}
+
+/** Print queued records ahead of a record that can't be deferred, must be called with log mutex
+ * held. A producer preempted mid record is waited for a few ticks, then its record is left behind.
+ */
+static void furi_log_deferred_flush(FuriString* string) {
+    if(furi_log.mode != FuriLogModeDeferred || !furi_log.deferred.thread) return;
+
+    for(size_t i = 0; i < FURI_LOG_DEFERRED_FLUSH_WAIT_TICKS; i++) {
+        if(furi_log_deferred_drain(string)) break;
+        furi_delay_tick(1);
+    }
+    furi_string_reset(string);
+}
+
+static int32_t furi_log_deferred_worker(void* context) {
+    UNUSED(context);
+
+    FuriString* string = furi_string_alloc();
+    bool empty = true;
+
+    while(true) {
+        // Producer preempted mid record is waited for with a short timeout
+        furi_thread_flags_wait(
+            FURI_LOG_DEFERRED_FLAG_RECORD, FuriFlagWaitAny, empty ? FuriWaitForever : 1);
+        furi_check(furi_mutex_acquire(furi_log.mutex, FuriWaitForever) == FuriStatusOk);
+        empty = furi_log_deferred_drain(string);
+        furi_check(furi_mutex_release(furi_log.mutex) == FuriStatusOk);
+    }
+
+    furi_string_free(string);
+    return 0;
+}
+
+void furi_log_print_format(FuriLogLevel level, const char* tag, const char* format, ...) {
+    if(level > furi_log.log_level) return;
+
+    va_list args;
+    va_start(args, format);
+    bool deferred = (furi_log.mode == FuriLogModeDeferred) &&
+                    furi_log_deferred_push(level, false, tag, format, args);
+    va_end(args);
+
+    if(!deferred && furi_mutex_acquire(furi_log.mutex, FuriWaitForever) == FuriStatusOk) {
+        FuriString* string;
+        string = furi_string_alloc();
+
+        // Keep order with records still queued
+        furi_log_deferred_flush(string);
+
+        furi_log_cat_header(string, level, tag, furi_log.timestamp());
         furi_log.puts(furi_string_get_cstr(string));
         furi_string_reset(string);
 
-        va_list args;
         va_start(args, format);
         furi_string_vprintf(string, format, args);
         va_end(args);
@@ -96,11 +647,21 @@ void furi_log_print_format(FuriLogLevel level, const char* tag, const char* form
 }
 
 void furi_log_print_raw_format(FuriLogLevel level, const char* format, ...) {
-    if(level <= furi_log.log_level &&
-       furi_mutex_acquire(furi_log.mutex, FuriWaitForever) == FuriStatusOk) {
+    if(level > furi_log.log_level) return;
+
+    va_list args;
+    va_start(args, format);
+    bool deferred = (furi_log.mode == FuriLogModeDeferred) &&
+                    furi_log_deferred_push(level, true, NULL, format, args);
+    va_end(args);
+
+    if(!deferred && furi_mutex_acquire(furi_log.mutex, FuriWaitForever) == FuriStatusOk) {
         FuriString* string;
         string = furi_string_alloc();
-        va_list args;
+
+        // Keep order with records still queued
+        furi_log_deferred_flush(string);
+
         va_start(args, format);
         furi_string_vprintf(string, format, args);
         va_end(args);
@@ -123,6 +684,43 @@ FuriLogLevel furi_log_get_level(void) {
     return furi_log.log_level;
 }
 
+void furi_log_set_mode(FuriLogMode mode) {
+    furi_assert(!furi_kernel_is_irq_or_masked());
+    FuriLogDeferred* deferred = &furi_log.deferred;
+
+    if(mode == furi_log.mode) return;
+
+    if(mode == FuriLogModeDeferred) {
+        // Ring and worker are kept for good: a preempted producer may still hold on to them
+        if(!deferred->thread) {
+            deferred->buffer = malloc(FURI_LOG_DEFERRED_BUFFER_SIZE);
+            deferred->thread = furi_thread_alloc_ex(
+                "LogWorker", FURI_LOG_DEFERRED_STACK_SIZE, furi_log_deferred_worker, NULL);
+            furi_thread_set_priority(deferred->thread, FuriThreadPriorityLow);
+            furi_thread_start(deferred->thread);
+            deferred->thread_id = furi_thread_get_id(deferred->thread);
+        }
+        furi_log.mode = FuriLogModeDeferred;
+    } else {
+        furi_log.mode = FuriLogModeSync;
+        // Let worker print what was queued before returning to synchronous output
+        while(__atomic_load_n(&deferred->tail, __ATOMIC_SEQ_CST) !=
+              __atomic_load_n(&deferred->head, __ATOMIC_SEQ_CST)) {
+            furi_delay_tick(1);
+        }
+    }
+}
+
+FuriLogMode furi_log_get_mode(void) {
+    return furi_log.mode;
+}
+
+void furi_log_get_stats(FuriLogStats* stats) {
+    furi_assert(stats);
+    stats->written = __atomic_load_n(&furi_log.deferred.written, __ATOMIC_RELAXED);
+    stats->dropped = __atomic_load_n(&furi_log.deferred.dropped, __ATOMIC_RELAXED);
+}
+
 void furi_log_set_puts(FuriLogPuts puts) {
     furi_assert(puts);
     furi_log.puts = puts;
@@ -151,4 +749,4 @@ bool furi_log_level_from_string(const char* str, FuriLogLevel* level) {
         }
     }
     return false;
-}
\ No newline at end of file
+}
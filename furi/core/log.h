@@ -39,6 +39,16 @@ typedef enum {
 #define _FURI_LOG_CLR_D _FURI_LOG_CLR(_FURI_LOG_CLR_BLUE)
 #define _FURI_LOG_CLR_T _FURI_LOG_CLR(_FURI_LOG_CLR_PURPLE)
 
+typedef enum {
+    FuriLogModeSync, /**< Records are formatted and printed by the caller */
+    FuriLogModeDeferred, /**< Records are queued and printed by a low priority thread */
+} FuriLogMode;
+
+typedef struct {
+    uint32_t written; /**< Records queued in deferred mode */
+    uint32_t dropped; /**< Records lost because deferred buffer was full */
+} FuriLogStats;
+
 typedef void (*FuriLogPuts)(const char* data);
 typedef uint32_t (*FuriLogTimestamp)(void);
 
@@ -76,6 +86,29 @@ void furi_log_set_level(FuriLogLevel level);
  */
 FuriLogLevel furi_log_get_level();
 
+/** Set log mode
+ *
+ * In deferred mode caller only copies arguments into a ring buffer, formatting and output happen
+ * in a low priority thread. Records that don't fit are dropped and counted. Records with
+ * unsupported format, too many arguments or long string arguments are printed synchronously.
+ * Switching back to synchronous mode waits until queued records are printed.
+ *
+ * @param[in]  mode  The mode
+ */
+void furi_log_set_mode(FuriLogMode mode);
+
+/** Get log mode
+ *
+ * @return     The furi log mode.
+ */
+FuriLogMode furi_log_get_mode(void);
+
+/** Get deferred mode counters
+ *
+ * @param[out] stats  The stats
+ */
+void furi_log_get_stats(FuriLogStats* stats);
+
 /** Set log output callback
  *
  * @param[in]  puts  The puts callback
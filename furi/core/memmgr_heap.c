@@ -38,6 +38,7 @@
 #include "check.h"
 #include <stdlib.h>
 #include <stdio.h>
+#include <string.h>
 #include <stm32wbxx.h>
 #include <furi_hal_console.h>
 #include <core/common_defines.h>
@@ -90,6 +91,18 @@ static void prvInsertBlockIntoFreeList(BlockLink_t* pxBlockToInsert);
  */
 static void prvHeapInit(void);
 
+/*
+ * Allocates memory on behalf of caller, caller is recorded by heap profiler.
+ */
+void* memmgr_heap_malloc(size_t xWantedSize, void* caller);
+
+/*
+ * Takes a block from the heap free list, returns NULL if there is no block big enough.
+ */
+static void* memmgr_heap_block_alloc(size_t xWantedSize, void* caller);
+
+size_t xPortGetTotalHeapSize(void);
+
 /*-----------------------------------------------------------*/
 
 /* The size of the structure placed at the beginning of each allocated memory
@@ -114,6 +127,101 @@ static size_t xBlockAllocatedBit = 0;
 /* Furi heap extension */
 #include <m-dict.h>
 
+#ifdef FURI_MEMMGR_SLAB
+/* Slab allocator
+ *
+ * Small requests are served from fixed size objects packed into pages taken from the heap,
+ * so short lived small allocations don't split free blocks all over the heap. Request goes to
+ * the heap when its size class can't get a page. Pages are kept in address order to find the
+ * page owning a pointer on free.
+ */
+#define MEMMGR_HEAP_SLAB_PAGE_SIZE (1024)
+#define MEMMGR_HEAP_SLAB_PAGES_MAX (48)
+
+typedef struct MemmgrHeapSlabPage {
+    struct MemmgrHeapSlabPage* next; /* next page of the same size class */
+    uint32_t used_map[2];
+    uint32_t profiled_map[2]; /* objects counted by the running heap profile */
+    uint16_t used;
+    uint8_t size_class;
+} MemmgrHeapSlabPage;
+
+#define MEMMGR_HEAP_SLAB_PAGE_HEADER_SIZE \
+    ((sizeof(MemmgrHeapSlabPage) + portBYTE_ALIGNMENT_MASK) & ~portBYTE_ALIGNMENT_MASK)
+
+typedef struct {
+    MemmgrHeapSlabPage* pages;
+    uint16_t object_size;
+    uint16_t capacity; /* objects per page */
+    size_t objects;
+    size_t objects_peak;
+    size_t pages_count;
+    size_t empty_pages;
+    uint32_t allocs;
+    uint32_t fallbacks;
+} MemmgrHeapSlabClass;
+
+#define MEMMGR_HEAP_SLAB_CLASS(size)                                                       \
+    {                                                                                      \
+        .object_size = (size),                                                             \
+        .capacity = (MEMMGR_HEAP_SLAB_PAGE_SIZE - MEMMGR_HEAP_SLAB_PAGE_HEADER_SIZE) / (size), \
+    }
+
+static MemmgrHeapSlabClass memmgr_heap_slab_classes[] = {
+    MEMMGR_HEAP_SLAB_CLASS(16),
+    MEMMGR_HEAP_SLAB_CLASS(32),
+    MEMMGR_HEAP_SLAB_CLASS(48),
+    MEMMGR_HEAP_SLAB_CLASS(64),
+    MEMMGR_HEAP_SLAB_CLASS(96),
+    MEMMGR_HEAP_SLAB_CLASS(128),
+};
+
+#define MEMMGR_HEAP_SLAB_CLASSES COUNT_OF(memmgr_heap_slab_classes)
+#define MEMMGR_HEAP_SLAB_SIZE_MAX (128)
+
+static MemmgrHeapSlabPage* memmgr_heap_slab_pages[MEMMGR_HEAP_SLAB_PAGES_MAX];
+static size_t memmgr_heap_slab_pages_count = 0;
+
+/* Must be called with scheduler suspended */
+static MemmgrHeapSlabPage* memmgr_heap_slab_find_page(const void* pointer) {
+    const uint8_t* address = pointer;
+    size_t low = 0;
+    size_t high = memmgr_heap_slab_pages_count;
+
+    // Last page starting at or below address
+    while(low < high) {
+        const size_t mid = (low + high) / 2;
+        if((uint8_t*)memmgr_heap_slab_pages[mid] <= address) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+
+    if(low == 0) return NULL;
+    MemmgrHeapSlabPage* page = memmgr_heap_slab_pages[low - 1];
+    return address < (uint8_t*)page + MEMMGR_HEAP_SLAB_PAGE_SIZE ? page : NULL;
+}
+
+/* Must be called with scheduler suspended, returns object index or -1 if not an object start */
+static int32_t memmgr_heap_slab_get_index(const MemmgrHeapSlabPage* page, const void* pointer) {
+    const MemmgrHeapSlabClass* slab_class = &memmgr_heap_slab_classes[page->size_class];
+    const size_t offset = (uint8_t*)pointer - (uint8_t*)page;
+    if(offset < MEMMGR_HEAP_SLAB_PAGE_HEADER_SIZE) return -1;
+
+    const size_t index = (offset - MEMMGR_HEAP_SLAB_PAGE_HEADER_SIZE) / slab_class->object_size;
+    if(index >= slab_class->capacity ||
+       (offset - MEMMGR_HEAP_SLAB_PAGE_HEADER_SIZE) % slab_class->object_size) {
+        return -1;
+    }
+    return index;
+}
+
+static inline bool memmgr_heap_slab_is_used(const MemmgrHeapSlabPage* page, size_t index) {
+    return page->used_map[index / 32] & (1UL << (index % 32));
+}
+#endif
+
 /* Allocation tracking types */
 DICT_DEF2(MemmgrHeapAllocDict, uint32_t, uint32_t) //-V1048
 
@@ -173,6 +281,16 @@ size_t memmgr_heap_get_thread_memory(FuriThreadId thread_id) {
                 MemmgrHeapAllocDict_itref_t* data = MemmgrHeapAllocDict_ref(alloc_dict_it);
                 if(data->key != 0) {
                     uint8_t* puc = (uint8_t*)data->key;
+#ifdef FURI_MEMMGR_SLAB
+                    MemmgrHeapSlabPage* page = memmgr_heap_slab_find_page(puc);
+                    if(page) {
+                        const int32_t index = memmgr_heap_slab_get_index(page, puc);
+                        if(index >= 0 && memmgr_heap_slab_is_used(page, index)) {
+                            leftovers += data->value;
+                        }
+                        continue;
+                    }
+#endif
                     puc -= xHeapStructSize;
                     BlockLink_t* pxLink = (void*)puc;
 
@@ -220,10 +338,10 @@ static inline void traceFREE(void* pointer, size_t size) {
     }
 }
 
-size_t memmgr_heap_get_max_free_block() {
+/* Must be called with scheduler suspended */
+static size_t memmgr_heap_find_max_free_block() {
     size_t max_free_size = 0;
     BlockLink_t* pxBlock;
-    vTaskSuspendAll();
 
     pxBlock = xStart.pxNextFreeBlock;
     while(pxBlock->pxNextFreeBlock != NULL) {
@@ -233,10 +351,325 @@ size_t memmgr_heap_get_max_free_block() {
         pxBlock = pxBlock->pxNextFreeBlock;
     }
 
+    return max_free_size;
+}
+
+size_t memmgr_heap_get_max_free_block() {
+    size_t max_free_size;
+    vTaskSuspendAll();
+    max_free_size = memmgr_heap_find_max_free_block();
     xTaskResumeAll();
     return max_free_size;
 }
 
+/* Heap profiler
+ *
+ * Profiled blocks keep thread and allocation site slots in the unused high bits of their
+ * size: heap is smaller than 256KB, so bits 18-30 are always zero otherwise. Blocks allocated
+ * before profiling started carry no tag and are not accounted on free.
+ */
+#define MEMMGR_HEAP_PROFILE_TAG_FLAG (1UL << 18)
+#define MEMMGR_HEAP_PROFILE_THREAD_SHIFT (19)
+#define MEMMGR_HEAP_PROFILE_THREAD_MASK (0x1FUL)
+#define MEMMGR_HEAP_PROFILE_SITE_SHIFT (24)
+#define MEMMGR_HEAP_PROFILE_SITE_MASK (0x7FUL)
+#define MEMMGR_HEAP_PROFILE_TAG_MASK (0x7FFC0000UL)
+
+/* Slot 0 in a tag means untracked */
+#define MEMMGR_HEAP_PROFILE_THREADS (MEMMGR_HEAP_PROFILE_THREAD_MASK)
+#define MEMMGR_HEAP_PROFILE_SITES (MEMMGR_HEAP_PROFILE_SITE_MASK)
+#define MEMMGR_HEAP_PROFILE_SIZE_CLASSES (16)
+#define MEMMGR_HEAP_PROFILE_SAMPLES (64)
+#define MEMMGR_HEAP_PROFILE_SAMPLE_PERIOD (100)
+
+typedef struct {
+    MemmgrHeapProfileHeader header;
+    uint32_t size_classes[MEMMGR_HEAP_PROFILE_SIZE_CLASSES];
+    MemmgrHeapProfileSite sites[MEMMGR_HEAP_PROFILE_SITES];
+    MemmgrHeapProfileThread threads[MEMMGR_HEAP_PROFILE_THREADS];
+    MemmgrHeapProfileSample samples[MEMMGR_HEAP_PROFILE_SAMPLES];
+    uint32_t last_sample_tick;
+} MemmgrHeapProfile;
+
+static MemmgrHeapProfile* memmgr_heap_profile = NULL;
+static volatile bool memmgr_heap_profile_running = false;
+
+static inline size_t memmgr_heap_profile_size_class(size_t size) {
+    if(size <= 8) return 0;
+    const size_t size_class = 32 - __builtin_clz(size - 1) - 3;
+    return MIN(size_class, (size_t)MEMMGR_HEAP_PROFILE_SIZE_CLASSES - 1);
+}
+
+static size_t memmgr_heap_profile_get_site(MemmgrHeapProfile* profile, uint32_t address) {
+    size_t index = (address >> 1) % MEMMGR_HEAP_PROFILE_SITES;
+    for(size_t i = 0; i < MEMMGR_HEAP_PROFILE_SITES; i++) {
+        MemmgrHeapProfileSite* site = &profile->sites[index];
+        if(site->address == 0) {
+            site->address = address;
+        }
+        if(site->address == address) {
+            return index + 1;
+        }
+        index = (index + 1) % MEMMGR_HEAP_PROFILE_SITES;
+    }
+    return 0;
+}
+
+static size_t memmgr_heap_profile_get_thread(MemmgrHeapProfile* profile, FuriThreadId thread_id) {
+    if(!thread_id) return 0;
+
+    // Thread ids are reused, name tells restarted thread from a new one
+    char name[sizeof(profile->threads[0].name)] = {0};
+    const char* thread_name = furi_thread_get_name(thread_id);
+    if(thread_name) strncpy(name, thread_name, sizeof(name));
+
+    for(size_t i = 0; i < profile->header.thread_count; i++) {
+        MemmgrHeapProfileThread* thread = &profile->threads[i];
+        if(thread->thread_id == (uint32_t)thread_id && !memcmp(thread->name, name, sizeof(name))) {
+            return i + 1;
+        }
+    }
+
+    if(profile->header.thread_count == MEMMGR_HEAP_PROFILE_THREADS) return 0;
+
+    MemmgrHeapProfileThread* thread = &profile->threads[profile->header.thread_count++];
+    thread->thread_id = (uint32_t)thread_id;
+    memcpy(thread->name, name, sizeof(name));
+    return profile->header.thread_count;
+}
+
+static void memmgr_heap_profile_sample(MemmgrHeapProfile* profile) {
+    MemmgrHeapProfileHeader* header = &profile->header;
+    const uint32_t tick = xTaskGetTickCount();
+
+    if(header->sample_count && tick - profile->last_sample_tick < header->sample_period) return;
+    profile->last_sample_tick = tick;
+
+    // Halve resolution instead of dropping history, samples always span whole session
+    if(header->sample_count == MEMMGR_HEAP_PROFILE_SAMPLES) {
+        for(size_t i = 0; i < MEMMGR_HEAP_PROFILE_SAMPLES / 2; i++) {
+            profile->samples[i] = profile->samples[i * 2];
+        }
+        header->sample_count = MEMMGR_HEAP_PROFILE_SAMPLES / 2;
+        header->sample_period *= 2;
+    }
+
+    MemmgrHeapProfileSample* sample = &profile->samples[header->sample_count++];
+    sample->tick = tick;
+    sample->free = xFreeBytesRemaining;
+    sample->max_free_block = memmgr_heap_find_max_free_block();
+
+    if(sample->max_free_block < header->worst_max_free_block) {
+        header->worst_max_free_block = sample->max_free_block;
+        header->worst_max_free_block_tick = tick;
+    }
+}
+
+/* Must be called with scheduler suspended on freshly allocated block.
+ * Slab objects come without block: they are counted, but not tracked live, their pages are. */
+static void memmgr_heap_profile_malloc(BlockLink_t* block, size_t size, void* caller) {
+    if(!memmgr_heap_profile_running) return;
+
+    MemmgrHeapProfile* profile = memmgr_heap_profile;
+    MemmgrHeapProfileHeader* header = &profile->header;
+    const size_t block_size = block ? block->xBlockSize & ~xBlockAllocatedBit : 0;
+
+    header->alloc_count++;
+    header->live += block_size;
+    if(header->live > header->peak) header->peak = header->live;
+    profile->size_classes[memmgr_heap_profile_size_class(size)]++;
+
+    const size_t site_slot = memmgr_heap_profile_get_site(profile, (uint32_t)caller);
+    if(site_slot) {
+        MemmgrHeapProfileSite* site = &profile->sites[site_slot - 1];
+        site->count++;
+        site->bytes += block_size;
+        site->live += block_size;
+    }
+
+    const size_t thread_slot =
+        memmgr_heap_profile_get_thread(profile, furi_thread_get_current_id());
+    if(thread_slot) {
+        MemmgrHeapProfileThread* thread = &profile->threads[thread_slot - 1];
+        thread->count++;
+        thread->live += block_size;
+        if(thread->live > thread->peak) thread->peak = thread->live;
+    }
+
+    if(!site_slot || !thread_slot) header->untracked_count++;
+
+    if(block) {
+        block->xBlockSize |= MEMMGR_HEAP_PROFILE_TAG_FLAG |
+                             (thread_slot << MEMMGR_HEAP_PROFILE_THREAD_SHIFT) |
+                             (site_slot << MEMMGR_HEAP_PROFILE_SITE_SHIFT);
+    }
+
+    memmgr_heap_profile_sample(profile);
+}
+
+/* Must be called with scheduler suspended before block size is used */
+static void memmgr_heap_profile_free(BlockLink_t* block) {
+    const size_t tag = block->xBlockSize & MEMMGR_HEAP_PROFILE_TAG_MASK;
+    if(!tag) return;
+
+    block->xBlockSize &= ~MEMMGR_HEAP_PROFILE_TAG_MASK;
+
+    // Tags of stopped profile are just stripped
+    if(!memmgr_heap_profile_running) return;
+
+    MemmgrHeapProfile* profile = memmgr_heap_profile;
+    const size_t block_size = block->xBlockSize & ~xBlockAllocatedBit;
+    const size_t site_slot =
+        (tag >> MEMMGR_HEAP_PROFILE_SITE_SHIFT) & MEMMGR_HEAP_PROFILE_SITE_MASK;
+    const size_t thread_slot =
+        (tag >> MEMMGR_HEAP_PROFILE_THREAD_SHIFT) & MEMMGR_HEAP_PROFILE_THREAD_MASK;
+
+    profile->header.free_count++;
+    profile->header.live -= block_size;
+    if(site_slot) profile->sites[site_slot - 1].live -= block_size;
+    if(thread_slot) profile->threads[thread_slot - 1].live -= block_size;
+
+    memmgr_heap_profile_sample(profile);
+}
+
+#ifdef FURI_MEMMGR_SLAB
+/* Must be called with scheduler suspended on slab object counted by memmgr_heap_profile_malloc */
+static void memmgr_heap_profile_slab_free() {
+    if(!memmgr_heap_profile_running) return;
+
+    memmgr_heap_profile->header.free_count++;
+    memmgr_heap_profile_sample(memmgr_heap_profile);
+}
+#endif
+
+/* Must be called with scheduler suspended, forgets blocks tagged by previous profile */
+static void memmgr_heap_profile_clear_tags() {
+    BlockLink_t* pxBlock = (void*)(((size_t)ucHeap + portBYTE_ALIGNMENT_MASK) &
+                                   ~((size_t)portBYTE_ALIGNMENT_MASK));
+    while(pxBlock < pxEnd) {
+        pxBlock->xBlockSize &= ~MEMMGR_HEAP_PROFILE_TAG_MASK;
+        pxBlock = (void*)((uint8_t*)pxBlock + (pxBlock->xBlockSize & ~xBlockAllocatedBit));
+    }
+
+#ifdef FURI_MEMMGR_SLAB
+    for(size_t i = 0; i < memmgr_heap_slab_pages_count; i++) {
+        memset(
+            memmgr_heap_slab_pages[i]->profiled_map,
+            0,
+            sizeof(memmgr_heap_slab_pages[i]->profiled_map));
+    }
+#endif
+}
+
+void memmgr_heap_profile_start() {
+    furi_check(xPortGetTotalHeapSize() < MEMMGR_HEAP_PROFILE_TAG_FLAG);
+
+    MemmgrHeapProfile* profile = pvPortMalloc(sizeof(MemmgrHeapProfile));
+    MemmgrHeapProfile* previous;
+
+    vTaskSuspendAll();
+    {
+        memmgr_heap_profile_running = false;
+        memmgr_heap_profile_clear_tags();
+
+        profile->header.start_tick = xTaskGetTickCount();
+        profile->header.sample_period = MEMMGR_HEAP_PROFILE_SAMPLE_PERIOD;
+        profile->header.worst_max_free_block = memmgr_heap_find_max_free_block();
+        profile->header.worst_max_free_block_tick = profile->header.start_tick;
+
+        previous = memmgr_heap_profile;
+        memmgr_heap_profile = profile;
+        memmgr_heap_profile_running = true;
+    }
+    (void)xTaskResumeAll();
+
+    if(previous) vPortFree(previous);
+}
+
+void memmgr_heap_profile_stop() {
+    vTaskSuspendAll();
+    memmgr_heap_profile_running = false;
+    (void)xTaskResumeAll();
+}
+
+void memmgr_heap_profile_clear() {
+    MemmgrHeapProfile* profile;
+
+    vTaskSuspendAll();
+    {
+        memmgr_heap_profile_running = false;
+        profile = memmgr_heap_profile;
+        memmgr_heap_profile = NULL;
+    }
+    (void)xTaskResumeAll();
+
+    if(profile) vPortFree(profile);
+}
+
+bool memmgr_heap_profile_is_running() {
+    return memmgr_heap_profile_running;
+}
+
+uint8_t* memmgr_heap_profile_dump(size_t* size) {
+    furi_assert(size);
+
+    // Largest possible dump, allocated before profile is locked
+    uint8_t* dump = pvPortMalloc(sizeof(MemmgrHeapProfile));
+    size_t dump_size = 0;
+
+    vTaskSuspendAll();
+    {
+        MemmgrHeapProfile* profile = memmgr_heap_profile;
+        if(profile) {
+            MemmgrHeapProfileHeader header = profile->header;
+            header.magic = MEMMGR_HEAP_PROFILE_MAGIC;
+            header.version = MEMMGR_HEAP_PROFILE_VERSION;
+            header.header_size = sizeof(MemmgrHeapProfileHeader);
+            header.tick = xTaskGetTickCount();
+            header.heap_total = xPortGetTotalHeapSize();
+            header.heap_free = xFreeBytesRemaining;
+            header.heap_min_free = xMinimumEverFreeBytesRemaining;
+            header.max_free_block = memmgr_heap_find_max_free_block();
+            if(header.max_free_block < header.worst_max_free_block) {
+                header.worst_max_free_block = header.max_free_block;
+                header.worst_max_free_block_tick = header.tick;
+            }
+            header.size_class_count = MEMMGR_HEAP_PROFILE_SIZE_CLASSES;
+            header.site_count = 0;
+
+            dump_size = sizeof(header);
+            memcpy(dump + dump_size, profile->size_classes, sizeof(profile->size_classes));
+            dump_size += sizeof(profile->size_classes);
+
+            for(size_t i = 0; i < MEMMGR_HEAP_PROFILE_SITES; i++) {
+                if(profile->sites[i].address == 0) continue;
+                memcpy(dump + dump_size, &profile->sites[i], sizeof(MemmgrHeapProfileSite));
+                dump_size += sizeof(MemmgrHeapProfileSite);
+                header.site_count++;
+            }
+
+            const size_t threads_size = header.thread_count * sizeof(MemmgrHeapProfileThread);
+            memcpy(dump + dump_size, profile->threads, threads_size);
+            dump_size += threads_size;
+
+            const size_t samples_size = header.sample_count * sizeof(MemmgrHeapProfileSample);
+            memcpy(dump + dump_size, profile->samples, samples_size);
+            dump_size += samples_size;
+
+            memcpy(dump, &header, sizeof(header));
+        }
+    }
+    (void)xTaskResumeAll();
+
+    if(!dump_size) {
+        vPortFree(dump);
+        dump = NULL;
+    }
+
+    *size = dump_size;
+    return dump;
+}
+
 void memmgr_heap_printf_free_blocks() {
     BlockLink_t* pxBlock;
     //TODO enable when we can do printf with a locked scheduler
@@ -251,6 +684,195 @@ void memmgr_heap_printf_free_blocks() {
     //xTaskResumeAll();
 }
 
+#ifdef FURI_MEMMGR_SLAB
+/* Must be called with scheduler suspended */
+static MemmgrHeapSlabPage* memmgr_heap_slab_page_alloc(size_t size_class, void* caller) {
+    if(memmgr_heap_slab_pages_count == MEMMGR_HEAP_SLAB_PAGES_MAX) return NULL;
+
+    // Page is shared, it must not be accounted to the thread that happened to need it
+    memmgr_heap_thread_trace_depth++;
+    MemmgrHeapSlabPage* page = memmgr_heap_block_alloc(MEMMGR_HEAP_SLAB_PAGE_SIZE, caller);
+    memmgr_heap_thread_trace_depth--;
+    if(!page) return NULL;
+
+    memset(page, 0, MEMMGR_HEAP_SLAB_PAGE_HEADER_SIZE);
+    page->size_class = size_class;
+
+    size_t index = memmgr_heap_slab_pages_count;
+    while(index > 0 && memmgr_heap_slab_pages[index - 1] > page) {
+        memmgr_heap_slab_pages[index] = memmgr_heap_slab_pages[index - 1];
+        index--;
+    }
+    memmgr_heap_slab_pages[index] = page;
+    memmgr_heap_slab_pages_count++;
+
+    MemmgrHeapSlabClass* slab_class = &memmgr_heap_slab_classes[size_class];
+    page->next = slab_class->pages;
+    slab_class->pages = page;
+    slab_class->pages_count++;
+    slab_class->empty_pages++;
+
+    return page;
+}
+
+/* Must be called with scheduler suspended, page must be empty */
+static void memmgr_heap_slab_page_release(MemmgrHeapSlabPage* page) {
+    MemmgrHeapSlabClass* slab_class = &memmgr_heap_slab_classes[page->size_class];
+    MemmgrHeapSlabPage** link = &slab_class->pages;
+    while(*link != page) {
+        link = &(*link)->next;
+    }
+    *link = page->next;
+    slab_class->pages_count--;
+    slab_class->empty_pages--;
+
+    size_t index = 0;
+    while(memmgr_heap_slab_pages[index] != page) {
+        index++;
+    }
+    memmgr_heap_slab_pages_count--;
+    memmove(
+        &memmgr_heap_slab_pages[index],
+        &memmgr_heap_slab_pages[index + 1],
+        (memmgr_heap_slab_pages_count - index) * sizeof(MemmgrHeapSlabPage*));
+}
+
+static void* memmgr_heap_slab_alloc(size_t size, void* caller) {
+    if(size == 0 || size > MEMMGR_HEAP_SLAB_SIZE_MAX) return NULL;
+
+    size_t size_class = 0;
+    while(memmgr_heap_slab_classes[size_class].object_size < size) {
+        size_class++;
+    }
+
+    MemmgrHeapSlabClass* slab_class = &memmgr_heap_slab_classes[size_class];
+    void* object = NULL;
+
+    vTaskSuspendAll();
+    {
+        // Pages with free objects are kept in front
+        MemmgrHeapSlabPage* page = slab_class->pages;
+        if(!page || page->used == slab_class->capacity) {
+            page = memmgr_heap_slab_page_alloc(size_class, caller);
+        }
+
+        if(page) {
+            size_t index = 0;
+            while(memmgr_heap_slab_is_used(page, index)) {
+                index++;
+            }
+            page->used_map[index / 32] |= 1UL << (index % 32);
+            if(page->used++ == 0) slab_class->empty_pages--;
+
+            // Full page goes to the back, behind pages with free objects
+            if(page->used == slab_class->capacity && page->next) {
+                slab_class->pages = page->next;
+                MemmgrHeapSlabPage* last = page->next;
+                while(last->next) {
+                    last = last->next;
+                }
+                last->next = page;
+                page->next = NULL;
+            }
+
+            object = (uint8_t*)page + MEMMGR_HEAP_SLAB_PAGE_HEADER_SIZE +
+                     index * slab_class->object_size;
+
+            slab_class->allocs++;
+            slab_class->objects++;
+            if(slab_class->objects > slab_class->objects_peak) {
+                slab_class->objects_peak = slab_class->objects;
+            }
+
+            if(memmgr_heap_profile_running) {
+                page->profiled_map[index / 32] |= 1UL << (index % 32);
+                memmgr_heap_profile_malloc(NULL, size, caller);
+            }
+            traceMALLOC(object, slab_class->object_size);
+        } else {
+            slab_class->fallbacks++;
+        }
+    }
+    (void)xTaskResumeAll();
+
+    return object;
+}
+
+/* Returns false if pointer doesn't belong to slab */
+static bool memmgr_heap_slab_free(void* pointer) {
+    MemmgrHeapSlabPage* page;
+
+    vTaskSuspendAll();
+    {
+        page = memmgr_heap_slab_find_page(pointer);
+        if(page) {
+            MemmgrHeapSlabClass* slab_class = &memmgr_heap_slab_classes[page->size_class];
+            const int32_t index = memmgr_heap_slab_get_index(page, pointer);
+            furi_check(index >= 0 && memmgr_heap_slab_is_used(page, index));
+
+            page->used_map[index / 32] &= ~(1UL << (index % 32));
+            slab_class->objects--;
+            if(page->profiled_map[index / 32] & (1UL << (index % 32))) {
+                page->profiled_map[index / 32] &= ~(1UL << (index % 32));
+                memmgr_heap_profile_slab_free();
+            }
+            traceFREE(pointer, slab_class->object_size);
+
+            // Page with free objects goes to the front
+            if(page->used-- == slab_class->capacity && slab_class->pages != page) {
+                MemmgrHeapSlabPage** link = &slab_class->pages;
+                while(*link != page) {
+                    link = &(*link)->next;
+                }
+                *link = page->next;
+                page->next = slab_class->pages;
+                slab_class->pages = page;
+            }
+
+            // One empty page per class is kept to not bounce pages on alloc/free pairs
+            if(page->used == 0 && slab_class->empty_pages++ > 0) {
+                memmgr_heap_slab_page_release(page);
+                vPortFree(page);
+            }
+        }
+    }
+    (void)xTaskResumeAll();
+
+    return page != NULL;
+}
+#endif
+
+size_t memmgr_heap_slab_get_class_count() {
+#ifdef FURI_MEMMGR_SLAB
+    return MEMMGR_HEAP_SLAB_CLASSES;
+#else
+    return 0;
+#endif
+}
+
+void memmgr_heap_slab_get_stats(size_t index, MemmgrHeapSlabStats* stats) {
+    furi_assert(stats);
+    memset(stats, 0, sizeof(MemmgrHeapSlabStats));
+#ifdef FURI_MEMMGR_SLAB
+    furi_check(index < MEMMGR_HEAP_SLAB_CLASSES);
+
+    vTaskSuspendAll();
+    {
+        const MemmgrHeapSlabClass* slab_class = &memmgr_heap_slab_classes[index];
+        stats->object_size = slab_class->object_size;
+        stats->objects = slab_class->objects;
+        stats->objects_peak = slab_class->objects_peak;
+        stats->capacity = slab_class->pages_count * slab_class->capacity;
+        stats->pages = slab_class->pages_count;
+        stats->allocs = slab_class->allocs;
+        stats->fallbacks = slab_class->fallbacks;
+    }
+    (void)xTaskResumeAll();
+#else
+    UNUSED(index);
+#endif
+}
+
 #ifdef HEAP_PRINT_DEBUG
 char* ultoa(unsigned long num, char* str, int radix) {
     char temp[33]; // at radix 2 the string is at most 32 + 1 null long.
@@ -338,14 +960,47 @@ static void print_heap_free(void* ptr) {
 /*-----------------------------------------------------------*/
 
 void* pvPortMalloc(size_t xWantedSize) {
-    BlockLink_t *pxBlock, *pxPreviousBlock, *pxNewBlockLink;
+    return memmgr_heap_malloc(xWantedSize, __builtin_return_address(0));
+}
+
+void* memmgr_heap_malloc(size_t xWantedSize, void* caller) {
     void* pvReturn = NULL;
-    size_t to_wipe = xWantedSize;
 
     if(FURI_IS_IRQ_MODE()) {
         furi_crash("memmgt in ISR");
     }
 
+#ifdef FURI_MEMMGR_SLAB
+    pvReturn = memmgr_heap_slab_alloc(xWantedSize, caller);
+#endif
+
+    if(!pvReturn) {
+        pvReturn = memmgr_heap_block_alloc(xWantedSize, caller);
+    }
+
+#if(configUSE_MALLOC_FAILED_HOOK == 1)
+    {
+        if(pvReturn == NULL) {
+            extern void vApplicationMallocFailedHook(void);
+            vApplicationMallocFailedHook();
+        } else {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+#endif
+
+    configASSERT((((size_t)pvReturn) & (size_t)portBYTE_ALIGNMENT_MASK) == 0);
+
+    furi_check(pvReturn, xWantedSize ? "out of memory" : "malloc(0)");
+    pvReturn = memset(pvReturn, 0, xWantedSize);
+    return pvReturn;
+}
+
+static void* memmgr_heap_block_alloc(size_t xWantedSize, void* caller) {
+    BlockLink_t *pxBlock, *pxPreviousBlock, *pxNewBlockLink;
+    void* pvReturn = NULL;
+    size_t to_wipe = xWantedSize;
+
 #ifdef HEAP_PRINT_DEBUG
     BlockLink_t* print_heap_block = NULL;
 #endif
@@ -448,6 +1103,8 @@ void* pvPortMalloc(size_t xWantedSize) {
                     pxBlock->xBlockSize |= xBlockAllocatedBit;
                     pxBlock->pxNextFreeBlock = NULL;
 
+                    memmgr_heap_profile_malloc(pxBlock, to_wipe, caller);
+
 #ifdef HEAP_PRINT_DEBUG
                     print_heap_block = pxBlock;
 #endif
@@ -466,24 +1123,11 @@ void* pvPortMalloc(size_t xWantedSize) {
     (void)xTaskResumeAll();
 
 #ifdef HEAP_PRINT_DEBUG
-    print_heap_malloc(print_heap_block, print_heap_block->xBlockSize & ~xBlockAllocatedBit);
+    print_heap_malloc(
+        print_heap_block,
+        print_heap_block->xBlockSize & ~(xBlockAllocatedBit | MEMMGR_HEAP_PROFILE_TAG_MASK));
 #endif
 
-#if(configUSE_MALLOC_FAILED_HOOK == 1)
-    {
-        if(pvReturn == NULL) {
-            extern void vApplicationMallocFailedHook(void);
-            vApplicationMallocFailedHook();
-        } else {
-            mtCOVERAGE_TEST_MARKER();
-        }
-    }
-#endif
-
-    configASSERT((((size_t)pvReturn) & (size_t)portBYTE_ALIGNMENT_MASK) == 0);
-
-    furi_check(pvReturn, xWantedSize ? "out of memory" : "malloc(0)");
-    pvReturn = memset(pvReturn, 0, to_wipe);
     return pvReturn;
 }
 /*-----------------------------------------------------------*/
@@ -496,6 +1140,12 @@ void vPortFree(void* pv) {
         furi_crash("memmgt in ISR");
     }
 
+#ifdef FURI_MEMMGR_SLAB
+    if(pv != NULL && memmgr_heap_slab_free(pv)) {
+        return;
+    }
+#endif
+
     if(pv != NULL) {
         /* The memory being freed will have an BlockLink_t structure immediately
         before it. */
@@ -520,6 +1170,8 @@ void vPortFree(void* pv) {
 
                 vTaskSuspendAll();
                 {
+                    memmgr_heap_profile_free(pxLink);
+
                     furi_assert((size_t)pv >= SRAM_BASE);
                     furi_assert((size_t)pv < SRAM_BASE + 1024 * 256);
                     furi_assert(pxLink->xBlockSize >= xHeapStructSize);
@@ -5,6 +5,7 @@
 
 #pragma once
 
+#include <stdbool.h>
 #include <stdint.h>
 #include <core/thread.h>
 
@@ -44,6 +45,124 @@ size_t memmgr_heap_get_max_free_block();
  */
 void memmgr_heap_printf_free_blocks();
 
+typedef struct {
+    size_t object_size;
+    size_t objects; /**< objects in use */
+    size_t objects_peak;
+    size_t capacity; /**< objects fitting into current pages */
+    size_t pages;
+    uint32_t allocs; /**< allocations served */
+    uint32_t fallbacks; /**< allocations passed to the heap for lack of a page */
+} MemmgrHeapSlabStats;
+
+/** Get slab allocator size class count
+ *
+ * @return     size class count, 0 if firmware is built without slab allocator
+ */
+size_t memmgr_heap_slab_get_class_count();
+
+/** Get slab allocator size class statistics
+ *
+ * @param      index  size class index
+ * @param      stats  pointer to store statistics in
+ */
+void memmgr_heap_slab_get_stats(size_t index, MemmgrHeapSlabStats* stats);
+
+/** Heap profile dump format
+ *
+ * Little endian dump made of MemmgrHeapProfileHeader followed by size_class_count uint32_t
+ * allocation counters, site_count MemmgrHeapProfileSite, thread_count MemmgrHeapProfileThread
+ * and sample_count MemmgrHeapProfileSample, oldest sample first.
+ * Size class N counts requests of (2^(N+2), 2^(N+3)] bytes, class 0 also counts smaller ones
+ * and the last class everything above. scripts/heap_profile.py decodes and symbolizes it.
+ */
+#define MEMMGR_HEAP_PROFILE_MAGIC (0x44504846UL) /**< "FHPD" */
+#define MEMMGR_HEAP_PROFILE_VERSION (1)
+
+typedef struct {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t header_size;
+    uint32_t tick; /**< tick the dump was made at */
+    uint32_t start_tick; /**< tick profiling started at */
+    uint32_t heap_total;
+    uint32_t heap_free;
+    uint32_t heap_min_free;
+    uint32_t max_free_block;
+    uint32_t worst_max_free_block; /**< smallest largest free block seen while profiling */
+    uint32_t worst_max_free_block_tick;
+    uint32_t alloc_count;
+    uint32_t free_count;
+    uint32_t untracked_count; /**< allocations that didn't fit into site or thread tables */
+    uint32_t live; /**< bytes allocated since profiling start and not freed yet */
+    uint32_t peak; /**< peak of live */
+    uint32_t sample_period; /**< ticks between samples */
+    uint16_t size_class_count;
+    uint16_t site_count;
+    uint16_t thread_count;
+    uint16_t sample_count;
+} MemmgrHeapProfileHeader;
+
+typedef struct {
+    uint32_t address; /**< caller return address */
+    uint32_t count; /**< allocations made */
+    uint32_t bytes; /**< bytes allocated in total, including block headers */
+    uint32_t live; /**< bytes still allocated */
+} MemmgrHeapProfileSite;
+
+typedef struct {
+    uint32_t thread_id;
+    char name[12]; /**< truncated thread name, not always null terminated */
+    uint32_t count; /**< allocations made */
+    uint32_t live; /**< bytes still allocated */
+    uint32_t peak; /**< peak of live */
+} MemmgrHeapProfileThread;
+
+typedef struct {
+    uint32_t tick;
+    uint32_t free;
+    uint32_t max_free_block;
+} MemmgrHeapProfileSample;
+
+/** Start heap profiling
+ *
+ * Discards previous profile. Profile tables take about 4KB of heap while kept.
+ */
+void memmgr_heap_profile_start();
+
+/** Stop heap profiling, collected profile is kept until cleared or restarted
+ */
+void memmgr_heap_profile_stop();
+
+/** Stop heap profiling and release collected profile
+ */
+void memmgr_heap_profile_clear();
+
+/** Check if heap profiling is running
+ *
+ * @return     true if allocations are being recorded
+ */
+bool memmgr_heap_profile_is_running();
+
+/** Dump collected heap profile
+ *
+ * @param      size  pointer to store dump size in
+ *
+ * @return     dump allocated with malloc, caller must free it. NULL if there is no profile.
+ */
+uint8_t* memmgr_heap_profile_dump(size_t* size);
+
+/** Heap fragmentation index
+ *
+ * @param      free            free heap size
+ * @param      max_free_block  largest free block size
+ *
+ * @return     0 when all free memory is one block, up to 1000 when it is all scattered
+ */
+static inline uint32_t memmgr_heap_fragmentation_index(size_t free, size_t max_free_block) {
+    return free ? (uint32_t)(1000 - (uint64_t)max_free_block * 1000 / free) : 0;
+}
+
 #ifdef __cplusplus
 }
 #endif
@@ -2,38 +2,89 @@
 #include "memmgr.h"
 #include "check.h"
 #include "mutex.h"
+#include "kernel.h"
+#include "common_defines.h"
 
-#include <m-list.h>
+#include <string.h>
 
 struct FuriPubSubSubscription {
     FuriPubSubCallback callback;
     void* callback_context;
 };
 
-LIST_DEF(FuriPubSubSubscriptionList, FuriPubSubSubscription, M_POD_OPLIST);
+/* Immutable list of subscriptions.
+ * Publishers hold a reference while delivering, writers replace the whole snapshot. */
+typedef struct {
+    size_t refs;
+    size_t count;
+    FuriPubSubSubscription* items[];
+} FuriPubSubSnapshot;
 
+/* Publishers are counted per epoch: unsubscribe starts a new epoch and waits for publishers of
+ * the previous one, they are the only ones that may still see removed subscription. */
 struct FuriPubSub {
-    FuriPubSubSubscriptionList_t items;
+    FuriPubSubSnapshot* snapshot;
     FuriMutex* mutex;
+    uint8_t epoch;
+    size_t publishers[2];
 };
 
+static FuriPubSubSnapshot* furi_pubsub_snapshot_acquire(FuriPubSub* pubsub, uint8_t* epoch) {
+    FURI_CRITICAL_ENTER();
+    FuriPubSubSnapshot* snapshot = pubsub->snapshot;
+    if(snapshot) snapshot->refs++;
+    *epoch = pubsub->epoch;
+    pubsub->publishers[*epoch]++;
+    FURI_CRITICAL_EXIT();
+    return snapshot;
+}
+
+static void furi_pubsub_snapshot_release(FuriPubSubSnapshot* snapshot) {
+    if(!snapshot) return;
+
+    FURI_CRITICAL_ENTER();
+    bool last = (--snapshot->refs == 0);
+    FURI_CRITICAL_EXIT();
+
+    if(last) free(snapshot);
+}
+
+/** Replace current snapshot, must be called with mutex held
+ *
+ * @return     previous snapshot, reference formerly held by pubsub is passed to caller
+ */
+static FuriPubSubSnapshot*
+    furi_pubsub_snapshot_swap(FuriPubSub* pubsub, FuriPubSubSnapshot* snapshot) {
+    FURI_CRITICAL_ENTER();
+    FuriPubSubSnapshot* previous = pubsub->snapshot;
+    pubsub->snapshot = snapshot;
+    FURI_CRITICAL_EXIT();
+    return previous;
+}
+
+static FuriPubSubSnapshot* furi_pubsub_snapshot_alloc(size_t count) {
+    if(count == 0) return NULL;
+
+    FuriPubSubSnapshot* snapshot =
+        malloc(sizeof(FuriPubSubSnapshot) + count * sizeof(FuriPubSubSubscription*));
+    snapshot->refs = 1;
+    snapshot->count = count;
+    return snapshot;
+}
+
 FuriPubSub* furi_pubsub_alloc() {
     FuriPubSub* pubsub = malloc(sizeof(FuriPubSub));
 
     pubsub->mutex = furi_mutex_alloc(FuriMutexTypeNormal);
     furi_assert(pubsub->mutex);
 
-    FuriPubSubSubscriptionList_init(pubsub->items);
-
     return pubsub;
 }
 
 void furi_pubsub_free(FuriPubSub* pubsub) {
     furi_assert(pubsub);
 
-    furi_check(FuriPubSubSubscriptionList_size(pubsub->items) == 0);
-
-    FuriPubSubSubscriptionList_clear(pubsub->items);
+    furi_check(pubsub->snapshot == NULL);
 
     furi_mutex_free(pubsub->mutex);
 
@@ -42,16 +93,27 @@ void furi_pubsub_free(FuriPubSub* pubsub) {
 
 FuriPubSubSubscription*
     furi_pubsub_subscribe(FuriPubSub* pubsub, FuriPubSubCallback callback, void* callback_context) {
-    furi_check(furi_mutex_acquire(pubsub->mutex, FuriWaitForever) == FuriStatusOk);
-    // put uninitialized item to the list
-    FuriPubSubSubscription* item = FuriPubSubSubscriptionList_push_raw(pubsub->items);
-
-    // initialize item
+    FuriPubSubSubscription* item = malloc(sizeof(FuriPubSubSubscription));
     item->callback = callback;
     item->callback_context = callback_context;
 
+    furi_check(furi_mutex_acquire(pubsub->mutex, FuriWaitForever) == FuriStatusOk);
+
+    const FuriPubSubSnapshot* current = pubsub->snapshot;
+    const size_t count = current ? current->count : 0;
+    FuriPubSubSnapshot* snapshot = furi_pubsub_snapshot_alloc(count + 1);
+    if(count) {
+        memcpy(snapshot->items, current->items, count * sizeof(FuriPubSubSubscription*));
+    }
+    snapshot->items[count] = item;
+
+    FuriPubSubSnapshot* previous = furi_pubsub_snapshot_swap(pubsub, snapshot);
+
     furi_check(furi_mutex_release(pubsub->mutex) == FuriStatusOk);
 
+    // Publishers still delivering to the previous snapshot keep it alive
+    furi_pubsub_snapshot_release(previous);
+
     return item;
 }
 
@@ -60,36 +122,69 @@ void furi_pubsub_unsubscribe(FuriPubSub* pubsub, FuriPubSubSubscription* pubsub_
     furi_assert(pubsub_subscription);
 
     furi_check(furi_mutex_acquire(pubsub->mutex, FuriWaitForever) == FuriStatusOk);
-    bool result = false;
 
-    // iterate over items
-    FuriPubSubSubscriptionList_it_t it;
-    for(FuriPubSubSubscriptionList_it(it, pubsub->items); !FuriPubSubSubscriptionList_end_p(it);
-        FuriPubSubSubscriptionList_next(it)) {
-        const FuriPubSubSubscription* item = FuriPubSubSubscriptionList_cref(it);
+    const FuriPubSubSnapshot* current = pubsub->snapshot;
+    const size_t count = current ? current->count : 0;
+    FuriPubSubSnapshot* snapshot = furi_pubsub_snapshot_alloc(count ? count - 1 : 0);
+    bool result = false;
 
-        // if the iterator is equal to our element
-        if(item == pubsub_subscription) {
-            FuriPubSubSubscriptionList_remove(pubsub->items, it);
+    for(size_t i = 0, j = 0; i < count; i++) {
+        if(current->items[i] == pubsub_subscription) {
             result = true;
-            break;
+        } else if(j < count - 1) {
+            snapshot->items[j++] = current->items[i];
+        }
+    }
+
+    if(result) {
+        FuriPubSubSnapshot* previous = furi_pubsub_snapshot_swap(pubsub, snapshot);
+        furi_pubsub_snapshot_release(previous);
+
+        FURI_CRITICAL_ENTER();
+        const uint8_t epoch = pubsub->epoch;
+        pubsub->epoch = !epoch;
+        FURI_CRITICAL_EXIT();
+
+        // Callback must not be called once we return, new publishers can't see it anymore
+        while(true) {
+            FURI_CRITICAL_ENTER();
+            const bool in_use = pubsub->publishers[epoch] > 0;
+            FURI_CRITICAL_EXIT();
+            if(!in_use) break;
+            furi_delay_tick(1);
         }
+        free(pubsub_subscription);
+    } else {
+        free(snapshot);
     }
 
     furi_check(furi_mutex_release(pubsub->mutex) == FuriStatusOk);
     furi_check(result);
 }
 
+static void furi_pubsub_queue_callback(const void* message, void* context) {
+    // Slow consumer loses messages instead of stalling publisher
+    furi_message_queue_put(context, message, 0);
+}
+
+FuriPubSubSubscription* furi_pubsub_subscribe_queue(FuriPubSub* pubsub, FuriMessageQueue* queue) {
+    furi_assert(queue);
+    return furi_pubsub_subscribe(pubsub, furi_pubsub_queue_callback, queue);
+}
+
 void furi_pubsub_publish(FuriPubSub* pubsub, void* message) {
-    furi_check(furi_mutex_acquire(pubsub->mutex, FuriWaitForever) == FuriStatusOk);
+    uint8_t epoch;
+    FuriPubSubSnapshot* snapshot = furi_pubsub_snapshot_acquire(pubsub, &epoch);
 
     // iterate over subscribers
-    FuriPubSubSubscriptionList_it_t it;
-    for(FuriPubSubSubscriptionList_it(it, pubsub->items); !FuriPubSubSubscriptionList_end_p(it);
-        FuriPubSubSubscriptionList_next(it)) {
-        const FuriPubSubSubscription* item = FuriPubSubSubscriptionList_cref(it);
+    for(size_t i = 0; snapshot && i < snapshot->count; i++) {
+        const FuriPubSubSubscription* item = snapshot->items[i];
         item->callback(message, item->callback_context);
     }
 
-    furi_check(furi_mutex_release(pubsub->mutex) == FuriStatusOk);
+    furi_pubsub_snapshot_release(snapshot);
+
+    FURI_CRITICAL_ENTER();
+    pubsub->publishers[epoch]--;
+    FURI_CRITICAL_EXIT();
 }
@@ -4,6 +4,8 @@
  */
 #pragma once
 
+#include "message_queue.h"
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -44,9 +46,26 @@ void furi_pubsub_free(FuriPubSub* pubsub);
 FuriPubSubSubscription*
     furi_pubsub_subscribe(FuriPubSub* pubsub, FuriPubSubCallback callback, void* callback_context);
 
+/** Subscribe to FuriPubSub with a message queue
+ *
+ * Publisher copies message into the queue instead of calling back, so a slow subscriber doesn't
+ * stall it. Messages are dropped when queue is full. Queue message size must match the size of
+ * published messages.
+ *
+ * Threadsafe, Reentrable
+ *
+ * @param      pubsub  pointer to FuriPubSub instance
+ * @param      queue   message queue, must outlive the subscription
+ *
+ * @return     pointer to FuriPubSubSubscription instance
+ */
+FuriPubSubSubscription* furi_pubsub_subscribe_queue(FuriPubSub* pubsub, FuriMessageQueue* queue);
+
 /** Unsubscribe from FuriPubSub
  * 
  * No use of `pubsub_subscription` allowed after call of this method
+ * Waits for publishers still delivering to the subscription, so its callback is never called
+ * after return. Must not be called from a callback of the same FuriPubSub.
  * Threadsafe, Reentrable.
  *
  * @param      pubsub               pointer to FuriPubSub instance
@@ -56,6 +75,8 @@ void furi_pubsub_unsubscribe(FuriPubSub* pubsub, FuriPubSubSubscription* pubsub_
 
 /** Publish message to FuriPubSub
  *
+ * Callbacks are called without holding any lock, concurrent publishers don't wait for each
+ * other. Subscriptions added or removed during publish are not seen by it.
  * Threadsafe, Reentrable.
  * 
  * @param      pubsub   pointer to FuriPubSub instance
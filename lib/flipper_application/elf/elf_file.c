@@ -4,6 +4,9 @@
 #include "elf_file_i.h"
 #include "elf_api_interface.h"
 #include "../api_hashtable/api_hashtable.h"
+#include <furi_hal.h>
+#include <toolbox/crc32_calc.h>
+#include <toolbox/version.h>
 
 #define TAG "Elf"
 
@@ -13,6 +16,12 @@
 #define RESOLVER_THREAD_YIELD_STEP 30
 #define FAST_RELOCATION_VERSION 1
 
+#define RELOCATION_CACHE_MAGIC 0x43524C45
+#define RELOCATION_CACHE_VERSION 2
+#define RELOCATION_CACHE_FLAG_FAST (1 << 0)
+#define RELOCATION_CACHE_READ_CHUNK 32
+#define RELOCATION_CACHE_HASH_CHUNK 512
+
 // #define ELF_DEBUG_LOG 1
 
 #ifndef ELF_DEBUG_LOG
@@ -36,6 +45,17 @@ typedef struct {
     uint32_t addr;
 } __attribute__((packed)) JMPTrampoline;
 
+typedef struct {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t api_version_major;
+    uint16_t api_version_minor;
+    uint16_t reserved;
+    uint32_t firmware_hash;
+    uint32_t file_hash;
+    uint32_t entries_count;
+} __attribute__((packed)) ELFRelocationCacheHeader;
+
 /**************************************************************************************************/
 /********************************************* Caches *********************************************/
 /**************************************************************************************************/
@@ -54,6 +74,14 @@ static void address_cache_put(AddressCache_t cache, int symEntry, Elf32_Addr sym
     AddressCache_set_at(cache, symEntry, symAddr);
 }
 
+static inline uint32_t elf_profile_start() {
+    return DWT->CYCCNT;
+}
+
+static inline uint32_t elf_profile_us(uint32_t start) {
+    return (DWT->CYCCNT - start) / furi_hal_cortex_instructions_per_microsecond();
+}
+
 /**************************************************************************************************/
 /********************************************** ELF ***********************************************/
 /**************************************************************************************************/
@@ -397,8 +425,21 @@ static bool elf_relocate(ELFFile* elf, ELFSection* s) {
                     elf_reloc_type_to_str(relType),
                     furi_string_get_cstr(symbol_name));
 
+                uint32_t resolve_start = elf_profile_start();
                 symAddr = elf_address_of(elf, &sym, furi_string_get_cstr(symbol_name));
+                elf->profile.resolve_us += elf_profile_us(resolve_start);
+                elf->profile.symbols_resolved++;
                 address_cache_put(elf->relocation_cache, symEntry, symAddr);
+
+                if(elf->relocation_cache_path && symAddr != ELF_INVALID_ADDRESS) {
+                    ELFRelocationCacheEntry entry = {
+                        .key = symEntry,
+                        .value = sym.st_shndx == SHN_UNDEF ? symAddr : sym.st_value,
+                        .section = sym.st_shndx,
+                        .flags = 0,
+                    };
+                    ELFRelocationCacheArray_push_back(elf->relocation_cache_entries, entry);
+                }
             }
 
             if(symAddr != ELF_INVALID_ADDRESS) {
@@ -589,6 +630,7 @@ static SectionType elf_preload_section(
     if(strcmp(name, ".strtab") == 0) {
         FURI_LOG_D(TAG, "Found .strtab section");
         elf->symbol_table_strings = section_header->sh_offset;
+        elf->symbol_table_strings_size = section_header->sh_size;
         return SectionTypeStrTab;
     }
 
@@ -680,8 +722,22 @@ static bool elf_relocate_fast(ELFFile* elf, ELFSection* s) {
             if(symSec) {
                 address = ((Elf32_Addr)symSec->data) + section_value;
             }
-        } else {
+        } else if(!address_cache_get(elf->import_cache, hash_or_section_index, &address)) {
+            uint32_t resolve_start = elf_profile_start();
             address = elf_address_of_by_hash(elf, hash_or_section_index);
+            elf->profile.resolve_us += elf_profile_us(resolve_start);
+            elf->profile.symbols_resolved++;
+            address_cache_put(elf->import_cache, hash_or_section_index, address);
+
+            if(elf->relocation_cache_path && address != ELF_INVALID_ADDRESS) {
+                ELFRelocationCacheEntry entry = {
+                    .key = hash_or_section_index,
+                    .value = address,
+                    .section = SHN_UNDEF,
+                    .flags = RELOCATION_CACHE_FLAG_FAST,
+                };
+                ELFRelocationCacheArray_push_back(elf->relocation_cache_entries, entry);
+            }
         }
 
         if(address == ELF_INVALID_ADDRESS) {
@@ -751,12 +807,173 @@ static void elf_file_call_section_list(ELFSection* section, bool reverse_order)
     }
 }
 
+static uint32_t elf_relocation_cache_firmware_hash() {
+    const char* githash = version_get_githash(NULL);
+    const char* builddate = version_get_builddate(NULL);
+    uint32_t crc = crc32_calc_buffer(0, githash, strlen(githash));
+    return crc32_calc_buffer(crc, builddate, strlen(builddate));
+}
+
+static void elf_relocation_cache_fill_header(ELFFile* elf, ELFRelocationCacheHeader* header) {
+    header->magic = RELOCATION_CACHE_MAGIC;
+    header->version = RELOCATION_CACHE_VERSION;
+    header->api_version_major = elf->api_interface->api_version_major;
+    header->api_version_minor = elf->api_interface->api_version_minor;
+    header->reserved = 0;
+    header->firmware_hash = elf_relocation_cache_firmware_hash();
+    header->file_hash = elf->file_hash;
+    header->entries_count = ELFRelocationCacheArray_size(elf->relocation_cache_entries);
+}
+
+static bool elf_relocation_cache_apply(ELFFile* elf, const ELFRelocationCacheEntry* entry) {
+    if(entry->flags & RELOCATION_CACHE_FLAG_FAST) {
+        address_cache_put(elf->import_cache, entry->key, entry->value);
+    } else if(entry->section == SHN_UNDEF) {
+        address_cache_put(elf->relocation_cache, entry->key, entry->value);
+    } else {
+        ELFSection* symSec = elf_section_of(elf, entry->section);
+        if(!symSec) return false;
+        address_cache_put(
+            elf->relocation_cache, entry->key, ((Elf32_Addr)symSec->data) + entry->value);
+    }
+    return true;
+}
+
+static bool elf_relocation_cache_hash_file(ELFFile* elf, off_t offset, size_t size, void* buffer) {
+    if(!storage_file_seek(elf->fd, offset, true)) return false;
+
+    while(size) {
+        size_t chunk = MIN(size, (size_t)RELOCATION_CACHE_HASH_CHUNK);
+        if(storage_file_read(elf->fd, buffer, chunk) != chunk) return false;
+        elf->file_hash = crc32_calc_buffer(elf->file_hash, buffer, chunk);
+        size -= chunk;
+    }
+
+    return true;
+}
+
+// Cached values come from symbols and relocations, headers alone miss a rebuild of the same size
+static bool elf_relocation_cache_hash_contents(ELFFile* elf) {
+    bool result = true;
+    void* buffer = malloc(RELOCATION_CACHE_HASH_CHUNK);
+
+    result &= elf_relocation_cache_hash_file(
+        elf, elf->symbol_table, elf->symbol_count * sizeof(Elf32_Sym), buffer);
+    result &= elf_relocation_cache_hash_file(
+        elf, elf->symbol_table_strings, elf->symbol_table_strings_size, buffer);
+
+    ELFSectionDict_it_t it;
+    for(ELFSectionDict_it(it, elf->sections); result && !ELFSectionDict_end_p(it);
+        ELFSectionDict_next(it)) {
+        const ELFSection* section = &ELFSectionDict_cref(it)->value;
+        result &= elf_relocation_cache_hash_file(
+            elf, section->rel_offset, section->rel_count * sizeof(Elf32_Rel), buffer);
+        if(section->fast_rel && section->fast_rel->data) {
+            elf->file_hash = crc32_calc_buffer(
+                elf->file_hash, section->fast_rel->data, section->fast_rel->size);
+        }
+    }
+
+    free(buffer);
+    return result;
+}
+
+static bool elf_relocation_cache_load(ELFFile* elf) {
+    bool result = false;
+    File* file = storage_file_alloc(elf->storage);
+
+    do {
+        if(!storage_file_open(
+               file,
+               furi_string_get_cstr(elf->relocation_cache_path),
+               FSAM_READ,
+               FSOM_OPEN_EXISTING)) {
+            break;
+        }
+
+        ELFRelocationCacheHeader header, expected;
+        if(storage_file_read(file, &header, sizeof(header)) != sizeof(header)) break;
+
+        elf_relocation_cache_fill_header(elf, &expected);
+        expected.entries_count = header.entries_count;
+        if(memcmp(&header, &expected, sizeof(header)) != 0) {
+            FURI_LOG_I(TAG, "Relocation cache is outdated");
+            break;
+        }
+
+        ELFRelocationCacheEntry entries[RELOCATION_CACHE_READ_CHUNK];
+        size_t entries_left = header.entries_count;
+        result = true;
+        while(result && entries_left) {
+            size_t count = MIN(entries_left, (size_t)RELOCATION_CACHE_READ_CHUNK);
+            size_t size = count * sizeof(ELFRelocationCacheEntry);
+            if(storage_file_read(file, entries, size) != size) {
+                result = false;
+                break;
+            }
+            for(size_t i = 0; i < count; i++) {
+                if(!elf_relocation_cache_apply(elf, &entries[i])) {
+                    result = false;
+                    break;
+                }
+            }
+            entries_left -= count;
+        }
+    } while(false);
+
+    storage_file_free(file);
+
+    if(!result) {
+        AddressCache_reset(elf->relocation_cache);
+        AddressCache_reset(elf->import_cache);
+    }
+
+    return result;
+}
+
+static void elf_relocation_cache_save(ELFFile* elf) {
+    const char* path = furi_string_get_cstr(elf->relocation_cache_path);
+
+    if(elf->profile.relocation_cache_used) {
+        if(elf->profile.symbols_resolved) {
+            // Cache is incomplete, rebuild it on the next load
+            storage_common_remove(elf->storage, path);
+        }
+        return;
+    }
+
+    ELFRelocationCacheHeader header;
+    elf_relocation_cache_fill_header(elf, &header);
+    size_t entries_size = header.entries_count * sizeof(ELFRelocationCacheEntry);
+    size_t size = sizeof(header) + entries_size;
+
+    uint8_t* buffer = malloc(size);
+    memcpy(buffer, &header, sizeof(header));
+    if(entries_size) {
+        memcpy(
+            buffer + sizeof(header),
+            ELFRelocationCacheArray_cget(elf->relocation_cache_entries, 0),
+            entries_size);
+    }
+
+    File* file = storage_file_alloc(elf->storage);
+    if(!storage_file_open(file, path, FSAM_WRITE, FSOM_CREATE_ALWAYS) ||
+       storage_file_write_bulk(file, buffer, size) != size) {
+        FURI_LOG_W(TAG, "Failed to save relocation cache");
+        storage_file_close(file);
+        storage_common_remove(elf->storage, path);
+    }
+    storage_file_free(file);
+    free(buffer);
+}
+
 /**************************************************************************************************/
 /********************************************* Public *********************************************/
 /**************************************************************************************************/
 
 ELFFile* elf_file_alloc(Storage* storage, const ElfApiInterface* api_interface) {
     ELFFile* elf = malloc(sizeof(ELFFile));
+    elf->storage = storage;
     elf->fd = storage_file_alloc(storage);
     elf->api_interface = api_interface;
     ELFSectionDict_init(elf->sections);
@@ -807,13 +1024,29 @@ void elf_file_free(ELFFile* elf) {
         free(elf->debug_link_info.debug_link);
     }
 
+    if(elf->relocation_cache_path) {
+        furi_string_free(elf->relocation_cache_path);
+    }
+
     elf_file_maybe_release_fd(elf);
     free(elf);
 }
 
+void elf_file_set_relocation_cache(ELFFile* elf, const char* path) {
+    if(!elf->relocation_cache_path) {
+        elf->relocation_cache_path = furi_string_alloc();
+    }
+    furi_string_set(elf->relocation_cache_path, path);
+}
+
+const ELFFileLoadProfile* elf_file_get_load_profile(ELFFile* elf) {
+    return &elf->profile;
+}
+
 bool elf_file_open(ELFFile* elf, const char* path) {
     Elf32_Ehdr h;
     Elf32_Shdr sH;
+    uint32_t start = elf_profile_start();
 
     if(!storage_file_open(elf->fd, path, FSAM_READ, FSOM_OPEN_EXISTING) ||
        !storage_file_seek(elf->fd, 0, true) ||
@@ -827,12 +1060,22 @@ bool elf_file_open(ELFFile* elf, const char* path) {
     elf->sections_count = h.e_shnum;
     elf->section_table = h.e_shoff;
     elf->section_table_strings = sH.sh_offset;
+
+    // Identity of the file for the relocation cache, extended with section headers and
+    // symbol and relocation contents later. Storage timestamp is not per file and changes on
+    // every write, cache save included.
+    uint32_t file_size = storage_file_size(elf->fd);
+    elf->file_hash = crc32_calc_buffer(0, &h, sizeof(h));
+    elf->file_hash = crc32_calc_buffer(elf->file_hash, &file_size, sizeof(file_size));
+
+    elf->profile.read_us += elf_profile_us(start);
     return true;
 }
 
 bool elf_file_load_section_table(ELFFile* elf) {
     SectionType loaded_sections = SectionTypeERROR;
     FuriString* name = furi_string_alloc();
+    uint32_t start = elf_profile_start();
 
     FURI_LOG_D(TAG, "Scan ELF indexs...");
     // TODO FL-3526: why we start from 1?
@@ -845,6 +1088,8 @@ bool elf_file_load_section_table(ELFFile* elf) {
             break;
         }
 
+        elf->file_hash = crc32_calc_buffer(elf->file_hash, &section_header, sizeof(Elf32_Shdr));
+
         FURI_LOG_D(
             TAG, "Preloading data for section #%d %s", section_idx, furi_string_get_cstr(name));
         SectionType section_type = elf_preload_section(elf, section_idx, &section_header, name);
@@ -857,6 +1102,7 @@ bool elf_file_load_section_table(ELFFile* elf) {
     }
 
     furi_string_free(name);
+    elf->profile.read_us += elf_profile_us(start);
 
     return IS_FLAGS_SET(loaded_sections, SectionTypeValid);
 }
@@ -869,6 +1115,7 @@ ElfProcessSectionResult elf_process_section(
     ElfProcessSectionResult result = ElfProcessSectionResultNotFound;
     FuriString* section_name = furi_string_alloc();
     Elf32_Shdr section_header;
+    uint32_t start = elf_profile_start();
 
     // find section
     // TODO FL-3526: why we start from 1?
@@ -893,6 +1140,7 @@ ElfProcessSectionResult elf_process_section(
     }
 
     furi_string_free(section_name);
+    elf->profile.read_us += elf_profile_us(start);
 
     return result;
 }
@@ -901,8 +1149,21 @@ ELFFileLoadStatus elf_file_load_sections(ELFFile* elf) {
     furi_check(elf->fd != NULL);
     ELFFileLoadStatus status = ELFFileLoadStatusSuccess;
     ELFSectionDict_it_t it;
+    uint32_t start = elf_profile_start();
 
     AddressCache_init(elf->relocation_cache);
+    AddressCache_init(elf->import_cache);
+    ELFRelocationCacheArray_init(elf->relocation_cache_entries);
+
+    if(elf->relocation_cache_path && !elf_relocation_cache_hash_contents(elf)) {
+        FURI_LOG_W(TAG, "Failed to hash sections, relocation cache disabled");
+        furi_string_free(elf->relocation_cache_path);
+        elf->relocation_cache_path = NULL;
+    }
+
+    if(elf->relocation_cache_path) {
+        elf->profile.relocation_cache_used = elf_relocation_cache_load(elf);
+    }
 
     for(ELFSectionDict_it(it, elf->sections); !ELFSectionDict_end_p(it); ELFSectionDict_next(it)) {
         ELFSectionDict_itref_t* itref = ELFSectionDict_ref(it);
@@ -927,7 +1188,14 @@ ELFFileLoadStatus elf_file_load_sections(ELFFile* elf) {
 
     FURI_LOG_D(TAG, "Relocation cache size: %u", AddressCache_size(elf->relocation_cache));
     FURI_LOG_D(TAG, "Trampoline cache size: %u", AddressCache_size(elf->trampoline_cache));
+
+    if(elf->relocation_cache_path && status == ELFFileLoadStatusSuccess) {
+        elf_relocation_cache_save(elf);
+    }
+
     AddressCache_clear(elf->relocation_cache);
+    AddressCache_clear(elf->import_cache);
+    ELFRelocationCacheArray_clear(elf->relocation_cache_entries);
 
     {
         size_t total_size = 0;
@@ -940,14 +1208,17 @@ ELFFileLoadStatus elf_file_load_sections(ELFFile* elf) {
     }
 
     elf_file_maybe_release_fd(elf);
+    elf->profile.relocate_us += elf_profile_us(start);
     return status;
 }
 
 void elf_file_call_init(ELFFile* elf) {
     furi_check(!elf->init_array_called);
+    uint32_t start = elf_profile_start();
     elf_file_call_section_list(elf->preinit_array, false);
     elf_file_call_section_list(elf->init_array, false);
     elf->init_array_called = true;
+    elf->profile.init_us += elf_profile_us(start);
 }
 
 bool elf_file_is_init_complete(ELFFile* elf) {
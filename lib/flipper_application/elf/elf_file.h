@@ -45,6 +45,15 @@ typedef enum {
 
 typedef bool(ElfProcessSection)(File* file, size_t offset, size_t size, void* context);
 
+typedef struct {
+    uint32_t read_us; /**< Headers and sections data */
+    uint32_t relocate_us; /**< Relocation, symbol resolution included */
+    uint32_t resolve_us; /**< Symbol resolution */
+    uint32_t init_us; /**< Static constructors */
+    uint32_t symbols_resolved; /**< Symbols resolved without the relocation cache */
+    bool relocation_cache_used;
+} ELFFileLoadProfile;
+
 /**
  * @brief Allocate ELFFile instance
  * @param storage 
@@ -59,6 +68,23 @@ ELFFile* elf_file_alloc(Storage* storage, const ElfApiInterface* api_interface);
  */
 void elf_file_free(ELFFile* elf_file);
 
+/**
+ * @brief Enable persistent relocation cache, must be set before loading sections.
+ * Symbols resolved during the first load are saved to the file, next loads take them
+ * from it while API version, firmware build and ELF file headers stay the same.
+ * Use only with the firmware API interface, plugin resolvers return runtime addresses.
+ * @param elf_file 
+ * @param path cache file path
+ */
+void elf_file_set_relocation_cache(ELFFile* elf_file, const char* path);
+
+/**
+ * @brief Get time spent in load stages
+ * @param elf_file 
+ * @return const ELFFileLoadProfile* 
+ */
+const ELFFileLoadProfile* elf_file_get_load_profile(ELFFile* elf_file);
+
 /**
  * @brief Open ELF file
  * @param elf_file 
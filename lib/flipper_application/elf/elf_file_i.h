@@ -1,6 +1,7 @@
 #pragma once
 #include "elf_file.h"
 #include <m-dict.h>
+#include <m-array.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -28,6 +29,18 @@ struct ELFSection {
 
 DICT_DEF2(ELFSectionDict, const char*, M_CSTR_OPLIST, ELFSection, M_POD_OPLIST)
 
+/**
+ * Relocation cache entry, a symbol resolved during the first load
+ */
+typedef struct {
+    uint32_t key; /**< Symbol table index, or name hash for fast relocations */
+    uint32_t value; /**< Import address, or symbol value inside of the section */
+    uint16_t section; /**< Section index, SHN_UNDEF for imports */
+    uint16_t flags;
+} ELFRelocationCacheEntry;
+
+ARRAY_DEF(ELFRelocationCacheArray, ELFRelocationCacheEntry, M_POD_OPLIST)
+
 struct ELFFile {
     size_t sections_count;
     off_t section_table;
@@ -36,12 +49,20 @@ struct ELFFile {
     size_t symbol_count;
     off_t symbol_table;
     off_t symbol_table_strings;
+    size_t symbol_table_strings_size;
     off_t entry;
     ELFSectionDict_t sections;
 
     AddressCache_t relocation_cache;
     AddressCache_t trampoline_cache;
+    AddressCache_t import_cache;
+
+    FuriString* relocation_cache_path;
+    ELFRelocationCacheArray_t relocation_cache_entries;
+    uint32_t file_hash;
+    ELFFileLoadProfile profile;
 
+    Storage* storage;
     File* fd;
     const ElfApiInterface* api_interface;
     ELFDebugLinkInfo debug_link_info;
@@ -9,6 +9,8 @@
 
 #define TAG "Fap"
 
+#define FLIPPER_APPLICATION_RELOCATION_CACHE_EXT ".rcache"
+
 struct FlipperApplication {
     ELFDebugInfo state;
     FlipperApplicationManifest manifest;
@@ -161,6 +163,14 @@ static FlipperApplicationPreloadStatus
             return FlipperApplicationPreloadStatusInvalidFile;
         }
 
+        // firmware symbols don't move until the next update, keep them resolved on SD
+        if(elf_file_get_api_interface(app->elf) == firmware_api_interface) {
+            FuriString* cache_path =
+                furi_string_alloc_printf("%s%s", path, FLIPPER_APPLICATION_RELOCATION_CACHE_EXT);
+            elf_file_set_relocation_cache(app->elf, furi_string_get_cstr(cache_path));
+            furi_string_free(cache_path);
+        }
+
         // load assets section
         FlipperApplicationPreloadAssetsContext preload_context = {.path = path};
         if(elf_process_section(
@@ -198,6 +208,18 @@ const FlipperApplicationManifest* flipper_application_get_manifest(FlipperApplic
     return &app->manifest;
 }
 
+void flipper_application_get_load_profile(
+    FlipperApplication* app,
+    FlipperApplicationLoadProfile* profile) {
+    const ELFFileLoadProfile* elf_profile = elf_file_get_load_profile(app->elf);
+    profile->read_us = elf_profile->read_us;
+    profile->relocate_us = elf_profile->relocate_us;
+    profile->resolve_us = elf_profile->resolve_us;
+    profile->init_us = elf_profile->init_us;
+    profile->symbols_resolved = elf_profile->symbols_resolved;
+    profile->relocation_cache_used = elf_profile->relocation_cache_used;
+}
+
 FlipperApplicationLoadStatus flipper_application_map_to_memory(FlipperApplication* app) {
     ELFFileLoadStatus status = elf_file_load_sections(app->elf);
 
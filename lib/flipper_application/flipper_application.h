@@ -61,6 +61,15 @@ typedef struct {
     uint8_t* debug_link;
 } FlipperApplicationState;
 
+typedef struct {
+    uint32_t read_us; /**< Headers, manifest, assets and sections data */
+    uint32_t relocate_us; /**< Relocation, symbol resolution included */
+    uint32_t resolve_us; /**< Symbol resolution */
+    uint32_t init_us; /**< Static constructors */
+    uint32_t symbols_resolved; /**< Symbols resolved without the relocation cache */
+    bool relocation_cache_used;
+} FlipperApplicationLoadProfile;
+
 /**
  * @brief Initialize FlipperApplication object
  * @param storage Storage instance
@@ -99,6 +108,15 @@ FlipperApplicationPreloadStatus
  */
 const FlipperApplicationManifest* flipper_application_get_manifest(FlipperApplication* app);
 
+/**
+ * @brief Get time spent in application load stages
+ * @param app Application pointer
+ * @param profile Pointer to profile to fill
+ */
+void flipper_application_get_load_profile(
+    FlipperApplication* app,
+    FlipperApplicationLoadProfile* profile);
+
 /**
  * @brief Load sections and process relocations for already pre-loaded application
  * @param app Application pointer
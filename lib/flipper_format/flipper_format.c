@@ -44,6 +44,16 @@ FlipperFormat* flipper_format_buffered_file_alloc(Storage* storage) {
     return flipper_format;
 }
 
+FlipperFormat* flipper_format_buffered_file_alloc_ex(
+    Storage* storage,
+    size_t block_size,
+    size_t blocks_count) {
+    FlipperFormat* flipper_format = malloc(sizeof(FlipperFormat));
+    flipper_format->stream = buffered_file_stream_alloc_ex(storage, block_size, blocks_count);
+    flipper_format->strict_mode = false;
+    return flipper_format;
+}
+
 bool flipper_format_file_open_existing(FlipperFormat* flipper_format, const char* path) {
     furi_assert(flipper_format);
     return file_stream_open(flipper_format->stream, path, FSAM_READ_WRITE, FSOM_OPEN_EXISTING);
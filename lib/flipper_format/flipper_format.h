@@ -120,6 +120,19 @@ FlipperFormat* flipper_format_file_alloc(Storage* storage);
  */
 FlipperFormat* flipper_format_buffered_file_alloc(Storage* storage);
 
+/**
+ * Allocate FlipperFormat as file, buffered mode with a multi-block cache.
+ * Suits files that are rewound and searched for keys several times.
+ * @param storage Pointer to a Storage instance
+ * @param block_size Cache block size, multiple of 512 is recommended
+ * @param blocks_count Number of cache blocks
+ * @return FlipperFormat* pointer to a FlipperFormat instance
+ */
+FlipperFormat* flipper_format_buffered_file_alloc_ex(
+    Storage* storage,
+    size_t block_size,
+    size_t blocks_count);
+
 /**
  * Open existing file. 
  * Use only if FlipperFormat allocated as a file.
@@ -8,6 +8,7 @@
 #include "protocol_group_misc_defs.h"
 
 #define IBUTTON_MISC_READ_TIMEOUT 100
+#define IBUTTON_MISC_READ_BATCH_SIZE 32
 
 #define IBUTTON_MISC_DATA_KEY_KEY_COMMON "Data"
 
@@ -107,17 +108,21 @@ static bool ibutton_protocol_group_misc_read(
     const uint32_t tick_start = furi_get_tick();
 
     for(;;) {
-        LevelDuration level;
+        LevelDuration levels[IBUTTON_MISC_READ_BATCH_SIZE];
         size_t ret = furi_stream_buffer_receive(
-            read_context.stream, &level, sizeof(LevelDuration), IBUTTON_MISC_READ_TIMEOUT);
+            read_context.stream, levels, sizeof(levels), IBUTTON_MISC_READ_TIMEOUT);
 
         if((furi_get_tick() - tick_start) > IBUTTON_MISC_READ_TIMEOUT) {
             break;
         }
 
-        if(ret > 0) {
-            ProtocolId decoded_index = protocol_dict_decoders_feed(
-                group->dict, level_duration_get_level(level), level_duration_get_duration(level));
+        const size_t count = ret / sizeof(LevelDuration);
+
+        for(size_t index = 0; index < count;) {
+            size_t consumed;
+            ProtocolId decoded_index = protocol_dict_decoders_feed_batch(
+                group->dict, &levels[index], count - index, &consumed);
+            index += consumed;
 
             if(decoded_index == PROTOCOL_NO) continue;
 
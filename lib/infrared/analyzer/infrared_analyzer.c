@@ -0,0 +1,381 @@
+#include "infrared_analyzer.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <core/check.h>
+#include <core/common_defines.h>
+
+/* frequency of raw signal can be that far from protocol one, in 1/x of it */
+#define INFRARED_ANALYZER_FREQUENCY_DIVIDER (10U)
+
+typedef struct {
+    size_t count;
+    uint32_t center[INFRARED_TEMPLATE_SYMBOLS_MAX];
+    uint32_t max[INFRARED_TEMPLATE_SYMBOLS_MAX];
+} InfraredAnalyzerClusters;
+
+struct InfraredAnalyzer {
+    InfraredDecoderHandler* decoder;
+    InfraredEncoderHandler* encoder;
+    InfraredMessage message;
+    InfraredTemplate tmpl;
+
+    InfraredAnalyzerClusters marks;
+    InfraredAnalyzerClusters spaces;
+    uint32_t sorted[INFRARED_TEMPLATE_LENGTH_MAX];
+    uint8_t cluster[INFRARED_TEMPLATE_TIMINGS_MAX];
+    uint8_t symbol[INFRARED_TEMPLATE_LENGTH_MAX];
+};
+
+static inline uint32_t infrared_analyzer_tolerance(uint32_t duration) {
+    return MAX(
+        duration / 100 * INFRARED_ANALYZER_TOLERANCE_PERCENT, INFRARED_ANALYZER_TOLERANCE_US);
+}
+
+static bool infrared_analyzer_match_timing(uint32_t duration, uint32_t expected) {
+    if((duration >= INFRARED_ANALYZER_SILENCE_US) && (expected >= INFRARED_ANALYZER_SILENCE_US)) {
+        return true;
+    }
+    const uint32_t difference = (duration > expected) ? duration - expected : expected - duration;
+    return difference <= infrared_analyzer_tolerance(expected);
+}
+
+static int infrared_analyzer_compare(const void* a, const void* b) {
+    const uint32_t x = *(const uint32_t*)a;
+    const uint32_t y = *(const uint32_t*)b;
+    return (x > y) - (x < y);
+}
+
+static uint8_t infrared_analyzer_symbol_bits(const InfraredTemplate* tmpl) {
+    uint8_t bits = 1;
+    while((1U << bits) < tmpl->symbols_count) {
+        ++bits;
+    }
+    return bits;
+}
+
+static size_t infrared_analyzer_digits(uint32_t value) {
+    size_t digits = 1;
+    while(value >= 10) {
+        value /= 10;
+        ++digits;
+    }
+    return digits;
+}
+
+InfraredAnalyzer* infrared_analyzer_alloc(void) {
+    InfraredAnalyzer* analyzer = malloc(sizeof(InfraredAnalyzer));
+    analyzer->decoder = infrared_alloc_decoder();
+    analyzer->encoder = infrared_alloc_encoder();
+    return analyzer;
+}
+
+void infrared_analyzer_free(InfraredAnalyzer* analyzer) {
+    furi_assert(analyzer);
+    infrared_free_decoder(analyzer->decoder);
+    infrared_free_encoder(analyzer->encoder);
+    free(analyzer);
+}
+
+static bool infrared_analyzer_decode(
+    InfraredAnalyzer* analyzer,
+    const uint32_t* timings,
+    size_t timings_size) {
+    const InfraredMessage* message = NULL;
+    infrared_reset_decoder(analyzer->decoder);
+
+    for(size_t i = 0; (i < timings_size) && !message; ++i) {
+        message = infrared_decode(analyzer->decoder, !(i % 2), timings[i]);
+    }
+    if(!message) {
+        message = infrared_check_decoder_ready(analyzer->decoder);
+    }
+
+    if(message) {
+        analyzer->message = *message;
+        analyzer->message.repeat = false;
+    }
+
+    return message != NULL;
+}
+
+/* Same sequence infrared_send() would transmit, with leading silence skipped */
+static bool infrared_analyzer_match_message(
+    InfraredAnalyzer* analyzer,
+    const uint32_t* timings,
+    size_t timings_size,
+    uint32_t frequency) {
+    if(!infrared_analyzer_decode(analyzer, timings, timings_size)) return false;
+
+    const InfraredProtocol protocol = analyzer->message.protocol;
+    const uint32_t protocol_frequency = infrared_get_protocol_frequency(protocol);
+    const uint32_t frequency_difference = (frequency > protocol_frequency) ?
+                                              frequency - protocol_frequency :
+                                              protocol_frequency - frequency;
+    if(frequency_difference > protocol_frequency / INFRARED_ANALYZER_FREQUENCY_DIVIDER) {
+        return false;
+    }
+
+    infrared_reset_encoder(analyzer->encoder, &analyzer->message);
+    size_t transmissions = MAX(infrared_get_protocol_min_repeat_count(protocol), 1U);
+
+    size_t index = 0;
+    uint32_t pending = 0;
+    bool pending_level = false;
+
+    while(transmissions) {
+        uint32_t duration;
+        bool level;
+        if(infrared_encode(analyzer->encoder, &duration, &level) == InfraredStatusDone) {
+            --transmissions;
+        }
+
+        if(!pending && !level) continue;
+
+        if(pending && (level != pending_level)) {
+            if(index >= timings_size) return false;
+            if(!infrared_analyzer_match_timing(timings[index++], pending)) return false;
+            pending = 0;
+        }
+        pending_level = level;
+        pending += duration;
+    }
+
+    return (index + 1 == timings_size) && infrared_analyzer_match_timing(timings[index], pending);
+}
+
+/* Group every other timing starting from first, neighbours within tolerance are one cluster */
+static bool infrared_analyzer_cluster(
+    InfraredAnalyzer* analyzer,
+    InfraredAnalyzerClusters* clusters,
+    const uint32_t* timings,
+    size_t timings_size,
+    size_t first) {
+    size_t count = 0;
+    for(size_t i = first; i < timings_size; i += 2) {
+        analyzer->sorted[count++] = timings[i];
+    }
+    qsort(analyzer->sorted, count, sizeof(uint32_t), infrared_analyzer_compare);
+
+    clusters->count = 0;
+    uint64_t sum = 0;
+    size_t members = 0;
+    uint32_t start = 0;
+
+    for(size_t i = 0; i <= count; ++i) {
+        if(members && ((i == count) ||
+                       (analyzer->sorted[i] > start + infrared_analyzer_tolerance(start)))) {
+            if(clusters->count == INFRARED_TEMPLATE_SYMBOLS_MAX) return false;
+            clusters->center[clusters->count] = (sum + members / 2) / members;
+            clusters->max[clusters->count] = analyzer->sorted[i - 1];
+            ++clusters->count;
+            members = 0;
+            sum = 0;
+        }
+        if(i == count) break;
+        if(!members) start = analyzer->sorted[i];
+        sum += analyzer->sorted[i];
+        ++members;
+    }
+
+    for(size_t i = first; i < timings_size; i += 2) {
+        uint8_t cluster = 0;
+        while(timings[i] > clusters->max[cluster]) {
+            ++cluster;
+        }
+        analyzer->cluster[i] = cluster;
+    }
+
+    return true;
+}
+
+/* Shortest frame the whole signal repeats, in symbols */
+static size_t infrared_analyzer_find_frame(InfraredAnalyzer* analyzer, size_t timings_size) {
+    const size_t symbols = (timings_size + 1) / 2;
+
+    for(size_t length = 1; length < symbols; ++length) {
+        if(symbols % length) continue;
+
+        bool is_periodic = true;
+        for(size_t i = 0; (i + length * 2 < timings_size) && is_periodic; ++i) {
+            is_periodic = analyzer->cluster[i] == analyzer->cluster[i + length * 2];
+        }
+        if(is_periodic) return length;
+    }
+
+    return symbols;
+}
+
+static bool infrared_analyzer_add_symbol(
+    InfraredAnalyzer* analyzer,
+    size_t index,
+    uint32_t mark,
+    uint32_t space) {
+    InfraredTemplate* tmpl = &analyzer->tmpl;
+    size_t symbol = 0;
+    for(; symbol < tmpl->symbols_count; ++symbol) {
+        if((tmpl->symbols[symbol * 2] == mark) &&
+           ((tmpl->symbols[symbol * 2 + 1] == space) || !space)) {
+            break;
+        }
+    }
+
+    if(symbol == tmpl->symbols_count) {
+        if(tmpl->symbols_count == INFRARED_TEMPLATE_SYMBOLS_MAX) return false;
+        tmpl->symbols[symbol * 2] = mark;
+        tmpl->symbols[symbol * 2 + 1] = space;
+        ++tmpl->symbols_count;
+    }
+
+    analyzer->symbol[index] = symbol;
+    return true;
+}
+
+/* Symbol width is known only after alphabet is complete */
+static void infrared_analyzer_pack_stream(InfraredAnalyzer* analyzer) {
+    InfraredTemplate* tmpl = &analyzer->tmpl;
+    const uint8_t bits = infrared_analyzer_symbol_bits(tmpl);
+
+    for(size_t i = 0; i < tmpl->length; ++i) {
+        for(uint8_t bit = 0; bit < bits; ++bit) {
+            const size_t position = i * bits + bit;
+            if(analyzer->symbol[i] & (1 << (bits - bit - 1))) {
+                tmpl->stream[position / 8] |= 0x80 >> (position % 8);
+            }
+        }
+    }
+}
+
+static bool infrared_analyzer_build_template(
+    InfraredAnalyzer* analyzer,
+    const uint32_t* timings,
+    size_t timings_size,
+    uint32_t frequency,
+    float duty_cycle) {
+    /* Template can't describe trailing space */
+    if(!(timings_size % 2)) return false;
+
+    if(!infrared_analyzer_cluster(analyzer, &analyzer->marks, timings, timings_size, 0) ||
+       !infrared_analyzer_cluster(analyzer, &analyzer->spaces, timings, timings_size, 1)) {
+        return false;
+    }
+
+    InfraredTemplate* tmpl = &analyzer->tmpl;
+    memset(tmpl, 0, sizeof(InfraredTemplate));
+    tmpl->frequency = frequency;
+    tmpl->duty_cycle = duty_cycle;
+    tmpl->length = infrared_analyzer_find_frame(analyzer, timings_size);
+    tmpl->repeat = (timings_size + 1) / 2 / tmpl->length;
+
+    for(size_t i = 0; i < tmpl->length; ++i) {
+        const uint32_t mark = analyzer->marks.center[analyzer->cluster[i * 2]];
+        /* Last space of single frame isn't sent, any symbol with the same mark fits */
+        const uint32_t space = (i * 2 + 1 < timings_size) ?
+                                   analyzer->spaces.center[analyzer->cluster[i * 2 + 1]] :
+                                   0;
+        if(!infrared_analyzer_add_symbol(analyzer, i, mark, space)) return false;
+    }
+    infrared_analyzer_pack_stream(analyzer);
+
+    /* Compare text size of "data" and template values, plus names of extra keys */
+    size_t raw_size = 0;
+    for(size_t i = 0; i < timings_size; ++i) {
+        raw_size += infrared_analyzer_digits(timings[i]) + 1;
+    }
+    size_t template_size = infrared_analyzer_digits(tmpl->length) +
+                           infrared_analyzer_digits(tmpl->repeat) +
+                           infrared_template_get_stream_size(tmpl) * 3 + 35;
+    for(size_t i = 0; i < tmpl->symbols_count * 2; ++i) {
+        template_size += infrared_analyzer_digits(tmpl->symbols[i]) + 1;
+    }
+
+    return template_size < raw_size;
+}
+
+InfraredAnalyzerResult infrared_analyzer_process(
+    InfraredAnalyzer* analyzer,
+    const uint32_t* timings,
+    size_t timings_size,
+    uint32_t frequency,
+    float duty_cycle) {
+    furi_assert(analyzer);
+    furi_assert(timings);
+
+    InfraredAnalyzerResult result = InfraredAnalyzerResultRaw;
+
+    if(!timings_size || (timings_size > INFRARED_TEMPLATE_TIMINGS_MAX)) {
+        result = InfraredAnalyzerResultRaw;
+    } else if(infrared_analyzer_match_message(analyzer, timings, timings_size, frequency)) {
+        result = InfraredAnalyzerResultMessage;
+    } else if(infrared_analyzer_build_template(
+                  analyzer, timings, timings_size, frequency, duty_cycle)) {
+        result = InfraredAnalyzerResultTemplate;
+    }
+
+    return result;
+}
+
+const InfraredMessage* infrared_analyzer_get_message(const InfraredAnalyzer* analyzer) {
+    furi_assert(analyzer);
+    return &analyzer->message;
+}
+
+const InfraredTemplate* infrared_analyzer_get_template(const InfraredAnalyzer* analyzer) {
+    furi_assert(analyzer);
+    return &analyzer->tmpl;
+}
+
+bool infrared_template_is_valid(const InfraredTemplate* tmpl) {
+    furi_assert(tmpl);
+    return (tmpl->symbols_count > 0) && (tmpl->symbols_count <= INFRARED_TEMPLATE_SYMBOLS_MAX) &&
+           (tmpl->length > 0) && (tmpl->length <= INFRARED_TEMPLATE_LENGTH_MAX) &&
+           (tmpl->repeat > 0) &&
+           (tmpl->repeat <= INFRARED_TEMPLATE_LENGTH_MAX / tmpl->length);
+}
+
+size_t infrared_template_get_stream_size(const InfraredTemplate* tmpl) {
+    furi_assert(tmpl);
+    return (tmpl->length * infrared_analyzer_symbol_bits(tmpl) + 7) / 8;
+}
+
+size_t infrared_template_get_timings_size(const InfraredTemplate* tmpl) {
+    furi_assert(tmpl);
+    return tmpl->length * tmpl->repeat * 2 - 1;
+}
+
+size_t infrared_template_expand(
+    const InfraredTemplate* tmpl,
+    uint32_t* timings,
+    size_t timings_size) {
+    furi_assert(tmpl);
+    furi_assert(timings);
+
+    const size_t size = infrared_template_get_timings_size(tmpl);
+    if(size > timings_size) return 0;
+
+    const uint8_t bits = infrared_analyzer_symbol_bits(tmpl);
+    size_t index = 0;
+
+    for(size_t i = 0; i < tmpl->length; ++i) {
+        uint8_t symbol = 0;
+        for(size_t position = i * bits; position < (i + 1) * bits; ++position) {
+            symbol = (symbol << 1) | ((tmpl->stream[position / 8] >> (7 - position % 8)) & 1);
+        }
+        if(symbol >= tmpl->symbols_count) return 0;
+
+        timings[index++] = tmpl->symbols[symbol * 2];
+        if(index < size) timings[index++] = tmpl->symbols[symbol * 2 + 1];
+    }
+
+    for(size_t frame = 1; frame < tmpl->repeat; ++frame) {
+        const size_t frame_size = MIN(tmpl->length * 2, size - index);
+        memcpy(&timings[index], timings, frame_size * sizeof(uint32_t));
+        index += frame_size;
+    }
+
+    for(size_t i = 0; i < size; ++i) {
+        if(!timings[i]) return 0;
+    }
+
+    return size;
+}
@@ -0,0 +1,143 @@
+#pragma once
+
+#include "infrared.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define INFRARED_TEMPLATE_SYMBOLS_MAX (16U)
+#define INFRARED_TEMPLATE_TIMINGS_MAX (1024U)
+#define INFRARED_TEMPLATE_LENGTH_MAX (INFRARED_TEMPLATE_TIMINGS_MAX / 2)
+#define INFRARED_TEMPLATE_STREAM_SIZE_MAX (INFRARED_TEMPLATE_LENGTH_MAX / 2)
+
+/* timings closer than this to cluster center are the same symbol */
+#define INFRARED_ANALYZER_TOLERANCE_PERCENT (20U)
+#define INFRARED_ANALYZER_TOLERANCE_US (120U)
+/* spaces that long only separate frames, their exact length doesn't matter to receiver */
+#define INFRARED_ANALYZER_SILENCE_US (10000U)
+
+typedef struct InfraredAnalyzer InfraredAnalyzer;
+
+/**
+ * Compact form of raw signal in pulse distance terms.
+ * Each symbol is a mark followed by a space, frame is a sequence of symbols,
+ * packed into stream MSB first with as few bits per symbol as alphabet allows.
+ * Frame is sent `repeat` times, last space of the last frame is not sent,
+ * so expanded signal always starts and ends with a mark.
+ */
+typedef struct {
+    uint32_t frequency;
+    float duty_cycle;
+    size_t symbols_count;
+    uint32_t symbols[INFRARED_TEMPLATE_SYMBOLS_MAX * 2]; /**< mark, space pairs */
+    uint32_t length; /**< symbols in frame */
+    uint32_t repeat; /**< frames in signal */
+    uint8_t stream[INFRARED_TEMPLATE_STREAM_SIZE_MAX];
+} InfraredTemplate;
+
+typedef enum {
+    InfraredAnalyzerResultRaw, /**< signal has to be kept as is */
+    InfraredAnalyzerResultMessage, /**< signal is the same as encoded message */
+    InfraredAnalyzerResultTemplate, /**< signal fits into template */
+} InfraredAnalyzerResult;
+
+/**
+ * Allocate raw signal analyzer.
+ *
+ * \return      analyzer instance.
+ */
+InfraredAnalyzer* infrared_analyzer_alloc(void);
+
+/**
+ * Free analyzer allocated with \c infrared_analyzer_alloc().
+ *
+ * \param[in]   analyzer    - analyzer instance.
+ */
+void infrared_analyzer_free(InfraredAnalyzer* analyzer);
+
+/**
+ * Find the most compact form of raw signal.
+ * Signal becomes message only when transmitting it with \c infrared_send() produces
+ * the same timings within tolerance on a close carrier frequency. Otherwise timings are
+ * clustered and repeated frames are folded into template if it takes less space than raw.
+ * Raw signal must start with a mark.
+ *
+ * \param[in]   analyzer    - analyzer instance.
+ * \param[in]   timings     - raw signal timings, us.
+ * \param[in]   timings_size - amount of timings.
+ * \param[in]   frequency   - carrier frequency of raw signal.
+ * \param[in]   duty_cycle  - carrier duty cycle of raw signal.
+ *
+ * \return      result, get it with \c infrared_analyzer_get_message() or
+ *              \c infrared_analyzer_get_template().
+ */
+InfraredAnalyzerResult infrared_analyzer_process(
+    InfraredAnalyzer* analyzer,
+    const uint32_t* timings,
+    size_t timings_size,
+    uint32_t frequency,
+    float duty_cycle);
+
+/**
+ * Get message found by last \c infrared_analyzer_process() call.
+ *
+ * \param[in]   analyzer    - analyzer instance.
+ *
+ * \return      message, valid until next \c infrared_analyzer_process() call.
+ */
+const InfraredMessage* infrared_analyzer_get_message(const InfraredAnalyzer* analyzer);
+
+/**
+ * Get template built by last \c infrared_analyzer_process() call.
+ *
+ * \param[in]   analyzer    - analyzer instance.
+ *
+ * \return      template, valid until next \c infrared_analyzer_process() call.
+ */
+const InfraredTemplate* infrared_analyzer_get_template(const InfraredAnalyzer* analyzer);
+
+/**
+ * Check template header (symbols, length, repeat) before reading or expanding stream.
+ *
+ * \param[in]   tmpl        - template to check.
+ *
+ * \return      true if template fits in limits.
+ */
+bool infrared_template_is_valid(const InfraredTemplate* tmpl);
+
+/**
+ * Get size of packed symbol stream.
+ *
+ * \param[in]   tmpl        - valid template.
+ *
+ * \return      stream size, bytes.
+ */
+size_t infrared_template_get_stream_size(const InfraredTemplate* tmpl);
+
+/**
+ * Get amount of timings template expands to.
+ *
+ * \param[in]   tmpl        - valid template.
+ *
+ * \return      amount of timings.
+ */
+size_t infrared_template_get_timings_size(const InfraredTemplate* tmpl);
+
+/**
+ * Expand template into raw signal timings, starting with a mark.
+ *
+ * \param[in]   tmpl        - valid template.
+ * \param[out]  timings     - buffer for timings.
+ * \param[in]   timings_size - buffer size, amount of timings.
+ *
+ * \return      amount of timings written, 0 if buffer is too small or stream is corrupted.
+ */
+size_t infrared_template_expand(
+    const InfraredTemplate* tmpl,
+    uint32_t* timings,
+    size_t timings_size);
+
+#ifdef __cplusplus
+}
+#endif
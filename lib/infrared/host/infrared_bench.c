@@ -0,0 +1,405 @@
+// Host batch tool for infrared raw signal analyzer
+//
+// Runs every raw signal of .ir files through infrared_analyzer the way InfraredSignal saves it,
+// checks that converted signal transmits the same timings within tolerance and prints size and
+// load time of each file before and after. Load time is host time of parsing values out of
+// text, which is what flipper_format spends most of its time on when loading a remote.
+//
+// Without arguments, the shipped universal remote databases are processed.
+
+#include <infrared.h>
+#include <infrared_analyzer.h>
+
+#include <core/common_defines.h>
+
+#include <glob.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#define INFRARED_BENCH_ASSETS "../../../assets/resources/infrared/assets/*.ir"
+#define INFRARED_BENCH_LOOPS (20)
+
+typedef struct {
+    size_t signals;
+    size_t raw;
+    size_t parsed;
+    size_t templates;
+    size_t errors;
+    size_t size;
+    size_t converted_size;
+    double load;
+    double converted_load;
+} InfraredBenchStats;
+
+typedef struct {
+    char* data;
+    size_t size;
+    size_t capacity;
+} InfraredBenchText;
+
+static double infrared_bench_now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static void infrared_bench_printf(InfraredBenchText* text, const char* format, ...)
+    __attribute__((format(printf, 2, 3)));
+
+static void infrared_bench_printf(InfraredBenchText* text, const char* format, ...) {
+    va_list args;
+    for(;;) {
+        va_start(args, format);
+        const int size =
+            vsnprintf(text->data + text->size, text->capacity - text->size, format, args);
+        va_end(args);
+        if((size_t)size < text->capacity - text->size) {
+            text->size += size;
+            break;
+        }
+        text->capacity = text->capacity * 2 + size;
+        text->data = realloc(text->data, text->capacity);
+    }
+}
+
+static char* infrared_bench_read_file(const char* path, size_t* size) {
+    FILE* file = fopen(path, "rb");
+    if(!file) return NULL;
+
+    fseek(file, 0, SEEK_END);
+    *size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+
+    char* data = malloc(*size + 1);
+    if(fread(data, 1, *size, file) != *size) {
+        free(data);
+        data = NULL;
+    } else {
+        data[*size] = '\0';
+    }
+
+    fclose(file);
+    return data;
+}
+
+static const char* infrared_bench_value(const char* line, const char* key) {
+    const size_t key_size = strlen(key);
+    if(strncmp(line, key, key_size) || line[key_size] != ':') return NULL;
+    return line + key_size + 1;
+}
+
+static size_t infrared_bench_read_uint32(const char* value, uint32_t* data, size_t data_size) {
+    size_t count = 0;
+    char* end;
+    while(count < data_size) {
+        const unsigned long number = strtoul(value, &end, 10);
+        if(end == value) break;
+        data[count++] = number;
+        value = end;
+    }
+    return count;
+}
+
+static size_t infrared_bench_read_hex(const char* value, uint8_t* data, size_t data_size) {
+    size_t count = 0;
+    char* end;
+    while(count < data_size) {
+        const unsigned long number = strtoul(value, &end, 16);
+        if(end == value) break;
+        data[count++] = number;
+        value = end;
+    }
+    return count;
+}
+
+static bool infrared_bench_match(const uint32_t* timings, const uint32_t* expected, size_t size) {
+    for(size_t i = 0; i < size; ++i) {
+        if((timings[i] >= INFRARED_ANALYZER_SILENCE_US) &&
+           (expected[i] >= INFRARED_ANALYZER_SILENCE_US))
+            continue;
+        const uint32_t difference = (timings[i] > expected[i]) ? timings[i] - expected[i] :
+                                                                 expected[i] - timings[i];
+        const uint32_t tolerance = expected[i] / 100 * INFRARED_ANALYZER_TOLERANCE_PERCENT;
+        if(difference > tolerance && difference > INFRARED_ANALYZER_TOLERANCE_US) return false;
+    }
+    return true;
+}
+
+/* Parse all values of remote the way InfraredSignal reads them, returns signals loaded */
+static size_t infrared_bench_load(const char* text) {
+    static uint32_t timings[INFRARED_TEMPLATE_TIMINGS_MAX];
+    static InfraredTemplate tmpl;
+    size_t signals = 0;
+
+    for(const char* line = text; line && *line; line = strchr(line, '\n'), line += !!line) {
+        const char* value;
+        uint32_t number;
+        if((value = infrared_bench_value(line, "data"))) {
+            signals += infrared_bench_read_uint32(value, timings, COUNT_OF(timings)) > 0;
+        } else if((value = infrared_bench_value(line, "protocol"))) {
+            char name[32] = {0};
+            sscanf(value, " %31s", name);
+            signals += infrared_get_protocol_by_name(name) != InfraredProtocolUnknown;
+        } else if((value = infrared_bench_value(line, "address"))) {
+            infrared_bench_read_hex(value, (uint8_t*)&number, sizeof(number));
+        } else if((value = infrared_bench_value(line, "command"))) {
+            infrared_bench_read_hex(value, (uint8_t*)&number, sizeof(number));
+        } else if((value = infrared_bench_value(line, "frequency"))) {
+            infrared_bench_read_uint32(value, &number, 1);
+        } else if((value = infrared_bench_value(line, "duty_cycle"))) {
+            tmpl.duty_cycle = strtof(value, NULL);
+        } else if((value = infrared_bench_value(line, "symbols"))) {
+            tmpl.symbols_count =
+                infrared_bench_read_uint32(value, tmpl.symbols, COUNT_OF(tmpl.symbols)) / 2;
+        } else if((value = infrared_bench_value(line, "length"))) {
+            infrared_bench_read_uint32(value, &tmpl.length, 1);
+        } else if((value = infrared_bench_value(line, "repeat"))) {
+            infrared_bench_read_uint32(value, &tmpl.repeat, 1);
+        } else if((value = infrared_bench_value(line, "stream"))) {
+            if(!infrared_template_is_valid(&tmpl)) continue;
+            const size_t stream_size = infrared_template_get_stream_size(&tmpl);
+            if(infrared_bench_read_hex(value, tmpl.stream, stream_size) != stream_size) continue;
+            signals += infrared_template_expand(&tmpl, timings, COUNT_OF(timings)) > 0;
+        }
+    }
+
+    return signals;
+}
+
+static double infrared_bench_load_time(const char* text, size_t loops, size_t* signals) {
+    double best = 0;
+    for(size_t i = 0; i < loops; ++i) {
+        const double start = infrared_bench_now();
+        *signals = infrared_bench_load(text);
+        const double time = infrared_bench_now() - start;
+        if(!i || time < best) best = time;
+    }
+    return best;
+}
+
+static void infrared_bench_save_template(InfraredBenchText* text, const InfraredTemplate* tmpl) {
+    infrared_bench_printf(
+        text,
+        "type: template\nfrequency: %u\nduty_cycle: %f\nsymbols:",
+        tmpl->frequency,
+        (double)tmpl->duty_cycle);
+    for(size_t i = 0; i < tmpl->symbols_count * 2; ++i) {
+        infrared_bench_printf(text, " %u", tmpl->symbols[i]);
+    }
+    infrared_bench_printf(
+        text, "\nlength: %u\nrepeat: %u\nstream:", tmpl->length, tmpl->repeat);
+    for(size_t i = 0; i < infrared_template_get_stream_size(tmpl); ++i) {
+        infrared_bench_printf(text, " %02X", tmpl->stream[i]);
+    }
+    infrared_bench_printf(text, "\n");
+}
+
+static void infrared_bench_save_message(InfraredBenchText* text, const InfraredMessage* message) {
+    const uint8_t* address = (const uint8_t*)&message->address;
+    const uint8_t* command = (const uint8_t*)&message->command;
+    infrared_bench_printf(
+        text,
+        "type: parsed\nprotocol: %s\naddress: %02X %02X %02X %02X\n"
+        "command: %02X %02X %02X %02X\n",
+        infrared_get_protocol_name(message->protocol),
+        address[0],
+        address[1],
+        address[2],
+        address[3],
+        command[0],
+        command[1],
+        command[2],
+        command[3]);
+}
+
+/* Rewrite raw signals, "type: raw" is always followed by frequency, duty_cycle and data */
+static char* infrared_bench_convert(
+    InfraredAnalyzer* analyzer,
+    const char* path,
+    const char* data,
+    InfraredBenchStats* stats) {
+    static uint32_t timings[INFRARED_TEMPLATE_TIMINGS_MAX];
+    static uint32_t expanded[INFRARED_TEMPLATE_TIMINGS_MAX];
+    InfraredBenchText text = {.data = malloc(4096), .capacity = 4096};
+    const char* line = data;
+
+    while(*line) {
+        const char* next = strchr(line, '\n');
+        next = next ? next + 1 : line + strlen(line);
+
+        const char *frequency, *duty_cycle, *values;
+        const char* duty_line = strchr(next, '\n');
+        const char* data_line = duty_line ? strchr(duty_line + 1, '\n') : NULL;
+        if(strncmp(line, "type: raw", 9) ||
+           !(frequency = infrared_bench_value(next, "frequency")) || !duty_line ||
+           !(duty_cycle = infrared_bench_value(duty_line + 1, "duty_cycle")) || !data_line ||
+           !(values = infrared_bench_value(data_line + 1, "data"))) {
+            infrared_bench_printf(&text, "%.*s", (int)(next - line), line);
+            line = next;
+            continue;
+        }
+
+        const char* end = strchr(values, '\n');
+        end = end ? end + 1 : values + strlen(values);
+        const size_t size = infrared_bench_read_uint32(values, timings, COUNT_OF(timings));
+        const uint32_t carrier = strtoul(frequency, NULL, 10);
+        const float duty = strtof(duty_cycle, NULL);
+
+        stats->signals++;
+        switch(infrared_analyzer_process(analyzer, timings, size, carrier, duty)) {
+        case InfraredAnalyzerResultMessage:
+            infrared_bench_save_message(&text, infrared_analyzer_get_message(analyzer));
+            stats->parsed++;
+            break;
+        case InfraredAnalyzerResultTemplate: {
+            const InfraredTemplate* tmpl = infrared_analyzer_get_template(analyzer);
+            if(infrared_template_expand(tmpl, expanded, COUNT_OF(expanded)) != size ||
+               !infrared_bench_match(expanded, timings, size)) {
+                printf("%s: template differs from signal at offset %zu\n", path, line - data);
+                stats->errors++;
+            }
+            infrared_bench_save_template(&text, tmpl);
+            stats->templates++;
+            break;
+        }
+        default:
+            infrared_bench_printf(&text, "%.*s", (int)(end - line), line);
+            stats->raw++;
+            break;
+        }
+        line = end;
+    }
+
+    return text.data;
+}
+
+static bool infrared_bench_write_file(const char* directory, const char* path, const char* text) {
+    const char* name = strrchr(path, '/');
+    char output[512];
+    snprintf(output, sizeof(output), "%s/%s", directory, name ? name + 1 : path);
+
+    FILE* file = fopen(output, "wb");
+    if(!file) return false;
+    const size_t size = strlen(text);
+    const bool success = fwrite(text, 1, size, file) == size;
+    fclose(file);
+    return success;
+}
+
+static void infrared_bench_print(const char* name, const InfraredBenchStats* stats) {
+    printf(
+        "%-16s %7zu %6zu %6zu %8zu %9.1f %9.1f %6.1f%% %8.2f %8.2f\n",
+        name,
+        stats->signals,
+        stats->parsed,
+        stats->templates,
+        stats->raw,
+        stats->size / 1024.0,
+        stats->converted_size / 1024.0,
+        100.0 - stats->converted_size * 100.0 / stats->size,
+        stats->load * 1e3,
+        stats->converted_load * 1e3);
+}
+
+int main(int argc, char** argv) {
+    const char* output = NULL;
+    size_t loops = INFRARED_BENCH_LOOPS;
+    int opt;
+
+    while((opt = getopt(argc, argv, "o:n:")) != -1) {
+        switch(opt) {
+        case 'o':
+            output = optarg;
+            break;
+        case 'n':
+            loops = strtoul(optarg, NULL, 0);
+            break;
+        default:
+            fprintf(stderr, "Usage: %s [-o output_dir] [-n loops] [file.ir ...]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    glob_t assets = {0};
+    char** paths = argv + optind;
+    size_t paths_count = argc - optind;
+    if(!paths_count) {
+        glob(INFRARED_BENCH_ASSETS, 0, NULL, &assets);
+        paths = assets.gl_pathv;
+        paths_count = assets.gl_pathc;
+    }
+
+    InfraredAnalyzer* analyzer = infrared_analyzer_alloc();
+    InfraredBenchStats total = {0};
+    size_t errors = 0;
+
+    printf(
+        "%-16s %7s %6s %6s %8s %9s %9s %7s %8s %8s\n",
+        "File",
+        "Raw",
+        "Parsed",
+        "Templ",
+        "Kept raw",
+        "Size,KB",
+        "New,KB",
+        "Saved",
+        "Load,ms",
+        "New,ms");
+
+    for(size_t i = 0; i < paths_count; ++i) {
+        size_t size;
+        char* data = infrared_bench_read_file(paths[i], &size);
+        if(!data) {
+            printf("%s: can't read\n", paths[i]);
+            errors++;
+            continue;
+        }
+
+        InfraredBenchStats stats = {.size = size};
+        char* converted = infrared_bench_convert(analyzer, paths[i], data, &stats);
+        stats.converted_size = strlen(converted);
+
+        size_t signals, converted_signals;
+        stats.load = infrared_bench_load_time(data, loops, &signals);
+        stats.converted_load = infrared_bench_load_time(converted, loops, &converted_signals);
+        if(signals != converted_signals) {
+            printf("%s: %zu signals loaded, %zu after\n", paths[i], signals, converted_signals);
+            stats.errors++;
+        }
+        if(output && !infrared_bench_write_file(output, paths[i], converted)) {
+            printf("%s: can't write to %s\n", paths[i], output);
+            stats.errors++;
+        }
+
+        const char* name = strrchr(paths[i], '/');
+        infrared_bench_print(name ? name + 1 : paths[i], &stats);
+
+        total.signals += stats.signals;
+        total.parsed += stats.parsed;
+        total.templates += stats.templates;
+        total.raw += stats.raw;
+        total.size += stats.size;
+        total.converted_size += stats.converted_size;
+        total.load += stats.load;
+        total.converted_load += stats.converted_load;
+        errors += stats.errors;
+
+        free(converted);
+        free(data);
+    }
+
+    if(total.size) infrared_bench_print("Total", &total);
+
+    infrared_analyzer_free(analyzer);
+    globfree(&assets);
+
+    if(errors) {
+        printf("%zu errors\n", errors);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,5 @@
+#pragma once
+
+// Just enough of furi to build infrared encoders and decoders on host
+
+#include <core/core_defines.h>
@@ -0,0 +1,458 @@
+// Host benchmark for ProtocolDict batch feed
+//
+// Replays LF RFID captures through all decoders twice: pair by pair like LFRFIDWorker read
+// did before, and with protocol_dict_decoders_feed_batch like it does now. Prints decode
+// throughput of both and fails if they decode different protocols, data or positions.
+//
+// Captures are files from "Read RAW" (lfrfid_raw_file.c format, 32 bit size_t). Without them,
+// every protocol encoder output is replayed instead, same way unit tests do.
+
+#include <furi.h>
+#include <toolbox/protocols/protocol_dict.h>
+#include <toolbox/pulse_protocols/pulse_glue.h>
+#include <lfrfid/protocols/lfrfid_protocols.h>
+#include <lfrfid/tools/varint_pair.h>
+
+#include <time.h>
+#include <unistd.h>
+
+#define LFRFID_BENCH_RAW_FILE_MAGIC 0x4C464952
+#define LFRFID_BENCH_RAW_FILE_VERSION 1
+
+// Same as LFRFID_WORKER_READ_BUFFER_SIZE, 512 bytes of varint pairs
+#define LFRFID_BENCH_BUFFER_SIZE (512)
+#define LFRFID_BENCH_SYNTHETIC_LEVELS (40000)
+#define LFRFID_BENCH_READ_TIMING_MULTIPLIER (8)
+#define LFRFID_BENCH_DATA_MAX (16)
+
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    float frequency;
+    float duty_cycle;
+    uint32_t max_buffer_size;
+} LFRFIDBenchRawFileHeader;
+
+typedef struct {
+    char name[64];
+    LFRFIDFeature feature;
+    LevelDuration* pairs; // High and low level of every captured pulse
+    size_t pairs_count;
+    size_t* buffers; // Pairs in each capture buffer
+    size_t buffers_count;
+} LFRFIDBenchCapture;
+
+typedef struct {
+    size_t position; // Pair that completed decoding
+    ProtocolId protocol;
+    uint8_t data[LFRFID_BENCH_DATA_MAX];
+} LFRFIDBenchResult;
+
+typedef struct {
+    LFRFIDBenchResult* items;
+    size_t count;
+    size_t capacity;
+} LFRFIDBenchResults;
+
+static double lfrfid_bench_now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static void
+    lfrfid_bench_capture_push(LFRFIDBenchCapture* capture, uint32_t pulse, uint32_t duration) {
+    if(!(capture->pairs_count % 1024)) {
+        capture->pairs =
+            realloc(capture->pairs, sizeof(LevelDuration) * (capture->pairs_count + 1024));
+    }
+    capture->pairs[capture->pairs_count++] = level_duration_make(true, pulse);
+    capture->pairs[capture->pairs_count++] = level_duration_make(false, duration - pulse);
+}
+
+static void lfrfid_bench_capture_end_buffer(LFRFIDBenchCapture* capture, size_t start) {
+    if(capture->pairs_count == start) return;
+    capture->buffers = realloc(capture->buffers, sizeof(size_t) * (capture->buffers_count + 1));
+    capture->buffers[capture->buffers_count++] = capture->pairs_count - start;
+}
+
+static bool lfrfid_bench_capture_load(LFRFIDBenchCapture* capture, const char* path) {
+    FILE* file = fopen(path, "rb");
+    if(!file) return false;
+
+    bool result = false;
+    uint8_t* buffer = NULL;
+
+    do {
+        LFRFIDBenchRawFileHeader header;
+        if(fread(&header, sizeof(header), 1, file) != 1) break;
+        if(header.magic != LFRFID_BENCH_RAW_FILE_MAGIC ||
+           header.version != LFRFID_BENCH_RAW_FILE_VERSION) {
+            break;
+        }
+
+        snprintf(capture->name, sizeof(capture->name), "%s", path);
+        // Worker reads PSK at 62.5 kHz and ASK at 125 kHz
+        capture->feature = header.frequency < 100000.0f ? LFRFIDFeaturePSK : LFRFIDFeatureASK;
+        buffer = malloc(header.max_buffer_size);
+
+        uint32_t size;
+        result = true;
+        while(fread(&size, sizeof(size), 1, file) == 1) {
+            if(size > header.max_buffer_size || fread(buffer, size, 1, file) != 1) {
+                result = false;
+                break;
+            }
+
+            size_t start = capture->pairs_count;
+            for(size_t index = 0; index < size;) {
+                uint32_t pulse, duration;
+                size_t tmp_size;
+                if(!varint_pair_unpack(
+                       &buffer[index], size - index, &pulse, &duration, &tmp_size)) {
+                    break;
+                }
+                index += tmp_size;
+                lfrfid_bench_capture_push(capture, pulse, duration);
+            }
+            lfrfid_bench_capture_end_buffer(capture, start);
+        }
+    } while(false);
+
+    free(buffer);
+    fclose(file);
+    return result;
+}
+
+typedef struct {
+    ProtocolId protocol;
+    uint8_t data[LFRFID_BENCH_DATA_MAX];
+} LFRFIDBenchSample;
+
+// Data the decoders validate, other protocols get a fixed pattern
+static const LFRFIDBenchSample lfrfid_bench_samples[] = {
+    // 26 bit format, decoder rejects unknown format lengths
+    {LFRFIDProtocolAwid, {26, 0x35, 0x80, 0x1C, 0x40, 0x00, 0x00, 0x00, 0x00}},
+    // Reserved byte is zero, low nibble of byte 5 is the parity of bytes 1 to 5
+    {LFRFIDProtocolNexwatch, {0x00, 0x12, 0x34, 0x56, 0x78, 0x98, 0x00, 0x00}},
+};
+
+static void lfrfid_bench_sample_data(ProtocolId protocol, uint8_t* data, size_t data_size) {
+    for(size_t i = 0; i < COUNT_OF(lfrfid_bench_samples); i++) {
+        if(lfrfid_bench_samples[i].protocol == protocol) {
+            memcpy(data, lfrfid_bench_samples[i].data, data_size);
+            return;
+        }
+    }
+    for(size_t i = 0; i < data_size; i++) {
+        data[i] = 0x35 + i * 0x4B;
+    }
+}
+
+typedef struct {
+    size_t start;
+    size_t size;
+} LFRFIDBenchBuffer;
+
+// Pulse as the worker stores it, split in buffers of worker size
+static void lfrfid_bench_capture_add(
+    LFRFIDBenchCapture* capture,
+    LFRFIDBenchBuffer* buffer,
+    uint32_t pulse,
+    uint32_t duration) {
+    VarintPair* pair = varint_pair_alloc();
+    varint_pair_pack(pair, true, pulse);
+    varint_pair_pack(pair, false, duration);
+    if(buffer->size + varint_pair_get_size(pair) > LFRFID_BENCH_BUFFER_SIZE) {
+        lfrfid_bench_capture_end_buffer(capture, buffer->start);
+        buffer->start = capture->pairs_count;
+        buffer->size = 0;
+    }
+    buffer->size += varint_pair_get_size(pair);
+    varint_pair_free(pair);
+
+    lfrfid_bench_capture_push(capture, pulse, duration);
+}
+
+// ASK and FSK: carrier cycles as they come from comparator
+static void lfrfid_bench_capture_synthesize_ask(
+    LFRFIDBenchCapture* capture,
+    ProtocolDict* dict,
+    ProtocolId protocol) {
+    PulseGlue* pulse_glue = pulse_glue_alloc();
+    LFRFIDBenchBuffer buffer = {0};
+    for(size_t i = 0; i < LFRFID_BENCH_SYNTHETIC_LEVELS; i++) {
+        LevelDuration level = protocol_dict_encoder_yield(dict, protocol);
+        if(pulse_glue_push(
+               pulse_glue,
+               level_duration_get_level(level),
+               level_duration_get_duration(level) * LFRFID_BENCH_READ_TIMING_MULTIPLIER)) {
+            uint32_t length, period;
+            pulse_glue_pop(pulse_glue, &length, &period);
+            lfrfid_bench_capture_add(capture, &buffer, period, length);
+        }
+    }
+    lfrfid_bench_capture_end_buffer(capture, buffer.start);
+    pulse_glue_free(pulse_glue);
+}
+
+// PSK: encoder yields carrier half periods, comparator sees the carrier phase instead.
+// Halves with the same phase join into one level, a phase flip starts the next one.
+static void lfrfid_bench_capture_synthesize_psk(
+    LFRFIDBenchCapture* capture,
+    ProtocolDict* dict,
+    ProtocolId protocol) {
+    LFRFIDBenchBuffer buffer = {0};
+    bool phase = true;
+    uint32_t durations[2] = {0};
+    for(size_t i = 0; capture->pairs_count < LFRFID_BENCH_SYNTHETIC_LEVELS; i++) {
+        LevelDuration level = protocol_dict_encoder_yield(dict, protocol);
+        bool level_phase = level_duration_get_level(level) ^ (i & 1);
+        uint32_t duration =
+            level_duration_get_duration(level) * LFRFID_BENCH_READ_TIMING_MULTIPLIER;
+
+        if(level_phase != phase) {
+            phase = level_phase;
+            if(phase && durations[0] && durations[1]) {
+                lfrfid_bench_capture_add(
+                    capture, &buffer, durations[0], durations[0] + durations[1]);
+                durations[0] = durations[1] = 0;
+            }
+        }
+        durations[phase ? 0 : 1] += duration;
+    }
+    lfrfid_bench_capture_end_buffer(capture, buffer.start);
+}
+
+static bool lfrfid_bench_capture_synthesize(
+    LFRFIDBenchCapture* capture,
+    ProtocolDict* dict,
+    ProtocolId protocol) {
+    uint8_t data[LFRFID_BENCH_DATA_MAX];
+    const size_t data_size = protocol_dict_get_data_size(dict, protocol);
+    furi_check(data_size <= sizeof(data));
+    lfrfid_bench_sample_data(protocol, data, data_size);
+    protocol_dict_set_data(dict, protocol, data, data_size);
+    if(!protocol_dict_encoder_start(dict, protocol)) return false;
+
+    snprintf(capture->name, sizeof(capture->name), "%s", protocol_dict_get_name(dict, protocol));
+    capture->feature = protocol_dict_get_features(dict, protocol) & LFRFIDFeatureASK ?
+                           LFRFIDFeatureASK :
+                           LFRFIDFeaturePSK;
+
+    if(capture->feature == LFRFIDFeaturePSK) {
+        lfrfid_bench_capture_synthesize_psk(capture, dict, protocol);
+    } else {
+        lfrfid_bench_capture_synthesize_ask(capture, dict, protocol);
+    }
+
+    return capture->pairs_count > 0;
+}
+
+static void lfrfid_bench_result_add(
+    LFRFIDBenchResults* results,
+    ProtocolDict* dict,
+    ProtocolId protocol,
+    size_t position) {
+    if(results->count == results->capacity) {
+        results->capacity = results->capacity ? results->capacity * 2 : 64;
+        results->items = realloc(results->items, sizeof(LFRFIDBenchResult) * results->capacity);
+    }
+
+    LFRFIDBenchResult* result = &results->items[results->count++];
+    memset(result, 0, sizeof(LFRFIDBenchResult));
+    result->position = position;
+    result->protocol = protocol;
+    protocol_dict_get_data(
+        dict, protocol, result->data, protocol_dict_get_data_size(dict, protocol));
+}
+
+// LFRFIDWorker read loop before batch feed
+static void lfrfid_bench_feed_pairs(
+    ProtocolDict* dict,
+    const LFRFIDBenchCapture* capture,
+    LFRFIDBenchResults* results) {
+    protocol_dict_decoders_start(dict);
+
+    const LevelDuration* pairs = capture->pairs;
+    for(size_t i = 0; i < capture->pairs_count; i += 2) {
+        size_t position = i;
+        ProtocolId protocol = protocol_dict_decoders_feed_by_feature(
+            dict, capture->feature, true, level_duration_get_duration(pairs[i]));
+        if(protocol == PROTOCOL_NO) {
+            position = i + 1;
+            protocol = protocol_dict_decoders_feed_by_feature(
+                dict, capture->feature, false, level_duration_get_duration(pairs[i + 1]));
+        }
+
+        if(protocol != PROTOCOL_NO) {
+            if(results) lfrfid_bench_result_add(results, dict, protocol, position);
+            protocol_dict_decoders_start(dict);
+        }
+    }
+}
+
+// LFRFIDWorker read loop with batch feed, one call per capture buffer
+static void lfrfid_bench_feed_batch(
+    ProtocolDict* dict,
+    const LFRFIDBenchCapture* capture,
+    LFRFIDBenchResults* results) {
+    protocol_dict_decoders_start(dict);
+
+    size_t start = 0;
+    for(size_t buffer = 0; buffer < capture->buffers_count; buffer++) {
+        const LevelDuration* pairs = &capture->pairs[start];
+        const size_t pairs_count = capture->buffers[buffer];
+
+        size_t index = 0;
+        while(index < pairs_count) {
+            size_t consumed;
+            ProtocolId protocol = protocol_dict_decoders_feed_batch_by_feature(
+                dict, capture->feature, &pairs[index], pairs_count - index, &consumed);
+            index += consumed;
+
+            if(protocol != PROTOCOL_NO) {
+                if(results) lfrfid_bench_result_add(results, dict, protocol, start + index - 1);
+                if(level_duration_get_level(pairs[index - 1])) index++;
+                protocol_dict_decoders_start(dict);
+            }
+        }
+
+        start += pairs_count;
+    }
+}
+
+static bool lfrfid_bench_results_equal(const LFRFIDBenchResults* a, const LFRFIDBenchResults* b) {
+    if(a->count != b->count) return false;
+    for(size_t i = 0; i < a->count; i++) {
+        if(a->items[i].position != b->items[i].position ||
+           a->items[i].protocol != b->items[i].protocol ||
+           memcmp(a->items[i].data, b->items[i].data, LFRFID_BENCH_DATA_MAX) != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+typedef void (*LFRFIDBenchFeed)(ProtocolDict*, const LFRFIDBenchCapture*, LFRFIDBenchResults*);
+
+// Pairs per second
+static double lfrfid_bench_run(
+    LFRFIDBenchFeed feed,
+    ProtocolDict* dict,
+    const LFRFIDBenchCapture* capture,
+    size_t loops,
+    LFRFIDBenchResults* results) {
+    feed(dict, capture, results);
+
+    const double start = lfrfid_bench_now();
+    for(size_t i = 0; i < loops; i++) {
+        feed(dict, capture, NULL);
+    }
+    return capture->pairs_count * loops / (lfrfid_bench_now() - start);
+}
+
+static bool lfrfid_bench_capture(
+    ProtocolDict* dict,
+    const LFRFIDBenchCapture* capture,
+    size_t loops,
+    double* total_pairs,
+    double* total_batch) {
+    LFRFIDBenchResults pairs_results = {0};
+    LFRFIDBenchResults batch_results = {0};
+
+    const double pairs_rate =
+        lfrfid_bench_run(lfrfid_bench_feed_pairs, dict, capture, loops, &pairs_results);
+    const double batch_rate =
+        lfrfid_bench_run(lfrfid_bench_feed_batch, dict, capture, loops, &batch_results);
+    const bool equal = lfrfid_bench_results_equal(&pairs_results, &batch_results);
+
+    printf(
+        "%-24s %3s %8zu %6zu %10.2f %10.2f %6.2fx %s\n",
+        capture->name,
+        capture->feature == LFRFIDFeaturePSK ? "PSK" : "ASK",
+        capture->pairs_count,
+        pairs_results.count,
+        pairs_rate / 1e6,
+        batch_rate / 1e6,
+        batch_rate / pairs_rate,
+        equal ? "" : "MISMATCH");
+
+    *total_pairs += capture->pairs_count / pairs_rate;
+    *total_batch += capture->pairs_count / batch_rate;
+
+    free(pairs_results.items);
+    free(batch_results.items);
+    return equal;
+}
+
+static void lfrfid_bench_capture_free(LFRFIDBenchCapture* capture) {
+    free(capture->pairs);
+    free(capture->buffers);
+    memset(capture, 0, sizeof(LFRFIDBenchCapture));
+}
+
+int main(int argc, char** argv) {
+    size_t loops = 50;
+    int opt;
+
+    while((opt = getopt(argc, argv, "n:")) != -1) {
+        switch(opt) {
+        case 'n':
+            loops = strtoul(optarg, NULL, 0);
+            break;
+        default:
+            fprintf(stderr, "Usage: %s [-n loops] [capture.raw ...]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    ProtocolDict* dict = protocol_dict_alloc(lfrfid_protocols, LFRFIDProtocolMax);
+    size_t errors = 0;
+    double total_pairs = 0;
+    double total_batch = 0;
+
+    printf(
+        "%-24s %3s %8s %6s %10s %10s %7s\n",
+        "Capture",
+        "Mod",
+        "Levels",
+        "Reads",
+        "Feed M/s",
+        "Batch M/s",
+        "Speed");
+
+    if(optind < argc) {
+        for(int i = optind; i < argc; i++) {
+            LFRFIDBenchCapture capture = {0};
+            if(!lfrfid_bench_capture_load(&capture, argv[i])) {
+                printf("%s: can't load capture\n", argv[i]);
+                errors++;
+            } else if(!lfrfid_bench_capture(dict, &capture, loops, &total_pairs, &total_batch)) {
+                errors++;
+            }
+            lfrfid_bench_capture_free(&capture);
+        }
+    } else {
+        for(ProtocolId protocol = 0; protocol < LFRFIDProtocolMax; protocol++) {
+            LFRFIDBenchCapture capture = {0};
+            if(lfrfid_bench_capture_synthesize(&capture, dict, protocol) &&
+               !lfrfid_bench_capture(dict, &capture, loops, &total_pairs, &total_batch)) {
+                errors++;
+            }
+            lfrfid_bench_capture_free(&capture);
+        }
+    }
+
+    if(total_batch > 0) {
+        printf("Total speedup %.2fx\n", total_pairs / total_batch);
+    }
+
+    protocol_dict_free(dict);
+
+    if(errors) {
+        printf("%zu errors\n", errors);
+        return 1;
+    }
+    return 0;
+}
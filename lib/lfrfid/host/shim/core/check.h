@@ -0,0 +1,17 @@
+#pragma once
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#define furi_crash(message)                                         \
+    do {                                                            \
+        fprintf(stderr, "%s:%d %s\n", __FILE__, __LINE__, message); \
+        abort();                                                    \
+    } while(0)
+
+#define furi_check(condition)                             \
+    do {                                                  \
+        if(!(condition)) furi_crash("furi_check failed"); \
+    } while(0)
+
+#define furi_assert(condition) furi_check(condition)
@@ -0,0 +1,30 @@
+#pragma once
+
+// Just enough of furi to build protocol decoders on host
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <core/check.h>
+
+#define UNUSED(X) (void)(X)
+#define COUNT_OF(x) (sizeof(x) / sizeof(x[0]))
+#define MIN(a, b) ((a) < (b) ? (a) : (b))
+
+#define FURI_LOG_E(tag, format, ...)
+#define FURI_LOG_W(tag, format, ...)
+#define FURI_LOG_I(tag, format, ...)
+#define FURI_LOG_D(tag, format, ...)
+#define FURI_LOG_T(tag, format, ...)
+
+typedef struct FuriString FuriString;
+
+FuriString* furi_string_alloc(void);
+void furi_string_free(FuriString* string);
+void furi_string_reset(FuriString* string);
+const char* furi_string_get_cstr(const FuriString* string);
+int furi_string_printf(FuriString* string, const char format[], ...);
+int furi_string_cat_printf(FuriString* string, const char format[], ...);
@@ -0,0 +1,10 @@
+#pragma once
+
+typedef enum {
+    FuriHalRtcLocaleUnitsMetric = 0,
+    FuriHalRtcLocaleUnitsImperial = 1,
+} FuriHalRtcLocaleUnits;
+
+static inline FuriHalRtcLocaleUnits furi_hal_rtc_get_locale_units(void) {
+    return FuriHalRtcLocaleUnitsMetric;
+}
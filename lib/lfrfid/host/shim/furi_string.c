@@ -0,0 +1,44 @@
+#include <furi.h>
+#include <stdarg.h>
+
+struct FuriString {
+    char data[256];
+};
+
+FuriString* furi_string_alloc(void) {
+    return calloc(1, sizeof(FuriString));
+}
+
+void furi_string_free(FuriString* string) {
+    free(string);
+}
+
+void furi_string_reset(FuriString* string) {
+    string->data[0] = '\0';
+}
+
+const char* furi_string_get_cstr(const FuriString* string) {
+    return string->data;
+}
+
+static int furi_string_vcat_printf(FuriString* string, const char format[], va_list args) {
+    size_t length = strlen(string->data);
+    return vsnprintf(string->data + length, sizeof(string->data) - length, format, args);
+}
+
+int furi_string_printf(FuriString* string, const char format[], ...) {
+    va_list args;
+    va_start(args, format);
+    furi_string_reset(string);
+    int result = furi_string_vcat_printf(string, format, args);
+    va_end(args);
+    return result;
+}
+
+int furi_string_cat_printf(FuriString* string, const char format[], ...) {
+    va_list args;
+    va_start(args, format);
+    int result = furi_string_vcat_printf(string, format, args);
+    va_end(args);
+    return result;
+}
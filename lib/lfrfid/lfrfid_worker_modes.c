@@ -36,6 +36,8 @@
 
 #define LFRFID_WORKER_READ_BUFFER_SIZE 512
 #define LFRFID_WORKER_READ_BUFFER_COUNT 16
+// Varint pair takes at least 2 bytes and unpacks to high and low levels
+#define LFRFID_WORKER_READ_PAIRS_MAX LFRFID_WORKER_READ_BUFFER_SIZE
 
 #define LFRFID_WORKER_EMULATE_BUFFER_SIZE 1024
 
@@ -139,6 +141,7 @@ static LFRFIDWorkerReadState lfrfid_worker_read_internal(
     size_t last_size = protocol_dict_get_max_data_size(worker->protocols);
     uint8_t* last_data = malloc(last_size);
     uint8_t* protocol_data = malloc(last_size);
+    LevelDuration* pairs = malloc(sizeof(LevelDuration) * LFRFID_WORKER_READ_PAIRS_MAX);
     size_t last_read_count = 0;
 
     uint32_t switch_os_tick_last = furi_get_tick();
@@ -179,9 +182,9 @@ static LFRFIDWorkerReadState lfrfid_worker_read_internal(
 
         size_t size = buffer_get_size(buffer);
         uint8_t* data = buffer_get_data(buffer);
-        size_t index = 0;
+        size_t pairs_count = 0;
 
-        while(index < size) {
+        for(size_t index = 0; index < size;) {
             uint32_t duration;
             uint32_t pulse;
             size_t tmp_size;
@@ -189,8 +192,23 @@ static LFRFIDWorkerReadState lfrfid_worker_read_internal(
             if(!varint_pair_unpack(&data[index], size - index, &pulse, &duration, &tmp_size)) {
                 FURI_LOG_E(TAG, "can't unpack varint pair");
                 break;
-            } else {
-                index += tmp_size;
+            }
+
+            index += tmp_size;
+            pairs[pairs_count++] = level_duration_make(true, pulse);
+            pairs[pairs_count++] = level_duration_make(false, duration - pulse);
+        }
+
+        size_t index = 0;
+        while(index < pairs_count) {
+            size_t consumed;
+            ProtocolId protocol = protocol_dict_decoders_feed_batch_by_feature(
+                worker->protocols, feature, &pairs[index], pairs_count - index, &consumed);
+
+            // card sense, over the same pulses decoders took
+            for(size_t i = index; i < index + consumed; i += 2) {
+                uint32_t pulse = level_duration_get_duration(pairs[i]);
+                uint32_t duration = pulse + level_duration_get_duration(pairs[i + 1]);
 
                 average_duration += duration;
                 average_pulse += pulse;
@@ -217,71 +235,68 @@ static LFRFIDWorkerReadState lfrfid_worker_read_internal(
                         }
                     }
                 }
+            }
 
-                ProtocolId protocol = PROTOCOL_NO;
+            index += consumed;
 
-                protocol = protocol_dict_decoders_feed_by_feature(
-                    worker->protocols, feature, true, pulse);
-                if(protocol == PROTOCOL_NO) {
-                    protocol = protocol_dict_decoders_feed_by_feature(
-                        worker->protocols, feature, false, duration - pulse);
-                }
+            // low part of the pulse that completed decoding is dropped
+            if(protocol != PROTOCOL_NO && level_duration_get_level(pairs[index - 1])) {
+                index++;
+            }
 
-                if(protocol != PROTOCOL_NO) {
-                    // reset switch timer
-                    switch_os_tick_last = furi_get_tick();
+            if(protocol != PROTOCOL_NO) {
+                // reset switch timer
+                switch_os_tick_last = furi_get_tick();
 
-                    size_t protocol_data_size =
-                        protocol_dict_get_data_size(worker->protocols, protocol);
-                    protocol_dict_get_data(
-                        worker->protocols, protocol, protocol_data, protocol_data_size);
+                size_t protocol_data_size =
+                    protocol_dict_get_data_size(worker->protocols, protocol);
+                protocol_dict_get_data(
+                    worker->protocols, protocol, protocol_data, protocol_data_size);
 
-                    // validate protocol
-                    if(protocol == last_protocol &&
-                       memcmp(last_data, protocol_data, protocol_data_size) == 0) {
-                        last_read_count = last_read_count + 1;
+                // validate protocol
+                if(protocol == last_protocol &&
+                   memcmp(last_data, protocol_data, protocol_data_size) == 0) {
+                    last_read_count = last_read_count + 1;
 
-                        size_t validation_count =
-                            protocol_dict_get_validate_count(worker->protocols, protocol);
+                    size_t validation_count =
+                        protocol_dict_get_validate_count(worker->protocols, protocol);
 
-                        if(last_read_count >= validation_count) {
-                            state = LFRFIDWorkerReadOK;
-                            *result_protocol = protocol;
-                            break;
-                        }
-                    } else {
-                        if(last_protocol == PROTOCOL_NO && worker->read_cb) {
-                            worker->read_cb(
-                                LFRFIDWorkerReadSenseCardStart, protocol, worker->cb_ctx);
-                        }
-
-                        last_protocol = protocol;
-                        memcpy(last_data, protocol_data, protocol_data_size);
-                        last_read_count = 0;
+                    if(last_read_count >= validation_count) {
+                        state = LFRFIDWorkerReadOK;
+                        *result_protocol = protocol;
+                        break;
+                    }
+                } else {
+                    if(last_protocol == PROTOCOL_NO && worker->read_cb) {
+                        worker->read_cb(LFRFIDWorkerReadSenseCardStart, protocol, worker->cb_ctx);
                     }
 
-                    if(furi_log_get_level() >= FuriLogLevelDebug) {
-                        FuriString* string_info;
-                        string_info = furi_string_alloc();
-                        for(uint8_t i = 0; i < protocol_data_size; i++) {
-                            if(i != 0) {
-                                furi_string_cat_printf(string_info, " ");
-                            }
+                    last_protocol = protocol;
+                    memcpy(last_data, protocol_data, protocol_data_size);
+                    last_read_count = 0;
+                }
 
-                            furi_string_cat_printf(string_info, "%02X", protocol_data[i]);
+                if(furi_log_get_level() >= FuriLogLevelDebug) {
+                    FuriString* string_info;
+                    string_info = furi_string_alloc();
+                    for(uint8_t i = 0; i < protocol_data_size; i++) {
+                        if(i != 0) {
+                            furi_string_cat_printf(string_info, " ");
                         }
 
-                        FURI_LOG_D(
-                            TAG,
-                            "%s, %zu, [%s]",
-                            protocol_dict_get_name(worker->protocols, protocol),
-                            last_read_count,
-                            furi_string_get_cstr(string_info));
-                        furi_string_free(string_info);
+                        furi_string_cat_printf(string_info, "%02X", protocol_data[i]);
                     }
 
-                    protocol_dict_decoders_start(worker->protocols);
+                    FURI_LOG_D(
+                        TAG,
+                        "%s, %zu, [%s]",
+                        protocol_dict_get_name(worker->protocols, protocol),
+                        last_read_count,
+                        furi_string_get_cstr(string_info));
+                    furi_string_free(string_info);
                 }
+
+                protocol_dict_decoders_start(worker->protocols);
             }
         }
 
@@ -318,6 +333,7 @@ static LFRFIDWorkerReadState lfrfid_worker_read_internal(
     varint_pair_free(ctx.pair);
     buffer_stream_free(ctx.stream);
 
+    free(pairs);
     free(protocol_data);
     free(last_data);
 
@@ -93,12 +93,9 @@ static void protocol_awid_decode(uint8_t* encoded_data, uint8_t* decoded_data) {
     bit_lib_copy_bits(decoded_data, 0, 66, encoded_data, 8);
 }
 
-bool protocol_awid_decoder_feed(ProtocolAwid* protocol, bool level, uint32_t duration) {
-    bool value;
-    uint32_t count;
+static bool protocol_awid_decoder_push(ProtocolAwid* protocol, bool value, uint32_t count) {
     bool result = false;
 
-    fsk_demod_feed(protocol->decoder.fsk_demod, level, duration, &value, &count);
     if(count > 0) {
         for(size_t i = 0; i < count; i++) {
             bit_lib_push_bit(protocol->encoded_data, AWID_ENCODED_DATA_SIZE, value);
@@ -114,6 +111,26 @@ bool protocol_awid_decoder_feed(ProtocolAwid* protocol, bool level, uint32_t dur
     return result;
 };
 
+bool protocol_awid_decoder_feed(ProtocolAwid* protocol, bool level, uint32_t duration) {
+    bool value;
+    uint32_t count;
+
+    fsk_demod_feed(protocol->decoder.fsk_demod, level, duration, &value, &count);
+    return protocol_awid_decoder_push(protocol, value, count);
+};
+
+size_t protocol_awid_decoder_feed_batch(
+    ProtocolAwid* protocol,
+    const LevelDuration* pairs,
+    size_t count) {
+    return fsk_demod_feed_batch(
+        protocol->decoder.fsk_demod,
+        pairs,
+        count,
+        (FSKDemodCallback)protocol_awid_decoder_push,
+        protocol);
+};
+
 static void protocol_awid_encode(const uint8_t* decoded_data, uint8_t* encoded_data) {
     memset(encoded_data, 0, AWID_ENCODED_DATA_SIZE);
 
@@ -243,6 +260,7 @@ const ProtocolBase protocol_awid = {
         {
             .start = (ProtocolDecoderStart)protocol_awid_decoder_start,
             .feed = (ProtocolDecoderFeed)protocol_awid_decoder_feed,
+            .feed_batch = (ProtocolDecoderFeedBatch)protocol_awid_decoder_feed_batch,
         },
     .encoder =
         {
@@ -140,7 +140,8 @@ void protocol_em4100_decoder_start(ProtocolEM4100* proto) {
         NULL);
 };
 
-bool protocol_em4100_decoder_feed(ProtocolEM4100* proto, bool level, uint32_t duration) {
+static inline bool
+    protocol_em4100_decoder_advance(ProtocolEM4100* proto, bool level, uint32_t duration) {
     bool result = false;
 
     ManchesterEvent event = ManchesterEventReset;
@@ -179,6 +180,26 @@ bool protocol_em4100_decoder_feed(ProtocolEM4100* proto, bool level, uint32_t du
     }
 
     return result;
+}
+
+bool protocol_em4100_decoder_feed(ProtocolEM4100* proto, bool level, uint32_t duration) {
+    return protocol_em4100_decoder_advance(proto, level, duration);
+};
+
+size_t protocol_em4100_decoder_feed_batch(
+    ProtocolEM4100* proto,
+    const LevelDuration* pairs,
+    size_t count) {
+    for(size_t i = 0; i < count; i++) {
+        if(protocol_em4100_decoder_advance(
+               proto,
+               level_duration_get_level(pairs[i]),
+               level_duration_get_duration(pairs[i]))) {
+            return i + 1;
+        }
+    }
+
+    return 0;
 };
 
 static void em4100_write_nibble(bool low_nibble, uint8_t data, EM4100DecodedData* encoded_data) {
@@ -289,6 +310,7 @@ const ProtocolBase protocol_em4100 = {
         {
             .start = (ProtocolDecoderStart)protocol_em4100_decoder_start,
             .feed = (ProtocolDecoderFeed)protocol_em4100_decoder_feed,
+            .feed_batch = (ProtocolDecoderFeedBatch)protocol_em4100_decoder_feed_batch,
         },
     .encoder =
         {
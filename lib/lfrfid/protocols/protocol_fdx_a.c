@@ -107,12 +107,9 @@ static bool protocol_fdx_a_can_be_decoded(const uint8_t* data) {
     return (parity_sum == 0);
 }
 
-bool protocol_fdx_a_decoder_feed(ProtocolFDXA* protocol, bool level, uint32_t duration) {
-    bool value;
-    uint32_t count;
+static bool protocol_fdx_a_decoder_push(ProtocolFDXA* protocol, bool value, uint32_t count) {
     bool result = false;
 
-    fsk_demod_feed(protocol->decoder.fsk_demod, level, duration, &value, &count);
     if(count > 0) {
         for(size_t i = 0; i < count; i++) {
             bit_lib_push_bit(protocol->encoded_data, FDXA_ENCODED_DATA_SIZE, value);
@@ -126,6 +123,26 @@ bool protocol_fdx_a_decoder_feed(ProtocolFDXA* protocol, bool level, uint32_t du
     return result;
 };
 
+bool protocol_fdx_a_decoder_feed(ProtocolFDXA* protocol, bool level, uint32_t duration) {
+    bool value;
+    uint32_t count;
+
+    fsk_demod_feed(protocol->decoder.fsk_demod, level, duration, &value, &count);
+    return protocol_fdx_a_decoder_push(protocol, value, count);
+};
+
+size_t protocol_fdx_a_decoder_feed_batch(
+    ProtocolFDXA* protocol,
+    const LevelDuration* pairs,
+    size_t count) {
+    return fsk_demod_feed_batch(
+        protocol->decoder.fsk_demod,
+        pairs,
+        count,
+        (FSKDemodCallback)protocol_fdx_a_decoder_push,
+        protocol);
+};
+
 static void protocol_fdx_a_encode(ProtocolFDXA* protocol) {
     protocol->encoded_data[0] = FDXA_PREAMBLE_0;
     protocol->encoded_data[1] = FDXA_PREAMBLE_1;
@@ -240,6 +257,7 @@ const ProtocolBase protocol_fdx_a = {
         {
             .start = (ProtocolDecoderStart)protocol_fdx_a_decoder_start,
             .feed = (ProtocolDecoderFeed)protocol_fdx_a_decoder_feed,
+            .feed_batch = (ProtocolDecoderFeedBatch)protocol_fdx_a_decoder_feed_batch,
         },
     .encoder =
         {
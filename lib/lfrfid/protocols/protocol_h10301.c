@@ -187,12 +187,9 @@ static void protocol_h10301_decode(const uint32_t* card_data, uint8_t* decoded_d
     memcpy(decoded_data, &data, H10301_DECODED_DATA_SIZE);
 }
 
-bool protocol_h10301_decoder_feed(ProtocolH10301* protocol, bool level, uint32_t duration) {
-    bool value;
-    uint32_t count;
+static bool protocol_h10301_decoder_push(ProtocolH10301* protocol, bool value, uint32_t count) {
     bool result = false;
 
-    fsk_demod_feed(protocol->decoder.fsk_demod, level, duration, &value, &count);
     if(count > 0) {
         for(size_t i = 0; i < count; i++) {
             protocol_h10301_decoder_store_data(protocol, value);
@@ -207,6 +204,26 @@ bool protocol_h10301_decoder_feed(ProtocolH10301* protocol, bool level, uint32_t
     return result;
 };
 
+bool protocol_h10301_decoder_feed(ProtocolH10301* protocol, bool level, uint32_t duration) {
+    bool value;
+    uint32_t count;
+
+    fsk_demod_feed(protocol->decoder.fsk_demod, level, duration, &value, &count);
+    return protocol_h10301_decoder_push(protocol, value, count);
+};
+
+size_t protocol_h10301_decoder_feed_batch(
+    ProtocolH10301* protocol,
+    const LevelDuration* pairs,
+    size_t count) {
+    return fsk_demod_feed_batch(
+        protocol->decoder.fsk_demod,
+        pairs,
+        count,
+        (FSKDemodCallback)protocol_h10301_decoder_push,
+        protocol);
+};
+
 static void protocol_h10301_write_raw_bit(bool bit, uint8_t position, uint32_t* card_data) {
     if(bit) {
         card_data[position / H10301_BIT_SIZE] |=
@@ -378,6 +395,7 @@ const ProtocolBase protocol_h10301 = {
         {
             .start = (ProtocolDecoderStart)protocol_h10301_decoder_start,
             .feed = (ProtocolDecoderFeed)protocol_h10301_decoder_feed,
+            .feed_batch = (ProtocolDecoderFeedBatch)protocol_h10301_decoder_feed_batch,
         },
     .encoder =
         {
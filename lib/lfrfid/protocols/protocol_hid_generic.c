@@ -125,12 +125,9 @@ static uint8_t protocol_hid_generic_decode_protocol_size(ProtocolHID* protocol)
     return size < 26 ? HID_PROTOCOL_SIZE_UNKNOWN : size;
 }
 
-bool protocol_hid_generic_decoder_feed(ProtocolHID* protocol, bool level, uint32_t duration) {
-    bool value;
-    uint32_t count;
+static bool protocol_hid_generic_decoder_push(ProtocolHID* protocol, bool value, uint32_t count) {
     bool result = false;
 
-    fsk_demod_feed(protocol->decoder.fsk_demod, level, duration, &value, &count);
     if(count > 0) {
         for(size_t i = 0; i < count; i++) {
             bit_lib_push_bit(protocol->encoded_data, HID_ENCODED_DATA_SIZE, value);
@@ -144,6 +141,26 @@ bool protocol_hid_generic_decoder_feed(ProtocolHID* protocol, bool level, uint32
     return result;
 };
 
+bool protocol_hid_generic_decoder_feed(ProtocolHID* protocol, bool level, uint32_t duration) {
+    bool value;
+    uint32_t count;
+
+    fsk_demod_feed(protocol->decoder.fsk_demod, level, duration, &value, &count);
+    return protocol_hid_generic_decoder_push(protocol, value, count);
+};
+
+size_t protocol_hid_generic_decoder_feed_batch(
+    ProtocolHID* protocol,
+    const LevelDuration* pairs,
+    size_t count) {
+    return fsk_demod_feed_batch(
+        protocol->decoder.fsk_demod,
+        pairs,
+        count,
+        (FSKDemodCallback)protocol_hid_generic_decoder_push,
+        protocol);
+};
+
 static void protocol_hid_generic_encode(ProtocolHID* protocol) {
     protocol->encoded_data[0] = HID_PREAMBLE;
 
@@ -276,6 +293,7 @@ const ProtocolBase protocol_hid_generic = {
         {
             .start = (ProtocolDecoderStart)protocol_hid_generic_decoder_start,
             .feed = (ProtocolDecoderFeed)protocol_hid_generic_decoder_feed,
+            .feed_batch = (ProtocolDecoderFeedBatch)protocol_hid_generic_decoder_feed_batch,
         },
     .encoder =
         {
@@ -95,7 +95,8 @@ static void protocol_indala26_decoder_save(uint8_t* data_to, const uint8_t* data
     bit_lib_copy_bits(data_to, 27, 2, data_from, 62);
 }
 
-bool protocol_indala26_decoder_feed(ProtocolIndala* protocol, bool level, uint32_t duration) {
+static inline bool
+    protocol_indala26_decoder_advance(ProtocolIndala* protocol, bool level, uint32_t duration) {
     bool result = false;
 
     if(duration > (INDALA26_US_PER_BIT / 2)) {
@@ -146,6 +147,26 @@ bool protocol_indala26_decoder_feed(ProtocolIndala* protocol, bool level, uint32
     }
 
     return result;
+}
+
+bool protocol_indala26_decoder_feed(ProtocolIndala* protocol, bool level, uint32_t duration) {
+    return protocol_indala26_decoder_advance(protocol, level, duration);
+};
+
+size_t protocol_indala26_decoder_feed_batch(
+    ProtocolIndala* protocol,
+    const LevelDuration* pairs,
+    size_t count) {
+    for(size_t i = 0; i < count; i++) {
+        if(protocol_indala26_decoder_advance(
+               protocol,
+               level_duration_get_level(pairs[i]),
+               level_duration_get_duration(pairs[i]))) {
+            return i + 1;
+        }
+    }
+
+    return 0;
 };
 
 bool protocol_indala26_encoder_start(ProtocolIndala* protocol) {
@@ -344,6 +365,7 @@ const ProtocolBase protocol_indala26 = {
         {
             .start = (ProtocolDecoderStart)protocol_indala26_decoder_start,
             .feed = (ProtocolDecoderFeed)protocol_indala26_decoder_feed,
+            .feed_batch = (ProtocolDecoderFeedBatch)protocol_indala26_decoder_feed_batch,
         },
     .encoder =
         {
@@ -155,13 +155,10 @@ void protocol_io_prox_xsf_decode(const uint8_t* encoded_data, uint8_t* decoded_d
     decoded_data[3] = bit_lib_get_bits(encoded_data, 45, 8);
 }
 
-bool protocol_io_prox_xsf_decoder_feed(ProtocolIOProxXSF* protocol, bool level, uint32_t duration) {
+static bool
+    protocol_io_prox_xsf_decoder_push(ProtocolIOProxXSF* protocol, bool value, uint32_t count) {
     bool result = false;
 
-    uint32_t count;
-    bool value;
-
-    fsk_demod_feed(protocol->decoder.fsk_demod, level, duration, &value, &count);
     for(size_t i = 0; i < count; i++) {
         bit_lib_push_bit(protocol->encoded_data, IOPROXXSF_ENCODED_DATA_SIZE, value);
         if(protocol_io_prox_xsf_can_be_decoded(protocol->encoded_data)) {
@@ -174,6 +171,26 @@ bool protocol_io_prox_xsf_decoder_feed(ProtocolIOProxXSF* protocol, bool level,
     return result;
 };
 
+bool protocol_io_prox_xsf_decoder_feed(ProtocolIOProxXSF* protocol, bool level, uint32_t duration) {
+    bool value;
+    uint32_t count;
+
+    fsk_demod_feed(protocol->decoder.fsk_demod, level, duration, &value, &count);
+    return protocol_io_prox_xsf_decoder_push(protocol, value, count);
+};
+
+size_t protocol_io_prox_xsf_decoder_feed_batch(
+    ProtocolIOProxXSF* protocol,
+    const LevelDuration* pairs,
+    size_t count) {
+    return fsk_demod_feed_batch(
+        protocol->decoder.fsk_demod,
+        pairs,
+        count,
+        (FSKDemodCallback)protocol_io_prox_xsf_decoder_push,
+        protocol);
+};
+
 static void protocol_io_prox_xsf_encode(const uint8_t* decoded_data, uint8_t* encoded_data) {
     // Packet to transmit:
     //
@@ -289,6 +306,7 @@ const ProtocolBase protocol_io_prox_xsf = {
         {
             .start = (ProtocolDecoderStart)protocol_io_prox_xsf_decoder_start,
             .feed = (ProtocolDecoderFeed)protocol_io_prox_xsf_decoder_feed,
+            .feed_batch = (ProtocolDecoderFeedBatch)protocol_io_prox_xsf_decoder_feed_batch,
         },
     .encoder =
         {
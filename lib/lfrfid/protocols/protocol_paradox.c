@@ -84,11 +84,7 @@ static void protocol_paradox_decode(uint8_t* encoded_data, uint8_t* decoded_data
     bit_lib_push_bit(decoded_data, PARADOX_DECODED_DATA_SIZE, 0);
 }
 
-bool protocol_paradox_decoder_feed(ProtocolParadox* protocol, bool level, uint32_t duration) {
-    bool value;
-    uint32_t count;
-
-    fsk_demod_feed(protocol->decoder.fsk_demod, level, duration, &value, &count);
+static bool protocol_paradox_decoder_push(ProtocolParadox* protocol, bool value, uint32_t count) {
     if(count > 0) {
         for(size_t i = 0; i < count; i++) {
             bit_lib_push_bit(protocol->encoded_data, PARADOX_ENCODED_DATA_SIZE, value);
@@ -103,6 +99,26 @@ bool protocol_paradox_decoder_feed(ProtocolParadox* protocol, bool level, uint32
     return false;
 };
 
+bool protocol_paradox_decoder_feed(ProtocolParadox* protocol, bool level, uint32_t duration) {
+    bool value;
+    uint32_t count;
+
+    fsk_demod_feed(protocol->decoder.fsk_demod, level, duration, &value, &count);
+    return protocol_paradox_decoder_push(protocol, value, count);
+};
+
+size_t protocol_paradox_decoder_feed_batch(
+    ProtocolParadox* protocol,
+    const LevelDuration* pairs,
+    size_t count) {
+    return fsk_demod_feed_batch(
+        protocol->decoder.fsk_demod,
+        pairs,
+        count,
+        (FSKDemodCallback)protocol_paradox_decoder_push,
+        protocol);
+};
+
 static void protocol_paradox_encode(const uint8_t* decoded_data, uint8_t* encoded_data) {
     // preamble
     bit_lib_set_bits(encoded_data, 0, 0b00001111, 8);
@@ -228,6 +244,7 @@ const ProtocolBase protocol_paradox = {
         {
             .start = (ProtocolDecoderStart)protocol_paradox_decoder_start,
             .feed = (ProtocolDecoderFeed)protocol_paradox_decoder_feed,
+            .feed_batch = (ProtocolDecoderFeedBatch)protocol_paradox_decoder_feed_batch,
         },
     .encoder =
         {
@@ -105,12 +105,9 @@ static void protocol_pyramid_decode(ProtocolPyramid* protocol) {
     bit_lib_copy_bits(protocol->data, 16, 16, protocol->encoded_data, 81 + 8);
 }
 
-bool protocol_pyramid_decoder_feed(ProtocolPyramid* protocol, bool level, uint32_t duration) {
-    bool value;
-    uint32_t count;
+static bool protocol_pyramid_decoder_push(ProtocolPyramid* protocol, bool value, uint32_t count) {
     bool result = false;
 
-    fsk_demod_feed(protocol->decoder.fsk_demod, level, duration, &value, &count);
     if(count > 0) {
         for(size_t i = 0; i < count; i++) {
             bit_lib_push_bit(protocol->encoded_data, PYRAMID_ENCODED_DATA_SIZE, value);
@@ -124,6 +121,26 @@ bool protocol_pyramid_decoder_feed(ProtocolPyramid* protocol, bool level, uint32
     return result;
 };
 
+bool protocol_pyramid_decoder_feed(ProtocolPyramid* protocol, bool level, uint32_t duration) {
+    bool value;
+    uint32_t count;
+
+    fsk_demod_feed(protocol->decoder.fsk_demod, level, duration, &value, &count);
+    return protocol_pyramid_decoder_push(protocol, value, count);
+};
+
+size_t protocol_pyramid_decoder_feed_batch(
+    ProtocolPyramid* protocol,
+    const LevelDuration* pairs,
+    size_t count) {
+    return fsk_demod_feed_batch(
+        protocol->decoder.fsk_demod,
+        pairs,
+        count,
+        (FSKDemodCallback)protocol_pyramid_decoder_push,
+        protocol);
+};
+
 bool protocol_pyramid_get_parity(const uint8_t* bits, uint8_t type, int length) {
     int x;
     for(x = 0; length > 0; --length) x += bit_lib_get_bit(bits, length - 1);
@@ -270,6 +287,7 @@ const ProtocolBase protocol_pyramid = {
         {
             .start = (ProtocolDecoderStart)protocol_pyramid_decoder_start,
             .feed = (ProtocolDecoderFeed)protocol_pyramid_decoder_feed,
+            .feed_batch = (ProtocolDecoderFeedBatch)protocol_pyramid_decoder_feed_batch,
         },
     .encoder =
         {
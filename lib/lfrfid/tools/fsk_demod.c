@@ -49,8 +49,9 @@ void fsk_demod_free(FSKDemod* demod) {
     free(demod);
 }
 
-void fsk_demod_feed(FSKDemod* demod, bool polarity, uint32_t time, bool* value, uint32_t* count) {
-    *count = 0;
+static inline uint32_t
+    fsk_demod_advance(FSKDemod* demod, bool polarity, uint32_t time, bool* value) {
+    uint32_t count = 0;
 
     if(polarity) {
         // accumulate time
@@ -82,7 +83,7 @@ void fsk_demod_feed(FSKDemod* demod, bool polarity, uint32_t time, bool* value,
                     *value = demod->invert;
                 }
 
-                *count = data_count;
+                count = data_count;
                 demod->count = 0;
                 demod->last_pulse = pulse;
             }
@@ -90,4 +91,32 @@ void fsk_demod_feed(FSKDemod* demod, bool polarity, uint32_t time, bool* value,
             demod->count = 0;
         }
     }
+
+    return count;
+}
+
+void fsk_demod_feed(FSKDemod* demod, bool polarity, uint32_t time, bool* value, uint32_t* count) {
+    *count = fsk_demod_advance(demod, polarity, time, value);
+}
+
+size_t fsk_demod_feed_batch(
+    FSKDemod* demod,
+    const LevelDuration* pairs,
+    size_t pairs_count,
+    FSKDemodCallback callback,
+    void* context) {
+    for(size_t i = 0; i < pairs_count; i++) {
+        bool value;
+        uint32_t count = fsk_demod_advance(
+            demod,
+            level_duration_get_level(pairs[i]),
+            level_duration_get_duration(pairs[i]),
+            &value);
+
+        if(count > 0 && callback(context, value, count)) {
+            return i + 1;
+        }
+    }
+
+    return 0;
 }
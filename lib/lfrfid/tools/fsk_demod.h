@@ -1,6 +1,8 @@
 #pragma once
 #include <stdint.h>
 #include <stdbool.h>
+#include <stddef.h>
+#include <lib/toolbox/level_duration.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -8,6 +10,16 @@ extern "C" {
 
 typedef struct FSKDemod FSKDemod;
 
+/**
+ * @brief Demodulated bits callback for fsk_demod_feed_batch
+ * 
+ * @param context callback context
+ * @param value demodulated bit value
+ * @param count demodulated bit count, never 0
+ * @return true if protocol is decoded, stops the batch
+ */
+typedef bool (*FSKDemodCallback)(void* context, bool value, uint32_t count);
+
 /**
  * @brief Allocate a new FSKDemod instance
  * FSKDemod is a demodulator that can decode FSK encoded data
@@ -39,6 +51,23 @@ void fsk_demod_free(FSKDemod* fsk_demod);
  */
 void fsk_demod_feed(FSKDemod* demod, bool polarity, uint32_t time, bool* value, uint32_t* count);
 
+/**
+ * @brief Feed samples to demodulator, same as fsk_demod_feed for each of them
+ * 
+ * @param demod FSKDemod instance
+ * @param pairs samples
+ * @param pairs_count samples count
+ * @param callback called for every sample that completes some bits
+ * @param context callback context
+ * @return number of samples taken if callback returned true, 0 otherwise
+ */
+size_t fsk_demod_feed_batch(
+    FSKDemod* demod,
+    const LevelDuration* pairs,
+    size_t pairs_count,
+    FSKDemodCallback callback,
+    void* context);
+
 #ifdef __cplusplus
 }
 #endif
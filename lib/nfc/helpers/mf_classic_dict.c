@@ -1,19 +1,70 @@
 #include "mf_classic_dict.h"
 
 #include <lib/toolbox/args.h>
+#include <lib/toolbox/crc32_calc.h>
 #include <lib/flipper_format/flipper_format.h>
 
 #define MF_CLASSIC_DICT_FLIPPER_PATH EXT_PATH("nfc/assets/mf_classic_dict.nfc")
 #define MF_CLASSIC_DICT_USER_PATH EXT_PATH("nfc/assets/mf_classic_dict_user.nfc")
 #define MF_CLASSIC_DICT_UNIT_TEST_PATH EXT_PATH("unit_tests/mf_classic_dict.nfc")
+#define MF_CLASSIC_DICT_COMPILED_PATH EXT_PATH("nfc/assets/.mf_classic_dict.bin")
+#define MF_CLASSIC_DICT_UNIT_TEST_COMPILED_PATH EXT_PATH("unit_tests/.mf_classic_dict.bin")
 
 #define TAG "MfClassicDict"
 
 #define NFC_MF_CLASSIC_KEY_LEN (13)
 
+#define MF_CLASSIC_DICT_COMPILED_MAGIC (0x4443464DU) // "MFCD"
+#define MF_CLASSIC_DICT_COMPILED_VERSION (1U)
+#define MF_CLASSIC_DICT_KEY_SIZE (6U)
+#define MF_CLASSIC_DICT_PAGE_KEYS (64U)
+#define MF_CLASSIC_DICT_PAGE_SIZE (MF_CLASSIC_DICT_PAGE_KEYS * MF_CLASSIC_DICT_KEY_SIZE)
+#define MF_CLASSIC_DICT_PAGE_NONE (UINT32_MAX)
+#define MF_CLASSIC_DICT_SOURCE_BUFFER_SIZE (512U)
+
+/*
+ * Compiled dictionary layout:
+ * - MfClassicDictCompiledHeader
+ * - first key of every page of sorted keys, used to find the page without reading the file
+ * - keys in the source order, without duplicates
+ * - sorted keys
+ * Keys are 6 bytes each, most significant byte first.
+ */
+typedef struct {
+    uint32_t magic;
+    uint8_t version;
+    uint8_t reserved[3];
+    uint32_t sources_crc;
+    uint32_t keys_count;
+} MfClassicDictCompiledHeader;
+
+typedef enum {
+    MfClassicDictSectionOrdered,
+    MfClassicDictSectionSorted,
+} MfClassicDictSection;
+
 struct MfClassicDict {
     Stream* stream;
     uint32_t total_keys;
+
+    // Compiled dictionary
+    File* file;
+    uint32_t pages_count;
+    uint8_t* page_first_keys;
+    uint32_t position;
+    uint32_t page_loaded;
+    uint8_t page[MF_CLASSIC_DICT_PAGE_SIZE];
+};
+
+typedef void (*MfClassicDictSourceCallback)(const uint8_t* key, void* context);
+
+static const char* const mf_classic_dict_compiled_sources[] = {
+    MF_CLASSIC_DICT_USER_PATH,
+    MF_CLASSIC_DICT_FLIPPER_PATH,
+};
+
+static const char* const mf_classic_dict_unit_test_compiled_sources[] = {
+    MF_CLASSIC_DICT_UNIT_TEST_PATH,
 };
 
 bool mf_classic_dict_check_presence(MfClassicDictType dict_type) {
@@ -27,6 +78,13 @@ bool mf_classic_dict_check_presence(MfClassicDictType dict_type) {
     } else if(dict_type == MfClassicDictTypeUnitTest) {
         dict_present = storage_common_stat(storage, MF_CLASSIC_DICT_UNIT_TEST_PATH, NULL) ==
                        FSE_OK;
+    } else if(dict_type == MfClassicDictTypeCompiled) {
+        dict_present =
+            (storage_common_stat(storage, MF_CLASSIC_DICT_FLIPPER_PATH, NULL) == FSE_OK) ||
+            (storage_common_stat(storage, MF_CLASSIC_DICT_USER_PATH, NULL) == FSE_OK);
+    } else if(dict_type == MfClassicDictTypeUnitTestCompiled) {
+        dict_present = storage_common_stat(storage, MF_CLASSIC_DICT_UNIT_TEST_PATH, NULL) ==
+                       FSE_OK;
     }
 
     furi_record_close(RECORD_STORAGE);
@@ -34,8 +92,411 @@ bool mf_classic_dict_check_presence(MfClassicDictType dict_type) {
     return dict_present;
 }
 
+static int mf_classic_dict_key_cmp(const void* a, const void* b) {
+    return memcmp(a, b, MF_CLASSIC_DICT_KEY_SIZE);
+}
+
+static bool mf_classic_dict_parse_line(const char* line, size_t line_len, uint8_t* key) {
+    if(line_len && line[line_len - 1] == '\r') line_len--;
+    if(line_len != MF_CLASSIC_DICT_KEY_SIZE * 2) return false;
+
+    for(size_t i = 0; i < MF_CLASSIC_DICT_KEY_SIZE; i++) {
+        if(!args_char_to_hex(line[i * 2], line[i * 2 + 1], &key[i])) return false;
+    }
+    return true;
+}
+
+// Read source dictionary in bulk, update crc with its content and pass the keys to callback
+static bool mf_classic_dict_read_source(
+    Storage* storage,
+    const char* path,
+    uint32_t* crc,
+    MfClassicDictSourceCallback callback,
+    void* context) {
+    File* file = storage_file_alloc(storage);
+    uint8_t* buffer = malloc(MF_CLASSIC_DICT_SOURCE_BUFFER_SIZE);
+    bool source_read = false;
+
+    do {
+        uint32_t source_size = UINT32_MAX;
+        if(!storage_file_open(file, path, FSAM_READ, FSOM_OPEN_EXISTING)) {
+            // Missing source changes crc too
+            if(crc) *crc = crc32_calc_buffer(*crc, &source_size, sizeof(source_size));
+            break;
+        }
+        source_size = storage_file_size(file);
+        if(crc) *crc = crc32_calc_buffer(*crc, &source_size, sizeof(source_size));
+
+        // Only key lines are kept, longer lines are skipped
+        char line[NFC_MF_CLASSIC_KEY_LEN + 1];
+        size_t line_len = 0;
+        bool line_skip = false;
+        uint8_t key[MF_CLASSIC_DICT_KEY_SIZE];
+
+        while(true) {
+            uint16_t bytes_read =
+                storage_file_read(file, buffer, MF_CLASSIC_DICT_SOURCE_BUFFER_SIZE);
+            if(crc) *crc = crc32_calc_buffer(*crc, buffer, bytes_read);
+            if(callback) {
+                for(size_t i = 0; i < bytes_read; i++) {
+                    char c = buffer[i];
+                    if(c == '\n') {
+                        if(!line_skip && mf_classic_dict_parse_line(line, line_len, key)) {
+                            callback(key, context);
+                        }
+                        line_len = 0;
+                        line_skip = false;
+                    } else if(line_len == 0 && c == '#') {
+                        line_skip = true;
+                    } else if(line_len < sizeof(line)) {
+                        line[line_len++] = c;
+                    } else {
+                        line_skip = true;
+                    }
+                }
+            }
+            if(bytes_read < MF_CLASSIC_DICT_SOURCE_BUFFER_SIZE) break;
+        }
+        if(callback && !line_skip && mf_classic_dict_parse_line(line, line_len, key)) {
+            callback(key, context);
+        }
+
+        source_read = storage_file_get_error(file) == FSE_OK;
+    } while(false);
+
+    free(buffer);
+    storage_file_close(file);
+    storage_file_free(file);
+    return source_read;
+}
+
+static uint32_t mf_classic_dict_sources_crc(
+    Storage* storage,
+    const char* const* sources,
+    size_t sources_count) {
+    uint32_t crc = 0;
+    for(size_t i = 0; i < sources_count; i++) {
+        mf_classic_dict_read_source(storage, sources[i], &crc, NULL, NULL);
+    }
+    return crc;
+}
+
+typedef struct {
+    uint8_t* keys;
+    size_t keys_count;
+    size_t keys_capacity;
+} MfClassicDictCollectContext;
+
+static void mf_classic_dict_collect_callback(const uint8_t* key, void* context) {
+    MfClassicDictCollectContext* collect = context;
+    if(collect->keys_count < collect->keys_capacity) {
+        memcpy(
+            &collect->keys[collect->keys_count * MF_CLASSIC_DICT_KEY_SIZE],
+            key,
+            MF_CLASSIC_DICT_KEY_SIZE);
+        collect->keys_count++;
+    }
+}
+
+typedef struct {
+    File* file;
+    const uint8_t* sorted_keys;
+    size_t keys_count;
+    uint32_t* written; // bitmap over sorted keys
+    uint8_t page[MF_CLASSIC_DICT_PAGE_SIZE];
+    size_t page_size;
+    bool error;
+} MfClassicDictWriteContext;
+
+static void mf_classic_dict_write_page(MfClassicDictWriteContext* write) {
+    if(write->page_size &&
+       storage_file_write(write->file, write->page, write->page_size) != write->page_size) {
+        write->error = true;
+    }
+    write->page_size = 0;
+}
+
+static void mf_classic_dict_write_callback(const uint8_t* key, void* context) {
+    MfClassicDictWriteContext* write = context;
+    const uint8_t* found = bsearch(
+        key,
+        write->sorted_keys,
+        write->keys_count,
+        MF_CLASSIC_DICT_KEY_SIZE,
+        mf_classic_dict_key_cmp);
+    if(!found) return;
+
+    // Keep only the first occurrence
+    size_t index = (found - write->sorted_keys) / MF_CLASSIC_DICT_KEY_SIZE;
+    if(write->written[index / 32] & (1UL << (index % 32))) return;
+    write->written[index / 32] |= 1UL << (index % 32);
+
+    memcpy(&write->page[write->page_size], key, MF_CLASSIC_DICT_KEY_SIZE);
+    write->page_size += MF_CLASSIC_DICT_KEY_SIZE;
+    if(write->page_size == MF_CLASSIC_DICT_PAGE_SIZE) {
+        mf_classic_dict_write_page(write);
+    }
+}
+
+static bool mf_classic_dict_compile(
+    Storage* storage,
+    const char* const* sources,
+    size_t sources_count,
+    const char* path,
+    uint32_t sources_crc) {
+    uint32_t start = furi_get_tick();
+
+    // Every key line takes at least 13 bytes, except the last one without new line
+    MfClassicDictCollectContext collect = {};
+    for(size_t i = 0; i < sources_count; i++) {
+        FileInfo file_info;
+        if(storage_common_stat(storage, sources[i], &file_info) == FSE_OK) {
+            collect.keys_capacity += file_info.size / NFC_MF_CLASSIC_KEY_LEN + 1;
+        }
+    }
+    if(!collect.keys_capacity) return false;
+    collect.keys = malloc(collect.keys_capacity * MF_CLASSIC_DICT_KEY_SIZE);
+    for(size_t i = 0; i < sources_count; i++) {
+        mf_classic_dict_read_source(
+            storage, sources[i], NULL, mf_classic_dict_collect_callback, &collect);
+    }
+
+    // Sort and remove duplicates
+    size_t keys_count = 0;
+    qsort(collect.keys, collect.keys_count, MF_CLASSIC_DICT_KEY_SIZE, mf_classic_dict_key_cmp);
+    for(size_t i = 0; i < collect.keys_count; i++) {
+        uint8_t* key = &collect.keys[i * MF_CLASSIC_DICT_KEY_SIZE];
+        if(keys_count &&
+           mf_classic_dict_key_cmp(
+               key, &collect.keys[(keys_count - 1) * MF_CLASSIC_DICT_KEY_SIZE]) == 0) {
+            continue;
+        }
+        memmove(
+            &collect.keys[keys_count * MF_CLASSIC_DICT_KEY_SIZE], key, MF_CLASSIC_DICT_KEY_SIZE);
+        keys_count++;
+    }
+
+    MfClassicDictWriteContext* write = malloc(sizeof(MfClassicDictWriteContext));
+    write->file = storage_file_alloc(storage);
+    write->sorted_keys = collect.keys;
+    write->keys_count = keys_count;
+    write->written = malloc((keys_count / 32 + 1) * sizeof(uint32_t));
+
+    bool compiled = false;
+    do {
+        if(!storage_file_open(write->file, path, FSAM_WRITE, FSOM_CREATE_ALWAYS)) break;
+
+        MfClassicDictCompiledHeader header = {
+            .magic = MF_CLASSIC_DICT_COMPILED_MAGIC,
+            .version = MF_CLASSIC_DICT_COMPILED_VERSION,
+            .sources_crc = sources_crc,
+            .keys_count = keys_count,
+        };
+        if(storage_file_write(write->file, &header, sizeof(header)) != sizeof(header)) break;
+
+        for(size_t i = 0; i < keys_count; i += MF_CLASSIC_DICT_PAGE_KEYS) {
+            memcpy(
+                &write->page[write->page_size],
+                &collect.keys[i * MF_CLASSIC_DICT_KEY_SIZE],
+                MF_CLASSIC_DICT_KEY_SIZE);
+            write->page_size += MF_CLASSIC_DICT_KEY_SIZE;
+            if(write->page_size == MF_CLASSIC_DICT_PAGE_SIZE) mf_classic_dict_write_page(write);
+        }
+        mf_classic_dict_write_page(write);
+
+        // Second pass over the sources restores the original order
+        for(size_t i = 0; i < sources_count; i++) {
+            mf_classic_dict_read_source(
+                storage, sources[i], NULL, mf_classic_dict_write_callback, write);
+        }
+        mf_classic_dict_write_page(write);
+        if(write->error) break;
+
+        size_t sorted_size = keys_count * MF_CLASSIC_DICT_KEY_SIZE;
+        for(size_t offset = 0; offset < sorted_size; offset += MF_CLASSIC_DICT_PAGE_SIZE) {
+            uint16_t chunk = MIN(sorted_size - offset, MF_CLASSIC_DICT_PAGE_SIZE);
+            if(storage_file_write(write->file, &collect.keys[offset], chunk) != chunk) {
+                write->error = true;
+                break;
+            }
+        }
+        if(write->error) break;
+
+        compiled = true;
+    } while(false);
+
+    storage_file_close(write->file);
+    storage_file_free(write->file);
+    if(!compiled) {
+        storage_common_remove(storage, path);
+    }
+
+    free(write->written);
+    free(write);
+    free(collect.keys);
+
+    FURI_LOG_I(
+        TAG,
+        "Compiled %zu of %zu keys in %lums",
+        keys_count,
+        collect.keys_count,
+        furi_get_tick() - start);
+    return compiled;
+}
+
+static bool
+    mf_classic_dict_open_compiled(MfClassicDict* dict, const char* path, uint32_t sources_crc) {
+    bool opened = false;
+
+    do {
+        if(!storage_file_open(dict->file, path, FSAM_READ, FSOM_OPEN_EXISTING)) break;
+
+        MfClassicDictCompiledHeader header;
+        if(storage_file_read(dict->file, &header, sizeof(header)) != sizeof(header)) break;
+        if(header.magic != MF_CLASSIC_DICT_COMPILED_MAGIC ||
+           header.version != MF_CLASSIC_DICT_COMPILED_VERSION ||
+           header.sources_crc != sources_crc) {
+            FURI_LOG_D(TAG, "Compiled dictionary is outdated");
+            break;
+        }
+
+        uint32_t pages_count =
+            (header.keys_count + MF_CLASSIC_DICT_PAGE_KEYS - 1) / MF_CLASSIC_DICT_PAGE_KEYS;
+        uint64_t expected_size = sizeof(header) +
+                                 (uint64_t)pages_count * MF_CLASSIC_DICT_KEY_SIZE +
+                                 (uint64_t)header.keys_count * MF_CLASSIC_DICT_KEY_SIZE * 2;
+        if(storage_file_size(dict->file) != expected_size) break;
+
+        if(pages_count) {
+            size_t first_keys_size = pages_count * MF_CLASSIC_DICT_KEY_SIZE;
+            dict->page_first_keys = malloc(first_keys_size);
+            if(storage_file_read(dict->file, dict->page_first_keys, first_keys_size) !=
+               first_keys_size) {
+                break;
+            }
+        }
+
+        dict->pages_count = pages_count;
+        dict->total_keys = header.keys_count;
+        dict->position = 0;
+        dict->page_loaded = MF_CLASSIC_DICT_PAGE_NONE;
+        opened = true;
+    } while(false);
+
+    if(!opened) {
+        storage_file_close(dict->file);
+        free(dict->page_first_keys);
+        dict->page_first_keys = NULL;
+    }
+
+    return opened;
+}
+
+static bool mf_classic_dict_alloc_compiled(
+    MfClassicDict* dict,
+    const char* const* sources,
+    size_t sources_count,
+    const char* path) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    dict->file = storage_file_alloc(storage);
+
+    uint32_t sources_crc = mf_classic_dict_sources_crc(storage, sources, sources_count);
+    bool dict_loaded = mf_classic_dict_open_compiled(dict, path, sources_crc);
+    if(!dict_loaded &&
+       mf_classic_dict_compile(storage, sources, sources_count, path, sources_crc)) {
+        dict_loaded = mf_classic_dict_open_compiled(dict, path, sources_crc);
+    }
+
+    if(dict_loaded) {
+        FURI_LOG_I(TAG, "Loaded compiled dictionary with %lu keys", dict->total_keys);
+    } else {
+        storage_file_free(dict->file);
+        dict->file = NULL;
+    }
+
+    furi_record_close(RECORD_STORAGE);
+    return dict_loaded;
+}
+
+// Get key from the compiled dictionary, loading its page if needed
+static const uint8_t* mf_classic_dict_get_compiled_key(
+    MfClassicDict* dict,
+    MfClassicDictSection section,
+    uint32_t index) {
+    furi_assert(index < dict->total_keys);
+
+    uint32_t page = section * dict->pages_count + index / MF_CLASSIC_DICT_PAGE_KEYS;
+    if(dict->page_loaded != page) {
+        uint32_t section_offset = sizeof(MfClassicDictCompiledHeader) +
+                                  dict->pages_count * MF_CLASSIC_DICT_KEY_SIZE +
+                                  section * dict->total_keys * MF_CLASSIC_DICT_KEY_SIZE;
+        uint32_t page_first = index - index % MF_CLASSIC_DICT_PAGE_KEYS;
+        uint16_t page_size =
+            MIN(dict->total_keys - page_first, MF_CLASSIC_DICT_PAGE_KEYS) *
+            MF_CLASSIC_DICT_KEY_SIZE;
+
+        dict->page_loaded = MF_CLASSIC_DICT_PAGE_NONE;
+        if(!storage_file_seek(
+               dict->file, section_offset + page_first * MF_CLASSIC_DICT_KEY_SIZE, true))
+            return NULL;
+        if(storage_file_read(dict->file, dict->page, page_size) != page_size) return NULL;
+        dict->page_loaded = page;
+    }
+
+    return &dict->page[(index % MF_CLASSIC_DICT_PAGE_KEYS) * MF_CLASSIC_DICT_KEY_SIZE];
+}
+
+static bool mf_classic_dict_find_compiled_key(MfClassicDict* dict, const uint8_t* key) {
+    if(!dict->pages_count) return false;
+
+    // Find the last page starting with a key not greater than the searched one
+    uint32_t low = 0;
+    uint32_t high = dict->pages_count;
+    while(high - low > 1) {
+        uint32_t mid = (low + high) / 2;
+        if(mf_classic_dict_key_cmp(&dict->page_first_keys[mid * MF_CLASSIC_DICT_KEY_SIZE], key) >
+           0) {
+            high = mid;
+        } else {
+            low = mid;
+        }
+    }
+
+    uint32_t page_first = low * MF_CLASSIC_DICT_PAGE_KEYS;
+    const uint8_t* page_key =
+        mf_classic_dict_get_compiled_key(dict, MfClassicDictSectionSorted, page_first);
+    if(!page_key) return false;
+
+    size_t page_keys = MIN(dict->total_keys - page_first, MF_CLASSIC_DICT_PAGE_KEYS);
+    return bsearch(key, page_key, page_keys, MF_CLASSIC_DICT_KEY_SIZE, mf_classic_dict_key_cmp) !=
+           NULL;
+}
+
 MfClassicDict* mf_classic_dict_alloc(MfClassicDictType dict_type) {
     MfClassicDict* dict = malloc(sizeof(MfClassicDict));
+
+    if(dict_type == MfClassicDictTypeCompiled || dict_type == MfClassicDictTypeUnitTestCompiled) {
+        bool dict_loaded = false;
+        if(dict_type == MfClassicDictTypeCompiled) {
+            dict_loaded = mf_classic_dict_alloc_compiled(
+                dict,
+                mf_classic_dict_compiled_sources,
+                COUNT_OF(mf_classic_dict_compiled_sources),
+                MF_CLASSIC_DICT_COMPILED_PATH);
+        } else {
+            dict_loaded = mf_classic_dict_alloc_compiled(
+                dict,
+                mf_classic_dict_unit_test_compiled_sources,
+                COUNT_OF(mf_classic_dict_unit_test_compiled_sources),
+                MF_CLASSIC_DICT_UNIT_TEST_COMPILED_PATH);
+        }
+        if(!dict_loaded) {
+            free(dict);
+            dict = NULL;
+        }
+        return dict;
+    }
+
     Storage* storage = furi_record_open(RECORD_STORAGE);
     dict->stream = buffered_file_stream_alloc(storage);
     furi_record_close(RECORD_STORAGE);
@@ -115,10 +576,16 @@ MfClassicDict* mf_classic_dict_alloc(MfClassicDictType dict_type) {
 
 void mf_classic_dict_free(MfClassicDict* dict) {
     furi_assert(dict);
-    furi_assert(dict->stream);
 
-    buffered_file_stream_close(dict->stream);
-    stream_free(dict->stream);
+    if(dict->file) {
+        storage_file_close(dict->file);
+        storage_file_free(dict->file);
+        free(dict->page_first_keys);
+    } else {
+        furi_assert(dict->stream);
+        buffered_file_stream_close(dict->stream);
+        stream_free(dict->stream);
+    }
     free(dict);
 }
 
@@ -146,19 +613,39 @@ uint32_t mf_classic_dict_get_total_keys(MfClassicDict* dict) {
     return dict->total_keys;
 }
 
+static uint64_t mf_classic_dict_bytes_to_int(const uint8_t* key_bytes) {
+    uint64_t key_int = 0;
+    for(size_t i = 0; i < MF_CLASSIC_DICT_KEY_SIZE; i++) {
+        key_int = (key_int << 8) | key_bytes[i];
+    }
+    return key_int;
+}
+
 bool mf_classic_dict_rewind(MfClassicDict* dict) {
     furi_assert(dict);
-    furi_assert(dict->stream);
 
+    if(dict->file) {
+        dict->position = 0;
+        return true;
+    }
+
+    furi_assert(dict->stream);
     return stream_rewind(dict->stream);
 }
 
 bool mf_classic_dict_get_next_key_str(MfClassicDict* dict, FuriString* key) {
     furi_assert(dict);
-    furi_assert(dict->stream);
 
-    bool key_read = false;
     furi_string_reset(key);
+    if(dict->file) {
+        uint64_t key_int;
+        if(!mf_classic_dict_get_next_key(dict, &key_int)) return false;
+        furi_string_printf(key, "%012llX", key_int);
+        return true;
+    }
+
+    furi_assert(dict->stream);
+    bool key_read = false;
     while(!key_read) {
         if(!stream_read_line(dict->stream, key)) break;
         if(furi_string_get_char(key, 0) == '#') continue;
@@ -172,6 +659,17 @@ bool mf_classic_dict_get_next_key_str(MfClassicDict* dict, FuriString* key) {
 
 bool mf_classic_dict_get_next_key(MfClassicDict* dict, uint64_t* key) {
     furi_assert(dict);
+
+    if(dict->file) {
+        if(dict->position >= dict->total_keys) return false;
+        const uint8_t* key_bytes =
+            mf_classic_dict_get_compiled_key(dict, MfClassicDictSectionOrdered, dict->position);
+        if(!key_bytes) return false;
+        *key = mf_classic_dict_bytes_to_int(key_bytes);
+        dict->position++;
+        return true;
+    }
+
     furi_assert(dict->stream);
 
     FuriString* temp_key;
@@ -186,6 +684,16 @@ bool mf_classic_dict_get_next_key(MfClassicDict* dict, uint64_t* key) {
 
 bool mf_classic_dict_is_key_present_str(MfClassicDict* dict, FuriString* key) {
     furi_assert(dict);
+
+    if(dict->file) {
+        uint8_t key_bytes[MF_CLASSIC_DICT_KEY_SIZE];
+        if(!mf_classic_dict_parse_line(
+               furi_string_get_cstr(key), furi_string_size(key), key_bytes)) {
+            return false;
+        }
+        return mf_classic_dict_find_compiled_key(dict, key_bytes);
+    }
+
     furi_assert(dict->stream);
 
     FuriString* next_line;
@@ -207,6 +715,12 @@ bool mf_classic_dict_is_key_present_str(MfClassicDict* dict, FuriString* key) {
 }
 
 bool mf_classic_dict_is_key_present(MfClassicDict* dict, uint8_t* key) {
+    furi_assert(dict);
+
+    if(dict->file) {
+        return mf_classic_dict_find_compiled_key(dict, key);
+    }
+
     FuriString* temp_key;
 
     temp_key = furi_string_alloc();
@@ -218,6 +732,7 @@ bool mf_classic_dict_is_key_present(MfClassicDict* dict, uint8_t* key) {
 
 bool mf_classic_dict_add_key_str(MfClassicDict* dict, FuriString* key) {
     furi_assert(dict);
+    if(dict->file) return false;
     furi_assert(dict->stream);
 
     furi_string_cat_printf(key, "\n");
@@ -236,6 +751,7 @@ bool mf_classic_dict_add_key_str(MfClassicDict* dict, FuriString* key) {
 
 bool mf_classic_dict_add_key(MfClassicDict* dict, uint8_t* key) {
     furi_assert(dict);
+    if(dict->file) return false;
     furi_assert(dict->stream);
 
     FuriString* temp_key;
@@ -249,8 +765,16 @@ bool mf_classic_dict_add_key(MfClassicDict* dict, uint8_t* key) {
 
 bool mf_classic_dict_get_key_at_index_str(MfClassicDict* dict, FuriString* key, uint32_t target) {
     furi_assert(dict);
-    furi_assert(dict->stream);
 
+    if(dict->file) {
+        furi_string_reset(key);
+        uint64_t key_int;
+        if(!mf_classic_dict_get_key_at_index(dict, &key_int, target)) return false;
+        furi_string_printf(key, "%012llX", key_int);
+        return true;
+    }
+
+    furi_assert(dict->stream);
     FuriString* next_line;
     uint32_t index = 0;
     next_line = furi_string_alloc();
@@ -272,6 +796,13 @@ bool mf_classic_dict_get_key_at_index_str(MfClassicDict* dict, FuriString* key,
 
 bool mf_classic_dict_get_key_at_index(MfClassicDict* dict, uint64_t* key, uint32_t target) {
     furi_assert(dict);
+
+    if(dict->file) {
+        if(target >= dict->total_keys - MIN(dict->position, dict->total_keys)) return false;
+        dict->position += target;
+        return mf_classic_dict_get_next_key(dict, key);
+    }
+
     furi_assert(dict->stream);
 
     FuriString* temp_key;
@@ -286,6 +817,7 @@ bool mf_classic_dict_get_key_at_index(MfClassicDict* dict, uint64_t* key, uint32
 
 bool mf_classic_dict_find_index_str(MfClassicDict* dict, FuriString* key, uint32_t* target) {
     furi_assert(dict);
+    if(dict->file) return false;
     furi_assert(dict->stream);
 
     FuriString* next_line;
@@ -310,6 +842,7 @@ bool mf_classic_dict_find_index_str(MfClassicDict* dict, FuriString* key, uint32
 
 bool mf_classic_dict_find_index(MfClassicDict* dict, uint8_t* key, uint32_t* target) {
     furi_assert(dict);
+    if(dict->file) return false;
     furi_assert(dict->stream);
 
     FuriString* temp_key;
@@ -323,6 +856,7 @@ bool mf_classic_dict_find_index(MfClassicDict* dict, uint8_t* key, uint32_t* tar
 
 bool mf_classic_dict_delete_index(MfClassicDict* dict, uint32_t target) {
     furi_assert(dict);
+    if(dict->file) return false;
     furi_assert(dict->stream);
 
     FuriString* next_line;
@@ -14,6 +14,10 @@ typedef enum {
     MfClassicDictTypeUser,
     MfClassicDictTypeSystem,
     MfClassicDictTypeUnitTest,
+    /** User and system dictionaries merged into one compiled read-only dictionary */
+    MfClassicDictTypeCompiled,
+    /** Unit test dictionary compiled into a read-only dictionary */
+    MfClassicDictTypeUnitTestCompiled,
 } MfClassicDictType;
 
 typedef struct MfClassicDict MfClassicDict;
@@ -21,6 +25,12 @@ typedef struct MfClassicDict MfClassicDict;
 bool mf_classic_dict_check_presence(MfClassicDictType dict_type);
 
 /** Allocate MfClassicDict instance
+ *
+ * Compiled dictionaries keep sorted and deduplicated binary keys on the SD card.
+ * Source dictionaries are compiled again when their content changes. Keys are
+ * read in pages, keeping the source order with the first occurrence of every
+ * key, and presence check is a binary search. Compiled dictionaries can't be
+ * modified.
  *
  * @param[in]  dict_type  The dictionary type
  *
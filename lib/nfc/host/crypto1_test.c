@@ -0,0 +1,268 @@
+// Host differential test for Crypto1
+//
+// Runs the table driven Crypto1 and the bitwise implementation it replaced side by side on
+// random keys and inputs, and fails on the first filter, bit, byte, word, encrypt, decrypt
+// output or LFSR state that differs. Then prints encrypt throughput of both.
+//
+// Cycle counts on the device are logged by the crypto1_benchmark_test unit test.
+
+#include <furi.h>
+#include "crypto1.h"
+
+#include <time.h>
+#include <unistd.h>
+
+#define CRYPTO1_TEST_ITERATIONS (20000)
+#define CRYPTO1_TEST_BYTES (16)
+#define CRYPTO1_TEST_BENCHMARK_ROUNDS (200000)
+
+static uint64_t crypto1_test_rng_state = 0x9E3779B97F4A7C15ULL;
+
+static uint32_t crypto1_test_random(void) {
+    // xorshift64*, reproducible for a given seed
+    crypto1_test_rng_state ^= crypto1_test_rng_state >> 12;
+    crypto1_test_rng_state ^= crypto1_test_rng_state << 25;
+    crypto1_test_rng_state ^= crypto1_test_rng_state >> 27;
+    return (crypto1_test_rng_state * 0x2545F4914F6CDD1DULL) >> 32;
+}
+
+static void crypto1_test_random_fill(uint8_t* buffer, size_t size) {
+    for(size_t i = 0; i < size; i++) {
+        buffer[i] = crypto1_test_random();
+    }
+}
+
+static double crypto1_test_now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+// Bitwise Crypto1, the implementation the table driven one replaced
+static uint8_t crypto1_ref_filter(uint32_t in) {
+    uint32_t out = 0;
+    out = 0xf22c0 >> (in & 0xf) & 16;
+    out |= 0x6c9c0 >> (in >> 4 & 0xf) & 8;
+    out |= 0x3c8b0 >> (in >> 8 & 0xf) & 4;
+    out |= 0x1e458 >> (in >> 12 & 0xf) & 2;
+    out |= 0x0d938 >> (in >> 16 & 0xf) & 1;
+    return FURI_BIT(0xEC57E80A, out);
+}
+
+static uint8_t crypto1_ref_bit(Crypto1* crypto1, uint8_t in, int is_encrypted) {
+    uint8_t out = crypto1_ref_filter(crypto1->odd);
+    uint32_t feed = out & (!!is_encrypted);
+    feed ^= !!in;
+    feed ^= 0x29CE5C & crypto1->odd;
+    feed ^= 0x870804 & crypto1->even;
+    crypto1->even = crypto1->even << 1 | __builtin_parity(feed);
+
+    uint32_t odd = crypto1->odd;
+    crypto1->odd = crypto1->even;
+    crypto1->even = odd;
+    return out;
+}
+
+static uint8_t crypto1_ref_byte(Crypto1* crypto1, uint8_t in, int is_encrypted) {
+    uint8_t out = 0;
+    for(uint8_t i = 0; i < 8; i++) {
+        out |= crypto1_ref_bit(crypto1, FURI_BIT(in, i), is_encrypted) << i;
+    }
+    return out;
+}
+
+static uint32_t crypto1_ref_word(Crypto1* crypto1, uint32_t in, int is_encrypted) {
+    uint32_t out = 0;
+    for(uint8_t i = 0; i < 32; i++) {
+        out |= crypto1_ref_bit(crypto1, FURI_BIT(in, i ^ 24), is_encrypted) << (24 ^ i);
+    }
+    return out;
+}
+
+static void crypto1_ref_decrypt(
+    Crypto1* crypto,
+    uint8_t* encrypted_data,
+    uint16_t encrypted_data_bits,
+    uint8_t* decrypted_data) {
+    if(encrypted_data_bits < 8) {
+        uint8_t decrypted_byte = 0;
+        for(uint8_t i = 0; i < 4; i++) {
+            decrypted_byte |= (crypto1_ref_bit(crypto, 0, 0) ^ FURI_BIT(encrypted_data[0], i))
+                              << i;
+        }
+        decrypted_data[0] = decrypted_byte;
+    } else {
+        for(size_t i = 0; i < encrypted_data_bits / 8; i++) {
+            decrypted_data[i] = crypto1_ref_byte(crypto, 0, 0) ^ encrypted_data[i];
+        }
+    }
+}
+
+static void crypto1_ref_encrypt(
+    Crypto1* crypto,
+    uint8_t* keystream,
+    uint8_t* plain_data,
+    uint16_t plain_data_bits,
+    uint8_t* encrypted_data,
+    uint8_t* encrypted_parity) {
+    if(plain_data_bits < 8) {
+        encrypted_data[0] = 0;
+        for(size_t i = 0; i < plain_data_bits; i++) {
+            encrypted_data[0] |= (crypto1_ref_bit(crypto, 0, 0) ^ FURI_BIT(plain_data[0], i))
+                                 << i;
+        }
+    } else {
+        memset(encrypted_parity, 0, plain_data_bits / 8 + 1);
+        for(uint8_t i = 0; i < plain_data_bits / 8; i++) {
+            encrypted_data[i] =
+                crypto1_ref_byte(crypto, keystream ? keystream[i] : 0, 0) ^ plain_data[i];
+            encrypted_parity[i / 8] |=
+                (((crypto1_ref_filter(crypto->odd) ^ !__builtin_parity(plain_data[i])) & 0x01)
+                 << (7 - (i & 0x0007)));
+        }
+    }
+}
+
+static bool crypto1_test_state_equal(Crypto1* a, Crypto1* b) {
+    return (a->odd & 0xFFFFFF) == (b->odd & 0xFFFFFF) &&
+           (a->even & 0xFFFFFF) == (b->even & 0xFFFFFF);
+}
+
+static bool crypto1_test_iteration(size_t iteration) {
+    uint8_t plain[CRYPTO1_TEST_BYTES];
+    uint8_t keystream[CRYPTO1_TEST_BYTES];
+    uint8_t encrypted[CRYPTO1_TEST_BYTES];
+    uint8_t encrypted_ref[CRYPTO1_TEST_BYTES];
+    uint8_t parity[CRYPTO1_TEST_BYTES + 1];
+    uint8_t parity_ref[CRYPTO1_TEST_BYTES + 1];
+    uint8_t decrypted[CRYPTO1_TEST_BYTES];
+    uint8_t decrypted_ref[CRYPTO1_TEST_BYTES];
+
+    uint64_t key = ((uint64_t)crypto1_test_random() << 16 ^ crypto1_test_random()) &
+                   0xFFFFFFFFFFFFULL;
+    uint32_t in = crypto1_test_random();
+    int is_encrypted = in & 1;
+    crypto1_test_random_fill(plain, sizeof(plain));
+    crypto1_test_random_fill(keystream, sizeof(keystream));
+
+    Crypto1 crypto;
+    Crypto1 crypto_ref;
+    crypto1_init(&crypto, key);
+    crypto_ref = crypto;
+
+    const char* failed = NULL;
+    do {
+        if(crypto1_filter(crypto.odd) != crypto1_ref_filter(crypto_ref.odd)) {
+            failed = "filter";
+            break;
+        }
+        if(crypto1_word(&crypto, in, is_encrypted) !=
+           crypto1_ref_word(&crypto_ref, in, is_encrypted)) {
+            failed = "word";
+            break;
+        }
+        if(crypto1_byte(&crypto, in >> 8, is_encrypted) !=
+           crypto1_ref_byte(&crypto_ref, in >> 8, is_encrypted)) {
+            failed = "byte";
+            break;
+        }
+        if(crypto1_bit(&crypto, in & 2, is_encrypted) !=
+           crypto1_ref_bit(&crypto_ref, in & 2, is_encrypted)) {
+            failed = "bit";
+            break;
+        }
+        if(!crypto1_test_state_equal(&crypto, &crypto_ref)) {
+            failed = "state after word, byte and bit";
+            break;
+        }
+
+        // Short frames are 4 or 7 bits, others whole bytes
+        uint8_t* stream = (in & 4) ? keystream : NULL;
+        uint16_t bits = (in & 8) ? ((in & 16) ? 4 : 7) :
+                                   8 * (1 + (in >> 16) % CRYPTO1_TEST_BYTES);
+        crypto1_encrypt(&crypto, stream, plain, bits, encrypted, parity);
+        crypto1_ref_encrypt(&crypto_ref, stream, plain, bits, encrypted_ref, parity_ref);
+        if(memcmp(encrypted, encrypted_ref, (bits + 7) / 8) != 0 ||
+           (bits >= 8 && memcmp(parity, parity_ref, (bits / 8 + 7) / 8) != 0) ||
+           !crypto1_test_state_equal(&crypto, &crypto_ref)) {
+            failed = "encrypt";
+            break;
+        }
+
+        crypto1_decrypt(&crypto, encrypted, bits, decrypted);
+        crypto1_ref_decrypt(&crypto_ref, encrypted, bits, decrypted_ref);
+        if(memcmp(decrypted, decrypted_ref, (bits + 7) / 8) != 0 ||
+           !crypto1_test_state_equal(&crypto, &crypto_ref)) {
+            failed = "decrypt";
+            break;
+        }
+    } while(false);
+
+    if(failed) {
+        printf(
+            "Iteration %zu, key %012llx, in %08x: %s differs\n",
+            iteration,
+            (unsigned long long)key,
+            in,
+            failed);
+    }
+    return !failed;
+}
+
+static void crypto1_test_benchmark(void) {
+    uint8_t plain[CRYPTO1_TEST_BYTES] = {0};
+    uint8_t encrypted[CRYPTO1_TEST_BYTES];
+    uint8_t parity[CRYPTO1_TEST_BYTES + 1];
+    Crypto1 crypto;
+    crypto1_init(&crypto, 0xA0A1A2A3A4A5);
+
+    double start = crypto1_test_now();
+    for(size_t i = 0; i < CRYPTO1_TEST_BENCHMARK_ROUNDS; i++) {
+        crypto1_encrypt(&crypto, NULL, plain, sizeof(plain) * 8, encrypted, parity);
+        plain[0] ^= encrypted[0];
+    }
+    double elapsed = crypto1_test_now() - start;
+
+    Crypto1 crypto_ref;
+    crypto1_init(&crypto_ref, 0xA0A1A2A3A4A5);
+    memset(plain, 0, sizeof(plain));
+    start = crypto1_test_now();
+    for(size_t i = 0; i < CRYPTO1_TEST_BENCHMARK_ROUNDS; i++) {
+        crypto1_ref_encrypt(&crypto_ref, NULL, plain, sizeof(plain) * 8, encrypted, parity);
+        plain[0] ^= encrypted[0];
+    }
+    double elapsed_ref = crypto1_test_now() - start;
+
+    const double bytes = (double)CRYPTO1_TEST_BENCHMARK_ROUNDS * CRYPTO1_TEST_BYTES;
+    printf(
+        "Crypto1 encrypt: %.2f ns/byte, bitwise reference %.2f ns/byte, %.2fx\n",
+        elapsed * 1e9 / bytes,
+        elapsed_ref * 1e9 / bytes,
+        elapsed_ref / elapsed);
+}
+
+int main(int argc, char** argv) {
+    size_t iterations = CRYPTO1_TEST_ITERATIONS;
+    int opt;
+    while((opt = getopt(argc, argv, "n:s:")) != -1) {
+        switch(opt) {
+        case 'n':
+            iterations = strtoul(optarg, NULL, 0);
+            break;
+        case 's':
+            crypto1_test_rng_state = strtoull(optarg, NULL, 0) | 1;
+            break;
+        default:
+            printf("Usage: %s [-n iterations] [-s seed]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    for(size_t i = 0; i < iterations; i++) {
+        if(!crypto1_test_iteration(i)) return 1;
+    }
+    printf("%zu random keys: ok\n", iterations);
+
+    crypto1_test_benchmark();
+    return 0;
+}
@@ -0,0 +1,25 @@
+#pragma once
+
+// Just enough of furi to build Crypto1 on host
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+
+#define furi_crash(message)                                         \
+    do {                                                            \
+        fprintf(stderr, "%s:%d %s\n", __FILE__, __LINE__, message); \
+        abort();                                                    \
+    } while(0)
+
+#define furi_check(condition)                             \
+    do {                                                  \
+        if(!(condition)) furi_crash("furi_check failed"); \
+    } while(0)
+
+#define furi_assert(condition) furi_check(condition)
+
+#define FURI_BIT(x, n) (((x) >> (n)) & 1)
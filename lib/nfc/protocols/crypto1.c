@@ -11,6 +11,82 @@
 
 #define BEBIT(x, n) FURI_BIT(x, (n) ^ 24)
 
+// Filter input bits 0..7 and 8..15 mapped to the 5 bit index of the final function,
+// bits 16..19 are looked up in the constant as before
+static const uint8_t crypto1_filter_lo[256] = {
+    0x00, 0x00, 0x10, 0x10, 0x00, 0x10, 0x00, 0x00, 0x00, 0x10, 0x00, 0x00, 0x10, 0x10, 0x10, 0x10,
+    0x00, 0x00, 0x10, 0x10, 0x00, 0x10, 0x00, 0x00, 0x00, 0x10, 0x00, 0x00, 0x10, 0x10, 0x10, 0x10,
+    0x00, 0x00, 0x10, 0x10, 0x00, 0x10, 0x00, 0x00, 0x00, 0x10, 0x00, 0x00, 0x10, 0x10, 0x10, 0x10,
+    0x08, 0x08, 0x18, 0x18, 0x08, 0x18, 0x08, 0x08, 0x08, 0x18, 0x08, 0x08, 0x18, 0x18, 0x18, 0x18,
+    0x08, 0x08, 0x18, 0x18, 0x08, 0x18, 0x08, 0x08, 0x08, 0x18, 0x08, 0x08, 0x18, 0x18, 0x18, 0x18,
+    0x08, 0x08, 0x18, 0x18, 0x08, 0x18, 0x08, 0x08, 0x08, 0x18, 0x08, 0x08, 0x18, 0x18, 0x18, 0x18,
+    0x00, 0x00, 0x10, 0x10, 0x00, 0x10, 0x00, 0x00, 0x00, 0x10, 0x00, 0x00, 0x10, 0x10, 0x10, 0x10,
+    0x00, 0x00, 0x10, 0x10, 0x00, 0x10, 0x00, 0x00, 0x00, 0x10, 0x00, 0x00, 0x10, 0x10, 0x10, 0x10,
+    0x08, 0x08, 0x18, 0x18, 0x08, 0x18, 0x08, 0x08, 0x08, 0x18, 0x08, 0x08, 0x18, 0x18, 0x18, 0x18,
+    0x00, 0x00, 0x10, 0x10, 0x00, 0x10, 0x00, 0x00, 0x00, 0x10, 0x00, 0x00, 0x10, 0x10, 0x10, 0x10,
+    0x00, 0x00, 0x10, 0x10, 0x00, 0x10, 0x00, 0x00, 0x00, 0x10, 0x00, 0x00, 0x10, 0x10, 0x10, 0x10,
+    0x08, 0x08, 0x18, 0x18, 0x08, 0x18, 0x08, 0x08, 0x08, 0x18, 0x08, 0x08, 0x18, 0x18, 0x18, 0x18,
+    0x08, 0x08, 0x18, 0x18, 0x08, 0x18, 0x08, 0x08, 0x08, 0x18, 0x08, 0x08, 0x18, 0x18, 0x18, 0x18,
+    0x00, 0x00, 0x10, 0x10, 0x00, 0x10, 0x00, 0x00, 0x00, 0x10, 0x00, 0x00, 0x10, 0x10, 0x10, 0x10,
+    0x08, 0x08, 0x18, 0x18, 0x08, 0x18, 0x08, 0x08, 0x08, 0x18, 0x08, 0x08, 0x18, 0x18, 0x18, 0x18,
+    0x08, 0x08, 0x18, 0x18, 0x08, 0x18, 0x08, 0x08, 0x08, 0x18, 0x08, 0x08, 0x18, 0x18, 0x18, 0x18,
+};
+
+static const uint8_t crypto1_filter_hi[256] = {
+    0x00, 0x00, 0x04, 0x04, 0x00, 0x04, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x04, 0x04, 0x04, 0x04,
+    0x00, 0x00, 0x04, 0x04, 0x00, 0x04, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x04, 0x04, 0x04, 0x04,
+    0x02, 0x02, 0x06, 0x06, 0x02, 0x06, 0x02, 0x02, 0x02, 0x06, 0x02, 0x02, 0x06, 0x06, 0x06, 0x06,
+    0x02, 0x02, 0x06, 0x06, 0x02, 0x06, 0x02, 0x02, 0x02, 0x06, 0x02, 0x02, 0x06, 0x06, 0x06, 0x06,
+    0x00, 0x00, 0x04, 0x04, 0x00, 0x04, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x04, 0x04, 0x04, 0x04,
+    0x02, 0x02, 0x06, 0x06, 0x02, 0x06, 0x02, 0x02, 0x02, 0x06, 0x02, 0x02, 0x06, 0x06, 0x06, 0x06,
+    0x00, 0x00, 0x04, 0x04, 0x00, 0x04, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x04, 0x04, 0x04, 0x04,
+    0x00, 0x00, 0x04, 0x04, 0x00, 0x04, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x04, 0x04, 0x04, 0x04,
+    0x00, 0x00, 0x04, 0x04, 0x00, 0x04, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x04, 0x04, 0x04, 0x04,
+    0x02, 0x02, 0x06, 0x06, 0x02, 0x06, 0x02, 0x02, 0x02, 0x06, 0x02, 0x02, 0x06, 0x06, 0x06, 0x06,
+    0x00, 0x00, 0x04, 0x04, 0x00, 0x04, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x04, 0x04, 0x04, 0x04,
+    0x00, 0x00, 0x04, 0x04, 0x00, 0x04, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x04, 0x04, 0x04, 0x04,
+    0x02, 0x02, 0x06, 0x06, 0x02, 0x06, 0x02, 0x02, 0x02, 0x06, 0x02, 0x02, 0x06, 0x06, 0x06, 0x06,
+    0x02, 0x02, 0x06, 0x06, 0x02, 0x06, 0x02, 0x02, 0x02, 0x06, 0x02, 0x02, 0x06, 0x06, 0x06, 0x06,
+    0x02, 0x02, 0x06, 0x06, 0x02, 0x06, 0x02, 0x02, 0x02, 0x06, 0x02, 0x02, 0x06, 0x06, 0x06, 0x06,
+    0x02, 0x02, 0x06, 0x06, 0x02, 0x06, 0x02, 0x02, 0x02, 0x06, 0x02, 0x02, 0x06, 0x06, 0x06, 0x06,
+};
+
+static inline uint32_t crypto1_filter_fast(uint32_t in) {
+    uint32_t out = crypto1_filter_lo[in & 0xff] | crypto1_filter_hi[in >> 8 & 0xff] |
+                   (0x0d938 >> (in >> 16 & 0xf) & 1);
+    return 0xEC57E80A >> out & 1;
+}
+
+static inline uint32_t crypto1_parity32(uint32_t data) {
+    data ^= data >> 16;
+    data ^= data >> 8;
+    data ^= data >> 4;
+    return 0x6996 >> (data & 0xf) & 1;
+}
+
+// One LFSR step on the state kept in registers by the callers, in is 0 or 1
+static inline uint32_t
+    crypto1_step(uint32_t* odd, uint32_t* even, uint32_t in, uint32_t is_encrypted) {
+    uint32_t out = crypto1_filter_fast(*odd);
+    uint32_t feed = (out & is_encrypted) ^ in;
+    feed ^= LF_POLY_ODD & *odd;
+    feed ^= LF_POLY_EVEN & *even;
+    uint32_t next = *even << 1 | crypto1_parity32(feed);
+
+    *even = *odd;
+    *odd = next;
+    return out;
+}
+
+static inline uint8_t
+    crypto1_step_byte(uint32_t* odd, uint32_t* even, uint8_t in, uint32_t is_encrypted) {
+    uint8_t out = 0;
+    for(uint8_t i = 0; i < 8; i++) {
+        out |= crypto1_step(odd, even, FURI_BIT(in, i), is_encrypted) << i;
+    }
+    return out;
+}
+
 void crypto1_reset(Crypto1* crypto1) {
     furi_assert(crypto1);
     crypto1->even = 0;
@@ -28,43 +104,35 @@ void crypto1_init(Crypto1* crypto1, uint64_t key) {
 }
 
 uint32_t crypto1_filter(uint32_t in) {
-    uint32_t out = 0;
-    out = 0xf22c0 >> (in & 0xf) & 16;
-    out |= 0x6c9c0 >> (in >> 4 & 0xf) & 8;
-    out |= 0x3c8b0 >> (in >> 8 & 0xf) & 4;
-    out |= 0x1e458 >> (in >> 12 & 0xf) & 2;
-    out |= 0x0d938 >> (in >> 16 & 0xf) & 1;
-    return FURI_BIT(0xEC57E80A, out);
+    return crypto1_filter_fast(in);
 }
 
 uint8_t crypto1_bit(Crypto1* crypto1, uint8_t in, int is_encrypted) {
     furi_assert(crypto1);
-    uint8_t out = crypto1_filter(crypto1->odd);
-    uint32_t feed = out & (!!is_encrypted);
-    feed ^= !!in;
-    feed ^= LF_POLY_ODD & crypto1->odd;
-    feed ^= LF_POLY_EVEN & crypto1->even;
-    crypto1->even = crypto1->even << 1 | (nfc_util_even_parity32(feed));
-
-    FURI_SWAP(crypto1->odd, crypto1->even);
-    return out;
+    return crypto1_step(&crypto1->odd, &crypto1->even, !!in, !!is_encrypted);
 }
 
 uint8_t crypto1_byte(Crypto1* crypto1, uint8_t in, int is_encrypted) {
     furi_assert(crypto1);
-    uint8_t out = 0;
-    for(uint8_t i = 0; i < 8; i++) {
-        out |= crypto1_bit(crypto1, FURI_BIT(in, i), is_encrypted) << i;
-    }
+    uint32_t odd = crypto1->odd;
+    uint32_t even = crypto1->even;
+    uint8_t out = crypto1_step_byte(&odd, &even, in, !!is_encrypted);
+    crypto1->odd = odd;
+    crypto1->even = even;
     return out;
 }
 
 uint32_t crypto1_word(Crypto1* crypto1, uint32_t in, int is_encrypted) {
     furi_assert(crypto1);
+    uint32_t odd = crypto1->odd;
+    uint32_t even = crypto1->even;
+    uint32_t encrypted = !!is_encrypted;
     uint32_t out = 0;
     for(uint8_t i = 0; i < 32; i++) {
-        out |= crypto1_bit(crypto1, BEBIT(in, i), is_encrypted) << (24 ^ i);
+        out |= crypto1_step(&odd, &even, BEBIT(in, i), encrypted) << (24 ^ i);
     }
+    crypto1->odd = odd;
+    crypto1->even = even;
     return out;
 }
 
@@ -84,18 +152,22 @@ void crypto1_decrypt(
     furi_assert(encrypted_data);
     furi_assert(decrypted_data);
 
+    uint32_t odd = crypto->odd;
+    uint32_t even = crypto->even;
     if(encrypted_data_bits < 8) {
         uint8_t decrypted_byte = 0;
-        decrypted_byte |= (crypto1_bit(crypto, 0, 0) ^ FURI_BIT(encrypted_data[0], 0)) << 0;
-        decrypted_byte |= (crypto1_bit(crypto, 0, 0) ^ FURI_BIT(encrypted_data[0], 1)) << 1;
-        decrypted_byte |= (crypto1_bit(crypto, 0, 0) ^ FURI_BIT(encrypted_data[0], 2)) << 2;
-        decrypted_byte |= (crypto1_bit(crypto, 0, 0) ^ FURI_BIT(encrypted_data[0], 3)) << 3;
+        for(uint8_t i = 0; i < 4; i++) {
+            decrypted_byte |= (crypto1_step(&odd, &even, 0, 0) ^ FURI_BIT(encrypted_data[0], i))
+                              << i;
+        }
         decrypted_data[0] = decrypted_byte;
     } else {
         for(size_t i = 0; i < encrypted_data_bits / 8; i++) {
-            decrypted_data[i] = crypto1_byte(crypto, 0, 0) ^ encrypted_data[i];
+            decrypted_data[i] = crypto1_step_byte(&odd, &even, 0, 0) ^ encrypted_data[i];
         }
     }
+    crypto->odd = odd;
+    crypto->even = even;
 }
 
 void crypto1_encrypt(
@@ -110,19 +182,25 @@ void crypto1_encrypt(
     furi_assert(encrypted_data);
     furi_assert(encrypted_parity);
 
+    uint32_t odd = crypto->odd;
+    uint32_t even = crypto->even;
     if(plain_data_bits < 8) {
         encrypted_data[0] = 0;
         for(size_t i = 0; i < plain_data_bits; i++) {
-            encrypted_data[0] |= (crypto1_bit(crypto, 0, 0) ^ FURI_BIT(plain_data[0], i)) << i;
+            encrypted_data[0] |= (crypto1_step(&odd, &even, 0, 0) ^ FURI_BIT(plain_data[0], i))
+                                 << i;
         }
     } else {
+        // Data and parity are encrypted in one pass, parity bit uses the next keystream bit
         memset(encrypted_parity, 0, plain_data_bits / 8 + 1);
         for(uint8_t i = 0; i < plain_data_bits / 8; i++) {
-            encrypted_data[i] = crypto1_byte(crypto, keystream ? keystream[i] : 0, 0) ^
-                                plain_data[i];
+            encrypted_data[i] =
+                crypto1_step_byte(&odd, &even, keystream ? keystream[i] : 0, 0) ^ plain_data[i];
             encrypted_parity[i / 8] |=
-                (((crypto1_filter(crypto->odd) ^ nfc_util_odd_parity8(plain_data[i])) & 0x01)
-                 << (7 - (i & 0x0007)));
+                ((crypto1_filter_fast(odd) ^ nfc_util_odd_parity8(plain_data[i])) & 0x01)
+                << (7 - (i & 0x0007));
         }
     }
+    crypto->odd = odd;
+    crypto->even = even;
 }
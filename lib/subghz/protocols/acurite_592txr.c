@@ -95,6 +95,14 @@ const SubGhzProtocol ws_protocol_acurite_592txr = {
     .filter = SubGhzProtocolFilter_Weather,
 };
 
+const SubGhzProtocolDecoderWake ws_protocol_acurite_592txr_wake = {
+    .timing = &ws_protocol_acurite_592txr_const,
+    .level = true,
+    .te_long = false,
+    .te_count = 3,
+    .delta_count = 2,
+};
+
 void* ws_protocol_decoder_acurite_592txr_alloc(SubGhzEnvironment* environment) {
     UNUSED(environment);
     WSProtocolDecoderAcurite_592TXR* instance = malloc(sizeof(WSProtocolDecoderAcurite_592TXR));
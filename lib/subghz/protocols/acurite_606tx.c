@@ -78,6 +78,14 @@ const SubGhzProtocol ws_protocol_acurite_606tx = {
     .filter = SubGhzProtocolFilter_Weather,
 };
 
+const SubGhzProtocolDecoderWake ws_protocol_acurite_606tx_wake = {
+    .timing = &ws_protocol_acurite_606tx_const,
+    .level = false,
+    .te_long = false,
+    .te_count = 17,
+    .delta_count = 8,
+};
+
 void* ws_protocol_decoder_acurite_606tx_alloc(SubGhzEnvironment* environment) {
     UNUSED(environment);
     WSProtocolDecoderAcurite_606TX* instance = malloc(sizeof(WSProtocolDecoderAcurite_606TX));
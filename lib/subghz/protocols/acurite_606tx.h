@@ -16,6 +16,7 @@ typedef struct WSProtocolEncoderAcurite_606TX WSProtocolEncoderAcurite_606TX;
 extern const SubGhzProtocolDecoder ws_protocol_acurite_606tx_decoder;
 extern const SubGhzProtocolEncoder ws_protocol_acurite_606tx_encoder;
 extern const SubGhzProtocol ws_protocol_acurite_606tx;
+extern const SubGhzProtocolDecoderWake ws_protocol_acurite_606tx_wake;
 
 /**
  * Allocate WSProtocolDecoderAcurite_606TX.
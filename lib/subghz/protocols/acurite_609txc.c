@@ -79,6 +79,14 @@ const SubGhzProtocol ws_protocol_acurite_609txc = {
     .filter = SubGhzProtocolFilter_Weather,
 };
 
+const SubGhzProtocolDecoderWake ws_protocol_acurite_609txc_wake = {
+    .timing = &ws_protocol_acurite_609txc_const,
+    .level = false,
+    .te_long = false,
+    .te_count = 17,
+    .delta_count = 8,
+};
+
 void* ws_protocol_decoder_acurite_609txc_alloc(SubGhzEnvironment* environment) {
     UNUSED(environment);
     WSProtocolDecoderAcurite_609TXC* instance = malloc(sizeof(WSProtocolDecoderAcurite_609TXC));
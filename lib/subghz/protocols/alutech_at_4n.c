@@ -79,6 +79,14 @@ const SubGhzProtocol subghz_protocol_alutech_at_4n = {
     .encoder = &subghz_protocol_alutech_at_4n_encoder,
 };
 
+const SubGhzProtocolDecoderWake subghz_protocol_alutech_at_4n_wake = {
+    .timing = &subghz_protocol_alutech_at_4n_const,
+    .level = true,
+    .te_long = false,
+    .te_count = 1,
+    .delta_count = 1,
+};
+
 static void subghz_protocol_alutech_at_4n_remote_controller(
     SubGhzBlockGeneric* instance,
     uint8_t crc,
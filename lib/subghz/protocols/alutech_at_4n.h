@@ -9,6 +9,7 @@ typedef struct SubGhzProtocolEncoderAlutech_at_4n SubGhzProtocolEncoderAlutech_a
 extern const SubGhzProtocolDecoder subghz_protocol_alutech_at_4n_decoder;
 extern const SubGhzProtocolEncoder subghz_protocol_alutech_at_4n_encoder;
 extern const SubGhzProtocol subghz_protocol_alutech_at_4n;
+extern const SubGhzProtocolDecoderWake subghz_protocol_alutech_at_4n_wake;
 
 /**
  * Allocate SubGhzProtocolEncoderAlutech_at_4n.
@@ -75,6 +75,14 @@ const SubGhzProtocol subghz_protocol_ansonic = {
     .encoder = &subghz_protocol_ansonic_encoder,
 };
 
+const SubGhzProtocolDecoderWake subghz_protocol_ansonic_wake = {
+    .timing = &subghz_protocol_ansonic_const,
+    .level = false,
+    .te_long = false,
+    .te_count = 35,
+    .delta_count = 35,
+};
+
 void* subghz_protocol_encoder_ansonic_alloc(SubGhzEnvironment* environment) {
     UNUSED(environment);
     SubGhzProtocolEncoderAnsonic* instance = malloc(sizeof(SubGhzProtocolEncoderAnsonic));
@@ -10,6 +10,7 @@ typedef struct SubGhzProtocolEncoderAnsonic SubGhzProtocolEncoderAnsonic;
 extern const SubGhzProtocolDecoder subghz_protocol_ansonic_decoder;
 extern const SubGhzProtocolEncoder subghz_protocol_ansonic_encoder;
 extern const SubGhzProtocol subghz_protocol_ansonic;
+extern const SubGhzProtocolDecoderWake subghz_protocol_ansonic_wake;
 
 /**
  * Allocate SubGhzProtocolEncoderAnsonic.
@@ -90,6 +90,14 @@ const SubGhzProtocol ws_protocol_auriol_ahfl = {
     .filter = SubGhzProtocolFilter_Weather,
 };
 
+const SubGhzProtocolDecoderWake ws_protocol_auriol_ahfl_wake = {
+    .timing = &ws_protocol_auriol_ahfl_const,
+    .level = false,
+    .te_long = false,
+    .te_count = 18,
+    .delta_count = 1,
+};
+
 void* ws_protocol_decoder_auriol_ahfl_alloc(SubGhzEnvironment* environment) {
     UNUSED(environment);
     WSProtocolDecoderAuriol_AHFL* instance = malloc(sizeof(WSProtocolDecoderAuriol_AHFL));
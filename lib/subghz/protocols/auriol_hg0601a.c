@@ -89,6 +89,14 @@ const SubGhzProtocol ws_protocol_auriol_th = {
     .filter = SubGhzProtocolFilter_Weather,
 };
 
+const SubGhzProtocolDecoderWake ws_protocol_auriol_th_wake = {
+    .timing = &ws_protocol_auriol_th_const,
+    .level = false,
+    .te_long = false,
+    .te_count = 8,
+    .delta_count = 1,
+};
+
 void* ws_protocol_decoder_auriol_th_alloc(SubGhzEnvironment* environment) {
     UNUSED(environment);
     WSProtocolDecoderAuriol_TH* instance = malloc(sizeof(WSProtocolDecoderAuriol_TH));
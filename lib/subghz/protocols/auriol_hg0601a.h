@@ -16,6 +16,7 @@ typedef struct WSProtocolEncoderAuriol_TH WSProtocolEncoderAuriol_TH;
 extern const SubGhzProtocolDecoder ws_protocol_auriol_th_decoder;
 extern const SubGhzProtocolEncoder ws_protocol_auriol_th_encoder;
 extern const SubGhzProtocol ws_protocol_auriol_th;
+extern const SubGhzProtocolDecoderWake ws_protocol_auriol_th_wake;
 
 /**
  * Allocate WSProtocolDecoderAuriol_TH.
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "../types.h"
+#include "../blocks/const.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -73,6 +74,21 @@ SubGhzProtocolStatus subghz_protocol_decoder_base_deserialize(
  */
 uint8_t subghz_protocol_decoder_base_get_hash_data(SubGhzProtocolDecoderBase* decoder_base);
 
+/**
+ * Wake-up condition of a decoder waiting in its reset step (parser_step == 0).
+ * Decoder leaves reset step only on a pulse of given level which satisfies
+ * DURATION_DIFF(duration, te * te_count) < te_delta * delta_count,
+ * any other pulse is ignored, so receiver may skip feeding it.
+ * Decoder instance must start with SubGhzProtocolDecoderBase followed by SubGhzBlockDecoder.
+ */
+typedef struct {
+    const SubGhzBlockConst* timing;
+    bool level;
+    bool te_long; /**< te_long instead of te_short */
+    uint8_t te_count;
+    uint8_t delta_count;
+} SubGhzProtocolDecoderWake;
+
 // Encoder Base
 typedef struct SubGhzProtocolEncoderBase SubGhzProtocolEncoderBase;
 
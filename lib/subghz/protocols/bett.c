@@ -84,6 +84,14 @@ const SubGhzProtocol subghz_protocol_bett = {
     .encoder = &subghz_protocol_bett_encoder,
 };
 
+const SubGhzProtocolDecoderWake subghz_protocol_bett_wake = {
+    .timing = &subghz_protocol_bett_const,
+    .level = false,
+    .te_long = false,
+    .te_count = 44,
+    .delta_count = 15,
+};
+
 void* subghz_protocol_encoder_bett_alloc(SubGhzEnvironment* environment) {
     UNUSED(environment);
     SubGhzProtocolEncoderBETT* instance = malloc(sizeof(SubGhzProtocolEncoderBETT));
@@ -10,6 +10,7 @@ typedef struct SubGhzProtocolEncoderBETT SubGhzProtocolEncoderBETT;
 extern const SubGhzProtocolDecoder subghz_protocol_bett_decoder;
 extern const SubGhzProtocolEncoder subghz_protocol_bett_encoder;
 extern const SubGhzProtocol subghz_protocol_bett;
+extern const SubGhzProtocolDecoderWake subghz_protocol_bett_wake;
 
 /**
  * Allocate SubGhzProtocolEncoderBETT.
@@ -81,6 +81,14 @@ const SubGhzProtocol subghz_protocol_came = {
     .encoder = &subghz_protocol_came_encoder,
 };
 
+const SubGhzProtocolDecoderWake subghz_protocol_came_wake = {
+    .timing = &subghz_protocol_came_const,
+    .level = false,
+    .te_long = false,
+    .te_count = 56,
+    .delta_count = 47,
+};
+
 void* subghz_protocol_encoder_came_alloc(SubGhzEnvironment* environment) {
     UNUSED(environment);
     SubGhzProtocolEncoderCame* instance = malloc(sizeof(SubGhzProtocolEncoderCame));
@@ -10,6 +10,7 @@ typedef struct SubGhzProtocolEncoderCame SubGhzProtocolEncoderCame;
 extern const SubGhzProtocolDecoder subghz_protocol_came_decoder;
 extern const SubGhzProtocolEncoder subghz_protocol_came_encoder;
 extern const SubGhzProtocol subghz_protocol_came;
+extern const SubGhzProtocolDecoderWake subghz_protocol_came_wake;
 
 /**
  * Allocate SubGhzProtocolEncoderCame.
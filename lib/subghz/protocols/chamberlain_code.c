@@ -98,6 +98,14 @@ const SubGhzProtocol subghz_protocol_chamb_code = {
     .encoder = &subghz_protocol_chamb_code_encoder,
 };
 
+const SubGhzProtocolDecoderWake subghz_protocol_chamb_code_wake = {
+    .timing = &subghz_protocol_chamb_code_const,
+    .level = false,
+    .te_long = false,
+    .te_count = 39,
+    .delta_count = 20,
+};
+
 void* subghz_protocol_encoder_chamb_code_alloc(SubGhzEnvironment* environment) {
     UNUSED(environment);
     SubGhzProtocolEncoderChamb_Code* instance = malloc(sizeof(SubGhzProtocolEncoderChamb_Code));
@@ -10,6 +10,7 @@ typedef struct SubGhzProtocolEncoderChamb_Code SubGhzProtocolEncoderChamb_Code;
 extern const SubGhzProtocolDecoder subghz_protocol_chamb_code_decoder;
 extern const SubGhzProtocolEncoder subghz_protocol_chamb_code_encoder;
 extern const SubGhzProtocol subghz_protocol_chamb_code;
+extern const SubGhzProtocolDecoderWake subghz_protocol_chamb_code_wake;
 
 /**
  * Allocate SubGhzProtocolEncoderChamb_Code.
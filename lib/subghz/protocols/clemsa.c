@@ -83,6 +83,14 @@ const SubGhzProtocol subghz_protocol_clemsa = {
     .encoder = &subghz_protocol_clemsa_encoder,
 };
 
+const SubGhzProtocolDecoderWake subghz_protocol_clemsa_wake = {
+    .timing = &subghz_protocol_clemsa_const,
+    .level = false,
+    .te_long = false,
+    .te_count = 51,
+    .delta_count = 25,
+};
+
 void* subghz_protocol_encoder_clemsa_alloc(SubGhzEnvironment* environment) {
     UNUSED(environment);
     SubGhzProtocolEncoderClemsa* instance = malloc(sizeof(SubGhzProtocolEncoderClemsa));
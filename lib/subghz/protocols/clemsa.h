@@ -10,6 +10,7 @@ typedef struct SubGhzProtocolEncoderClemsa SubGhzProtocolEncoderClemsa;
 extern const SubGhzProtocolDecoder subghz_protocol_clemsa_decoder;
 extern const SubGhzProtocolEncoder subghz_protocol_clemsa_encoder;
 extern const SubGhzProtocol subghz_protocol_clemsa;
+extern const SubGhzProtocolDecoderWake subghz_protocol_clemsa_wake;
 
 /**
  * Allocate SubGhzProtocolEncoderClemsa.
@@ -75,6 +75,14 @@ const SubGhzProtocol subghz_protocol_doitrand = {
     .encoder = &subghz_protocol_doitrand_encoder,
 };
 
+const SubGhzProtocolDecoderWake subghz_protocol_doitrand_wake = {
+    .timing = &subghz_protocol_doitrand_const,
+    .level = false,
+    .te_long = false,
+    .te_count = 62,
+    .delta_count = 30,
+};
+
 void* subghz_protocol_encoder_doitrand_alloc(SubGhzEnvironment* environment) {
     UNUSED(environment);
     SubGhzProtocolEncoderDoitrand* instance = malloc(sizeof(SubGhzProtocolEncoderDoitrand));
@@ -10,6 +10,7 @@ typedef struct SubGhzProtocolEncoderDoitrand SubGhzProtocolEncoderDoitrand;
 extern const SubGhzProtocolDecoder subghz_protocol_doitrand_decoder;
 extern const SubGhzProtocolEncoder subghz_protocol_doitrand_encoder;
 extern const SubGhzProtocol subghz_protocol_doitrand;
+extern const SubGhzProtocolDecoderWake subghz_protocol_doitrand_wake;
 
 /**
  * Allocate SubGhzProtocolEncoderDoitrand.
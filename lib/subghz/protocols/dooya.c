@@ -70,6 +70,14 @@ const SubGhzProtocol subghz_protocol_dooya = {
     .encoder = &subghz_protocol_dooya_encoder,
 };
 
+const SubGhzProtocolDecoderWake subghz_protocol_dooya_wake = {
+    .timing = &subghz_protocol_dooya_const,
+    .level = false,
+    .te_long = true,
+    .te_count = 12,
+    .delta_count = 20,
+};
+
 void* subghz_protocol_encoder_dooya_alloc(SubGhzEnvironment* environment) {
     UNUSED(environment);
     SubGhzProtocolEncoderDooya* instance = malloc(sizeof(SubGhzProtocolEncoderDooya));
@@ -10,6 +10,7 @@ typedef struct SubGhzProtocolEncoderDooya SubGhzProtocolEncoderDooya;
 extern const SubGhzProtocolDecoder subghz_protocol_dooya_decoder;
 extern const SubGhzProtocolEncoder subghz_protocol_dooya_encoder;
 extern const SubGhzProtocol subghz_protocol_dooya;
+extern const SubGhzProtocolDecoderWake subghz_protocol_dooya_wake;
 
 /**
  * Allocate SubGhzProtocolEncoderDooya.
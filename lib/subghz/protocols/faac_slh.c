@@ -91,6 +91,14 @@ const SubGhzProtocol subghz_protocol_faac_slh = {
     .encoder = &subghz_protocol_faac_slh_encoder,
 };
 
+const SubGhzProtocolDecoderWake subghz_protocol_faac_slh_wake = {
+    .timing = &subghz_protocol_faac_slh_const,
+    .level = true,
+    .te_long = true,
+    .te_count = 2,
+    .delta_count = 3,
+};
+
 /** 
  * Analysis of received data
  * @param instance Pointer to a SubGhzBlockGeneric* instance
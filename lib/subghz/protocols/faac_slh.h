@@ -10,6 +10,7 @@ typedef struct SubGhzProtocolEncoderFaacSLH SubGhzProtocolEncoderFaacSLH;
 extern const SubGhzProtocolDecoder subghz_protocol_faac_slh_decoder;
 extern const SubGhzProtocolEncoder subghz_protocol_faac_slh_encoder;
 extern const SubGhzProtocol subghz_protocol_faac_slh;
+extern const SubGhzProtocolDecoderWake subghz_protocol_faac_slh_wake;
 
 /**
  * Allocate SubGhzProtocolEncoderFaacSLH.
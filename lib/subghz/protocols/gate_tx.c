@@ -68,6 +68,14 @@ const SubGhzProtocol subghz_protocol_gate_tx = {
     .encoder = &subghz_protocol_gate_tx_encoder,
 };
 
+const SubGhzProtocolDecoderWake subghz_protocol_gate_tx_wake = {
+    .timing = &subghz_protocol_gate_tx_const,
+    .level = false,
+    .te_long = false,
+    .te_count = 47,
+    .delta_count = 47,
+};
+
 void* subghz_protocol_encoder_gate_tx_alloc(SubGhzEnvironment* environment) {
     UNUSED(environment);
     SubGhzProtocolEncoderGateTx* instance = malloc(sizeof(SubGhzProtocolEncoderGateTx));
@@ -10,6 +10,7 @@ typedef struct SubGhzProtocolEncoderGateTx SubGhzProtocolEncoderGateTx;
 extern const SubGhzProtocolDecoder subghz_protocol_gate_tx_decoder;
 extern const SubGhzProtocolEncoder subghz_protocol_gate_tx_encoder;
 extern const SubGhzProtocol subghz_protocol_gate_tx;
+extern const SubGhzProtocolDecoderWake subghz_protocol_gate_tx_wake;
 
 /**
  * Allocate SubGhzProtocolEncoderGateTx.
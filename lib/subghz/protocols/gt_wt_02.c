@@ -92,6 +92,14 @@ const SubGhzProtocol ws_protocol_gt_wt_02 = {
     .filter = SubGhzProtocolFilter_Weather,
 };
 
+const SubGhzProtocolDecoderWake ws_protocol_gt_wt_02_wake = {
+    .timing = &ws_protocol_gt_wt_02_const,
+    .level = false,
+    .te_long = false,
+    .te_count = 18,
+    .delta_count = 8,
+};
+
 void* ws_protocol_decoder_gt_wt_02_alloc(SubGhzEnvironment* environment) {
     UNUSED(environment);
     WSProtocolDecoderGT_WT02* instance = malloc(sizeof(WSProtocolDecoderGT_WT02));
@@ -16,6 +16,7 @@ typedef struct WSProtocolEncoderGT_WT02 WSProtocolEncoderGT_WT02;
 extern const SubGhzProtocolDecoder ws_protocol_gt_wt_02_decoder;
 extern const SubGhzProtocolEncoder ws_protocol_gt_wt_02_encoder;
 extern const SubGhzProtocol ws_protocol_gt_wt_02;
+extern const SubGhzProtocolDecoderWake ws_protocol_gt_wt_02_wake;
 
 /**
  * Allocate WSProtocolDecoderGT_WT02.
@@ -118,6 +118,14 @@ const SubGhzProtocol ws_protocol_gt_wt_03 = {
     .filter = SubGhzProtocolFilter_Weather,
 };
 
+const SubGhzProtocolDecoderWake ws_protocol_gt_wt_03_wake = {
+    .timing = &ws_protocol_gt_wt_03_const,
+    .level = true,
+    .te_long = false,
+    .te_count = 3,
+    .delta_count = 2,
+};
+
 void* ws_protocol_decoder_gt_wt_03_alloc(SubGhzEnvironment* environment) {
     UNUSED(environment);
     WSProtocolDecoderGT_WT03* instance = malloc(sizeof(WSProtocolDecoderGT_WT03));
@@ -16,6 +16,7 @@ typedef struct WSProtocolEncoderGT_WT03 WSProtocolEncoderGT_WT03;
 extern const SubGhzProtocolDecoder ws_protocol_gt_wt_03_decoder;
 extern const SubGhzProtocolEncoder ws_protocol_gt_wt_03_encoder;
 extern const SubGhzProtocol ws_protocol_gt_wt_03;
+extern const SubGhzProtocolDecoderWake ws_protocol_gt_wt_03_wake;
 
 /**
  * Allocate WSProtocolDecoderGT_WT03.
@@ -79,6 +79,14 @@ const SubGhzProtocol subghz_protocol_holtek = {
     .encoder = &subghz_protocol_holtek_encoder,
 };
 
+const SubGhzProtocolDecoderWake subghz_protocol_holtek_wake = {
+    .timing = &subghz_protocol_holtek_const,
+    .level = false,
+    .te_long = false,
+    .te_count = 36,
+    .delta_count = 36,
+};
+
 void* subghz_protocol_encoder_holtek_alloc(SubGhzEnvironment* environment) {
     UNUSED(environment);
     SubGhzProtocolEncoderHoltek* instance = malloc(sizeof(SubGhzProtocolEncoderHoltek));
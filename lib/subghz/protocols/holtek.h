@@ -10,6 +10,7 @@ typedef struct SubGhzProtocolEncoderHoltek SubGhzProtocolEncoderHoltek;
 extern const SubGhzProtocolDecoder subghz_protocol_holtek_decoder;
 extern const SubGhzProtocolEncoder subghz_protocol_holtek_encoder;
 extern const SubGhzProtocol subghz_protocol_holtek;
+extern const SubGhzProtocolDecoderWake subghz_protocol_holtek_wake;
 
 /**
  * Allocate SubGhzProtocolEncoderHoltek.
@@ -86,6 +86,14 @@ const SubGhzProtocol subghz_protocol_holtek_th12x = {
     .encoder = &subghz_protocol_holtek_th12x_encoder,
 };
 
+const SubGhzProtocolDecoderWake subghz_protocol_holtek_th12x_wake = {
+    .timing = &subghz_protocol_holtek_th12x_const,
+    .level = false,
+    .te_long = false,
+    .te_count = 36,
+    .delta_count = 36,
+};
+
 void* subghz_protocol_encoder_holtek_th12x_alloc(SubGhzEnvironment* environment) {
     UNUSED(environment);
     SubGhzProtocolEncoderHoltek_HT12X* instance =
@@ -10,6 +10,7 @@ typedef struct SubGhzProtocolEncoderHoltek_HT12X SubGhzProtocolEncoderHoltek_HT1
 extern const SubGhzProtocolDecoder subghz_protocol_holtek_th12x_decoder;
 extern const SubGhzProtocolEncoder subghz_protocol_holtek_th12x_encoder;
 extern const SubGhzProtocol subghz_protocol_holtek_th12x;
+extern const SubGhzProtocolDecoderWake subghz_protocol_holtek_th12x_wake;
 
 /**
  * Allocate SubGhzProtocolEncoderHoltek_HT12X.
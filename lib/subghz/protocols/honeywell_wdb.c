@@ -80,6 +80,14 @@ const SubGhzProtocol subghz_protocol_honeywell_wdb = {
     .encoder = &subghz_protocol_honeywell_wdb_encoder,
 };
 
+const SubGhzProtocolDecoderWake subghz_protocol_honeywell_wdb_wake = {
+    .timing = &subghz_protocol_honeywell_wdb_const,
+    .level = false,
+    .te_long = false,
+    .te_count = 3,
+    .delta_count = 1,
+};
+
 void* subghz_protocol_encoder_honeywell_wdb_alloc(SubGhzEnvironment* environment) {
     UNUSED(environment);
     SubGhzProtocolEncoderHoneywell_WDB* instance =
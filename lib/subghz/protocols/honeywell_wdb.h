@@ -10,6 +10,7 @@ typedef struct SubGhzProtocolEncoderHoneywell_WDB SubGhzProtocolEncoderHoneywell
 extern const SubGhzProtocolDecoder subghz_protocol_honeywell_wdb_decoder;
 extern const SubGhzProtocolEncoder subghz_protocol_honeywell_wdb_encoder;
 extern const SubGhzProtocol subghz_protocol_honeywell_wdb;
+extern const SubGhzProtocolDecoderWake subghz_protocol_honeywell_wdb_wake;
 
 /**
  * Allocate SubGhzProtocolEncoderHoneywell_WDB.
@@ -73,6 +73,14 @@ const SubGhzProtocol subghz_protocol_hormann = {
     .encoder = &subghz_protocol_hormann_encoder,
 };
 
+const SubGhzProtocolDecoderWake subghz_protocol_hormann_wake = {
+    .timing = &subghz_protocol_hormann_const,
+    .level = true,
+    .te_long = false,
+    .te_count = 24,
+    .delta_count = 24,
+};
+
 void* subghz_protocol_encoder_hormann_alloc(SubGhzEnvironment* environment) {
     UNUSED(environment);
     SubGhzProtocolEncoderHormann* instance = malloc(sizeof(SubGhzProtocolEncoderHormann));
@@ -10,6 +10,7 @@ typedef struct SubGhzProtocolEncoderHormann SubGhzProtocolEncoderHormann;
 extern const SubGhzProtocolDecoder subghz_protocol_hormann_decoder;
 extern const SubGhzProtocolEncoder subghz_protocol_hormann_encoder;
 extern const SubGhzProtocol subghz_protocol_hormann;
+extern const SubGhzProtocolDecoderWake subghz_protocol_hormann_wake;
 
 /**
  * Allocate SubGhzProtocolEncoderHormann.
@@ -68,6 +68,14 @@ const SubGhzProtocol subghz_protocol_ido = {
     .encoder = &subghz_protocol_ido_encoder,
 };
 
+const SubGhzProtocolDecoderWake subghz_protocol_ido_wake = {
+    .timing = &subghz_protocol_ido_const,
+    .level = true,
+    .te_long = false,
+    .te_count = 10,
+    .delta_count = 5,
+};
+
 void* subghz_protocol_decoder_ido_alloc(SubGhzEnvironment* environment) {
     UNUSED(environment);
     SubGhzProtocolDecoderIDo* instance = malloc(sizeof(SubGhzProtocolDecoderIDo));
@@ -10,6 +10,7 @@ typedef struct SubGhzProtocolEncoderIDo SubGhzProtocolEncoderIDo;
 extern const SubGhzProtocolDecoder subghz_protocol_ido_decoder;
 extern const SubGhzProtocolEncoder subghz_protocol_ido_encoder;
 extern const SubGhzProtocol subghz_protocol_ido;
+extern const SubGhzProtocolDecoderWake subghz_protocol_ido_wake;
 
 /**
  * Allocate SubGhzProtocolDecoderIDo.
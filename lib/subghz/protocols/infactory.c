@@ -103,6 +103,14 @@ const SubGhzProtocol ws_protocol_infactory = {
     .filter = SubGhzProtocolFilter_Weather,
 };
 
+const SubGhzProtocolDecoderWake ws_protocol_infactory_wake = {
+    .timing = &ws_protocol_infactory_const,
+    .level = true,
+    .te_long = false,
+    .te_count = 2,
+    .delta_count = 2,
+};
+
 void* ws_protocol_decoder_infactory_alloc(SubGhzEnvironment* environment) {
     UNUSED(environment);
     WSProtocolDecoderInfactory* instance = malloc(sizeof(WSProtocolDecoderInfactory));
@@ -16,6 +16,7 @@ typedef struct WSProtocolEncoderInfactory WSProtocolEncoderInfactory;
 extern const SubGhzProtocolDecoder ws_protocol_infactory_decoder;
 extern const SubGhzProtocolEncoder ws_protocol_infactory_encoder;
 extern const SubGhzProtocol ws_protocol_infactory;
+extern const SubGhzProtocolDecoderWake ws_protocol_infactory_wake;
 
 /**
  * Allocate WSProtocolDecoderInfactory.
@@ -78,6 +78,14 @@ const SubGhzProtocol subghz_protocol_intertechno_v3 = {
     .encoder = &subghz_protocol_intertechno_v3_encoder,
 };
 
+const SubGhzProtocolDecoderWake subghz_protocol_intertechno_v3_wake = {
+    .timing = &subghz_protocol_intertechno_v3_const,
+    .level = false,
+    .te_long = false,
+    .te_count = 37,
+    .delta_count = 15,
+};
+
 void* subghz_protocol_encoder_intertechno_v3_alloc(SubGhzEnvironment* environment) {
     UNUSED(environment);
     SubGhzProtocolEncoderIntertechno_V3* instance =
@@ -10,6 +10,7 @@ typedef struct SubGhzProtocolEncoderIntertechno_V3 SubGhzProtocolEncoderIntertec
 extern const SubGhzProtocolDecoder subghz_protocol_intertechno_v3_decoder;
 extern const SubGhzProtocolEncoder subghz_protocol_intertechno_v3_encoder;
 extern const SubGhzProtocol subghz_protocol_intertechno_v3;
+extern const SubGhzProtocolDecoderWake subghz_protocol_intertechno_v3_wake;
 
 /**
  * Allocate SubGhzProtocolEncoderIntertechno_V3.
@@ -87,6 +87,14 @@ const SubGhzProtocol subghz_protocol_keeloq = {
     .encoder = &subghz_protocol_keeloq_encoder,
 };
 
+const SubGhzProtocolDecoderWake subghz_protocol_keeloq_wake = {
+    .timing = &subghz_protocol_keeloq_const,
+    .level = true,
+    .te_long = false,
+    .te_count = 1,
+    .delta_count = 1,
+};
+
 /** 
  * Analysis of received data
  * @param instance Pointer to a SubGhzBlockGeneric* instance
@@ -728,21 +736,54 @@ static inline bool subghz_protocol_keeloq_check_decrypt_centurion(
     return false;
 }
 
-/** 
- * Checking the accepted code against the database manafacture key
+/**
+ * Normal learning man of a keystore key, cached for the serial number bound to the index
+ * @param index Pointer to a SubGhzKeystoreIndex instance
+ * @param position Key position in the keystore
+ * @param mirrored Use mirrored man, unknown learning type only
+ * @param fix Fix part of the parcel
+ * @param key Manufacture key
+ * @return manufacture for this serial number (64bit)
+ */
+static uint64_t subghz_protocol_keeloq_normal_learning_cached(
+    SubGhzKeystoreIndex* index,
+    size_t position,
+    bool mirrored,
+    uint32_t fix,
+    uint64_t key) {
+    uint16_t slot = index->learning_slot[position];
+    if(slot == SUBGHZ_KEYSTORE_INDEX_SLOT_NONE) {
+        return subghz_protocol_keeloq_common_normal_learning(fix, key);
+    }
+
+    slot += mirrored ? 1 : 0;
+    uint32_t mask = 1UL << (slot % 32);
+    if(!(index->learning_cache_valid[slot / 32] & mask)) {
+        index->learning_cache[slot] = subghz_protocol_keeloq_common_normal_learning(fix, key);
+        index->learning_cache_valid[slot / 32] |= mask;
+    }
+    return index->learning_cache[slot];
+}
+
+/**
+ * Checking the accepted code against one manafacture key
  * @param instance Pointer to a SubGhzBlockGeneric* instance
+ * @param keystore Pointer to a SubGhzKeystore* instance
+ * @param index Pointer to a SubGhzKeystoreIndex instance, bound to serial of the parcel
+ * @param position Key position in the keystore
  * @param fix Fix part of the parcel
  * @param hop Hop encrypted part of the parcel
- * @param keystore Pointer to a SubGhzKeystore* instance
- * @param manufacture_name 
- * @return true on successful search
+ * @param is_centurion Key belongs to Centurion
+ * @return true on successful decrypt
  */
-static uint8_t subghz_protocol_keeloq_check_remote_controller_selector(
+static bool subghz_protocol_keeloq_check_key(
     SubGhzBlockGeneric* instance,
+    SubGhzKeystore* keystore,
+    SubGhzKeystoreIndex* index,
+    size_t position,
     uint32_t fix,
     uint32_t hop,
-    SubGhzKeystore* keystore,
-    const char** manufacture_name) {
+    bool is_centurion) {
     // protocol HCS300 uses 10 bits in discriminator, HCS200 uses 8 bits, for backward compatibility, we are looking for the 8-bit pattern
     // HCS300 -> uint16_t end_serial = (uint16_t)(fix & 0x3FF);
     // HCS200 -> uint16_t end_serial = (uint16_t)(fix & 0xFF);
@@ -751,199 +792,190 @@ static uint8_t subghz_protocol_keeloq_check_remote_controller_selector(
     uint8_t btn = (uint8_t)(fix >> 28);
     uint32_t decrypt = 0;
     uint64_t man;
-    bool mf_not_set = false;
-    // TODO:
-    // if(mfname == 0x0) {
-    //     mfname = "";
-    // }
 
-    const char* mfname = keystore->mfname;
+    const SubGhzKey* manufacture_code =
+        SubGhzKeyArray_cget(*subghz_keystore_get_data(keystore), position);
+
+    switch(manufacture_code->type) {
+    case KEELOQ_LEARNING_SIMPLE:
+        // Simple Learning
+        decrypt = subghz_protocol_keeloq_common_decrypt(hop, manufacture_code->key);
+        return subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial);
+    case KEELOQ_LEARNING_NORMAL:
+        // Normal Learning
+        // https://phreakerclub.com/forum/showpost.php?p=43557&postcount=37
+        man = subghz_protocol_keeloq_normal_learning_cached(
+            index, position, false, fix, manufacture_code->key);
+        decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
+        if(is_centurion) {
+            return subghz_protocol_keeloq_check_decrypt_centurion(instance, decrypt, btn);
+        }
+        return subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial);
+    case KEELOQ_LEARNING_SECURE:
+        man = subghz_protocol_keeloq_common_secure_learning(
+            fix, instance->seed, manufacture_code->key);
+        decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
+        return subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial);
+    case KEELOQ_LEARNING_MAGIC_XOR_TYPE_1:
+        man = subghz_protocol_keeloq_common_magic_xor_type1_learning(fix, manufacture_code->key);
+        decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
+        return subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial);
+    case KEELOQ_LEARNING_MAGIC_SERIAL_TYPE_1:
+        man = subghz_protocol_keeloq_common_magic_serial_type1_learning(
+            fix, manufacture_code->key);
+        decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
+        return subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial);
+    case KEELOQ_LEARNING_MAGIC_SERIAL_TYPE_2:
+        man = subghz_protocol_keeloq_common_magic_serial_type2_learning(
+            fix, manufacture_code->key);
+        decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
+        return subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial);
+    case KEELOQ_LEARNING_MAGIC_SERIAL_TYPE_3:
+        man = subghz_protocol_keeloq_common_magic_serial_type3_learning(
+            fix, manufacture_code->key);
+        decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
+        return subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial);
+    case KEELOQ_LEARNING_UNKNOWN:
+        // Simple Learning
+        decrypt = subghz_protocol_keeloq_common_decrypt(hop, manufacture_code->key);
+        if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
+            keystore->kl_type = 1;
+            return true;
+        }
 
-    if(strcmp(mfname, "Unknown") == 0) {
-        return 1;
-    } else if(strcmp(mfname, "") == 0) {
-        mf_not_set = true;
-    }
-    for
-        M_EACH(manufacture_code, *subghz_keystore_get_data(keystore), SubGhzKeyArray_t) {
-            if(mf_not_set || (strcmp(furi_string_get_cstr(manufacture_code->name), mfname) == 0)) {
-                switch(manufacture_code->type) {
-                case KEELOQ_LEARNING_SIMPLE:
-                    // Simple Learning
-                    decrypt = subghz_protocol_keeloq_common_decrypt(hop, manufacture_code->key);
-                    if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                        *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                        keystore->mfname = *manufacture_name;
-                        return 1;
-                    }
-                    break;
-                case KEELOQ_LEARNING_NORMAL:
-                    // Normal Learning
-                    // https://phreakerclub.com/forum/showpost.php?p=43557&postcount=37
-                    man =
-                        subghz_protocol_keeloq_common_normal_learning(fix, manufacture_code->key);
-                    decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
-                    if((strcmp(furi_string_get_cstr(manufacture_code->name), "Centurion") == 0)) {
-                        if(subghz_protocol_keeloq_check_decrypt_centurion(instance, decrypt, btn)) {
-                            *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                            keystore->mfname = *manufacture_name;
-                            return 1;
-                        }
-                    } else {
-                        if(subghz_protocol_keeloq_check_decrypt(
-                               instance, decrypt, btn, end_serial)) {
-                            *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                            keystore->mfname = *manufacture_name;
-                            return 1;
-                        }
-                    }
-                    break;
-                case KEELOQ_LEARNING_SECURE:
-                    man = subghz_protocol_keeloq_common_secure_learning(
-                        fix, instance->seed, manufacture_code->key);
-                    decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
-                    if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                        *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                        keystore->mfname = *manufacture_name;
-                        return 1;
-                    }
-                    break;
-                case KEELOQ_LEARNING_MAGIC_XOR_TYPE_1:
-                    man = subghz_protocol_keeloq_common_magic_xor_type1_learning(
-                        fix, manufacture_code->key);
-                    decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
-                    if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                        *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                        keystore->mfname = *manufacture_name;
-                        return 1;
-                    }
-                    break;
-                case KEELOQ_LEARNING_MAGIC_SERIAL_TYPE_1:
-                    man = subghz_protocol_keeloq_common_magic_serial_type1_learning(
-                        fix, manufacture_code->key);
-                    decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
-                    if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                        *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                        keystore->mfname = *manufacture_name;
-                        return 1;
-                    }
-                    break;
-                case KEELOQ_LEARNING_MAGIC_SERIAL_TYPE_2:
-                    man = subghz_protocol_keeloq_common_magic_serial_type2_learning(
-                        fix, manufacture_code->key);
-                    decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
-                    if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                        *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                        keystore->mfname = *manufacture_name;
-                        return 1;
-                    }
-                    break;
-                case KEELOQ_LEARNING_MAGIC_SERIAL_TYPE_3:
-                    man = subghz_protocol_keeloq_common_magic_serial_type3_learning(
-                        fix, manufacture_code->key);
-                    decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
-                    if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                        *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                        keystore->mfname = *manufacture_name;
-                        return 1;
-                    }
-                    break;
-                case KEELOQ_LEARNING_UNKNOWN:
-                    // Simple Learning
-                    decrypt = subghz_protocol_keeloq_common_decrypt(hop, manufacture_code->key);
-                    if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                        *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                        keystore->mfname = *manufacture_name;
-                        keystore->kl_type = 1;
-                        return 1;
-                    }
+        // Check for mirrored man
+        uint64_t man_rev = 0;
+        uint64_t man_rev_byte = 0;
+        for(uint8_t i = 0; i < 64; i += 8) {
+            man_rev_byte = (uint8_t)(manufacture_code->key >> i);
+            man_rev = man_rev | man_rev_byte << (56 - i);
+        }
 
-                    // Check for mirrored man
-                    uint64_t man_rev = 0;
-                    uint64_t man_rev_byte = 0;
-                    for(uint8_t i = 0; i < 64; i += 8) {
-                        man_rev_byte = (uint8_t)(manufacture_code->key >> i);
-                        man_rev = man_rev | man_rev_byte << (56 - i);
-                    }
+        decrypt = subghz_protocol_keeloq_common_decrypt(hop, man_rev);
+        if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
+            keystore->kl_type = 1;
+            return true;
+        }
 
-                    decrypt = subghz_protocol_keeloq_common_decrypt(hop, man_rev);
-                    if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                        *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                        keystore->mfname = *manufacture_name;
-                        keystore->kl_type = 1;
-                        return 1;
-                    }
+        //###########################
+        // Normal Learning
+        // https://phreakerclub.com/forum/showpost.php?p=43557&postcount=37
+        man = subghz_protocol_keeloq_normal_learning_cached(
+            index, position, false, fix, manufacture_code->key);
+        decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
+        if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
+            keystore->kl_type = 2;
+            return true;
+        }
 
-                    //###########################
-                    // Normal Learning
-                    // https://phreakerclub.com/forum/showpost.php?p=43557&postcount=37
-                    man =
-                        subghz_protocol_keeloq_common_normal_learning(fix, manufacture_code->key);
-                    decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
-                    if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                        *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                        keystore->mfname = *manufacture_name;
-                        keystore->kl_type = 2;
-                        return 1;
-                    }
+        // Check for mirrored man
+        man = subghz_protocol_keeloq_normal_learning_cached(index, position, true, fix, man_rev);
+        decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
+        if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
+            keystore->kl_type = 2;
+            return true;
+        }
 
-                    // Check for mirrored man
-                    man = subghz_protocol_keeloq_common_normal_learning(fix, man_rev);
-                    decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
-                    if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                        *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                        keystore->mfname = *manufacture_name;
-                        keystore->kl_type = 2;
-                        return 1;
-                    }
+        // Secure Learning
+        man = subghz_protocol_keeloq_common_secure_learning(
+            fix, instance->seed, manufacture_code->key);
+        decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
+        if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
+            keystore->kl_type = 3;
+            return true;
+        }
 
-                    // Secure Learning
-                    man = subghz_protocol_keeloq_common_secure_learning(
-                        fix, instance->seed, manufacture_code->key);
-                    decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
-                    if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                        *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                        keystore->mfname = *manufacture_name;
-                        keystore->kl_type = 3;
-                        return 1;
-                    }
+        // Check for mirrored man
+        man = subghz_protocol_keeloq_common_secure_learning(fix, instance->seed, man_rev);
+        decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
+        if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
+            keystore->kl_type = 3;
+            return true;
+        }
 
-                    // Check for mirrored man
-                    man = subghz_protocol_keeloq_common_secure_learning(
-                        fix, instance->seed, man_rev);
-                    decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
-                    if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                        *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                        keystore->mfname = *manufacture_name;
-                        keystore->kl_type = 3;
-                        return 1;
-                    }
+        // Magic xor type1 learning
+        man = subghz_protocol_keeloq_common_magic_xor_type1_learning(fix, manufacture_code->key);
+        decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
+        if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
+            keystore->kl_type = 4;
+            return true;
+        }
 
-                    // Magic xor type1 learning
-                    man = subghz_protocol_keeloq_common_magic_xor_type1_learning(
-                        fix, manufacture_code->key);
-                    decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
-                    if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                        *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                        keystore->mfname = *manufacture_name;
-                        keystore->kl_type = 4;
-                        return 1;
-                    }
+        // Check for mirrored man
+        man = subghz_protocol_keeloq_common_magic_xor_type1_learning(fix, man_rev);
+        decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
+        if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
+            keystore->kl_type = 4;
+            return true;
+        }
+        return false;
+    default:
+        return false;
+    }
+}
 
-                    // Check for mirrored man
-                    man = subghz_protocol_keeloq_common_magic_xor_type1_learning(fix, man_rev);
-                    decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
-                    if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                        *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                        keystore->mfname = *manufacture_name;
-                        keystore->kl_type = 4;
-                        return 1;
-                    }
+/** 
+ * Checking the accepted code against the database manafacture key
+ * @param instance Pointer to a SubGhzBlockGeneric* instance
+ * @param fix Fix part of the parcel
+ * @param hop Hop encrypted part of the parcel
+ * @param keystore Pointer to a SubGhzKeystore* instance
+ * @param manufacture_name 
+ * @return true on successful search
+ */
+static uint8_t subghz_protocol_keeloq_check_remote_controller_selector(
+    SubGhzBlockGeneric* instance,
+    uint32_t fix,
+    uint32_t hop,
+    SubGhzKeystore* keystore,
+    const char** manufacture_name) {
+    // TODO:
+    // if(mfname == 0x0) {
+    //     mfname = "";
+    // }
+
+    const char* mfname = keystore->mfname;
 
-                    break;
+    if(strcmp(mfname, "Unknown") == 0) {
+        return 1;
+    }
+
+    SubGhzKeystoreIndex* index = subghz_keystore_get_index(keystore);
+    subghz_keystore_index_set_serial(index, fix);
+    uint16_t centurion_mf_id = subghz_keystore_index_find_mf(index, "Centurion");
+
+    if(strcmp(mfname, "") == 0) {
+        // Manufacture is not set, try every key in load order
+        for(size_t position = 0; position < index->keys_count; position++) {
+            uint16_t mf_id = index->key_mf[position];
+            if(subghz_protocol_keeloq_check_key(
+                   instance, keystore, index, position, fix, hop, mf_id == centurion_mf_id)) {
+                *manufacture_name = index->mf_names[mf_id];
+                keystore->mfname = *manufacture_name;
+                return 1;
+            }
+        }
+    } else {
+        // Only keys of known manufacture
+        uint16_t mf_id = subghz_keystore_index_find_mf(index, mfname);
+        if(mf_id != SUBGHZ_KEYSTORE_INDEX_MF_NONE) {
+            for(size_t i = index->mf_keys_offset[mf_id]; i < index->mf_keys_offset[mf_id + 1];
+                i++) {
+                if(subghz_protocol_keeloq_check_key(
+                       instance,
+                       keystore,
+                       index,
+                       index->mf_keys[i],
+                       fix,
+                       hop,
+                       mf_id == centurion_mf_id)) {
+                    *manufacture_name = index->mf_names[mf_id];
+                    keystore->mfname = *manufacture_name;
+                    return 1;
                 }
             }
         }
+    }
 
     *manufacture_name = "Unknown";
     keystore->mfname = "Unknown";
@@ -10,6 +10,7 @@ typedef struct SubGhzProtocolEncoderKeeloq SubGhzProtocolEncoderKeeloq;
 extern const SubGhzProtocolDecoder subghz_protocol_keeloq_decoder;
 extern const SubGhzProtocolEncoder subghz_protocol_keeloq_encoder;
 extern const SubGhzProtocol subghz_protocol_keeloq;
+extern const SubGhzProtocolDecoderWake subghz_protocol_keeloq_wake;
 
 /**
  * Allocate SubGhzProtocolEncoderKeeloq.
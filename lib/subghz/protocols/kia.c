@@ -71,6 +71,14 @@ const SubGhzProtocol subghz_protocol_kia = {
     .filter = SubGhzProtocolFilter_AutoAlarms,
 };
 
+const SubGhzProtocolDecoderWake subghz_protocol_kia_wake = {
+    .timing = &subghz_protocol_kia_const,
+    .level = true,
+    .te_long = false,
+    .te_count = 1,
+    .delta_count = 1,
+};
+
 void* subghz_protocol_decoder_kia_alloc(SubGhzEnvironment* environment) {
     UNUSED(environment);
     SubGhzProtocolDecoderKIA* instance = malloc(sizeof(SubGhzProtocolDecoderKIA));
@@ -10,6 +10,7 @@ typedef struct SubGhzProtocolEncoderKIA SubGhzProtocolEncoderKIA;
 extern const SubGhzProtocolDecoder subghz_protocol_kia_decoder;
 extern const SubGhzProtocolEncoder subghz_protocol_kia_encoder;
 extern const SubGhzProtocol subghz_protocol_kia;
+extern const SubGhzProtocolDecoderWake subghz_protocol_kia_wake;
 
 /**
  * Allocate SubGhzProtocolDecoderKIA.
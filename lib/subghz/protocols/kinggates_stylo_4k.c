@@ -75,6 +75,14 @@ const SubGhzProtocol subghz_protocol_kinggates_stylo_4k = {
     .encoder = &subghz_protocol_kinggates_stylo_4k_encoder,
 };
 
+const SubGhzProtocolDecoderWake subghz_protocol_kinggates_stylo_4k_wake = {
+    .timing = &subghz_protocol_kinggates_stylo_4k_const,
+    .level = true,
+    .te_long = false,
+    .te_count = 1,
+    .delta_count = 1,
+};
+
 //
 // Encoder
 //
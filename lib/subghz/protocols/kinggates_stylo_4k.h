@@ -9,6 +9,7 @@ typedef struct SubGhzProtocolEncoderKingGates_stylo_4k SubGhzProtocolEncoderKing
 extern const SubGhzProtocolDecoder subghz_protocol_kinggates_stylo_4k_decoder;
 extern const SubGhzProtocolEncoder subghz_protocol_kinggates_stylo_4k_encoder;
 extern const SubGhzProtocol subghz_protocol_kinggates_stylo_4k;
+extern const SubGhzProtocolDecoderWake subghz_protocol_kinggates_stylo_4k_wake;
 
 /**
  * Allocate SubGhzProtocolEncoderKingGates_stylo_4k.
@@ -85,6 +85,14 @@ const SubGhzProtocol ws_protocol_lacrosse_tx141thbv2 = {
     .filter = SubGhzProtocolFilter_Weather,
 };
 
+const SubGhzProtocolDecoderWake ws_protocol_lacrosse_tx141thbv2_wake = {
+    .timing = &ws_protocol_lacrosse_tx141thbv2_const,
+    .level = true,
+    .te_long = false,
+    .te_count = 4,
+    .delta_count = 2,
+};
+
 void* ws_protocol_decoder_lacrosse_tx141thbv2_alloc(SubGhzEnvironment* environment) {
     UNUSED(environment);
     WSProtocolDecoderLaCrosse_TX141THBv2* instance =
@@ -16,6 +16,7 @@ typedef struct WSProtocolEncoderLaCrosse_TX141THBv2 WSProtocolEncoderLaCrosse_TX
 extern const SubGhzProtocolDecoder ws_protocol_lacrosse_tx141thbv2_decoder;
 extern const SubGhzProtocolEncoder ws_protocol_lacrosse_tx141thbv2_encoder;
 extern const SubGhzProtocol ws_protocol_lacrosse_tx141thbv2;
+extern const SubGhzProtocolDecoderWake ws_protocol_lacrosse_tx141thbv2_wake;
 
 /**
  * Allocate WSProtocolDecoderLaCrosse_TX141THBv2.
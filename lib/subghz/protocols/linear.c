@@ -74,6 +74,14 @@ const SubGhzProtocol subghz_protocol_linear = {
     .encoder = &subghz_protocol_linear_encoder,
 };
 
+const SubGhzProtocolDecoderWake subghz_protocol_linear_wake = {
+    .timing = &subghz_protocol_linear_const,
+    .level = false,
+    .te_long = false,
+    .te_count = 42,
+    .delta_count = 20,
+};
+
 void* subghz_protocol_encoder_linear_alloc(SubGhzEnvironment* environment) {
     UNUSED(environment);
     SubGhzProtocolEncoderLinear* instance = malloc(sizeof(SubGhzProtocolEncoderLinear));
@@ -10,6 +10,7 @@ typedef struct SubGhzProtocolEncoderLinear SubGhzProtocolEncoderLinear;
 extern const SubGhzProtocolDecoder subghz_protocol_linear_decoder;
 extern const SubGhzProtocolEncoder subghz_protocol_linear_encoder;
 extern const SubGhzProtocol subghz_protocol_linear;
+extern const SubGhzProtocolDecoderWake subghz_protocol_linear_wake;
 
 /**
  * Allocate SubGhzProtocolEncoderLinear.
@@ -75,6 +75,14 @@ const SubGhzProtocol subghz_protocol_linear_delta3 = {
     .encoder = &subghz_protocol_linear_delta3_encoder,
 };
 
+const SubGhzProtocolDecoderWake subghz_protocol_linear_delta3_wake = {
+    .timing = &subghz_protocol_linear_delta3_const,
+    .level = false,
+    .te_long = false,
+    .te_count = 70,
+    .delta_count = 24,
+};
+
 void* subghz_protocol_encoder_linear_delta3_alloc(SubGhzEnvironment* environment) {
     UNUSED(environment);
     SubGhzProtocolEncoderLinearDelta3* instance =
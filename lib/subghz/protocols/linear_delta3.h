@@ -10,6 +10,7 @@ typedef struct SubGhzProtocolEncoderLinearDelta3 SubGhzProtocolEncoderLinearDelt
 extern const SubGhzProtocolDecoder subghz_protocol_linear_delta3_decoder;
 extern const SubGhzProtocolEncoder subghz_protocol_linear_delta3_encoder;
 extern const SubGhzProtocol subghz_protocol_linear_delta3;
+extern const SubGhzProtocolDecoderWake subghz_protocol_linear_delta3_wake;
 
 /**
  * Allocate SubGhzProtocolEncoderLinearDelta3.
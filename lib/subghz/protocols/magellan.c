@@ -72,6 +72,14 @@ const SubGhzProtocol subghz_protocol_magellan = {
     .filter = SubGhzProtocolFilter_Magellan,
 };
 
+const SubGhzProtocolDecoderWake subghz_protocol_magellan_wake = {
+    .timing = &subghz_protocol_magellan_const,
+    .level = true,
+    .te_long = false,
+    .te_count = 1,
+    .delta_count = 1,
+};
+
 void* subghz_protocol_encoder_magellan_alloc(SubGhzEnvironment* environment) {
     UNUSED(environment);
     SubGhzProtocolEncoderMagellan* instance = malloc(sizeof(SubGhzProtocolEncoderMagellan));
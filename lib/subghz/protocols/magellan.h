@@ -10,6 +10,7 @@ typedef struct SubGhzProtocolEncoderMagellan SubGhzProtocolEncoderMagellan;
 extern const SubGhzProtocolDecoder subghz_protocol_magellan_decoder;
 extern const SubGhzProtocolEncoder subghz_protocol_magellan_encoder;
 extern const SubGhzProtocol subghz_protocol_magellan;
+extern const SubGhzProtocolDecoderWake subghz_protocol_magellan_wake;
 
 /**
  * Allocate SubGhzProtocolEncoderMagellan.
@@ -80,6 +80,14 @@ const SubGhzProtocol subghz_protocol_megacode = {
     .encoder = &subghz_protocol_megacode_encoder,
 };
 
+const SubGhzProtocolDecoderWake subghz_protocol_megacode_wake = {
+    .timing = &subghz_protocol_megacode_const,
+    .level = false,
+    .te_long = false,
+    .te_count = 13,
+    .delta_count = 17,
+};
+
 void* subghz_protocol_encoder_megacode_alloc(SubGhzEnvironment* environment) {
     UNUSED(environment);
     SubGhzProtocolEncoderMegaCode* instance = malloc(sizeof(SubGhzProtocolEncoderMegaCode));
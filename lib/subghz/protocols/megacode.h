@@ -10,6 +10,7 @@ typedef struct SubGhzProtocolEncoderMegaCode SubGhzProtocolEncoderMegaCode;
 extern const SubGhzProtocolDecoder subghz_protocol_megacode_decoder;
 extern const SubGhzProtocolEncoder subghz_protocol_megacode_encoder;
 extern const SubGhzProtocol subghz_protocol_megacode;
+extern const SubGhzProtocolDecoderWake subghz_protocol_megacode_wake;
 
 /**
  * Allocate SubGhzProtocolEncoderMegaCode.
@@ -70,6 +70,14 @@ const SubGhzProtocol subghz_protocol_nero_radio = {
     .encoder = &subghz_protocol_nero_radio_encoder,
 };
 
+const SubGhzProtocolDecoderWake subghz_protocol_nero_radio_wake = {
+    .timing = &subghz_protocol_nero_radio_const,
+    .level = true,
+    .te_long = false,
+    .te_count = 1,
+    .delta_count = 1,
+};
+
 void* subghz_protocol_encoder_nero_radio_alloc(SubGhzEnvironment* environment) {
     UNUSED(environment);
     SubGhzProtocolEncoderNeroRadio* instance = malloc(sizeof(SubGhzProtocolEncoderNeroRadio));
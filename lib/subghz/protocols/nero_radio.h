@@ -10,6 +10,7 @@ typedef struct SubGhzProtocolEncoderNeroRadio SubGhzProtocolEncoderNeroRadio;
 extern const SubGhzProtocolDecoder subghz_protocol_nero_radio_decoder;
 extern const SubGhzProtocolEncoder subghz_protocol_nero_radio_encoder;
 extern const SubGhzProtocol subghz_protocol_nero_radio;
+extern const SubGhzProtocolDecoderWake subghz_protocol_nero_radio_wake;
 
 /**
  * Allocate SubGhzProtocolEncoderNeroRadio.
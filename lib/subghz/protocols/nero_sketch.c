@@ -69,6 +69,14 @@ const SubGhzProtocol subghz_protocol_nero_sketch = {
     .encoder = &subghz_protocol_nero_sketch_encoder,
 };
 
+const SubGhzProtocolDecoderWake subghz_protocol_nero_sketch_wake = {
+    .timing = &subghz_protocol_nero_sketch_const,
+    .level = true,
+    .te_long = false,
+    .te_count = 1,
+    .delta_count = 1,
+};
+
 void* subghz_protocol_encoder_nero_sketch_alloc(SubGhzEnvironment* environment) {
     UNUSED(environment);
     SubGhzProtocolEncoderNeroSketch* instance = malloc(sizeof(SubGhzProtocolEncoderNeroSketch));
@@ -10,6 +10,7 @@ typedef struct SubGhzProtocolEncoderNeroSketch SubGhzProtocolEncoderNeroSketch;
 extern const SubGhzProtocolDecoder subghz_protocol_nero_sketch_decoder;
 extern const SubGhzProtocolEncoder subghz_protocol_nero_sketch_encoder;
 extern const SubGhzProtocol subghz_protocol_nero_sketch;
+extern const SubGhzProtocolDecoderWake subghz_protocol_nero_sketch_wake;
 
 /**
  * Allocate SubGhzProtocolEncoderNeroSketch.
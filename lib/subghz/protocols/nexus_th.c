@@ -364,3 +364,11 @@ const SubGhzProtocol ws_protocol_nexus_th = {
 
     .filter = SubGhzProtocolFilter_Weather,
 };
+
+const SubGhzProtocolDecoderWake ws_protocol_nexus_th_wake = {
+    .timing = &ws_protocol_nexus_th_const,
+    .level = false,
+    .te_long = false,
+    .te_count = 8,
+    .delta_count = 4,
+};
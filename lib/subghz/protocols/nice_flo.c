@@ -68,6 +68,14 @@ const SubGhzProtocol subghz_protocol_nice_flo = {
     .encoder = &subghz_protocol_nice_flo_encoder,
 };
 
+const SubGhzProtocolDecoderWake subghz_protocol_nice_flo_wake = {
+    .timing = &subghz_protocol_nice_flo_const,
+    .level = false,
+    .te_long = false,
+    .te_count = 36,
+    .delta_count = 36,
+};
+
 void* subghz_protocol_encoder_nice_flo_alloc(SubGhzEnvironment* environment) {
     UNUSED(environment);
     SubGhzProtocolEncoderNiceFlo* instance = malloc(sizeof(SubGhzProtocolEncoderNiceFlo));
@@ -10,6 +10,7 @@ typedef struct SubGhzProtocolEncoderNiceFlo SubGhzProtocolEncoderNiceFlo;
 extern const SubGhzProtocolDecoder subghz_protocol_nice_flo_decoder;
 extern const SubGhzProtocolEncoder subghz_protocol_nice_flo_encoder;
 extern const SubGhzProtocol subghz_protocol_nice_flo;
+extern const SubGhzProtocolDecoderWake subghz_protocol_nice_flo_wake;
 
 /**
  * Allocate SubGhzProtocolEncoderNiceFlo.
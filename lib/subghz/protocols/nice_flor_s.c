@@ -88,6 +88,14 @@ const SubGhzProtocol subghz_protocol_nice_flor_s = {
     .filter = SubGhzProtocolFilter_NiceFlorS,
 };
 
+const SubGhzProtocolDecoderWake subghz_protocol_nice_flor_s_wake = {
+    .timing = &subghz_protocol_nice_flor_s_const,
+    .level = false,
+    .te_long = false,
+    .te_count = 38,
+    .delta_count = 38,
+};
+
 static void subghz_protocol_nice_flor_s_remote_controller(
     SubGhzBlockGeneric* instance,
     const char* file_name);
@@ -10,6 +10,7 @@ typedef struct SubGhzProtocolEncoderNiceFlorS SubGhzProtocolEncoderNiceFlorS;
 extern const SubGhzProtocolDecoder subghz_protocol_nice_flor_s_decoder;
 extern const SubGhzProtocolEncoder subghz_protocol_nice_flor_s_encoder;
 extern const SubGhzProtocol subghz_protocol_nice_flor_s;
+extern const SubGhzProtocolDecoderWake subghz_protocol_nice_flor_s_wake;
 
 /**
  * Allocate SubGhzProtocolEncoderNiceFlorS.
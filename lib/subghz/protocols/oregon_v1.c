@@ -104,6 +104,14 @@ const SubGhzProtocol ws_protocol_oregon_v1 = {
     .filter = SubGhzProtocolFilter_Weather,
 };
 
+const SubGhzProtocolDecoderWake ws_protocol_oregon_v1_wake = {
+    .timing = &ws_protocol_oregon_v1_const,
+    .level = true,
+    .te_long = false,
+    .te_count = 1,
+    .delta_count = 1,
+};
+
 void* ws_protocol_decoder_oregon_v1_alloc(SubGhzEnvironment* environment) {
     UNUSED(environment);
     WSProtocolDecoderOregon_V1* instance = malloc(sizeof(WSProtocolDecoderOregon_V1));
@@ -16,6 +16,7 @@ typedef struct WSProtocolEncoderOregon_V1 WSProtocolEncoderOregon_V1;
 extern const SubGhzProtocolDecoder ws_protocol_oregon_v1_decoder;
 extern const SubGhzProtocolEncoder ws_protocol_oregon_v1_encoder;
 extern const SubGhzProtocol ws_protocol_oregon_v1;
+extern const SubGhzProtocolDecoderWake ws_protocol_oregon_v1_wake;
 
 /**
  * Allocate WSProtocolDecoderOregon_V1.
@@ -70,6 +70,14 @@ const SubGhzProtocol subghz_protocol_phoenix_v2 = {
     .encoder = &subghz_protocol_phoenix_v2_encoder,
 };
 
+const SubGhzProtocolDecoderWake subghz_protocol_phoenix_v2_wake = {
+    .timing = &subghz_protocol_phoenix_v2_const,
+    .level = false,
+    .te_long = false,
+    .te_count = 60,
+    .delta_count = 30,
+};
+
 void* subghz_protocol_encoder_phoenix_v2_alloc(SubGhzEnvironment* environment) {
     UNUSED(environment);
     SubGhzProtocolEncoderPhoenix_V2* instance = malloc(sizeof(SubGhzProtocolEncoderPhoenix_V2));
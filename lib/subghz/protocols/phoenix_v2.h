@@ -10,6 +10,7 @@ typedef struct SubGhzProtocolEncoderPhoenix_V2 SubGhzProtocolEncoderPhoenix_V2;
 extern const SubGhzProtocolDecoder subghz_protocol_phoenix_v2_decoder;
 extern const SubGhzProtocolEncoder subghz_protocol_phoenix_v2_encoder;
 extern const SubGhzProtocol subghz_protocol_phoenix_v2;
+extern const SubGhzProtocolDecoderWake subghz_protocol_phoenix_v2_wake;
 
 /**
  * Allocate SubGhzProtocolEncoderPhoenix_V2.
@@ -81,6 +81,14 @@ const SubGhzProtocol subghz_protocol_princeton = {
     .filter = SubGhzProtocolFilter_Princeton,
 };
 
+const SubGhzProtocolDecoderWake subghz_protocol_princeton_wake = {
+    .timing = &subghz_protocol_princeton_const,
+    .level = false,
+    .te_long = false,
+    .te_count = 36,
+    .delta_count = 36,
+};
+
 void* subghz_protocol_encoder_princeton_alloc(SubGhzEnvironment* environment) {
     UNUSED(environment);
     SubGhzProtocolEncoderPrinceton* instance = malloc(sizeof(SubGhzProtocolEncoderPrinceton));
@@ -14,6 +14,7 @@ typedef struct SubGhzProtocolEncoderPrinceton SubGhzProtocolEncoderPrinceton;
 extern const SubGhzProtocolDecoder subghz_protocol_princeton_decoder;
 extern const SubGhzProtocolEncoder subghz_protocol_princeton_encoder;
 extern const SubGhzProtocol subghz_protocol_princeton;
+extern const SubGhzProtocolDecoderWake subghz_protocol_princeton_wake;
 
 /**
  * Allocate SubGhzProtocolEncoderPrinceton.
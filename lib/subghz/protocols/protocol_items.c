@@ -68,3 +68,58 @@ const SubGhzProtocol* subghz_protocol_registry_items[] = {
 const SubGhzProtocolRegistry subghz_protocol_registry = {
     .items = subghz_protocol_registry_items,
     .size = COUNT_OF(subghz_protocol_registry_items)};
+
+const SubGhzProtocolDecoderWakeItem subghz_protocol_registry_wake_items[] = {
+    {.protocol = &subghz_protocol_gate_tx, .wake = &subghz_protocol_gate_tx_wake},
+    {.protocol = &subghz_protocol_keeloq, .wake = &subghz_protocol_keeloq_wake},
+    {.protocol = &subghz_protocol_nice_flo, .wake = &subghz_protocol_nice_flo_wake},
+    {.protocol = &subghz_protocol_came, .wake = &subghz_protocol_came_wake},
+    {.protocol = &subghz_protocol_faac_slh, .wake = &subghz_protocol_faac_slh_wake},
+    {.protocol = &subghz_protocol_nice_flor_s, .wake = &subghz_protocol_nice_flor_s_wake},
+    {.protocol = &subghz_protocol_nero_sketch, .wake = &subghz_protocol_nero_sketch_wake},
+    {.protocol = &subghz_protocol_ido, .wake = &subghz_protocol_ido_wake},
+    {.protocol = &subghz_protocol_kia, .wake = &subghz_protocol_kia_wake},
+    {.protocol = &subghz_protocol_hormann, .wake = &subghz_protocol_hormann_wake},
+    {.protocol = &subghz_protocol_nero_radio, .wake = &subghz_protocol_nero_radio_wake},
+    {.protocol = &subghz_protocol_somfy_telis, .wake = &subghz_protocol_somfy_telis_wake},
+    {.protocol = &subghz_protocol_somfy_keytis, .wake = &subghz_protocol_somfy_keytis_wake},
+    {.protocol = &subghz_protocol_scher_khan, .wake = &subghz_protocol_scher_khan_wake},
+    {.protocol = &subghz_protocol_princeton, .wake = &subghz_protocol_princeton_wake},
+    {.protocol = &subghz_protocol_linear, .wake = &subghz_protocol_linear_wake},
+    {.protocol = &subghz_protocol_secplus_v1, .wake = &subghz_protocol_secplus_v1_wake},
+    {.protocol = &subghz_protocol_megacode, .wake = &subghz_protocol_megacode_wake},
+    {.protocol = &subghz_protocol_holtek, .wake = &subghz_protocol_holtek_wake},
+    {.protocol = &subghz_protocol_chamb_code, .wake = &subghz_protocol_chamb_code_wake},
+    {.protocol = &subghz_protocol_bett, .wake = &subghz_protocol_bett_wake},
+    {.protocol = &subghz_protocol_doitrand, .wake = &subghz_protocol_doitrand_wake},
+    {.protocol = &subghz_protocol_phoenix_v2, .wake = &subghz_protocol_phoenix_v2_wake},
+    {.protocol = &subghz_protocol_honeywell_wdb, .wake = &subghz_protocol_honeywell_wdb_wake},
+    {.protocol = &subghz_protocol_magellan, .wake = &subghz_protocol_magellan_wake},
+    {.protocol = &subghz_protocol_intertechno_v3, .wake = &subghz_protocol_intertechno_v3_wake},
+    {.protocol = &subghz_protocol_clemsa, .wake = &subghz_protocol_clemsa_wake},
+    {.protocol = &subghz_protocol_ansonic, .wake = &subghz_protocol_ansonic_wake},
+    {.protocol = &subghz_protocol_smc5326, .wake = &subghz_protocol_smc5326_wake},
+    {.protocol = &subghz_protocol_holtek_th12x, .wake = &subghz_protocol_holtek_th12x_wake},
+    {.protocol = &subghz_protocol_linear_delta3, .wake = &subghz_protocol_linear_delta3_wake},
+    {.protocol = &subghz_protocol_dooya, .wake = &subghz_protocol_dooya_wake},
+    {.protocol = &subghz_protocol_alutech_at_4n, .wake = &subghz_protocol_alutech_at_4n_wake},
+    {.protocol = &subghz_protocol_kinggates_stylo_4k,
+     .wake = &subghz_protocol_kinggates_stylo_4k_wake},
+    {.protocol = &ws_protocol_infactory, .wake = &ws_protocol_infactory_wake},
+    {.protocol = &ws_protocol_thermopro_tx4, .wake = &ws_protocol_thermopro_tx4_wake},
+    {.protocol = &ws_protocol_nexus_th, .wake = &ws_protocol_nexus_th_wake},
+    {.protocol = &ws_protocol_gt_wt_02, .wake = &ws_protocol_gt_wt_02_wake},
+    {.protocol = &ws_protocol_gt_wt_03, .wake = &ws_protocol_gt_wt_03_wake},
+    {.protocol = &ws_protocol_acurite_606tx, .wake = &ws_protocol_acurite_606tx_wake},
+    {.protocol = &ws_protocol_acurite_609txc, .wake = &ws_protocol_acurite_609txc_wake},
+    {.protocol = &ws_protocol_lacrosse_tx141thbv2, .wake = &ws_protocol_lacrosse_tx141thbv2_wake},
+    {.protocol = &ws_protocol_acurite_592txr, .wake = &ws_protocol_acurite_592txr_wake},
+    {.protocol = &ws_protocol_auriol_th, .wake = &ws_protocol_auriol_th_wake},
+    {.protocol = &ws_protocol_oregon_v1, .wake = &ws_protocol_oregon_v1_wake},
+    {.protocol = &ws_protocol_tx_8300, .wake = &ws_protocol_tx_8300_wake},
+    {.protocol = &ws_protocol_wendox_w6726, .wake = &ws_protocol_wendox_w6726_wake},
+    {.protocol = &ws_protocol_auriol_ahfl, .wake = &ws_protocol_auriol_ahfl_wake},
+};
+
+const size_t subghz_protocol_registry_wake_items_count =
+    COUNT_OF(subghz_protocol_registry_wake_items);
@@ -64,3 +64,12 @@
 #include "pocsag.h"
 #include "schrader_gg4.h"
 #include "bin_raw.h"
+
+typedef struct {
+    const SubGhzProtocol* protocol;
+    const SubGhzProtocolDecoderWake* wake;
+} SubGhzProtocolDecoderWakeItem;
+
+/** Wake-up conditions of registry decoders, used by receiver to skip idle decoders */
+extern const SubGhzProtocolDecoderWakeItem subghz_protocol_registry_wake_items[];
+extern const size_t subghz_protocol_registry_wake_items_count;
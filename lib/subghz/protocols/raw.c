@@ -1,6 +1,7 @@
 #include "raw.h"
 #include <lib/flipper_format/flipper_format.h>
 #include "../subghz_file_encoder_worker.h"
+#include "../subghz_raw_binary.h"
 
 #include "../blocks/const.h"
 #include "../blocks/decoder.h"
@@ -33,6 +34,8 @@ struct SubGhzProtocolDecoderRAW {
     size_t sample_write;
     bool last_level;
     bool pause;
+    bool binary;
+    SubGhzRawBinaryWriter* binary_writer;
 };
 
 struct SubGhzProtocolEncoderRAW {
@@ -158,6 +161,11 @@ bool subghz_protocol_raw_save_to_file_init(
             break;
         }
 
+        if(instance->binary) {
+            instance->binary_writer = subghz_raw_binary_writer_alloc(instance->flipper_file);
+            if(!instance->binary_writer) break;
+        }
+
         instance->upload_raw = malloc(SUBGHZ_DOWNLOAD_MAX_SIZE * sizeof(int32_t));
         instance->file_is_open = RAWFileIsOpenWrite;
         instance->sample_write = 0;
@@ -176,8 +184,15 @@ static bool subghz_protocol_raw_save_to_file_write(SubGhzProtocolDecoderRAW* ins
 
     bool is_write = false;
     if(instance->file_is_open == RAWFileIsOpenWrite) {
-        if(!flipper_format_write_int32(
-               instance->flipper_file, "RAW_Data", instance->upload_raw, instance->ind_write)) {
+        bool written = false;
+        if(instance->binary_writer) {
+            written = subghz_raw_binary_writer_write(
+                instance->binary_writer, instance->upload_raw, instance->ind_write);
+        } else {
+            written = flipper_format_write_int32(
+                instance->flipper_file, "RAW_Data", instance->upload_raw, instance->ind_write);
+        }
+        if(!written) {
             FURI_LOG_E(TAG, "Unable to add RAW_Data");
         } else {
             instance->sample_write += instance->ind_write;
@@ -193,6 +208,11 @@ void subghz_protocol_raw_save_to_file_stop(SubGhzProtocolDecoderRAW* instance) {
 
     if(instance->file_is_open == RAWFileIsOpenWrite && instance->ind_write)
         subghz_protocol_raw_save_to_file_write(instance);
+    if(instance->binary_writer) {
+        subghz_raw_binary_writer_finish(instance->binary_writer);
+        subghz_raw_binary_writer_free(instance->binary_writer);
+        instance->binary_writer = NULL;
+    }
     if(instance->file_is_open != RAWFileIsOpenClose) {
         free(instance->upload_raw);
         instance->upload_raw = NULL;
@@ -212,6 +232,11 @@ void subghz_protocol_raw_save_to_file_pause(SubGhzProtocolDecoderRAW* instance,
     }
 }
 
+void subghz_protocol_raw_save_to_file_set_binary(SubGhzProtocolDecoderRAW* instance, bool binary) {
+    furi_assert(instance);
+    instance->binary = binary;
+}
+
 size_t subghz_protocol_raw_get_sample_write(SubGhzProtocolDecoderRAW* instance) {
     return instance->sample_write + instance->ind_write;
 }
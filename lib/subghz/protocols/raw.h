@@ -35,6 +35,14 @@ bool subghz_protocol_raw_save_to_file_init(
  */
 void subghz_protocol_raw_save_to_file_stop(SubGhzProtocolDecoderRAW* instance);
 
+/**
+ * Write samples as binary container instead of text "RAW_Data" lines.
+ * Takes effect on the next subghz_protocol_raw_save_to_file_init.
+ * @param instance Pointer to a SubGhzProtocolDecoderRAW instance
+ * @param binary true - binary container, false - text
+ */
+void subghz_protocol_raw_save_to_file_set_binary(SubGhzProtocolDecoderRAW* instance, bool binary);
+
 /**
  * Get the number of samples received SubGhzProtocolDecoderRAW.
  * @param instance Pointer to a SubGhzProtocolDecoderRAW instance
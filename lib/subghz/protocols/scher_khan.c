@@ -78,6 +78,14 @@ const SubGhzProtocol subghz_protocol_scher_khan = {
     .filter = SubGhzProtocolFilter_AutoAlarms,
 };
 
+const SubGhzProtocolDecoderWake subghz_protocol_scher_khan_wake = {
+    .timing = &subghz_protocol_scher_khan_const,
+    .level = true,
+    .te_long = false,
+    .te_count = 2,
+    .delta_count = 1,
+};
+
 void* subghz_protocol_decoder_scher_khan_alloc(SubGhzEnvironment* environment) {
     UNUSED(environment);
     SubGhzProtocolDecoderScherKhan* instance = malloc(sizeof(SubGhzProtocolDecoderScherKhan));
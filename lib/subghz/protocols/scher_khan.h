@@ -10,6 +10,7 @@ typedef struct SubGhzProtocolEncoderScherKhan SubGhzProtocolEncoderScherKhan;
 extern const SubGhzProtocolDecoder subghz_protocol_scher_khan_decoder;
 extern const SubGhzProtocolEncoder subghz_protocol_scher_khan_encoder;
 extern const SubGhzProtocol subghz_protocol_scher_khan;
+extern const SubGhzProtocolDecoderWake subghz_protocol_scher_khan_wake;
 
 /**
  * Allocate SubGhzProtocolDecoderScherKhan.
@@ -91,6 +91,14 @@ const SubGhzProtocol subghz_protocol_secplus_v1 = {
     .encoder = &subghz_protocol_secplus_v1_encoder,
 };
 
+const SubGhzProtocolDecoderWake subghz_protocol_secplus_v1_wake = {
+    .timing = &subghz_protocol_secplus_v1_const,
+    .level = false,
+    .te_long = false,
+    .te_count = 120,
+    .delta_count = 120,
+};
+
 void* subghz_protocol_encoder_secplus_v1_alloc(SubGhzEnvironment* environment) {
     UNUSED(environment);
     SubGhzProtocolEncoderSecPlus_v1* instance = malloc(sizeof(SubGhzProtocolEncoderSecPlus_v1));
@@ -9,6 +9,7 @@ typedef struct SubGhzProtocolEncoderSecPlus_v1 SubGhzProtocolEncoderSecPlus_v1;
 extern const SubGhzProtocolDecoder subghz_protocol_secplus_v1_decoder;
 extern const SubGhzProtocolEncoder subghz_protocol_secplus_v1_encoder;
 extern const SubGhzProtocol subghz_protocol_secplus_v1;
+extern const SubGhzProtocolDecoderWake subghz_protocol_secplus_v1_wake;
 
 /**
  * Allocate SubGhzProtocolEncoderSecPlus_v1.
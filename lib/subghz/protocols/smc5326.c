@@ -94,6 +94,14 @@ const SubGhzProtocol subghz_protocol_smc5326 = {
     .encoder = &subghz_protocol_smc5326_encoder,
 };
 
+const SubGhzProtocolDecoderWake subghz_protocol_smc5326_wake = {
+    .timing = &subghz_protocol_smc5326_const,
+    .level = false,
+    .te_long = false,
+    .te_count = 24,
+    .delta_count = 12,
+};
+
 void* subghz_protocol_encoder_smc5326_alloc(SubGhzEnvironment* environment) {
     UNUSED(environment);
     SubGhzProtocolEncoderSMC5326* instance = malloc(sizeof(SubGhzProtocolEncoderSMC5326));
@@ -10,6 +10,7 @@ typedef struct SubGhzProtocolEncoderSMC5326 SubGhzProtocolEncoderSMC5326;
 extern const SubGhzProtocolDecoder subghz_protocol_smc5326_decoder;
 extern const SubGhzProtocolEncoder subghz_protocol_smc5326_encoder;
 extern const SubGhzProtocol subghz_protocol_smc5326;
+extern const SubGhzProtocolDecoderWake subghz_protocol_smc5326_wake;
 
 /**
  * Allocate SubGhzProtocolEncoderSMC5326.
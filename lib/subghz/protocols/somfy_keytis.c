@@ -65,6 +65,14 @@ const SubGhzProtocol subghz_protocol_somfy_keytis = {
     .encoder = &subghz_protocol_somfy_keytis_encoder,
 };
 
+const SubGhzProtocolDecoderWake subghz_protocol_somfy_keytis_wake = {
+    .timing = &subghz_protocol_somfy_keytis_const,
+    .level = true,
+    .te_long = false,
+    .te_count = 4,
+    .delta_count = 4,
+};
+
 const SubGhzProtocolEncoder subghz_protocol_somfy_keytis_encoder = {
     .alloc = subghz_protocol_encoder_somfy_keytis_alloc,
     .free = subghz_protocol_encoder_somfy_keytis_free,
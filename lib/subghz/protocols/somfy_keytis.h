@@ -10,6 +10,7 @@ typedef struct SubGhzProtocolEncoderSomfyKeytis SubGhzProtocolEncoderSomfyKeytis
 extern const SubGhzProtocolDecoder subghz_protocol_somfy_keytis_decoder;
 extern const SubGhzProtocolEncoder subghz_protocol_somfy_keytis_encoder;
 extern const SubGhzProtocol subghz_protocol_somfy_keytis;
+extern const SubGhzProtocolDecoderWake subghz_protocol_somfy_keytis_wake;
 
 /**
  * Allocate SubGhzProtocolEncoderSomfyKeytis.
@@ -75,6 +75,14 @@ const SubGhzProtocol subghz_protocol_somfy_telis = {
     .encoder = &subghz_protocol_somfy_telis_encoder,
 };
 
+const SubGhzProtocolDecoderWake subghz_protocol_somfy_telis_wake = {
+    .timing = &subghz_protocol_somfy_telis_const,
+    .level = true,
+    .te_long = false,
+    .te_count = 4,
+    .delta_count = 4,
+};
+
 void* subghz_protocol_encoder_somfy_telis_alloc(SubGhzEnvironment* environment) {
     UNUSED(environment);
     SubGhzProtocolEncoderSomfyTelis* instance = malloc(sizeof(SubGhzProtocolEncoderSomfyTelis));
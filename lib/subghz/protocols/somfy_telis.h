@@ -10,6 +10,7 @@ typedef struct SubGhzProtocolEncoderSomfyTelis SubGhzProtocolEncoderSomfyTelis;
 extern const SubGhzProtocolDecoder subghz_protocol_somfy_telis_decoder;
 extern const SubGhzProtocolEncoder subghz_protocol_somfy_telis_encoder;
 extern const SubGhzProtocol subghz_protocol_somfy_telis;
+extern const SubGhzProtocolDecoderWake subghz_protocol_somfy_telis_wake;
 
 /**
  * Allocate SubGhzProtocolEncoderSomfyTelis.
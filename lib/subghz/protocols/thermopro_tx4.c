@@ -88,6 +88,14 @@ const SubGhzProtocol ws_protocol_thermopro_tx4 = {
     .filter = SubGhzProtocolFilter_Weather,
 };
 
+const SubGhzProtocolDecoderWake ws_protocol_thermopro_tx4_wake = {
+    .timing = &ws_protocol_thermopro_tx4_const,
+    .level = false,
+    .te_long = false,
+    .te_count = 18,
+    .delta_count = 10,
+};
+
 void* ws_protocol_decoder_thermopro_tx4_alloc(SubGhzEnvironment* environment) {
     UNUSED(environment);
     WSProtocolDecoderThermoPRO_TX4* instance = malloc(sizeof(WSProtocolDecoderThermoPRO_TX4));
@@ -99,6 +99,14 @@ const SubGhzProtocol ws_protocol_tx_8300 = {
     .filter = SubGhzProtocolFilter_Weather,
 };
 
+const SubGhzProtocolDecoderWake ws_protocol_tx_8300_wake = {
+    .timing = &ws_protocol_tx_8300_const,
+    .level = true,
+    .te_long = false,
+    .te_count = 2,
+    .delta_count = 1,
+};
+
 void* ws_protocol_decoder_tx_8300_alloc(SubGhzEnvironment* environment) {
     UNUSED(environment);
     WSProtocolDecoderTX_8300* instance = malloc(sizeof(WSProtocolDecoderTX_8300));
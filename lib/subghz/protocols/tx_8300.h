@@ -16,6 +16,7 @@ typedef struct WSProtocolEncoderTX_8300 WSProtocolEncoderTX_8300;
 extern const SubGhzProtocolDecoder ws_protocol_tx_8300_decoder;
 extern const SubGhzProtocolEncoder ws_protocol_tx_8300_encoder;
 extern const SubGhzProtocol ws_protocol_tx_8300;
+extern const SubGhzProtocolDecoderWake ws_protocol_tx_8300_wake;
 
 /**
  * Allocate WSProtocolDecoderTX_8300.
@@ -93,6 +93,14 @@ const SubGhzProtocol ws_protocol_wendox_w6726 = {
     .filter = SubGhzProtocolFilter_Weather,
 };
 
+const SubGhzProtocolDecoderWake ws_protocol_wendox_w6726_wake = {
+    .timing = &ws_protocol_wendox_w6726_const,
+    .level = true,
+    .te_long = false,
+    .te_count = 1,
+    .delta_count = 1,
+};
+
 void* ws_protocol_decoder_wendox_w6726_alloc(SubGhzEnvironment* environment) {
     UNUSED(environment);
     WSProtocolDecoderWendoxW6726* instance = malloc(sizeof(WSProtocolDecoderWendoxW6726));
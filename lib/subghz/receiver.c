@@ -2,24 +2,55 @@
 
 #include "registry.h"
 #include "protocols/protocol_items.h"
+#include "blocks/decoder.h"
+#include "blocks/math.h"
 
 #include <m-array.h>
 
 typedef struct {
     SubGhzProtocolEncoderBase* base;
+    // Pre-filter, NULL block means decoder is fed with every pulse
+    const SubGhzBlockDecoder* block;
+    uint32_t wake_duration;
+    uint32_t wake_delta;
+    bool wake_level;
 } SubGhzReceiverSlot;
 
+// Common head of decoder instances that declare wake-up condition
+typedef struct {
+    SubGhzProtocolDecoderBase base;
+    SubGhzBlockDecoder decoder;
+} SubGhzReceiverDecoderHead;
+
 ARRAY_DEF(SubGhzReceiverSlotArray, SubGhzReceiverSlot, M_POD_OPLIST);
 #define M_OPL_SubGhzReceiverSlotArray_t() ARRAY_OPLIST(SubGhzReceiverSlotArray, M_POD_OPLIST)
 
 struct SubGhzReceiver {
     SubGhzReceiverSlotArray_t slots;
     SubGhzProtocolFlag filter;
+    bool prefilter;
 
     SubGhzReceiverCallback callback;
     void* context;
 };
 
+static void subghz_receiver_slot_set_wake(SubGhzReceiverSlot* slot) {
+    slot->block = NULL;
+
+    const SubGhzProtocol* protocol = slot->base->protocol;
+    for(size_t i = 0; i < subghz_protocol_registry_wake_items_count; i++) {
+        if(subghz_protocol_registry_wake_items[i].protocol != protocol) continue;
+
+        const SubGhzProtocolDecoderWake* wake = subghz_protocol_registry_wake_items[i].wake;
+        uint32_t te = wake->te_long ? wake->timing->te_long : wake->timing->te_short;
+        slot->wake_duration = te * wake->te_count;
+        slot->wake_delta = (uint32_t)wake->timing->te_delta * wake->delta_count;
+        slot->wake_level = wake->level;
+        slot->block = &((SubGhzReceiverDecoderHead*)slot->base)->decoder;
+        break;
+    }
+}
+
 SubGhzReceiver* subghz_receiver_alloc_init(SubGhzEnvironment* environment) {
     SubGhzReceiver* instance = malloc(sizeof(SubGhzReceiver));
     SubGhzReceiverSlotArray_init(instance->slots);
@@ -33,9 +64,11 @@ SubGhzReceiver* subghz_receiver_alloc_init(SubGhzEnvironment* environment) {
         if(protocol->decoder && protocol->decoder->alloc) {
             SubGhzReceiverSlot* slot = SubGhzReceiverSlotArray_push_new(instance->slots);
             slot->base = protocol->decoder->alloc(environment);
+            subghz_receiver_slot_set_wake(slot);
         }
     }
 
+    instance->prefilter = true;
     instance->callback = NULL;
     instance->context = NULL;
     return instance;
@@ -64,9 +97,17 @@ void subghz_receiver_decode(SubGhzReceiver* instance, bool level, uint32_t durat
 
     for
         M_EACH(slot, instance->slots, SubGhzReceiverSlotArray_t) {
-            if((slot->base->protocol->flag & instance->filter) != 0) {
-                slot->base->protocol->decoder->feed(slot->base, level, duration);
+            if((slot->base->protocol->flag & instance->filter) == 0) continue;
+
+            // Skip decoders waiting for a header this pulse can't be
+            if(instance->prefilter && slot->block && slot->block->parser_step == 0) {
+                if(level != slot->wake_level ||
+                   DURATION_DIFF(duration, slot->wake_duration) >= slot->wake_delta) {
+                    continue;
+                }
             }
+
+            slot->base->protocol->decoder->feed(slot->base, level, duration);
         }
 }
 
@@ -108,6 +149,11 @@ void subghz_receiver_set_filter(SubGhzReceiver* instance, SubGhzProtocolFlag fil
     instance->filter = filter;
 }
 
+void subghz_receiver_set_prefilter(SubGhzReceiver* instance, bool enable) {
+    furi_assert(instance);
+    instance->prefilter = enable;
+}
+
 SubGhzProtocolDecoderBase* subghz_receiver_search_decoder_base_by_name(
     SubGhzReceiver* instance,
     const char* decoder_name) {
@@ -59,6 +59,15 @@ void subghz_receiver_set_rx_callback(
  */
 void subghz_receiver_set_filter(SubGhzReceiver* instance, SubGhzProtocolFlag filter);
 
+/**
+ * Enable or disable timing pre-filter. When enabled, decoders waiting for a header
+ * are fed only with pulses matching their wake-up condition. Decode results are
+ * the same in both modes, pre-filter is enabled by default.
+ * @param instance Pointer to a SubGhzReceiver instance
+ * @param enable true to skip idle decoders
+ */
+void subghz_receiver_set_prefilter(SubGhzReceiver* instance, bool enable);
+
 /**
  * Search for a cattery by his name.
  * @param instance Pointer to a SubGhzReceiver instance
@@ -4,6 +4,7 @@
 #include <flipper_format/flipper_format.h>
 #include <flipper_format/flipper_format_i.h>
 #include <lib/subghz/devices/devices.h>
+#include "subghz_raw_binary.h"
 
 #define TAG "SubGhzFileEncoderWorker"
 
@@ -15,6 +16,8 @@ struct SubGhzFileEncoderWorker {
 
     Storage* storage;
     FlipperFormat* flipper_format;
+    SubGhzRawBinaryReader* reader;
+    int32_t* samples;
 
     volatile bool worker_running;
     volatile bool worker_stopping;
@@ -56,41 +59,27 @@ void subghz_file_encoder_worker_add_level_duration(
     }
 }
 
-bool subghz_file_encoder_worker_data_parse(SubGhzFileEncoderWorker* instance, const char* strStart) {
-    char* str1;
-    int32_t temp_ds = 0;
-    bool res = false;
-    // Line sample: "RAW_Data: -1, 2, -2..."
-
-    // Look for a key in the line
-    str1 = strstr(strStart, "RAW_Data: ");
-
-    if(str1 != NULL) {
-        // Skip key
-        str1 = strchr(str1, ' ');
-
-        // Check that there is still an element in the line
-        while(strchr(str1, ' ') != NULL) {
-            str1 = strchr(str1, ' ');
-
-            // Skip space
-            str1 += 1;
-            //
-            temp_ds = atoi(str1);
-            if((temp_ds < -1000000) || (temp_ds > 1000000)) {
-                if(temp_ds > 0) {
-                    subghz_file_encoder_worker_add_level_duration(instance, (int32_t)100);
-                } else {
-                    subghz_file_encoder_worker_add_level_duration(instance, (int32_t)-100);
-                }
-                //FURI_LOG_I("PARSE", "Number overflow - %d", atoi(str1));
-            } else {
-                subghz_file_encoder_worker_add_level_duration(instance, temp_ds);
-            }
+static void subghz_file_encoder_worker_add_samples(
+    SubGhzFileEncoderWorker* instance,
+    int32_t* samples,
+    size_t count) {
+    // Samples are checked in place and sent at once
+    size_t valid = 0;
+    for(size_t i = 0; i < count; i++) {
+        int32_t duration = samples[i];
+        if((duration < -1000000) || (duration > 1000000)) {
+            duration = (duration > 0) ? 100 : -100;
         }
-        res = true;
+        if((duration < 0 && !instance->level) || (duration > 0 && instance->level)) {
+            FURI_LOG_E(TAG, "Invalid level in the stream");
+            continue;
+        }
+        instance->level = !instance->level;
+        samples[valid++] = duration;
+    }
+    if(valid) {
+        furi_stream_buffer_send(instance->stream, samples, valid * sizeof(int32_t), 100);
     }
-    return res;
 }
 
 void subghz_file_encoder_worker_get_text_progress(
@@ -138,7 +127,6 @@ static int32_t subghz_file_encoder_worker_thread(void* context) {
     FURI_LOG_I(TAG, "Worker start");
     bool res = false;
     instance->is_storage_slow = false;
-    Stream* stream = flipper_format_get_raw_stream(instance->flipper_format);
     do {
         if(!flipper_format_file_open_existing(
                instance->flipper_format, furi_string_get_cstr(instance->file_path))) {
@@ -153,8 +141,10 @@ static int32_t subghz_file_encoder_worker_thread(void* context) {
             break;
         }
 
-        //skip the end of the previous line "\n"
-        stream_seek(stream, 1, StreamOffsetFromCurrent);
+        if(!subghz_raw_binary_reader_start(instance->reader, instance->flipper_format)) {
+            FURI_LOG_E(TAG, "Unsupported RAW data");
+            break;
+        }
         res = true;
         instance->worker_stopping = false;
         FURI_LOG_I(TAG, "Start transmission");
@@ -163,13 +153,10 @@ static int32_t subghz_file_encoder_worker_thread(void* context) {
     while(res && instance->worker_running) {
         size_t stream_free_byte = furi_stream_buffer_spaces_available(instance->stream);
         if((stream_free_byte / sizeof(int32_t)) >= SUBGHZ_FILE_ENCODER_LOAD) {
-            if(stream_read_line(stream, instance->str_data)) {
-                furi_string_trim(instance->str_data);
-                if(!subghz_file_encoder_worker_data_parse(
-                       instance, furi_string_get_cstr(instance->str_data))) {
-                    subghz_file_encoder_worker_add_level_duration(instance, LEVEL_DURATION_RESET);
-                    break;
-                }
+            size_t count = subghz_raw_binary_reader_read(
+                instance->reader, instance->samples, SUBGHZ_FILE_ENCODER_LOAD);
+            if(count) {
+                subghz_file_encoder_worker_add_samples(instance, instance->samples, count);
             } else {
                 subghz_file_encoder_worker_add_level_duration(instance, LEVEL_DURATION_RESET);
                 break;
@@ -211,6 +198,8 @@ SubGhzFileEncoderWorker* subghz_file_encoder_worker_alloc() {
 
     instance->storage = furi_record_open(RECORD_STORAGE);
     instance->flipper_format = flipper_format_file_alloc(instance->storage);
+    instance->reader = subghz_raw_binary_reader_alloc();
+    instance->samples = malloc(sizeof(int32_t) * SUBGHZ_FILE_ENCODER_LOAD);
 
     instance->str_data = furi_string_alloc();
     instance->file_path = furi_string_alloc();
@@ -229,6 +218,8 @@ void subghz_file_encoder_worker_free(SubGhzFileEncoderWorker* instance) {
     furi_string_free(instance->str_data);
     furi_string_free(instance->file_path);
 
+    subghz_raw_binary_reader_free(instance->reader);
+    free(instance->samples);
     flipper_format_free(instance->flipper_format);
     furi_record_close(RECORD_STORAGE);
 
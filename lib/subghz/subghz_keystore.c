@@ -10,6 +10,8 @@
 #include <flipper_format/flipper_format.h>
 #include <flipper_format/flipper_format_i.h>
 
+#include "protocols/keeloq_common.h"
+
 #define TAG "SubGhzKeystore"
 
 #define FILE_BUFFER_SIZE 64
@@ -31,6 +33,7 @@ SubGhzKeystore* subghz_keystore_alloc() {
     SubGhzKeystore* instance = malloc(sizeof(SubGhzKeystore));
 
     SubGhzKeyArray_init(instance->data);
+    instance->index = NULL;
 
     subghz_keystore_reset_kl(instance);
 
@@ -44,9 +47,27 @@ void subghz_keystore_reset_kl(SubGhzKeystore* instance) {
     instance->kl_type = 0;
 }
 
+static void subghz_keystore_index_free(SubGhzKeystore* instance) {
+    SubGhzKeystoreIndex* index = instance->index;
+    if(!index) return;
+
+    free(index->mf_names);
+    free(index->mf_keys_offset);
+    free(index->mf_keys);
+    free(index->key_mf);
+    free(index->learning_slot);
+    free(index->learning_cache);
+    free(index->learning_cache_valid);
+    free(index);
+
+    instance->index = NULL;
+}
+
 void subghz_keystore_free(SubGhzKeystore* instance) {
     furi_assert(instance);
 
+    subghz_keystore_index_free(instance);
+
     for
         M_EACH(manufacture_code, instance->data, SubGhzKeyArray_t) {
             furi_string_free(manufacture_code->name);
@@ -62,6 +83,9 @@ static void subghz_keystore_add_key(
     const char* name,
     uint64_t key,
     uint16_t type) {
+    // Keys changed, index will be rebuilt on next lookup
+    subghz_keystore_index_free(instance);
+
     SubGhzKey* manufacture_code = SubGhzKeyArray_push_raw(instance->data);
     manufacture_code->name = furi_string_alloc_set(name);
     manufacture_code->key = key;
@@ -349,6 +373,151 @@ SubGhzKeyArray_t* subghz_keystore_get_data(SubGhzKeystore* instance) {
     return &instance->data;
 }
 
+typedef struct {
+    const char* name;
+    uint32_t position;
+} SubGhzKeystoreIndexSortItem;
+
+static int subghz_keystore_index_sort_cmp(const void* a, const void* b) {
+    const SubGhzKeystoreIndexSortItem* item_a = a;
+    const SubGhzKeystoreIndexSortItem* item_b = b;
+    int ret = strcmp(item_a->name, item_b->name);
+    if(ret == 0) {
+        // Keep load order inside of manufacture, first match wins in decoders
+        ret = (item_a->position > item_b->position) - (item_a->position < item_b->position);
+    }
+    return ret;
+}
+
+static uint8_t subghz_keystore_index_learning_slots(uint16_t type) {
+    switch(type) {
+    case KEELOQ_LEARNING_NORMAL:
+        return 1;
+    case KEELOQ_LEARNING_UNKNOWN:
+        // Normal learning with direct and mirrored man
+        return 2;
+    default:
+        return 0;
+    }
+}
+
+static void subghz_keystore_index_build(SubGhzKeystore* instance, SubGhzKeystoreIndex* index) {
+    size_t keys_count = index->keys_count;
+
+    // Intern manufacture names: sort key positions by name
+    SubGhzKeystoreIndexSortItem* sorted = malloc(sizeof(SubGhzKeystoreIndexSortItem) * keys_count);
+    index->learning_slot = malloc(sizeof(uint16_t) * keys_count);
+    size_t slots = 0;
+    for(size_t i = 0; i < keys_count; i++) {
+        const SubGhzKey* key = SubGhzKeyArray_cget(instance->data, i);
+        sorted[i].name = furi_string_get_cstr(key->name);
+        sorted[i].position = i;
+
+        uint8_t key_slots = subghz_keystore_index_learning_slots(key->type);
+        if(key_slots && (slots + key_slots < SUBGHZ_KEYSTORE_INDEX_SLOT_NONE)) {
+            index->learning_slot[i] = slots;
+            slots += key_slots;
+        } else {
+            index->learning_slot[i] = SUBGHZ_KEYSTORE_INDEX_SLOT_NONE;
+        }
+    }
+    qsort(sorted, keys_count, sizeof(SubGhzKeystoreIndexSortItem), subghz_keystore_index_sort_cmp);
+
+    size_t mf_count = 0;
+    for(size_t i = 0; i < keys_count; i++) {
+        if(i == 0 || strcmp(sorted[i - 1].name, sorted[i].name) != 0) mf_count++;
+    }
+    furi_check(mf_count < SUBGHZ_KEYSTORE_INDEX_MF_NONE);
+
+    index->mf_count = mf_count;
+    index->mf_names = malloc(sizeof(const char*) * mf_count);
+    index->mf_keys_offset = malloc(sizeof(uint32_t) * (mf_count + 1));
+    index->mf_keys = malloc(sizeof(uint32_t) * keys_count);
+    index->key_mf = malloc(sizeof(uint16_t) * keys_count);
+
+    size_t mf_id = 0;
+    for(size_t i = 0; i < keys_count; i++) {
+        if(i == 0 || strcmp(sorted[i - 1].name, sorted[i].name) != 0) {
+            index->mf_names[mf_id] = sorted[i].name;
+            index->mf_keys_offset[mf_id] = i;
+            mf_id++;
+        }
+        index->mf_keys[i] = sorted[i].position;
+        index->key_mf[sorted[i].position] = mf_id - 1;
+    }
+    index->mf_keys_offset[mf_count] = keys_count;
+    free(sorted);
+
+    index->learning_cache_size = slots;
+    if(slots) {
+        index->learning_cache = malloc(sizeof(uint64_t) * slots);
+        index->learning_cache_valid = malloc(sizeof(uint32_t) * ((slots + 31) / 32));
+    }
+
+    FURI_LOG_D(
+        TAG, "Index: %zu keys, %zu manufactures, %zu cache slots", keys_count, mf_count, slots);
+}
+
+SubGhzKeystoreIndex* subghz_keystore_get_index(SubGhzKeystore* instance) {
+    furi_assert(instance);
+
+    if(instance->index) return instance->index;
+
+    size_t keys_count = SubGhzKeyArray_size(instance->data);
+    SubGhzKeystoreIndex* index = malloc(sizeof(SubGhzKeystoreIndex));
+    index->keys_count = keys_count;
+
+    // Never matches a 28bit serial, so first lookup wipes the cache
+    index->learning_cache_serial = UINT32_MAX;
+
+    if(keys_count) {
+        subghz_keystore_index_build(instance, index);
+    } else {
+        // Empty keystore: single terminating offset
+        index->mf_keys_offset = malloc(sizeof(uint32_t));
+    }
+
+    instance->index = index;
+
+    return index;
+}
+
+uint16_t subghz_keystore_index_find_mf(SubGhzKeystoreIndex* index, const char* name) {
+    furi_assert(index);
+    furi_assert(name);
+
+    size_t low = 0;
+    size_t high = index->mf_count;
+    while(low < high) {
+        size_t mid = (low + high) / 2;
+        int ret = strcmp(index->mf_names[mid], name);
+        if(ret == 0) {
+            return mid;
+        } else if(ret < 0) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+
+    return SUBGHZ_KEYSTORE_INDEX_MF_NONE;
+}
+
+void subghz_keystore_index_set_serial(SubGhzKeystoreIndex* index, uint32_t serial) {
+    furi_assert(index);
+
+    // Cache is filled lazily, as decoders usually need only one manufacture
+    serial &= 0x0FFFFFFF;
+    if(index->learning_cache_serial != serial) {
+        index->learning_cache_serial = serial;
+        if(!index->learning_cache_size) return;
+        memset(
+            index->learning_cache_valid,
+            0,
+            sizeof(uint32_t) * ((index->learning_cache_size + 31) / 32));
+    }
+}
+
 bool subghz_keystore_raw_encrypted_save(
     const char* input_file_name,
     const char* output_file_name,
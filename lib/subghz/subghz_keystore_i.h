@@ -2,8 +2,59 @@
 
 #include <m-array.h>
 
+#define SUBGHZ_KEYSTORE_INDEX_MF_NONE UINT16_MAX
+#define SUBGHZ_KEYSTORE_INDEX_SLOT_NONE UINT16_MAX
+
+/**
+ * Lookup index over the loaded keys, built once after loading.
+ *
+ * Manufacture names are interned into sorted ids, so the decoders can select
+ * the keys of one manufacture without comparing strings for every key.
+ * Keys of learning types that derive the man key from the serial number only
+ * get slots in the learning cache: derived keys are reused while the same
+ * remote keeps transmitting.
+ */
+typedef struct {
+    size_t keys_count;
+
+    const char** mf_names; /**< Interned manufacture names, sorted */
+    size_t mf_count;
+    uint32_t* mf_keys_offset; /**< mf_count + 1 offsets into mf_keys */
+    uint32_t* mf_keys; /**< Key positions grouped by manufacture, load order kept */
+    uint16_t* key_mf; /**< Manufacture id of every key */
+
+    uint16_t* learning_slot; /**< First learning cache slot of every key */
+    uint64_t* learning_cache;
+    uint32_t* learning_cache_valid; /**< Bitmap of filled learning cache slots */
+    size_t learning_cache_size;
+    uint32_t learning_cache_serial;
+} SubGhzKeystoreIndex;
+
 struct SubGhzKeystore {
     SubGhzKeyArray_t data;
     const char* mfname;
     uint8_t kl_type;
+    SubGhzKeystoreIndex* index;
 };
+
+/**
+ * Get lookup index, building it if keys were changed since last call
+ * @param instance Pointer to a SubGhzKeystore instance
+ * @return SubGhzKeystoreIndex*
+ */
+SubGhzKeystoreIndex* subghz_keystore_get_index(SubGhzKeystore* instance);
+
+/**
+ * Find interned manufacture id by name
+ * @param index Pointer to a SubGhzKeystoreIndex instance
+ * @param name Manufacture name
+ * @return manufacture id or SUBGHZ_KEYSTORE_INDEX_MF_NONE
+ */
+uint16_t subghz_keystore_index_find_mf(SubGhzKeystoreIndex* index, const char* name);
+
+/**
+ * Bind learning cache to the serial number, dropping cached keys on change
+ * @param index Pointer to a SubGhzKeystoreIndex instance
+ * @param serial Serial number (28bit)
+ */
+void subghz_keystore_index_set_serial(SubGhzKeystoreIndex* index, uint32_t serial);
@@ -0,0 +1,463 @@
+#include "subghz_raw_binary.h"
+
+#include <m-array.h>
+#include <toolbox/varint.h>
+#include <toolbox/crc32_calc.h>
+#include <toolbox/stream/stream.h>
+#include <flipper_format/flipper_format_i.h>
+#include "types.h"
+
+#define TAG "SubGhzRawBinary"
+
+#define SUBGHZ_RAW_BINARY_BLOCK_MAGIC 0x4B42 // "BK"
+#define SUBGHZ_RAW_BINARY_INDEX_MAGIC 0x5849 // "IX"
+#define SUBGHZ_RAW_BINARY_TRAILER_MAGIC 0x58444E49 // "INDX"
+#define SUBGHZ_RAW_BINARY_SAMPLE_MAX_SIZE 5
+#define SUBGHZ_RAW_BINARY_BUFFER_SIZE \
+    (SUBGHZ_RAW_BINARY_BLOCK_SAMPLES * SUBGHZ_RAW_BINARY_SAMPLE_MAX_SIZE)
+
+typedef struct {
+    uint16_t magic;
+    uint16_t samples;
+    uint32_t size; /**< Payload size */
+    uint32_t crc; /**< Payload CRC32 */
+} SubGhzRawBinaryBlockHeader;
+
+typedef struct {
+    uint32_t offset; /**< Block header offset from the start of the file */
+    uint32_t first_sample;
+} SubGhzRawBinaryIndexEntry;
+
+typedef struct {
+    uint32_t index_offset;
+    uint32_t magic;
+} SubGhzRawBinaryTrailer;
+
+ARRAY_DEF(SubGhzRawBinaryIndex, SubGhzRawBinaryIndexEntry, M_POD_OPLIST)
+
+struct SubGhzRawBinaryWriter {
+    Stream* stream;
+    uint8_t* buffer;
+    uint32_t samples_written;
+    SubGhzRawBinaryIndex_t index;
+};
+
+struct SubGhzRawBinaryReader {
+    Stream* stream;
+    bool binary;
+    uint8_t* buffer;
+    int32_t* block;
+    size_t block_size;
+    size_t block_pos;
+
+    FuriString* line;
+    size_t line_pos;
+};
+
+SubGhzRawBinaryWriter* subghz_raw_binary_writer_alloc(FlipperFormat* flipper_format) {
+    furi_assert(flipper_format);
+
+    uint32_t version = SUBGHZ_RAW_BINARY_VERSION;
+    if(!flipper_format_write_uint32(flipper_format, SUBGHZ_RAW_BINARY_KEY, &version, 1)) {
+        FURI_LOG_E(TAG, "Unable to add " SUBGHZ_RAW_BINARY_KEY);
+        return NULL;
+    }
+
+    SubGhzRawBinaryWriter* instance = malloc(sizeof(SubGhzRawBinaryWriter));
+    instance->stream = flipper_format_get_raw_stream(flipper_format);
+    instance->buffer = malloc(SUBGHZ_RAW_BINARY_BUFFER_SIZE);
+    instance->samples_written = 0;
+    SubGhzRawBinaryIndex_init(instance->index);
+    return instance;
+}
+
+void subghz_raw_binary_writer_free(SubGhzRawBinaryWriter* instance) {
+    furi_assert(instance);
+    SubGhzRawBinaryIndex_clear(instance->index);
+    free(instance->buffer);
+    free(instance);
+}
+
+static bool subghz_raw_binary_writer_write_block(
+    SubGhzRawBinaryWriter* instance,
+    const int32_t* samples,
+    size_t count) {
+    SubGhzRawBinaryBlockHeader header = {
+        .magic = SUBGHZ_RAW_BINARY_BLOCK_MAGIC,
+        .samples = count,
+        .size = 0,
+    };
+    for(size_t i = 0; i < count; i++) {
+        header.size += varint_int32_pack(samples[i], &instance->buffer[header.size]);
+    }
+    header.crc = crc32_calc_buffer(0, instance->buffer, header.size);
+
+    SubGhzRawBinaryIndexEntry* entry = SubGhzRawBinaryIndex_push_new(instance->index);
+    entry->offset = stream_tell(instance->stream);
+    entry->first_sample = instance->samples_written;
+
+    if(stream_write(instance->stream, (uint8_t*)&header, sizeof(header)) != sizeof(header) ||
+       stream_write(instance->stream, instance->buffer, header.size) != header.size) {
+        FURI_LOG_E(TAG, "Unable to write block");
+        return false;
+    }
+    instance->samples_written += count;
+    return true;
+}
+
+bool subghz_raw_binary_writer_write(
+    SubGhzRawBinaryWriter* instance,
+    const int32_t* samples,
+    size_t count) {
+    furi_assert(instance);
+    furi_assert(samples);
+
+    while(count) {
+        size_t block_count = MIN(count, (size_t)SUBGHZ_RAW_BINARY_BLOCK_SAMPLES);
+        if(!subghz_raw_binary_writer_write_block(instance, samples, block_count)) return false;
+        samples += block_count;
+        count -= block_count;
+    }
+    return true;
+}
+
+bool subghz_raw_binary_writer_finish(SubGhzRawBinaryWriter* instance) {
+    furi_assert(instance);
+
+    size_t entries_size =
+        SubGhzRawBinaryIndex_size(instance->index) * sizeof(SubGhzRawBinaryIndexEntry);
+    const SubGhzRawBinaryIndexEntry* entries =
+        entries_size ? SubGhzRawBinaryIndex_cget(instance->index, 0) : NULL;
+
+    SubGhzRawBinaryBlockHeader header = {
+        .magic = SUBGHZ_RAW_BINARY_INDEX_MAGIC,
+        .samples = 0,
+        .size = entries_size,
+        .crc = crc32_calc_buffer(0, entries, entries_size),
+    };
+    SubGhzRawBinaryTrailer trailer = {
+        .index_offset = stream_tell(instance->stream),
+        .magic = SUBGHZ_RAW_BINARY_TRAILER_MAGIC,
+    };
+
+    bool result = false;
+    do {
+        if(stream_write(instance->stream, (uint8_t*)&header, sizeof(header)) != sizeof(header))
+            break;
+        if(entries_size &&
+           stream_write(instance->stream, (const uint8_t*)entries, entries_size) != entries_size)
+            break;
+        if(stream_write(instance->stream, (uint8_t*)&trailer, sizeof(trailer)) != sizeof(trailer))
+            break;
+        result = true;
+    } while(false);
+
+    if(!result) {
+        FURI_LOG_E(TAG, "Unable to write index");
+    }
+    return result;
+}
+
+SubGhzRawBinaryReader* subghz_raw_binary_reader_alloc() {
+    SubGhzRawBinaryReader* instance = malloc(sizeof(SubGhzRawBinaryReader));
+    instance->buffer = malloc(SUBGHZ_RAW_BINARY_BUFFER_SIZE);
+    instance->block = malloc(SUBGHZ_RAW_BINARY_BLOCK_SAMPLES * sizeof(int32_t));
+    instance->line = furi_string_alloc();
+    return instance;
+}
+
+void subghz_raw_binary_reader_free(SubGhzRawBinaryReader* instance) {
+    furi_assert(instance);
+    furi_string_free(instance->line);
+    free(instance->block);
+    free(instance->buffer);
+    free(instance);
+}
+
+bool subghz_raw_binary_reader_start(
+    SubGhzRawBinaryReader* instance,
+    FlipperFormat* flipper_format) {
+    furi_assert(instance);
+    furi_assert(flipper_format);
+
+    instance->stream = flipper_format_get_raw_stream(flipper_format);
+    instance->block_size = 0;
+    instance->block_pos = 0;
+    furi_string_reset(instance->line);
+    instance->line_pos = 0;
+
+    size_t offset = stream_tell(instance->stream);
+    uint32_t version = 0;
+    flipper_format_set_strict_mode(flipper_format, true);
+    instance->binary =
+        flipper_format_read_uint32(flipper_format, SUBGHZ_RAW_BINARY_KEY, &version, 1);
+    flipper_format_set_strict_mode(flipper_format, false);
+
+    if(instance->binary) {
+        if(version != SUBGHZ_RAW_BINARY_VERSION) {
+            FURI_LOG_E(TAG, "Unsupported version %lu", version);
+            return false;
+        }
+        // Blocks start on the next line
+        stream_read_line(instance->stream, instance->line);
+        furi_string_reset(instance->line);
+    } else {
+        stream_seek(instance->stream, offset, StreamOffsetFromStart);
+    }
+    return true;
+}
+
+bool subghz_raw_binary_reader_is_binary(SubGhzRawBinaryReader* instance) {
+    furi_assert(instance);
+    return instance->binary;
+}
+
+static bool subghz_raw_binary_reader_load_block(SubGhzRawBinaryReader* instance) {
+    while(true) {
+        SubGhzRawBinaryBlockHeader header;
+        if(stream_read(instance->stream, (uint8_t*)&header, sizeof(header)) != sizeof(header)) {
+            // Recording without index
+            return false;
+        }
+        if(header.magic != SUBGHZ_RAW_BINARY_BLOCK_MAGIC) {
+            return false;
+        }
+        if(header.samples > SUBGHZ_RAW_BINARY_BLOCK_SAMPLES ||
+           header.size > SUBGHZ_RAW_BINARY_BUFFER_SIZE) {
+            FURI_LOG_E(TAG, "Invalid block");
+            return false;
+        }
+        if(stream_read(instance->stream, instance->buffer, header.size) != header.size) {
+            FURI_LOG_E(TAG, "Truncated block");
+            return false;
+        }
+        if(crc32_calc_buffer(0, instance->buffer, header.size) != header.crc) {
+            FURI_LOG_E(TAG, "Block checksum mismatch, skipped");
+            continue;
+        }
+
+        size_t offset = 0;
+        size_t count = 0;
+        while(offset < header.size && count < header.samples) {
+            offset += varint_int32_unpack(
+                &instance->block[count++], &instance->buffer[offset], header.size - offset);
+        }
+        if(offset != header.size || count != header.samples) {
+            FURI_LOG_E(TAG, "Block size mismatch, skipped");
+            continue;
+        }
+
+        instance->block_size = count;
+        instance->block_pos = 0;
+        return true;
+    }
+}
+
+static bool subghz_raw_binary_reader_load_line(SubGhzRawBinaryReader* instance) {
+    // Line sample: "RAW_Data: -1, 2, -2..."
+    const char* key = "RAW_Data:";
+    const size_t key_size = strlen(key);
+
+    if(instance->line_pos >= furi_string_size(instance->line)) {
+        do {
+            if(!stream_read_line(instance->stream, instance->line)) return false;
+            furi_string_trim(instance->line);
+        } while(furi_string_empty(instance->line));
+
+        if(!furi_string_start_with_str(instance->line, key)) return false;
+        instance->line_pos = key_size;
+    }
+
+    const char* start = furi_string_get_cstr(instance->line);
+    const char* str = start + instance->line_pos;
+    size_t count = 0;
+    while(count < SUBGHZ_RAW_BINARY_BLOCK_SAMPLES) {
+        while(*str == ' ' || *str == ',') str++;
+        char* end;
+        long value = strtol(str, &end, 10);
+        if(end == str) break;
+        instance->block[count++] = value;
+        str = end;
+    }
+    instance->line_pos = (*str == '\0' || count < SUBGHZ_RAW_BINARY_BLOCK_SAMPLES) ?
+                             furi_string_size(instance->line) :
+                             (size_t)(str - start);
+
+    instance->block_size = count;
+    instance->block_pos = 0;
+    return true;
+}
+
+size_t subghz_raw_binary_reader_read(
+    SubGhzRawBinaryReader* instance,
+    int32_t* samples,
+    size_t count) {
+    furi_assert(instance);
+    furi_assert(samples);
+
+    size_t read = 0;
+    while(read < count) {
+        if(instance->block_pos >= instance->block_size) {
+            bool loaded = instance->binary ? subghz_raw_binary_reader_load_block(instance) :
+                                             subghz_raw_binary_reader_load_line(instance);
+            if(!loaded) break;
+            continue;
+        }
+        size_t chunk = MIN(count - read, instance->block_size - instance->block_pos);
+        memcpy(&samples[read], &instance->block[instance->block_pos], chunk * sizeof(int32_t));
+        instance->block_pos += chunk;
+        read += chunk;
+    }
+    return read;
+}
+
+bool subghz_raw_binary_reader_seek(SubGhzRawBinaryReader* instance, size_t sample) {
+    furi_assert(instance);
+    if(!instance->binary) return false;
+
+    Stream* stream = instance->stream;
+    SubGhzRawBinaryIndexEntry* entries = NULL;
+    bool result = false;
+
+    do {
+        SubGhzRawBinaryTrailer trailer;
+        if(stream_size(stream) < sizeof(trailer)) break;
+        if(!stream_seek(stream, stream_size(stream) - sizeof(trailer), StreamOffsetFromStart))
+            break;
+        if(stream_read(stream, (uint8_t*)&trailer, sizeof(trailer)) != sizeof(trailer)) break;
+        if(trailer.magic != SUBGHZ_RAW_BINARY_TRAILER_MAGIC) {
+            FURI_LOG_E(TAG, "Missing index");
+            break;
+        }
+
+        SubGhzRawBinaryBlockHeader header;
+        if(!stream_seek(stream, trailer.index_offset, StreamOffsetFromStart)) break;
+        if(stream_read(stream, (uint8_t*)&header, sizeof(header)) != sizeof(header)) break;
+        if(header.magic != SUBGHZ_RAW_BINARY_INDEX_MAGIC || !header.size ||
+           header.size % sizeof(SubGhzRawBinaryIndexEntry)) {
+            FURI_LOG_E(TAG, "Invalid index");
+            break;
+        }
+        entries = malloc(header.size);
+        if(stream_read(stream, (uint8_t*)entries, header.size) != header.size) break;
+        if(crc32_calc_buffer(0, entries, header.size) != header.crc) {
+            FURI_LOG_E(TAG, "Index checksum mismatch");
+            break;
+        }
+
+        // Last block starting at or before the sample
+        size_t low = 0;
+        size_t high = header.size / sizeof(SubGhzRawBinaryIndexEntry);
+        while(high - low > 1) {
+            size_t mid = (low + high) / 2;
+            if(entries[mid].first_sample <= sample) {
+                low = mid;
+            } else {
+                high = mid;
+            }
+        }
+
+        if(!stream_seek(stream, entries[low].offset, StreamOffsetFromStart)) break;
+        if(!subghz_raw_binary_reader_load_block(instance)) break;
+        size_t skip = sample - entries[low].first_sample;
+        if(skip > instance->block_size) break;
+        instance->block_pos = skip;
+        result = true;
+    } while(false);
+
+    if(entries) free(entries);
+    if(!result) {
+        instance->block_size = 0;
+        instance->block_pos = 0;
+    }
+    return result;
+}
+
+bool subghz_raw_binary_convert(
+    Storage* storage,
+    const char* src_path,
+    const char* dst_path,
+    bool binary) {
+    furi_assert(storage);
+    furi_assert(src_path);
+    furi_assert(dst_path);
+
+    FlipperFormat* src = flipper_format_file_alloc(storage);
+    FlipperFormat* dst = flipper_format_file_alloc(storage);
+    SubGhzRawBinaryReader* reader = subghz_raw_binary_reader_alloc();
+    SubGhzRawBinaryWriter* writer = NULL;
+    FuriString* temp_str = furi_string_alloc();
+    int32_t* samples = malloc(SUBGHZ_RAW_BINARY_BLOCK_SAMPLES * sizeof(int32_t));
+    bool result = false;
+
+    do {
+        if(!flipper_format_file_open_existing(src, src_path)) {
+            FURI_LOG_E(TAG, "Unable to open file for read: %s", src_path);
+            break;
+        }
+        uint32_t version = 0;
+        if(!flipper_format_read_header(src, temp_str, &version)) {
+            FURI_LOG_E(TAG, "Missing or incorrect header");
+            break;
+        }
+        if(strcmp(furi_string_get_cstr(temp_str), SUBGHZ_RAW_FILE_TYPE) != 0 ||
+           version != SUBGHZ_RAW_FILE_VERSION) {
+            FURI_LOG_E(TAG, "Type or version mismatch");
+            break;
+        }
+        if(!flipper_format_read_string(src, "Protocol", temp_str)) {
+            FURI_LOG_E(TAG, "Missing Protocol");
+            break;
+        }
+
+        // Header is copied as is, including the end of the "Protocol" line
+        Stream* src_stream = flipper_format_get_raw_stream(src);
+        size_t header_size = stream_tell(src_stream) + 1;
+        if(!subghz_raw_binary_reader_start(reader, src)) break;
+        size_t data_offset = stream_tell(src_stream);
+
+        if(!flipper_format_file_open_always(dst, dst_path)) {
+            FURI_LOG_E(TAG, "Unable to open file for write: %s", dst_path);
+            break;
+        }
+        Stream* dst_stream = flipper_format_get_raw_stream(dst);
+        if(!stream_rewind(src_stream) ||
+           stream_copy(src_stream, dst_stream, header_size) != header_size ||
+           !stream_seek(src_stream, data_offset, StreamOffsetFromStart)) {
+            FURI_LOG_E(TAG, "Unable to copy header");
+            break;
+        }
+
+        if(binary) {
+            writer = subghz_raw_binary_writer_alloc(dst);
+            if(!writer) break;
+        }
+
+        bool write_ok = true;
+        size_t count;
+        while(write_ok && (count = subghz_raw_binary_reader_read(
+                               reader, samples, SUBGHZ_RAW_BINARY_BLOCK_SAMPLES))) {
+            if(binary) {
+                write_ok = subghz_raw_binary_writer_write(writer, samples, count);
+            } else {
+                write_ok = flipper_format_write_int32(dst, "RAW_Data", samples, count);
+            }
+        }
+        if(!write_ok) {
+            FURI_LOG_E(TAG, "Unable to write samples");
+            break;
+        }
+
+        if(binary && !subghz_raw_binary_writer_finish(writer)) break;
+        result = true;
+    } while(false);
+
+    if(writer) subghz_raw_binary_writer_free(writer);
+    free(samples);
+    furi_string_free(temp_str);
+    subghz_raw_binary_reader_free(reader);
+    flipper_format_free(dst);
+    flipper_format_free(src);
+
+    return result;
+}
@@ -0,0 +1,126 @@
+#pragma once
+
+#include <furi.h>
+#include <storage/storage.h>
+#include <flipper_format/flipper_format.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Binary RAW container.
+ *
+ * The text header of a RAW file is kept as is, the "RAW_Binary" key after
+ * "Protocol" marks that the samples follow as binary blocks instead of
+ * "RAW_Data" lines. Every block holds up to SUBGHZ_RAW_BINARY_BLOCK_SAMPLES
+ * varint encoded durations protected by CRC32. The block index at the end of
+ * the file allows seeking to any sample, files without the index (recording
+ * was interrupted) are still readable sequentially.
+ */
+
+#define SUBGHZ_RAW_BINARY_KEY "RAW_Binary"
+#define SUBGHZ_RAW_BINARY_VERSION 1
+#define SUBGHZ_RAW_BINARY_BLOCK_SAMPLES 512
+
+typedef struct SubGhzRawBinaryWriter SubGhzRawBinaryWriter;
+typedef struct SubGhzRawBinaryReader SubGhzRawBinaryReader;
+
+/**
+ * Allocate SubGhzRawBinaryWriter and write the format key.
+ * @param flipper_format Pointer to a FlipperFormat instance, header already written
+ * @return SubGhzRawBinaryWriter* pointer to a SubGhzRawBinaryWriter instance or NULL on error
+ */
+SubGhzRawBinaryWriter* subghz_raw_binary_writer_alloc(FlipperFormat* flipper_format);
+
+/**
+ * Free SubGhzRawBinaryWriter, the file stays open.
+ * @param instance Pointer to a SubGhzRawBinaryWriter instance
+ */
+void subghz_raw_binary_writer_free(SubGhzRawBinaryWriter* instance);
+
+/**
+ * Write samples, every SUBGHZ_RAW_BINARY_BLOCK_SAMPLES samples make one block.
+ * @param instance Pointer to a SubGhzRawBinaryWriter instance
+ * @param samples Durations in us, negative for low level
+ * @param count Samples count
+ * @return true On success
+ */
+bool subghz_raw_binary_writer_write(
+    SubGhzRawBinaryWriter* instance,
+    const int32_t* samples,
+    size_t count);
+
+/**
+ * Write the block index, no samples can be written after it.
+ * @param instance Pointer to a SubGhzRawBinaryWriter instance
+ * @return true On success
+ */
+bool subghz_raw_binary_writer_finish(SubGhzRawBinaryWriter* instance);
+
+/**
+ * Allocate SubGhzRawBinaryReader.
+ * @return SubGhzRawBinaryReader* pointer to a SubGhzRawBinaryReader instance
+ */
+SubGhzRawBinaryReader* subghz_raw_binary_reader_alloc();
+
+/**
+ * Free SubGhzRawBinaryReader.
+ * @param instance Pointer to a SubGhzRawBinaryReader instance
+ */
+void subghz_raw_binary_reader_free(SubGhzRawBinaryReader* instance);
+
+/**
+ * Start reading samples, text "RAW_Data" files are read as well.
+ * @param instance Pointer to a SubGhzRawBinaryReader instance
+ * @param flipper_format Pointer to a FlipperFormat instance, "Protocol" key already read
+ * @return true On success
+ */
+bool subghz_raw_binary_reader_start(
+    SubGhzRawBinaryReader* instance,
+    FlipperFormat* flipper_format);
+
+/**
+ * Check if samples are read from a binary container.
+ * @param instance Pointer to a SubGhzRawBinaryReader instance
+ * @return true If binary
+ */
+bool subghz_raw_binary_reader_is_binary(SubGhzRawBinaryReader* instance);
+
+/**
+ * Read next samples.
+ * @param instance Pointer to a SubGhzRawBinaryReader instance
+ * @param samples Output buffer
+ * @param count Output buffer size in samples
+ * @return Samples read, 0 at the end of data
+ */
+size_t subghz_raw_binary_reader_read(
+    SubGhzRawBinaryReader* instance,
+    int32_t* samples,
+    size_t count);
+
+/**
+ * Seek to sample using the block index, binary files only.
+ * @param instance Pointer to a SubGhzRawBinaryReader instance
+ * @param sample Sample number from the start of data
+ * @return true On success
+ */
+bool subghz_raw_binary_reader_seek(SubGhzRawBinaryReader* instance, size_t sample);
+
+/**
+ * Convert RAW file between text and binary format.
+ * @param storage Pointer to a Storage instance
+ * @param src_path Source file path, text or binary
+ * @param dst_path Destination file path
+ * @param binary Write binary container, text otherwise
+ * @return true On success
+ */
+bool subghz_raw_binary_convert(
+    Storage* storage,
+    const char* src_path,
+    const char* dst_path,
+    bool binary);
+
+#ifdef __cplusplus
+}
+#endif
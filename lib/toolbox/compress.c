@@ -1,6 +1,7 @@
 #include "compress.h"
 
 #include <furi.h>
+#include <furi_hal.h>
 #include <lib/heatshrink/heatshrink_encoder.h>
 #include <lib/heatshrink/heatshrink_decoder.h>
 
@@ -14,6 +15,10 @@
 #define COMPRESS_ICON_ENCODED_BUFF_SIZE (1024u)
 #define COMPRESS_ICON_DECODED_BUFF_SIZE (1024u)
 
+/** Decoded icon cache limits */
+#define COMPRESS_ICON_CACHE_ENTRIES (32u)
+#define COMPRESS_ICON_CACHE_MIN_FREE_HEAP (16u * 1024u)
+
 typedef struct {
     uint8_t is_compressed;
     uint8_t reserved;
@@ -22,9 +27,21 @@ typedef struct {
 
 _Static_assert(sizeof(CompressHeader) == 4, "Incorrect CompressHeader size");
 
+typedef struct {
+    const uint8_t* icon_data;
+    uint8_t* data; // Compressed data copy followed by decoded data
+    uint16_t compressed_size;
+    uint16_t decoded_size;
+    uint32_t last_used;
+} CompressIconCacheEntry;
+
 struct CompressIcon {
     heatshrink_decoder* decoder;
     uint8_t decoded_buff[COMPRESS_ICON_DECODED_BUFF_SIZE];
+
+    CompressIconCacheEntry* cache;
+    uint32_t cache_tick;
+    CompressIconCacheStats stats;
 };
 
 CompressIcon* compress_icon_alloc() {
@@ -41,10 +58,84 @@ CompressIcon* compress_icon_alloc() {
 
 void compress_icon_free(CompressIcon* instance) {
     furi_assert(instance);
+    compress_icon_set_cache_budget(instance, 0);
     heatshrink_decoder_free(instance->decoder);
     free(instance);
 }
 
+static void compress_icon_cache_remove(CompressIcon* instance, CompressIconCacheEntry* entry) {
+    instance->stats.used -= entry->compressed_size + entry->decoded_size;
+    instance->stats.entries--;
+    free(entry->data);
+    memset(entry, 0, sizeof(CompressIconCacheEntry));
+}
+
+static CompressIconCacheEntry*
+    compress_icon_cache_get(CompressIcon* instance, const uint8_t* icon_data, size_t size) {
+    for(size_t i = 0; i < COMPRESS_ICON_CACHE_ENTRIES; i++) {
+        CompressIconCacheEntry* entry = &instance->cache[i];
+        if(entry->icon_data != icon_data) continue;
+
+        // Same pointer may be reused by another icon once its data was freed
+        if(entry->compressed_size == size && memcmp(entry->data, icon_data, size) == 0) {
+            return entry;
+        }
+        compress_icon_cache_remove(instance, entry);
+        break;
+    }
+    return NULL;
+}
+
+static void compress_icon_cache_put(
+    CompressIcon* instance,
+    const uint8_t* icon_data,
+    size_t compressed_size,
+    size_t decoded_size) {
+    size_t entry_size = compressed_size + decoded_size;
+
+    // Single entry can't take the whole cache
+    if(entry_size > instance->stats.budget / 2) {
+        instance->stats.bypassed++;
+        return;
+    }
+
+    // Give the memory back when the heap is low
+    if(memmgr_get_free_heap() < COMPRESS_ICON_CACHE_MIN_FREE_HEAP) {
+        compress_icon_cache_clear(instance);
+        instance->stats.bypassed++;
+        return;
+    }
+
+    CompressIconCacheEntry* slot = NULL;
+    while(true) {
+        CompressIconCacheEntry* oldest = NULL;
+        slot = NULL;
+        for(size_t i = 0; i < COMPRESS_ICON_CACHE_ENTRIES; i++) {
+            CompressIconCacheEntry* entry = &instance->cache[i];
+            if(!entry->data) {
+                if(!slot) slot = entry;
+            } else if(!oldest || (int32_t)(entry->last_used - oldest->last_used) < 0) {
+                oldest = entry;
+            }
+        }
+        if(slot && instance->stats.used + entry_size <= instance->stats.budget) break;
+
+        furi_assert(oldest);
+        compress_icon_cache_remove(instance, oldest);
+        instance->stats.evictions++;
+    }
+
+    slot->icon_data = icon_data;
+    slot->data = malloc(entry_size);
+    slot->compressed_size = compressed_size;
+    slot->decoded_size = decoded_size;
+    slot->last_used = ++instance->cache_tick;
+    memcpy(slot->data, icon_data, compressed_size);
+    memcpy(slot->data + compressed_size, instance->decoded_buff, decoded_size);
+    instance->stats.used += entry_size;
+    instance->stats.entries++;
+}
+
 void compress_icon_decode(CompressIcon* instance, const uint8_t* icon_data, uint8_t** decoded_buff) {
     furi_assert(instance);
     furi_assert(icon_data);
@@ -52,7 +143,22 @@ void compress_icon_decode(CompressIcon* instance, const uint8_t* icon_data, uint
 
     CompressHeader* header = (CompressHeader*)icon_data;
     if(header->is_compressed) {
+        size_t compressed_size = sizeof(CompressHeader) + header->compressed_buff_size;
+        if(instance->cache) {
+            CompressIconCacheEntry* entry =
+                compress_icon_cache_get(instance, icon_data, compressed_size);
+            if(entry) {
+                entry->last_used = ++instance->cache_tick;
+                instance->stats.hits++;
+                *decoded_buff = entry->data + entry->compressed_size;
+                return;
+            }
+            instance->stats.misses++;
+        }
+
+        uint32_t start = DWT->CYCCNT;
         size_t data_processed = 0;
+        size_t decoded_size = 0;
         heatshrink_decoder_sink(
             instance->decoder,
             (uint8_t*)&icon_data[sizeof(CompressHeader)],
@@ -61,21 +167,85 @@ void compress_icon_decode(CompressIcon* instance, const uint8_t* icon_data, uint
         while(1) {
             HSD_poll_res res = heatshrink_decoder_poll(
                 instance->decoder,
-                instance->decoded_buff,
-                sizeof(instance->decoded_buff),
+                &instance->decoded_buff[decoded_size],
+                sizeof(instance->decoded_buff) - decoded_size,
                 &data_processed);
+            decoded_size += data_processed;
             furi_assert((res == HSDR_POLL_EMPTY) || (res == HSDR_POLL_MORE));
-            if(res != HSDR_POLL_MORE) {
+            if(res != HSDR_POLL_MORE || decoded_size == sizeof(instance->decoded_buff)) {
                 break;
             }
         }
         heatshrink_decoder_reset(instance->decoder);
+        instance->stats.decodes++;
+        instance->stats.decode_time_us +=
+            (DWT->CYCCNT - start) / furi_hal_cortex_instructions_per_microsecond();
         *decoded_buff = instance->decoded_buff;
+
+        if(instance->cache && decoded_size) {
+            compress_icon_cache_put(instance, icon_data, compressed_size, decoded_size);
+        }
     } else {
         *decoded_buff = (uint8_t*)&icon_data[1];
     }
 }
 
+void compress_icon_set_cache_budget(CompressIcon* instance, size_t budget) {
+    furi_assert(instance);
+
+    if(budget) {
+        if(!instance->cache) {
+            instance->cache =
+                malloc(sizeof(CompressIconCacheEntry) * COMPRESS_ICON_CACHE_ENTRIES);
+        }
+        // Shrink to the new budget
+        while(instance->stats.used > budget) {
+            CompressIconCacheEntry* oldest = NULL;
+            for(size_t i = 0; i < COMPRESS_ICON_CACHE_ENTRIES; i++) {
+                CompressIconCacheEntry* entry = &instance->cache[i];
+                if(entry->data &&
+                   (!oldest || (int32_t)(entry->last_used - oldest->last_used) < 0)) {
+                    oldest = entry;
+                }
+            }
+            compress_icon_cache_remove(instance, oldest);
+            instance->stats.evictions++;
+        }
+    } else if(instance->cache) {
+        compress_icon_cache_clear(instance);
+        free(instance->cache);
+        instance->cache = NULL;
+    }
+    instance->stats.budget = budget;
+}
+
+void compress_icon_cache_clear(CompressIcon* instance) {
+    furi_assert(instance);
+    if(!instance->cache) return;
+
+    for(size_t i = 0; i < COMPRESS_ICON_CACHE_ENTRIES; i++) {
+        if(instance->cache[i].data) {
+            compress_icon_cache_remove(instance, &instance->cache[i]);
+        }
+    }
+}
+
+void compress_icon_get_cache_stats(CompressIcon* instance, CompressIconCacheStats* stats) {
+    furi_assert(instance);
+    furi_assert(stats);
+    *stats = instance->stats;
+}
+
+void compress_icon_reset_cache_stats(CompressIcon* instance) {
+    furi_assert(instance);
+    instance->stats.hits = 0;
+    instance->stats.misses = 0;
+    instance->stats.bypassed = 0;
+    instance->stats.evictions = 0;
+    instance->stats.decodes = 0;
+    instance->stats.decode_time_us = 0;
+}
+
 struct Compress {
     heatshrink_encoder* encoder;
     heatshrink_decoder* decoder;
@@ -38,6 +38,50 @@ void compress_icon_free(CompressIcon* instance);
  */
 void compress_icon_decode(CompressIcon* instance, const uint8_t* icon_data, uint8_t** decoded_buff);
 
+/** Decoded icon cache counters */
+typedef struct {
+    uint32_t hits; /**< Icons served from the cache */
+    uint32_t misses; /**< Compressed icons decoded while the cache is enabled */
+    uint32_t bypassed; /**< Decoded icons not cached: too big or low heap */
+    uint32_t evictions; /**< Entries dropped to fit the budget */
+    uint32_t decodes; /**< Compressed icons decoded */
+    uint32_t decode_time_us; /**< Total decode time */
+    uint32_t entries; /**< Current entries count */
+    size_t used; /**< Memory used by entries */
+    size_t budget; /**< Cache memory budget, 0 if disabled */
+} CompressIconCacheStats;
+
+/** Set decoded icon cache memory budget
+ *
+ * Decoded icons are cached by icon data pointer, the compressed data is kept
+ * with the entry and compared on every hit, so data freed and reused for
+ * another icon never returns stale pixels. Least recently used entries are
+ * evicted to fit the budget and nothing is cached while the heap is low.
+ *
+ * @param      instance  The Compress Icon instance
+ * @param      budget    cache memory budget in bytes, 0 disables the cache
+ */
+void compress_icon_set_cache_budget(CompressIcon* instance, size_t budget);
+
+/** Drop all decoded icon cache entries
+ *
+ * @param      instance  The Compress Icon instance
+ */
+void compress_icon_cache_clear(CompressIcon* instance);
+
+/** Get decoded icon cache counters
+ *
+ * @param      instance  The Compress Icon instance
+ * @param[out] stats     counters destination
+ */
+void compress_icon_get_cache_stats(CompressIcon* instance, CompressIconCacheStats* stats);
+
+/** Reset decoded icon cache counters
+ *
+ * @param      instance  The Compress Icon instance
+ */
+void compress_icon_reset_cache_stats(CompressIcon* instance);
+
 /** Compress control structure */
 typedef struct Compress Compress;
 
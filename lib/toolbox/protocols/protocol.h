@@ -11,6 +11,12 @@ typedef uint8_t* (*ProtocolGetData)(void* protocol);
 
 typedef void (*ProtocolDecoderStart)(void* protocol);
 typedef bool (*ProtocolDecoderFeed)(void* protocol, bool level, uint32_t duration);
+/**
+ * Feed pairs in order until one of them completes decoding, same as calling feed for each.
+ * Returns number of pairs taken including the one that completed decoding, 0 if none did.
+ */
+typedef size_t (
+    *ProtocolDecoderFeedBatch)(void* protocol, const LevelDuration* pairs, size_t count);
 
 typedef bool (*ProtocolEncoderStart)(void* protocol);
 typedef LevelDuration (*ProtocolEncoderYield)(void* protocol);
@@ -21,6 +27,7 @@ typedef bool (*ProtocolWriteData)(void* protocol, void* data);
 typedef struct {
     ProtocolDecoderStart start;
     ProtocolDecoderFeed feed;
+    ProtocolDecoderFeedBatch feed_batch; // Optional, dict falls back to feed
 } ProtocolDecoder;
 
 typedef struct {
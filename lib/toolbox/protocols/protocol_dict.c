@@ -1,10 +1,15 @@
 #include <furi.h>
 #include "protocol_dict.h"
 
+// Pairs per batch step, bounds the work lost when a result restarts decoders
+#define PROTOCOL_DICT_BATCH_WINDOW (32)
+
 struct ProtocolDict {
     const ProtocolBase** base;
     size_t count;
     void** data;
+    size_t* ahead; // Pairs decoder took past the end of the last batch result
+    bool* ahead_ready; // Last of them completed decoding
 };
 
 ProtocolDict* protocol_dict_alloc(const ProtocolBase** protocols, size_t count) {
@@ -12,6 +17,8 @@ ProtocolDict* protocol_dict_alloc(const ProtocolBase** protocols, size_t count)
     dict->base = protocols;
     dict->count = count;
     dict->data = malloc(sizeof(void*) * dict->count);
+    dict->ahead = malloc(sizeof(size_t) * dict->count);
+    dict->ahead_ready = malloc(sizeof(bool) * dict->count);
 
     for(size_t i = 0; i < dict->count; i++) {
         dict->data[i] = dict->base[i]->alloc();
@@ -25,6 +32,8 @@ void protocol_dict_free(ProtocolDict* dict) {
         dict->base[i]->free(dict->data[i]);
     }
 
+    free(dict->ahead_ready);
+    free(dict->ahead);
     free(dict->data);
     free(dict);
 }
@@ -85,6 +94,8 @@ const char* protocol_dict_get_manufacturer(ProtocolDict* dict, size_t protocol_i
 void protocol_dict_decoders_start(ProtocolDict* dict) {
     for(size_t i = 0; i < dict->count; i++) {
         ProtocolDecoderStart fn = dict->base[i]->decoder.start;
+        dict->ahead[i] = 0;
+        dict->ahead_ready[i] = false;
 
         if(fn) {
             fn(dict->data[i]);
@@ -163,6 +174,95 @@ ProtocolId protocol_dict_decoders_feed_by_id(
     return ready_protocol_id;
 }
 
+static size_t protocol_dict_decoder_feed_batch(
+    const ProtocolBase* base,
+    void* data,
+    const LevelDuration* pairs,
+    size_t count) {
+    if(base->decoder.feed_batch) {
+        return base->decoder.feed_batch(data, pairs, count);
+    }
+
+    for(size_t i = 0; i < count; i++) {
+        if(base->decoder.feed(
+               data, level_duration_get_level(pairs[i]), level_duration_get_duration(pairs[i]))) {
+            return i + 1;
+        }
+    }
+
+    return 0;
+}
+
+static ProtocolId protocol_dict_decoders_feed_batch_internal(
+    ProtocolDict* dict,
+    bool by_feature,
+    uint32_t feature,
+    const LevelDuration* pairs,
+    size_t count,
+    size_t* consumed) {
+    ProtocolId ready_protocol_id = PROTOCOL_NO;
+    // Pairs every decoder has to take, shrinks to the earliest completed decoding.
+    // Windowed: decoders_start after a result drops what the others took past it.
+    size_t limit = MIN(count, (size_t)PROTOCOL_DICT_BATCH_WINDOW);
+
+    // Decoder that runs before the one with earlier result takes pairs past it. Remember how
+    // many, so the next call with the rest of pairs skips them for that decoder.
+    for(size_t i = 0; i < dict->count; i++) {
+        if(by_feature && !(dict->base[i]->features & feature)) continue;
+        if(!dict->base[i]->decoder.feed) continue;
+
+        size_t position = dict->ahead[i];
+        bool ready = dict->ahead_ready[i];
+        if(position < limit && !ready) {
+            size_t fed = protocol_dict_decoder_feed_batch(
+                dict->base[i], dict->data[i], &pairs[position], limit - position);
+            ready = fed > 0;
+            position += ready ? fed : limit - position;
+        }
+
+        dict->ahead[i] = position;
+        dict->ahead_ready[i] = ready;
+
+        if(ready && position <= limit) {
+            // Same pair completes several decoders, first one wins
+            if(ready_protocol_id == PROTOCOL_NO || position < limit) {
+                ready_protocol_id = i;
+                limit = position;
+            }
+        }
+    }
+
+    for(size_t i = 0; i < dict->count; i++) {
+        if(dict->ahead[i] > limit) {
+            dict->ahead[i] -= limit;
+        } else {
+            dict->ahead[i] = 0;
+            dict->ahead_ready[i] = false;
+        }
+    }
+
+    *consumed = limit;
+    return ready_protocol_id;
+}
+
+ProtocolId protocol_dict_decoders_feed_batch(
+    ProtocolDict* dict,
+    const LevelDuration* pairs,
+    size_t count,
+    size_t* consumed) {
+    return protocol_dict_decoders_feed_batch_internal(dict, false, 0, pairs, count, consumed);
+}
+
+ProtocolId protocol_dict_decoders_feed_batch_by_feature(
+    ProtocolDict* dict,
+    uint32_t feature,
+    const LevelDuration* pairs,
+    size_t count,
+    size_t* consumed) {
+    return protocol_dict_decoders_feed_batch_internal(
+        dict, true, feature, pairs, count, consumed);
+}
+
 bool protocol_dict_encoder_start(ProtocolDict* dict, size_t protocol_index) {
     furi_assert(protocol_index < dict->count);
     ProtocolEncoderStart fn = dict->base[protocol_index]->encoder.start;
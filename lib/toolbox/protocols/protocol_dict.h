@@ -54,6 +54,32 @@ ProtocolId protocol_dict_decoders_feed_by_id(
     bool level,
     uint32_t duration);
 
+/**
+ * Feed pairs to decoders until one of them completes decoding.
+ * Result is the same as calling protocol_dict_decoders_feed for each pair, protocols with
+ * feed_batch take whole array at once. Pass the rest of pairs with the next call, decoders
+ * keep track of pairs they already took. protocol_dict_decoders_start drops that.
+ * A call takes a bounded window of pairs, so consumed can be less than count without a result.
+ *
+ * @param dict dictionary
+ * @param pairs level/duration pairs
+ * @param count pairs count
+ * @param consumed pairs taken, up to and including the one that completed decoding
+ * @return ProtocolId of decoded protocol, PROTOCOL_NO if none of the consumed pairs completed decoding
+ */
+ProtocolId protocol_dict_decoders_feed_batch(
+    ProtocolDict* dict,
+    const LevelDuration* pairs,
+    size_t count,
+    size_t* consumed);
+
+ProtocolId protocol_dict_decoders_feed_batch_by_feature(
+    ProtocolDict* dict,
+    uint32_t feature,
+    const LevelDuration* pairs,
+    size_t count,
+    size_t* consumed);
+
 bool protocol_dict_encoder_start(ProtocolDict* dict, size_t protocol_index);
 
 LevelDuration protocol_dict_encoder_yield(ProtocolDict* dict, size_t protocol_index);
@@ -8,6 +8,8 @@ typedef struct {
     Stream stream_base;
     Stream* file_stream;
     StreamCache* cache;
+    size_t position; // Logical position when no write is pending
+    size_t file_position; // Position of the underlying stream, tracked to skip storage calls
     bool sync_pending;
 } BufferedFileStream;
 
@@ -29,6 +31,7 @@ static bool buffered_file_stream_delete_and_insert(
 
 static bool buffered_file_stream_flush(BufferedFileStream* stream);
 static bool buffered_file_stream_unread(BufferedFileStream* stream);
+static bool buffered_file_stream_fill(BufferedFileStream* stream);
 
 const StreamVTable buffered_file_stream_vtable = {
     .free = (StreamFreeFn)buffered_file_stream_free,
@@ -43,10 +46,17 @@ const StreamVTable buffered_file_stream_vtable = {
 };
 
 Stream* buffered_file_stream_alloc(Storage* storage) {
+    return buffered_file_stream_alloc_ex(
+        storage, STREAM_CACHE_DEFAULT_BLOCK_SIZE, STREAM_CACHE_DEFAULT_BLOCKS_COUNT);
+}
+
+Stream* buffered_file_stream_alloc_ex(Storage* storage, size_t block_size, size_t blocks_count) {
     BufferedFileStream* stream = malloc(sizeof(BufferedFileStream));
 
     stream->file_stream = file_stream_alloc(storage);
-    stream->cache = stream_cache_alloc();
+    stream->cache = stream_cache_alloc_ex(block_size, blocks_count);
+    stream->position = 0;
+    stream->file_position = 0;
     stream->sync_pending = false;
 
     stream->stream_base.vtable = &buffered_file_stream_vtable;
@@ -61,7 +71,17 @@ bool buffered_file_stream_open(
     furi_assert(_stream);
     BufferedFileStream* stream = (BufferedFileStream*)_stream;
     furi_check(stream->stream_base.vtable == &buffered_file_stream_vtable);
-    return file_stream_open(stream->file_stream, path, access_mode, open_mode);
+    stream_cache_drop(stream->cache);
+    stream->sync_pending = false;
+    stream->position = 0;
+    stream->file_position = 0;
+
+    const bool success = file_stream_open(stream->file_stream, path, access_mode, open_mode);
+    if(success && open_mode == FSOM_OPEN_APPEND) {
+        stream->position = stream_tell(stream->file_stream);
+        stream->file_position = stream->position;
+    }
+    return success;
 }
 
 bool buffered_file_stream_close(Stream* _stream) {
@@ -70,9 +90,8 @@ bool buffered_file_stream_close(Stream* _stream) {
     furi_check(stream->stream_base.vtable == &buffered_file_stream_vtable);
     bool success = false;
     do {
-        if(!(stream->sync_pending ? buffered_file_stream_flush(stream) :
-                                    buffered_file_stream_unread(stream)))
-            break;
+        if(stream->sync_pending && !buffered_file_stream_flush(stream)) break;
+        stream_cache_drop(stream->cache);
         if(!file_stream_close(stream->file_stream)) break;
         success = true;
     } while(false);
@@ -103,15 +122,14 @@ static void buffered_file_stream_free(BufferedFileStream* stream) {
 
 static bool buffered_file_stream_eof(BufferedFileStream* stream) {
     bool ret;
-    const bool file_stream_eof = stream_eof(stream->file_stream);
-    const bool cache_at_end = stream_cache_at_end(stream->cache);
-    if(!stream->sync_pending) {
-        ret = file_stream_eof && cache_at_end;
+    if(stream->sync_pending) {
+        ret = buffered_file_stream_tell(stream) >= buffered_file_stream_size(stream);
+    } else if(stream_cache_select(stream->cache, stream->position)) {
+        ret = false;
+    } else if(stream->position == stream->file_position) {
+        ret = stream_eof(stream->file_stream);
     } else {
-        const size_t remaining_size =
-            stream_size(stream->file_stream) - stream_tell(stream->file_stream);
-        ret = stream_cache_size(stream->cache) >=
-              (remaining_size ? cache_at_end : file_stream_eof);
+        ret = stream->position >= stream_size(stream->file_stream);
     }
     return ret;
 }
@@ -121,6 +139,8 @@ static void buffered_file_stream_clean(BufferedFileStream* stream) {
     stream->sync_pending = false;
     stream_cache_drop(stream->cache);
     stream_clean(stream->file_stream);
+    stream->position = 0;
+    stream->file_position = 0;
 }
 
 static bool buffered_file_stream_seek(
@@ -128,33 +148,57 @@ static bool buffered_file_stream_seek(
     int32_t offset,
     StreamOffset offset_type) {
     bool success = true;
-    int32_t new_offset = offset;
 
-    if(offset_type == StreamOffsetFromCurrent) {
-        new_offset -= stream_cache_seek(stream->cache, offset);
-        if(new_offset < 0) {
-            new_offset -= (int32_t)stream_cache_size(stream->cache);
+    do {
+        if(stream->sync_pending) {
+            // Move inside the pending data without writing it
+            if(offset_type == StreamOffsetFromCurrent) {
+                const int32_t moved = stream_cache_seek(stream->cache, offset);
+                if(moved == offset) break;
+                offset -= moved;
+            }
+            if(!buffered_file_stream_flush(stream)) {
+                success = false;
+                break;
+            }
         }
-    }
 
-    if((new_offset != 0) || (offset_type != StreamOffsetFromCurrent)) {
-        if(stream->sync_pending) {
-            success = buffered_file_stream_sync((Stream*)stream);
-        } else {
-            stream_cache_drop(stream->cache);
+        int32_t new_position = offset;
+        if(offset_type == StreamOffsetFromCurrent) {
+            new_position += (int32_t)stream->position;
+        } else if(offset_type == StreamOffsetFromEnd) {
+            new_position += (int32_t)stream_size(stream->file_stream);
         }
-        if(success) {
-            success = stream_seek(stream->file_stream, new_offset, offset_type);
+
+        if(new_position < 0) {
+            stream->position = 0;
+            success = false;
+            break;
+        }
+
+        // Cached data stays valid until the next write, no need to touch the file
+        if(stream_cache_select(stream->cache, new_position)) {
+            stream->position = new_position;
+            break;
         }
-    }
+
+        // The underlying stream is moved by the next fill or write
+        const size_t size = stream_size(stream->file_stream);
+        if((size_t)new_position > size) {
+            stream->position = size;
+            success = false;
+        } else {
+            stream->position = new_position;
+        }
+    } while(false);
 
     return success;
 }
 
 static size_t buffered_file_stream_tell(BufferedFileStream* stream) {
-    size_t pos = stream_tell(stream->file_stream) + stream_cache_pos(stream->cache);
-    if(!stream->sync_pending) {
-        pos -= stream_cache_size(stream->cache);
+    size_t pos = stream->position;
+    if(stream->sync_pending) {
+        pos = stream->file_position + stream_cache_pos(stream->cache);
     }
     return pos;
 }
@@ -162,10 +206,9 @@ static size_t buffered_file_stream_tell(BufferedFileStream* stream) {
 static size_t buffered_file_stream_size(BufferedFileStream* stream) {
     size_t size = stream_size(stream->file_stream);
     if(stream->sync_pending) {
-        const size_t remaining_size = size - stream_tell(stream->file_stream);
-        const size_t cache_size = stream_cache_size(stream->cache);
-        if(cache_size > remaining_size) {
-            size += (cache_size - remaining_size);
+        const size_t cache_end = stream->file_position + stream_cache_size(stream->cache);
+        if(cache_end > size) {
+            size = cache_end;
         }
     }
     return size;
@@ -174,34 +217,33 @@ static size_t buffered_file_stream_size(BufferedFileStream* stream) {
 static size_t
     buffered_file_stream_write(BufferedFileStream* stream, const uint8_t* data, size_t size) {
     size_t need_to_write = size;
-    do {
+    while(need_to_write) {
         if(!stream->sync_pending) {
             if(!buffered_file_stream_unread(stream)) break;
-        }
-        while(need_to_write) {
             stream->sync_pending = true;
-            need_to_write -=
-                stream_cache_write(stream->cache, data + (size - need_to_write), need_to_write);
-            if(need_to_write) {
-                stream->sync_pending = false;
-                if(!stream_cache_flush(stream->cache, stream->file_stream)) break;
-            }
         }
-    } while(false);
+        need_to_write -=
+            stream_cache_write(stream->cache, data + (size - need_to_write), need_to_write);
+        if(need_to_write) {
+            if(!buffered_file_stream_flush(stream)) break;
+        }
+    }
     return size - need_to_write;
 }
 
 static size_t buffered_file_stream_read(BufferedFileStream* stream, uint8_t* data, size_t size) {
     size_t need_to_read = size;
+    if(stream->sync_pending) {
+        if(!buffered_file_stream_flush(stream)) return 0;
+    }
     while(need_to_read) {
-        need_to_read -=
-            stream_cache_read(stream->cache, data + (size - need_to_read), need_to_read);
-        if(need_to_read) {
-            if(stream->sync_pending) {
-                if(!buffered_file_stream_flush(stream)) break;
-            }
-            if(!stream_cache_fill(stream->cache, stream->file_stream)) break;
+        if(!stream_cache_select(stream->cache, stream->position)) {
+            if(!buffered_file_stream_fill(stream)) break;
         }
+        const size_t size_read =
+            stream_cache_read(stream->cache, data + (size - need_to_read), need_to_read);
+        stream->position += size_read;
+        need_to_read -= size_read;
     }
     return size - need_to_read;
 }
@@ -213,41 +255,56 @@ static bool buffered_file_stream_delete_and_insert(
     const void* ctx) {
     bool success = false;
     do {
-        if(!(stream->sync_pending ? buffered_file_stream_flush(stream) :
-                                    buffered_file_stream_unread(stream)))
-            break;
-        if(!stream_delete_and_insert(stream->file_stream, delete_size, write_callback, ctx)) break;
-        success = true;
+        if(stream->sync_pending && !buffered_file_stream_flush(stream)) break;
+        if(!buffered_file_stream_unread(stream)) break;
+        success =
+            stream_delete_and_insert(stream->file_stream, delete_size, write_callback, ctx);
+        stream->file_position = stream_tell(stream->file_stream);
+        stream->position = stream->file_position;
     } while(false);
     return success;
 }
 
-// Write the cache into the underlying stream and adjust seek position
+// Write the cache into the underlying stream, the position stays at the cache cursor
 static bool buffered_file_stream_flush(BufferedFileStream* stream) {
-    bool success = false;
-    do {
-        const int32_t offset = stream_cache_size(stream->cache) - stream_cache_pos(stream->cache);
-        if(!stream_cache_flush(stream->cache, stream->file_stream)) break;
-        if(offset > 0) {
-            if(!stream_seek(stream->file_stream, -offset, StreamOffsetFromCurrent)) break;
-        }
-        success = true;
-    } while(false);
+    const size_t position = stream->file_position + stream_cache_pos(stream->cache);
+    const size_t cache_size = stream_cache_size(stream->cache);
+    const bool success = stream_cache_flush(stream->cache, stream->file_stream);
+    stream->file_position += cache_size;
+    stream->position = position;
     stream->sync_pending = false;
+    if(!success) {
+        stream->file_position = stream_tell(stream->file_stream);
+    }
     return success;
 }
 
-// Drop read cache and adjust the underlying stream seek position
+// Drop read cache and move the underlying stream to the current position
 static bool buffered_file_stream_unread(BufferedFileStream* stream) {
     bool success = true;
-    const size_t cache_size = stream_cache_size(stream->cache);
-    if(cache_size > 0) {
-        const size_t cache_pos = stream_cache_pos(stream->cache);
-        if(cache_pos < cache_size) {
-            const int32_t offset = cache_size - cache_pos;
-            success = stream_seek(stream->file_stream, -offset, StreamOffsetFromCurrent);
-        }
-        stream_cache_drop(stream->cache);
+    stream_cache_drop(stream->cache);
+    if(stream->file_position != stream->position) {
+        success = stream_seek(stream->file_stream, stream->position, StreamOffsetFromStart);
+        stream->file_position = stream_tell(stream->file_stream);
+        stream->position = stream->file_position;
     }
     return success;
 }
+
+// Load the block with the current position, continuing from the underlying stream if possible
+static bool buffered_file_stream_fill(BufferedFileStream* stream) {
+    size_t offset = stream->position;
+    if(offset != stream->file_position) {
+        // Keep blocks aligned, so neighbour seeks hit the same blocks
+        offset -= offset % stream_cache_block_size(stream->cache);
+        if(!stream_seek(stream->file_stream, offset, StreamOffsetFromStart)) {
+            stream->file_position = stream_tell(stream->file_stream);
+            return false;
+        }
+        stream->file_position = offset;
+    }
+
+    const size_t size_read = stream_cache_fill(stream->cache, stream->file_stream, offset);
+    stream->file_position += size_read;
+    return stream_cache_select(stream->cache, stream->position);
+}
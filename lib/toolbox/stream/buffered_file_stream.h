@@ -13,6 +13,16 @@ extern "C" {
  */
 Stream* buffered_file_stream_alloc(Storage* storage);
 
+/**
+ * Allocate a file stream with buffered read operations and a multi-block cache.
+ * Seeks into cached blocks do not access the file, least recently used block is reloaded.
+ * @param storage pointer to storage object.
+ * @param block_size size of a cache block, multiple of the sector size (512) is recommended
+ * @param blocks_count number of cache blocks
+ * @return Stream*
+ */
+Stream* buffered_file_stream_alloc_ex(Storage* storage, size_t block_size, size_t blocks_count);
+
 /**
  * Opens an existing file or creates a new one.
  * @param stream pointer to file stream object.
@@ -1,88 +1,214 @@
 #include "stream_cache.h"
 
-#define STREAM_CACHE_MAX_SIZE 1024U
+#define STREAM_CACHE_BLOCK_REUSED 2
 
-struct StreamCache {
-    uint8_t data[STREAM_CACHE_MAX_SIZE];
+typedef struct {
+    uint8_t* data;
+    size_t offset;
     size_t data_size;
+    uint32_t last_used;
+    uint8_t uses; // Read ahead blocks start with 0, blocks used more than once are kept
+} StreamCacheBlock;
+
+struct StreamCache {
+    StreamCacheBlock* blocks;
+    size_t blocks_count;
+    size_t block_size;
+    StreamCacheBlock* active;
     size_t position;
+    uint32_t use_counter;
+    size_t fill_end; // Stream offset after the last filled block
 };
 
+static inline bool stream_cache_block_reused(const StreamCacheBlock* block) {
+    return block->uses >= STREAM_CACHE_BLOCK_REUSED;
+}
+
 StreamCache* stream_cache_alloc() {
+    return stream_cache_alloc_ex(
+        STREAM_CACHE_DEFAULT_BLOCK_SIZE, STREAM_CACHE_DEFAULT_BLOCKS_COUNT);
+}
+
+StreamCache* stream_cache_alloc_ex(size_t block_size, size_t blocks_count) {
+    furi_assert(block_size);
+    furi_assert(blocks_count);
     StreamCache* cache = malloc(sizeof(StreamCache));
-    cache->data_size = 0;
-    cache->position = 0;
+    cache->blocks = malloc(sizeof(StreamCacheBlock) * blocks_count);
+    cache->blocks_count = blocks_count;
+    cache->block_size = block_size;
+
+    uint8_t* data = malloc(block_size * blocks_count);
+    for(size_t i = 0; i < blocks_count; i++) {
+        cache->blocks[i].data = data + i * block_size;
+    }
+
+    stream_cache_drop(cache);
     return cache;
 }
+
 void stream_cache_free(StreamCache* cache) {
     furi_assert(cache);
-    cache->data_size = 0;
-    cache->position = 0;
+    free(cache->blocks[0].data);
+    free(cache->blocks);
     free(cache);
 }
 
 void stream_cache_drop(StreamCache* cache) {
-    cache->data_size = 0;
+    for(size_t i = 0; i < cache->blocks_count; i++) {
+        cache->blocks[i].offset = 0;
+        cache->blocks[i].data_size = 0;
+        cache->blocks[i].last_used = 0;
+        cache->blocks[i].uses = 0;
+    }
+    cache->active = &cache->blocks[0];
     cache->position = 0;
+    cache->use_counter = 0;
+    cache->fill_end = 0;
+}
+
+size_t stream_cache_block_size(StreamCache* cache) {
+    return cache->block_size;
 }
 
 bool stream_cache_at_end(StreamCache* cache) {
-    furi_assert(cache->data_size >= cache->position);
-    return cache->data_size == cache->position;
+    furi_assert(cache->active->data_size >= cache->position);
+    return cache->active->data_size == cache->position;
 }
 
 size_t stream_cache_size(StreamCache* cache) {
-    return cache->data_size;
+    return cache->active->data_size;
 }
 
 size_t stream_cache_pos(StreamCache* cache) {
     return cache->position;
 }
 
-size_t stream_cache_fill(StreamCache* cache, Stream* stream) {
-    const size_t size_read = stream_read(stream, cache->data, STREAM_CACHE_MAX_SIZE);
-    cache->data_size = size_read;
+bool stream_cache_select(StreamCache* cache, size_t offset) {
+    StreamCacheBlock* block = cache->active;
+
+    // Sequential access stays in the active block most of the time
+    if((offset < block->offset) || (offset >= block->offset + block->data_size)) {
+        block = NULL;
+        for(size_t i = 0; i < cache->blocks_count; i++) {
+            StreamCacheBlock* candidate = &cache->blocks[i];
+            if((offset >= candidate->offset) &&
+               (offset < candidate->offset + candidate->data_size)) {
+                block = candidate;
+                break;
+            }
+        }
+    }
+
+    if(block) {
+        if(block != cache->active) {
+            block->last_used = ++cache->use_counter;
+            if(block->uses < STREAM_CACHE_BLOCK_REUSED) block->uses++;
+            cache->active = block;
+        }
+        cache->position = offset - block->offset;
+    }
+
+    return block != NULL;
+}
+
+size_t stream_cache_fill(StreamCache* cache, Stream* stream, size_t offset) {
+    // Blocks that were read only once are replaced first, so a long sequential
+    // read cycles through them and does not evict the blocks that are seeked to
+    StreamCacheBlock* block = NULL;
+    size_t blocks_to_fill = 1;
+
+    if(offset == cache->fill_end) {
+        // Sequential read, take the longest run of such blocks to read ahead
+        for(size_t i = 0; i < cache->blocks_count;) {
+            size_t run = 0;
+            while(i + run < cache->blocks_count &&
+                  !stream_cache_block_reused(&cache->blocks[i + run])) {
+                run++;
+            }
+            if(run > blocks_to_fill || (run && !block)) {
+                block = &cache->blocks[i];
+                blocks_to_fill = run;
+            }
+            i += run + 1;
+        }
+    } else {
+        for(size_t i = 0; i < cache->blocks_count; i++) {
+            StreamCacheBlock* candidate = &cache->blocks[i];
+            if(!stream_cache_block_reused(candidate) &&
+               (!block || candidate->last_used < block->last_used)) {
+                block = candidate;
+            }
+        }
+    }
+
+    if(!block) {
+        block = &cache->blocks[0];
+        for(size_t i = 1; i < cache->blocks_count; i++) {
+            if(cache->blocks[i].last_used < block->last_used) block = &cache->blocks[i];
+        }
+    }
+
+    const size_t size_read =
+        stream_read(stream, block->data, cache->block_size * blocks_to_fill);
+    if(!size_read) return 0;
+
+    for(size_t i = 0; i * cache->block_size < size_read; i++) {
+        block[i].offset = offset + i * cache->block_size;
+        block[i].data_size = MIN(cache->block_size, size_read - i * cache->block_size);
+        block[i].last_used = ++cache->use_counter;
+        block[i].uses = (i == 0) ? 1 : 0;
+    }
+    for(size_t i = (size_read + cache->block_size - 1) / cache->block_size; i < blocks_to_fill;
+        i++) {
+        block[i].data_size = 0;
+    }
+
+    cache->fill_end = offset + size_read;
+    cache->active = block;
     cache->position = 0;
     return size_read;
 }
 
 bool stream_cache_flush(StreamCache* cache, Stream* stream) {
-    const size_t size_written = stream_write(stream, cache->data, cache->data_size);
-    const bool success = (size_written == cache->data_size);
-    cache->data_size = 0;
+    StreamCacheBlock* block = cache->active;
+    const size_t size_written = stream_write(stream, block->data, block->data_size);
+    const bool success = (size_written == block->data_size);
+    block->data_size = 0;
     cache->position = 0;
     return success;
 }
 
 size_t stream_cache_read(StreamCache* cache, uint8_t* data, size_t size) {
-    furi_assert(cache->data_size >= cache->position);
-    const size_t size_read = MIN(size, cache->data_size - cache->position);
+    StreamCacheBlock* block = cache->active;
+    furi_assert(block->data_size >= cache->position);
+    const size_t size_read = MIN(size, block->data_size - cache->position);
     if(size_read > 0) {
-        memcpy(data, cache->data + cache->position, size_read);
+        memcpy(data, block->data + cache->position, size_read);
         cache->position += size_read;
     }
     return size_read;
 }
 
 size_t stream_cache_write(StreamCache* cache, const uint8_t* data, size_t size) {
-    furi_assert(cache->data_size >= cache->position);
-    const size_t size_written = MIN(size, STREAM_CACHE_MAX_SIZE - cache->position);
+    StreamCacheBlock* block = cache->active;
+    furi_assert(block->data_size >= cache->position);
+    const size_t size_written = MIN(size, cache->block_size - cache->position);
     if(size_written > 0) {
-        memcpy(cache->data + cache->position, data, size_written);
+        memcpy(block->data + cache->position, data, size_written);
         cache->position += size_written;
-        if(cache->position > cache->data_size) {
-            cache->data_size = cache->position;
+        if(cache->position > block->data_size) {
+            block->data_size = cache->position;
         }
     }
     return size_written;
 }
 
 int32_t stream_cache_seek(StreamCache* cache, int32_t offset) {
-    furi_assert(cache->data_size >= cache->position);
+    furi_assert(cache->active->data_size >= cache->position);
     int32_t actual_offset = 0;
 
     if(offset > 0) {
-        actual_offset = MIN(cache->data_size - cache->position, (size_t)offset);
+        actual_offset = MIN(cache->active->data_size - cache->position, (size_t)offset);
     } else if(offset < 0) {
         actual_offset = MAX(-((int32_t)cache->position), offset);
     }
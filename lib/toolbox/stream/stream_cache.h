@@ -6,14 +6,25 @@
 extern "C" {
 #endif
 
+#define STREAM_CACHE_DEFAULT_BLOCK_SIZE 1024U
+#define STREAM_CACHE_DEFAULT_BLOCKS_COUNT 1U
+
 typedef struct StreamCache StreamCache;
 
 /**
- * Allocate stream cache.
+ * Allocate stream cache with a single block of default size.
  * @return StreamCache* pointer to a StreamCache instance
  */
 StreamCache* stream_cache_alloc();
 
+/**
+ * Allocate stream cache with several blocks, replaced in LRU order.
+ * @param block_size Size of a block in bytes, multiple of the sector size is recommended
+ * @param blocks_count Number of blocks
+ * @return StreamCache* pointer to a StreamCache instance
+ */
+StreamCache* stream_cache_alloc_ex(size_t block_size, size_t blocks_count);
+
 /**
  * Free stream cache.
  * @param cache Pointer to a StreamCache instance
@@ -21,11 +32,18 @@ StreamCache* stream_cache_alloc();
 void stream_cache_free(StreamCache* cache);
 
 /**
- * Drop the cache contents and set it to initial state.
+ * Drop the cache contents (all blocks) and set it to initial state.
  * @param cache Pointer to a StreamCache instance
  */
 void stream_cache_drop(StreamCache* cache);
 
+/**
+ * Get the size of a cache block.
+ * @param cache Pointer to a StreamCache instance
+ * @return Block size in bytes.
+ */
+size_t stream_cache_block_size(StreamCache* cache);
+
 /**
  * Determine if the internal cursor is at end the end of cached data.
  * @param cache Pointer to a StreamCache instance
@@ -34,7 +52,7 @@ void stream_cache_drop(StreamCache* cache);
 bool stream_cache_at_end(StreamCache* cache);
 
 /**
- * Get the current size of cached data.
+ * Get the current size of cached data in the active block.
  * @param cache Pointer to a StreamCache instance
  * @return Size of cached data.
  */
@@ -43,20 +61,29 @@ size_t stream_cache_size(StreamCache* cache);
 /**
  * Get the internal cursor position.
  * @param cache Pointer to a StreamCache instance
- * @return Cursor position inside the cache.
+ * @return Cursor position inside the active block.
  */
 size_t stream_cache_pos(StreamCache* cache);
 
 /**
- * Load the cache with new data from a stream.
+ * Make the block holding the stream offset active and move the cursor to it.
+ * @param cache Pointer to a StreamCache instance
+ * @param offset Offset in the underlying stream
+ * @return True if the offset is cached, otherwise false and the active block is not changed.
+ */
+bool stream_cache_select(StreamCache* cache, size_t offset);
+
+/**
+ * Load the least recently used block with new data from a stream and make it active.
  * @param cache Pointer to a StreamCache instance
  * @param stream Pointer to a Stream instance
+ * @param offset Current offset of the stream
  * @return Size of newly cached data.
  */
-size_t stream_cache_fill(StreamCache* cache, Stream* stream);
+size_t stream_cache_fill(StreamCache* cache, Stream* stream, size_t offset);
 
 /**
- * Write as much cached data as possible to a stream.
+ * Write as much cached data of the active block as possible to a stream.
  * @param cache Pointer to a StreamCache instance
  * @param stream Pointer to a Stream instance
  * @return True on success, False on failure.
@@ -8,6 +8,40 @@
 #define TAG "XtremeAssets"
 
 #define ICONS_FMT XTREME_ASSETS_PATH "/%s/Icons/%s"
+#define ICONS_BUNDLE_FMT XTREME_ASSETS_PATH "/%s/Icons.pack"
+
+#define ICONS_BUNDLE_MAGIC 0x4B504158 // "XAPK"
+#define ICONS_BUNDLE_VERSION 1
+
+/*
+ * Icons.pack layout, little endian, made by scripts/asset_packer.py:
+ *   IconsBundleHeader
+ *   IconsBundleEntry[icons_count], sorted by path hash
+ *   icon data in table order: uint32_t frame_offsets[frame_count], frames
+ */
+typedef struct {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t reserved;
+    uint32_t icons_count;
+} __attribute__((packed)) IconsBundleHeader;
+
+typedef struct {
+    uint32_t path_hash; // FNV-1a of the ICON_PATHS path
+    uint32_t data_offset; // From the start of the file
+    uint32_t data_size;
+    uint8_t width;
+    uint8_t height;
+    uint8_t frame_rate;
+    uint8_t frame_count;
+} __attribute__((packed)) IconsBundleEntry;
+
+typedef struct {
+    uint32_t path_hash;
+    const IconPath* icon_path;
+} IconsBundleLookup;
+
+static bool icons_bundled = false;
 
 void load_icon_animated(const Icon* replace, const char* name, FuriString* path, File* file) {
     const char* pack = xtreme_settings.asset_pack;
@@ -94,13 +128,122 @@ void free_icon(const Icon* icon) {
     Icon* original = icon->original;
     memcpy((void*)icon, original, sizeof(Icon));
 
+    // Bundled icons live in one block that starts with the original
     free(original);
+    if(icons_bundled) return;
     for(int32_t i = 0; i < frame_count; i++) {
         free(frames[i]);
     }
     free(frames);
 }
 
+static uint32_t bundle_path_hash(const char* path) {
+    uint32_t hash = 2166136261UL;
+    while(*path) {
+        hash ^= (uint8_t)*path++;
+        hash *= 16777619UL;
+    }
+    return hash;
+}
+
+static int bundle_lookup_cmp(const void* a, const void* b) {
+    uint32_t hash_a = ((const IconsBundleLookup*)a)->path_hash;
+    uint32_t hash_b = ((const IconsBundleLookup*)b)->path_hash;
+    return (hash_a > hash_b) - (hash_a < hash_b);
+}
+
+bool load_icon_bundled(const Icon* replace, const IconsBundleEntry* entry, File* file) {
+    if(entry->frame_count == 0 || entry->data_size < sizeof(uint32_t) * entry->frame_count) {
+        return false;
+    }
+
+    // Original, frame pointers and frame data in one allocation
+    size_t header_size = sizeof(Icon) + sizeof(uint8_t*) * entry->frame_count;
+    uint8_t* block = malloc(header_size + entry->data_size);
+    uint8_t* data = block + header_size;
+
+    if(!storage_file_seek(file, entry->data_offset, true) ||
+       storage_file_read(file, data, entry->data_size) != entry->data_size) {
+        free(block);
+        return false;
+    }
+
+    uint8_t** frames = (uint8_t**)(block + sizeof(Icon));
+    const uint32_t* frame_offsets = (const uint32_t*)data;
+    for(size_t i = 0; i < entry->frame_count; i++) {
+        if(frame_offsets[i] >= entry->data_size) {
+            free(block);
+            return false;
+        }
+        frames[i] = data + frame_offsets[i];
+    }
+
+    Icon* original = (Icon*)block;
+    memcpy(original, replace, sizeof(Icon));
+    FURI_CONST_ASSIGN_PTR(replace->original, original);
+    FURI_CONST_ASSIGN(replace->width, entry->width);
+    FURI_CONST_ASSIGN(replace->height, entry->height);
+    FURI_CONST_ASSIGN(replace->frame_rate, entry->frame_rate);
+    FURI_CONST_ASSIGN(replace->frame_count, entry->frame_count);
+    FURI_CONST_ASSIGN_PTR(replace->frames, frames);
+    return true;
+}
+
+bool load_icons_bundle(FuriString* path, File* file) {
+    furi_string_printf(path, ICONS_BUNDLE_FMT, xtreme_settings.asset_pack);
+    if(!storage_file_open(file, furi_string_get_cstr(path), FSAM_READ, FSOM_OPEN_EXISTING)) {
+        storage_file_close(file);
+        return false;
+    }
+
+    IconsBundleHeader header;
+    IconsBundleEntry* table = NULL;
+    IconsBundleLookup* lookup = NULL;
+    bool ok = false;
+
+    do {
+        if(storage_file_read(file, &header, sizeof(header)) != sizeof(header) ||
+           header.magic != ICONS_BUNDLE_MAGIC || header.version != ICONS_BUNDLE_VERSION) {
+            FURI_LOG_W(TAG, "Invalid icons bundle");
+            break;
+        }
+
+        // Both sides sorted by hash, so the data is read front to back in one pass
+        size_t table_size = sizeof(IconsBundleEntry) * header.icons_count;
+        if(table_size) {
+            table = malloc(table_size);
+            if(storage_file_read(file, table, table_size) != table_size) break;
+        }
+
+        ok = true;
+        if(!ICON_PATHS_COUNT) break;
+
+        lookup = malloc(sizeof(IconsBundleLookup) * ICON_PATHS_COUNT);
+        for(size_t i = 0; i < ICON_PATHS_COUNT; i++) {
+            lookup[i].path_hash = bundle_path_hash(ICON_PATHS[i].path);
+            lookup[i].icon_path = &ICON_PATHS[i];
+        }
+        qsort(lookup, ICON_PATHS_COUNT, sizeof(IconsBundleLookup), bundle_lookup_cmp);
+
+        size_t t = 0;
+        for(size_t i = 0; ok && i < ICON_PATHS_COUNT; i++) {
+            while(t < header.icons_count && table[t].path_hash < lookup[i].path_hash) t++;
+            if(t == header.icons_count) break;
+            if(table[t].path_hash != lookup[i].path_hash) continue;
+
+            const Icon* icon = lookup[i].icon_path->icon;
+            if(icon->original == NULL) {
+                ok = load_icon_bundled(icon, &table[t], file);
+            }
+        }
+    } while(false);
+
+    if(lookup) free(lookup);
+    if(table) free(table);
+    storage_file_close(file);
+    return ok;
+}
+
 void XTREME_ASSETS_LOAD() {
     const char* pack = xtreme_settings.asset_pack;
     xtreme_settings.is_nsfw = !strncmp(pack, "NSFW", strlen("NSFW"));
@@ -114,12 +257,19 @@ void XTREME_ASSETS_LOAD() {
        info.flags & FSF_DIRECTORY) {
         File* f = storage_file_alloc(storage);
 
-        for(size_t i = 0; i < ICON_PATHS_COUNT; i++) {
-            if(ICON_PATHS[i].icon->original == NULL) {
-                if(ICON_PATHS[i].animated) {
-                    load_icon_animated(ICON_PATHS[i].icon, ICON_PATHS[i].path, p, f);
-                } else {
-                    load_icon_static(ICON_PATHS[i].icon, ICON_PATHS[i].path, p, f);
+        icons_bundled = true;
+        if(!load_icons_bundle(p, f)) {
+            // Loose files layout, drop anything partially loaded from the bundle
+            XTREME_ASSETS_FREE();
+            icons_bundled = false;
+
+            for(size_t i = 0; i < ICON_PATHS_COUNT; i++) {
+                if(ICON_PATHS[i].icon->original == NULL) {
+                    if(ICON_PATHS[i].animated) {
+                        load_icon_animated(ICON_PATHS[i].icon, ICON_PATHS[i].path, p, f);
+                    } else {
+                        load_icon_static(ICON_PATHS[i].icon, ICON_PATHS[i].path, p, f);
+                    }
                 }
             }
         }
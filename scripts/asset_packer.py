@@ -11,6 +11,12 @@ import io
 import os
 
 
+ICONS_BUNDLE_MAGIC = 0x4B504158  # "XAPK"
+ICONS_BUNDLE_VERSION = 1
+ICONS_BUNDLE_HEADER = struct.Struct("<IHHI")
+ICONS_BUNDLE_ENTRY = struct.Struct("<IIIBBBB")
+
+
 def convert_bm(img: "Image.Image | pathlib.Path") -> bytes:
     if not isinstance(img, Image.Image):
         img = Image.open(img)
@@ -85,6 +91,71 @@ def pack_icon_static(src: pathlib.Path, dst: pathlib.Path):
     dst.with_suffix(".bmx").write_bytes(convert_bmx(src))
 
 
+def bundle_path_hash(path: str) -> int:
+    hash = 2166136261
+    for byte in path.encode():
+        hash ^= byte
+        hash = (hash * 16777619) & 0xFFFFFFFF
+    return hash
+
+
+def pack_icons_bundle(icons: pathlib.Path, dst: pathlib.Path):
+    # Collect the packed loose icons, firmware falls back to them without the bundle
+    entries = {}
+    for category in icons.iterdir():
+        if not category.is_dir():
+            continue
+        for icon in category.iterdir():
+            path = f"{category.name}/{icon.stem if icon.is_file() else icon.name}"
+            if icon.is_dir() and (icon / "meta").is_file():
+                width, height, frame_rate, frame_count = struct.unpack(
+                    "<IIII", (icon / "meta").read_bytes()
+                )
+                frames = [
+                    (icon / f"frame_{i:02d}.bm").read_bytes() for i in range(frame_count)
+                ]
+            elif icon.is_file() and icon.suffix == ".bmx":
+                bmx = icon.read_bytes()
+                width, height = struct.unpack("<II", bmx[:8])
+                frame_rate = 0
+                frames = [bmx[8:]]
+            else:
+                continue
+            hash = bundle_path_hash(path)
+            if hash in entries:
+                raise Exception(f"Icon path hash collision: {path}")
+            entries[hash] = (width, height, frame_rate, frames)
+
+    table = bytearray()
+    data = bytearray()
+    data_offset = ICONS_BUNDLE_HEADER.size + ICONS_BUNDLE_ENTRY.size * len(entries)
+    for hash in sorted(entries):
+        width, height, frame_rate, frames = entries[hash]
+        icon_data = bytearray()
+        frame_offset = 4 * len(frames)
+        for frame in frames:
+            icon_data += struct.pack("<I", frame_offset)
+            frame_offset += len(frame)
+        for frame in frames:
+            icon_data += frame
+        table += ICONS_BUNDLE_ENTRY.pack(
+            hash,
+            data_offset + len(data),
+            len(icon_data),
+            width,
+            height,
+            frame_rate,
+            len(frames),
+        )
+        data += icon_data
+        data += b"\x00" * (-len(data) % 4)
+
+    header = ICONS_BUNDLE_HEADER.pack(
+        ICONS_BUNDLE_MAGIC, ICONS_BUNDLE_VERSION, 0, len(entries)
+    )
+    dst.write_bytes(header + table + data)
+
+
 def pack(
     input: "str | pathlib.Path", output: "str | pathlib.Path", logger: typing.Callable
 ):
@@ -145,6 +216,10 @@ def pack(
                             icon, packed / "Icons" / icons.name / icon.name
                         )
 
+        if (packed / "Icons").is_dir():
+            logger(f"Bundle: icons for pack '{source.name}'")
+            pack_icons_bundle(packed / "Icons", packed / "Icons.pack")
+
 
 if __name__ == "__main__":
     input(
@@ -0,0 +1,243 @@
+#!/usr/bin/env python3
+
+import shutil
+import struct
+import subprocess
+from dataclasses import dataclass
+
+from flipper.app import App
+from flipper.storage import FlipperStorage
+from flipper.utils.cdc import resolve_port
+
+# Keep in sync with furi/core/memmgr_heap.h
+PROFILE_MAGIC = 0x44504846
+PROFILE_VERSION = 1
+HEADER_FORMAT = "<IHH14I4H"
+SITE_FORMAT = "<4I"
+THREAD_FORMAT = "<I12s3I"
+SAMPLE_FORMAT = "<3I"
+
+
+@dataclass
+class Site:
+    address: int
+    count: int
+    bytes: int
+    live: int
+
+
+@dataclass
+class Thread:
+    thread_id: int
+    name: str
+    count: int
+    live: int
+    peak: int
+
+
+@dataclass
+class Sample:
+    tick: int
+    free: int
+    max_free_block: int
+
+
+def fragmentation(free: int, max_free_block: int) -> float:
+    return 1 - max_free_block / free if free else 0
+
+
+class HeapProfile:
+    HEADER_FIELDS = (
+        "magic",
+        "version",
+        "header_size",
+        "tick",
+        "start_tick",
+        "heap_total",
+        "heap_free",
+        "heap_min_free",
+        "max_free_block",
+        "worst_max_free_block",
+        "worst_max_free_block_tick",
+        "alloc_count",
+        "free_count",
+        "untracked_count",
+        "live",
+        "peak",
+        "sample_period",
+        "size_class_count",
+        "site_count",
+        "thread_count",
+        "sample_count",
+    )
+
+    def __init__(self, data: bytes):
+        header = struct.unpack_from(HEADER_FORMAT, data)
+        self.__dict__.update(zip(self.HEADER_FIELDS, header))
+        if self.magic != PROFILE_MAGIC:
+            raise ValueError("Not a heap profile dump")
+        if self.version != PROFILE_VERSION:
+            raise ValueError(f"Unsupported heap profile version {self.version}")
+
+        offset = self.header_size
+        self.size_classes = struct.unpack_from(f"<{self.size_class_count}I", data, offset)
+        offset += self.size_class_count * 4
+
+        self.sites = []
+        for _ in range(self.site_count):
+            self.sites.append(Site(*struct.unpack_from(SITE_FORMAT, data, offset)))
+            offset += struct.calcsize(SITE_FORMAT)
+
+        self.threads = []
+        for _ in range(self.thread_count):
+            thread_id, name, *counters = struct.unpack_from(THREAD_FORMAT, data, offset)
+            name = name.split(b"\0", 1)[0].decode("ascii", "replace")
+            self.threads.append(Thread(thread_id, name, *counters))
+            offset += struct.calcsize(THREAD_FORMAT)
+
+        self.samples = []
+        for _ in range(self.sample_count):
+            self.samples.append(Sample(*struct.unpack_from(SAMPLE_FORMAT, data, offset)))
+            offset += struct.calcsize(SAMPLE_FORMAT)
+
+    @staticmethod
+    def size_class_name(index: int, count: int) -> str:
+        if index == count - 1:
+            return f">{2 ** (index + 2)}"
+        return f"<={2 ** (index + 3)}"
+
+
+class Main(App):
+    def init(self):
+        self.subparsers = self.parser.add_subparsers(help="sub-command help")
+
+        self.parser_fetch = self.subparsers.add_parser(
+            "fetch", help="Fetch heap profile dump over CLI"
+        )
+        self.parser_fetch.add_argument("-p", "--port", help="CDC Port", default="auto")
+        self.parser_fetch.add_argument("output", help="Binary dump file")
+        self.parser_fetch.set_defaults(func=self.fetch)
+
+        self.parser_report = self.subparsers.add_parser(
+            "report", help="Decode heap profile dump"
+        )
+        self.parser_report.add_argument(
+            "dump", help="Binary or hex dump, as printed by `heap_profile dump`"
+        )
+        self.parser_report.add_argument("-e", "--elf", help="Firmware ELF to symbolize with")
+        self.parser_report.add_argument(
+            "--addr2line", help="addr2line binary", default="arm-none-eabi-addr2line"
+        )
+        self.parser_report.add_argument(
+            "-n", "--top", help="Allocation sites to show", type=int, default=20
+        )
+        self.parser_report.set_defaults(func=self.report)
+
+    def fetch(self):
+        if not (port := resolve_port(self.logger, self.args.port)):
+            return 1
+
+        with FlipperStorage(port) as flipper:
+            flipper.send_and_wait_eol("heap_profile dump\r")
+            data = flipper.read.until(FlipperStorage.CLI_PROMPT)
+
+        try:
+            dump = self._decode(data)
+            HeapProfile(dump)
+        except ValueError as e:
+            self.logger.error(f"Failed to fetch heap profile: {e}")
+            return 1
+
+        with open(self.args.output, "wb") as f:
+            f.write(dump)
+        self.logger.info(f"Heap profile saved to {self.args.output}, {len(dump)} bytes")
+        return 0
+
+    @staticmethod
+    def _decode(data: bytes) -> bytes:
+        if data.startswith(struct.pack("<I", PROFILE_MAGIC)):
+            return data
+        # Hex dump: CLI output or concatenated heap.profile.dump.* RPC properties
+        return bytes.fromhex("".join(data.decode("ascii").split()))
+
+    def _symbolize(self, addresses):
+        if not self.args.elf:
+            return {}
+        if not shutil.which(self.args.addr2line):
+            self.logger.warning(f"{self.args.addr2line} not found, not symbolizing")
+            return {}
+
+        # Thumb return address points past the call, step back into the call instruction
+        call_sites = [(address & ~1) - 2 for address in addresses]
+        output = subprocess.check_output(
+            [self.args.addr2line, "-f", "-C", "-e", self.args.elf]
+            + [f"0x{address:08x}" for address in call_sites],
+            shell=False,
+        )
+        lines = output.decode("utf-8").splitlines()
+        return {
+            address: f"{lines[i * 2]} {lines[i * 2 + 1]}"
+            for i, address in enumerate(addresses)
+        }
+
+    def report(self):
+        with open(self.args.dump, "rb") as f:
+            profile = HeapProfile(self._decode(f.read()))
+
+        duration = profile.tick - profile.start_tick
+        print(f"Profile: {duration} ticks, sample period {profile.sample_period}")
+        print(
+            f"Heap: total {profile.heap_total}, free {profile.heap_free}, "
+            f"min free {profile.heap_min_free}"
+        )
+        print(
+            f"Allocations: {profile.alloc_count}, frees {profile.free_count}, "
+            f"untracked {profile.untracked_count}"
+        )
+        print(f"Live: {profile.live}, peak {profile.peak}")
+        print(
+            f"Largest free block: {profile.max_free_block}, "
+            f"fragmentation {fragmentation(profile.heap_free, profile.max_free_block):.3f}"
+        )
+        print(
+            f"Worst largest free block: {profile.worst_max_free_block} "
+            f"at tick {profile.worst_max_free_block_tick}"
+        )
+
+        print("\nRequest size histogram:")
+        for index, count in enumerate(profile.size_classes):
+            if count:
+                name = HeapProfile.size_class_name(index, profile.size_class_count)
+                print(f"  {name:>8}: {count}")
+
+        print("\nThreads:")
+        print(f"  {'Name':<12} {'Id':<10} {'Allocs':>8} {'Live':>8} {'Peak':>8}")
+        for thread in sorted(profile.threads, key=lambda t: t.peak, reverse=True):
+            print(
+                f"  {thread.name:<12} {thread.thread_id:08x}   "
+                f"{thread.count:>8} {thread.live:>8} {thread.peak:>8}"
+            )
+
+        sites = sorted(profile.sites, key=lambda s: (s.live, s.bytes), reverse=True)
+        sites = sites[: self.args.top]
+        symbols = self._symbolize([site.address for site in sites])
+        print("\nAllocation sites:")
+        print(f"  {'Address':<10} {'Allocs':>8} {'Bytes':>10} {'Live':>8}")
+        for site in sites:
+            print(
+                f"  {site.address:08x}   {site.count:>8} {site.bytes:>10} {site.live:>8}"
+                f"  {symbols.get(site.address, '')}"
+            )
+
+        print("\nLargest free block over time:")
+        print(f"  {'Tick':>10} {'Free':>8} {'Largest':>8} {'Fragmentation':>14}")
+        for sample in profile.samples:
+            print(
+                f"  {sample.tick:>10} {sample.free:>8} {sample.max_free_block:>8} "
+                f"{fragmentation(sample.free, sample.max_free_block):>14.3f}"
+            )
+        return 0
+
+
+if __name__ == "__main__":
+    Main()()